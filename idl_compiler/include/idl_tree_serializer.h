@@ -144,10 +144,14 @@ std::string impl_templateMemberTypeName( std::string templateParentName, const M
 }
 
 void impl_generateParseFunctionBodyForPublishableStructStateSyncOrMessageInDepth( FILE* header, Root& root, CompositeType& obj );
+bool impl_isFixedLayoutForGmq( Root& root, CompositeType& s );
+std::string impl_generateMaxGmqSizeExpression( Root& root, CompositeType& s );
+std::string impl_generateMemberSkipStatement( Root& root, const MessageParameter& member );
 
 
 
 void impl_generateParseFunctionForMessagesAndAliasingStructs( FILE* header, Root& root, CompositeType& s );
+void impl_generateMessageView( FILE* header, Root& root, CompositeType& s );
 
 // code generation
 //void preprocessRoot(Root& s);
@@ -874,6 +874,8 @@ void generateRoot(FILE* header, Root& s, const GenerationConfig& config)
 
 void generateCplusplus(FILE* header, Root& s, GenerationConfig config)
 {
+    // compose/parse helpers are generated once per named type, so with concrete composers and parsers every call inlines;
+    // naming an interface type with --composer=/--parser= instead would turn every field into a virtual call
     if (config.composerNames.empty())
     {
         config.composerNames.push_back("GmqComposer");
@@ -112,12 +112,12 @@ void impl_generateScopeComposer(FILE* header, Scope& scope, const std::string& c
             composerType.c_str());
 
     fprintf(header, "\tcomposer.structBegin();\n"
-                    "\tcomposer.namedParamBegin(\"msgid\");\n"
+                    "\tcomposer.namedParamBegin(globalmq::marshalling2::JsonKey( \"msgid\", \"\\\"msgid\\\":\" ));\n"
                     "\tcomposer.composeUnsignedInteger(msgID::id);\n"
                     "\n"
                     "\tcomposer.nextElement();\n"
                     "\n"
-                    "\tcomposer.namedParamBegin(\"msgbody\");\n");
+                    "\tcomposer.namedParamBegin(globalmq::marshalling2::JsonKey( \"msgbody\", \"\\\"msgbody\\\":\" ));\n");
 
     fprintf(header, "\tif constexpr ( msgID::id == %s::id )\n", scope.objectList[0]->name.c_str());
     fprintf(header, "\t\tMESSAGE_%s_compose( composer, std::forward<Args>( args )... );\n",
@@ -373,7 +373,7 @@ void impl_generateParamCallBlockForComposingJson(FILE* header, CompositeType& s,
         }
         ++count;
 
-        fprintf(header, "%scomposer.namedParamBegin(\"%s\");\n", offset, param.name.c_str());
+        fprintf(header, "%scomposer.namedParamBegin(globalmq::marshalling2::JsonKey( \"%s\", \"\\\"%s\\\":\" ));\n", offset, param.name.c_str(), param.name.c_str());
 
         switch (param.type.kind)
         {
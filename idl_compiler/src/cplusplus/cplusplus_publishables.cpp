@@ -130,7 +130,7 @@ void impl_GeneratePublishableStateMemberGetter4Set(FILE* header, Root& root, con
     else
     {
         rootType = fmt::format("{}_WrapperForPublisher", rootTypeNameBase);
-        addr = "GMQ_COLL vector<uint64_t>()";
+        addr = "globalmq::marshalling2::PublishableAddress()";
         rootObjName = "*this";
     }
 
@@ -224,7 +224,7 @@ void impl_generateComposeFunctionForPublishableStruct_MemberIterationBlock(FILE*
             fprintf(header, "\n");
         }
 
-        fprintf(header, "%scomposer.namedParamBegin( \"%s\" );\n", offset, member.name.c_str());
+        fprintf(header, "%scomposer.namedParamBegin( globalmq::marshalling2::JsonKey( \"%s\", \"\\\"%s\\\":\" ) );\n", offset, member.name.c_str(), member.name.c_str());
         fprintf(header, "%s%s::compose(composer, t.%s );\n", offset, getTypeProcessor(member.type).c_str(),
                 impl_memberOrAccessFunctionName(member).c_str());
     }
@@ -249,7 +249,7 @@ void impl_generateComposeFunctionForPublishableStruct(FILE* header, Root& root,
     {
         fprintf(header, "\t\tuint64_t caseId = t.currentVariant();\n");
 
-        fprintf(header, "\t\tcomposer.namedParamBegin( \"caseId\" );\n");
+        fprintf(header, "\t\tcomposer.namedParamBegin( globalmq::marshalling2::JsonKey( \"caseId\", \"\\\"caseId\\\":\" ) );\n");
         fprintf(header, "\t\tcomposer.composeUnsignedInteger( caseId );\n");
 
         fprintf(header, "\n");
@@ -259,7 +259,7 @@ void impl_generateComposeFunctionForPublishableStruct(FILE* header, Root& root,
         fprintf(header, "\t\tif ( caseId != CppType::Variants::unknown )\n");
         fprintf(header, "\t\t{\n");
 
-        fprintf(header, "\t\t\tcomposer.namedParamBegin( \"caseData\" );\n");
+        fprintf(header, "\t\t\tcomposer.namedParamBegin( globalmq::marshalling2::JsonKey( \"caseData\", \"\\\"caseData\\\":\" ) );\n");
         fprintf(header, "\t\t\tcomposer.structBegin();\n");
         fprintf(header, "\t\t\tswitch ( caseId )\n");
         fprintf(header, "\t\t\t{\n");
@@ -578,7 +578,7 @@ void impl_GeneratePublishableStateMemberSetter(FILE* header, Root& root, bool fo
     //	assert( (forRoot && rootName != nullptr) || (forRoot == false && rootName == nullptr) );
     const char* composer = forRoot ? "composer" : "root.getComposer()";
     const char* composerT = forRoot ? "ComposerT" : "decltype(root.getComposer())";
-    const char* addrVector = forRoot ? "GMQ_COLL vector<uint64_t>()" : "address";
+    const char* addrVector = forRoot ? "globalmq::marshalling2::PublishableAddress()" : "address";
 
     fprintf(header, "\tvoid set_%s( %s val) { \n", param.name.c_str(), impl_templateMemberTypeName("T", param).c_str());
     fprintf(header, "\t\tt.%s = val; \n", impl_memberOrAccessFunctionName(param).c_str());
@@ -626,7 +626,7 @@ void impl_GeneratePublishableStateMemberAccessors(FILE* header, Root& root, Comp
         {
             const char* composer = forRoot ? "composer" : "root.getComposer()";
             const char* composerT = forRoot ? "ComposerT" : "decltype(root.getComposer())";
-            const char* addrVector = forRoot ? "GMQ_COLL vector<uint64_t>()" : "address";
+            const char* addrVector = forRoot ? "globalmq::marshalling2::PublishableAddress()" : "address";
             fprintf(header, "\tvoid set_currentVariant( typename T::Variants v ) { \n");
             fprintf(header, "\t\tt.initAs( v ); \n");
 
@@ -695,9 +695,12 @@ void impl_GeneratePublishableStateWrapperForPublisher(FILE* header, Root& root,
                     "composer.reset(); composer.stateUpdateBegin(); }\n");
     fprintf(header,
             "\tvirtual BufferT&& endTick() override { composer.stateUpdateEnd(); return std::move( buffer ); }\n");
+    fprintf(header, "\tvirtual bool setLengthPrefixedStrings( bool lengthPrefixed ) override { return "
+                    "::globalmq::marshalling::PublishableStateMessageHeader::applyStringEncoding( composer, lengthPrefixed ); }\n");
     fprintf(header, "\tvirtual const char* publishableName() override { return stringTypeID; }\n");
     fprintf(header, "\tvirtual uint64_t stateTypeID() override { return numTypeID; }\n");
     fprintf(header, "\tvirtual void generateStateSyncMessage(ComposerT& composer) override { compose(composer); }\n");
+    fprintf(header, "\tvirtual uint64_t changeCount() override { return composer.changeCount; }\n");
 
     impl_GeneratePublishableStateMemberAccessors(header, root, s, true);
     fprintf(header, "\n");
@@ -757,10 +760,10 @@ void impl_GeneratePublishableStructWrapper4Set(FILE* header, Root& root, Composi
     fprintf(header, "\tusing T = %s;\n", getGeneratedTypeName(s).c_str());
     fprintf(header, "\tT& t;\n");
     fprintf(header, "\tRootT& root;\n");
-    fprintf(header, "\tGMQ_COLL vector<uint64_t> address;\n");
+    fprintf(header, "\tglobalmq::marshalling2::PublishableAddress address;\n");
 
     fprintf(header, "\npublic:\n");
-    fprintf(header, "\t%s_RefWrapper4Set( T& actual, RootT& root_, GMQ_COLL vector<uint64_t>&& address_ )\n",
+    fprintf(header, "\t%s_RefWrapper4Set( T& actual, RootT& root_, globalmq::marshalling2::PublishableAddress&& address_ )\n",
             s.name.c_str());
     fprintf(header, "\t\t: t( actual ), root( root_ ), address( std::move(address_) )\n");
     fprintf(header, "\t\t{ }\n");
@@ -1185,7 +1188,7 @@ void impl_generateContinueParsingFunctionForPublishableStruct2(FileWritter f, Ro
     string className = getSubscriberClassName(obj.name);
 
     f.write("\tinline\n");
-    f.write("\tbool %s::parse_continue( %s& parser, GMQ_COLL vector<uint64_t>& addr, uint64_t offset )\n",
+    f.write("\tbool %s::parse_continue( %s& parser, globalmq::marshalling2::PublishableAddress& addr, uint64_t offset )\n",
             className.c_str(), parserType.c_str());
     f.write("\t{\n");
     f.write("\t\tbool changed = false;\n");
@@ -1557,7 +1560,7 @@ void impl_GenerateApplyUpdateMessageMemberFn2(FileWritter f)
     f.write("\tvoid applyMessageWithUpdates(ParserT& parser)\n");
     f.write("\t{\n");
     f.write("\t\tparser.stateUpdateBegin();\n");
-    f.write("\t\tGMQ_COLL vector<uint64_t> addr;\n");
+    f.write("\t\tglobalmq::marshalling2::PublishableAddress addr;\n");
     f.write("\t\twhile( parser.changeBegin( addr ) )\n");
     f.write("\t\t{\n");
     f.write("\t\t\tGMQ_ASSERT( addr.size() );\n");
@@ -1601,7 +1604,7 @@ void impl_generateComposeFunctionForPublishableStruct_MemberIterationBlock2(File
             f.write("\n");
         }
 
-        f.write("composer.namedParamBegin( \"%s\" );\n", member.name.c_str());
+        f.write("composer.namedParamBegin( globalmq::marshalling2::JsonKey( \"%s\", \"\\\"%s\\\":\" ) );\n", member.name.c_str(), member.name.c_str());
 
         switch (member.type.kind)
         {
@@ -1646,7 +1649,7 @@ void impl_generateComposeFunctionForPublishableStruct2(FileWritter f, CompositeT
     if (obj.isDiscriminatedUnion())
     {
         f.write("\t\tVariants caseId = this->currentVariant();\n");
-        f.write("\t\tcomposer.namedParamBegin( \"caseId\" );\n");
+        f.write("\t\tcomposer.namedParamBegin( globalmq::marshalling2::JsonKey( \"caseId\", \"\\\"caseId\\\":\" ) );\n");
         f.write("\t\tcomposer.composeUnsignedInteger( caseId );\n");
 
         f.write("\n");
@@ -1655,7 +1658,7 @@ void impl_generateComposeFunctionForPublishableStruct2(FileWritter f, CompositeT
 
         f.write("\t\tif ( caseId != Variants::unknown )\n");
         f.write("\t\t{\n");
-        f.write("\t\t\tcomposer.namedParamBegin( \"caseData\" );\n");
+        f.write("\t\t\tcomposer.namedParamBegin( globalmq::marshalling2::JsonKey( \"caseData\", \"\\\"caseData\\\":\" ) );\n");
         f.write("\t\t\tcomposer.structBegin();\n");
         f.write("\t\t\tswitch ( caseId )\n");
         f.write("\t\t\t{\n");
@@ -2299,9 +2302,9 @@ void impl_generateSubscriberStruct(FileWritter f, Root& root, CompositeType& obj
                 each.c_str());
         f.write("\n");
 
-        f.write("\tinline bool parse_continue( %s& parser, GMQ_COLL vector<uint64_t>& addr, uint64_t offset );\n",
+        f.write("\tinline bool parse_continue( %s& parser, globalmq::marshalling2::PublishableAddress& addr, uint64_t offset );\n",
                 each.c_str());
-        f.write("\tstatic bool parse_continue( %s& parser, ThisType& tt, GMQ_COLL vector<uint64_t>& addr, uint64_t "
+        f.write("\tstatic bool parse_continue( %s& parser, ThisType& tt, globalmq::marshalling2::PublishableAddress& addr, uint64_t "
                 "offset ) { return tt.parse_continue(parser, addr, offset); }\n",
                 each.c_str());
         f.write("\n");
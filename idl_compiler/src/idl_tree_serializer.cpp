@@ -730,6 +730,8 @@ void generateRoot( const char* fileName, uint32_t fileChecksum, FILE* header, co
 			assert( idx < s.structs.size() );
 			CompositeType& alias = *(s.structs[idx]);
 			impl_generateParseFunctionForMessagesAndAliasingStructs( header, s, alias );
+			if ( scope->proto == Proto::gmq && !alias.isDiscriminatedUnion() )
+				impl_generateMessageView( header, s, alias );
 		}
 
 		for ( auto it : scope->objectList )
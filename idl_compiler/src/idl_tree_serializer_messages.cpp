@@ -41,6 +41,11 @@ std::string impl_generateComposeFunctionName( CompositeType& s )
 	return fmt::format( "{}_{}_compose", s.type2string(), s.name );
 }
 
+std::string impl_generateSerializedSizeFunctionName( CompositeType& s )
+{
+	return fmt::format( "{}_{}_serializedSize", s.type2string(), s.name );
+}
+
 std::string impl_generateParseFunctionName( CompositeType& s )
 {
 	return fmt::format( "{}_{}_parse", s.type2string(), s.name );
@@ -180,15 +185,8 @@ void impl_generateScopeComposerForwardDeclaration( FILE* header, Scope& scope )
 	);
 }
 
-void impl_generateScopeComposer( FILE* header, Scope& scope )
+void impl_generateScopeComposerEnvelopeBegin( FILE* header, Scope& scope )
 {
-	assert( scope.objectList.size() != 0 );
-	fprintf( header, 
-		"template<typename msgID, class BufferT, typename ... Args>\n"
-		"void composeMessage( BufferT& buffer, Args&& ... args )\n"
-		"{\n"
-		"\tstatic_assert( std::is_base_of<::globalmq::marshalling::impl::MessageNameBase, msgID>::value );\n" 
-	);
 	switch ( scope.proto )
 	{
 		case Proto::gmq: 
@@ -201,25 +199,18 @@ void impl_generateScopeComposer( FILE* header, Scope& scope )
 			fprintf( header, 
 				"\tglobalmq::marshalling::JsonComposer composer( buffer );\n"
 				"\tcomposer.buff.append( \"{\\n  \", sizeof(\"{\\n  \") - 1 );\n"
-				"\t::globalmq::marshalling::impl::json::composeNamedSignedInteger( composer, \"msgid\", msgID::id);\n"
+				"\t::globalmq::marshalling::impl::json::composeNamedSignedInteger( composer, ::globalmq::marshalling::impl::JsonKeyForComposing( \"msgid\", \"\\\"msgid\\\":\" ), msgID::id);\n"
 				"\tcomposer.buff.append( \",\\n  \", sizeof(\",\\n  \") - 1 );\n"
-				"\t::globalmq::marshalling::impl::json::addNamePart( composer, \"msgbody\" );\n"
+				"\t::globalmq::marshalling::impl::json::addNamePart( composer, ::globalmq::marshalling::impl::JsonKeyForComposing( \"msgbody\", \"\\\"msgbody\\\":\" ) );\n"
 			);
 			break;
 		default:
 			assert( false );
 	}
+}
 
-	fprintf( header, "\tif constexpr ( msgID::id == %s::id )\n", scope.objectList[0]->name.c_str() );
-	fprintf( header, "\t\t%s( composer, std::forward<Args>( args )... );\n", impl_generateComposeFunctionName(*(scope.objectList[0])).c_str() );
-	for ( size_t i=1; i<scope.objectList.size(); ++i )
-	{
-		fprintf( header, "\telse if constexpr ( msgID::id == %s::id )\n", scope.objectList[i]->name.c_str() );
-		fprintf( header, "\t\t%s( composer, std::forward<Args>( args )... );\n", impl_generateComposeFunctionName(*(scope.objectList[i])).c_str() );
-	}
-	fprintf( header, 
-		"\telse\n"
-		"\t\tstatic_assert( std::is_same<::globalmq::marshalling::impl::MessageNameBase, msgID>::value, \"unexpected value of msgID\" ); // note: should be just static_assert(false,\"...\"); but it seems that in this case clang asserts yet before looking at constexpr conditions\n" );
+void impl_generateScopeComposerEnvelopeEnd( FILE* header, Scope& scope )
+{
 	switch ( scope.proto )
 	{
 		case Proto::gmq: break;
@@ -230,6 +221,55 @@ void impl_generateScopeComposer( FILE* header, Scope& scope )
 			assert( false );
 			break;
 	}
+}
+
+void impl_generateScopeComposer( FILE* header, Scope& scope )
+{
+	assert( scope.objectList.size() != 0 );
+
+	// size of a message to be composed (an upper bound, for fixed-layout GMQ messages), to have room for it reserved at once
+	// (composing functions only read their args; forwarding them twice, first for measuring, is therefore safe)
+	fprintf( header, 
+		"template<typename msgID, typename ... Args>\n"
+		"size_t serializedSize( Args&& ... args )\n"
+		"{\n"
+		"\tstatic_assert( std::is_base_of<::globalmq::marshalling::impl::MessageNameBase, msgID>::value );\n" 
+		"\t::globalmq::marshalling::SizeMeasuringBuffer buffer;\n"
+	);
+	impl_generateScopeComposerEnvelopeBegin( header, scope );
+	impl_generateScopeComposerEnvelopeEnd( header, scope );
+	fprintf( header, "\tif constexpr ( msgID::id == %s::id )\n", scope.objectList[0]->name.c_str() );
+	fprintf( header, "\t\treturn buffer.size() + %s( composer, std::forward<Args>( args )... );\n", impl_generateSerializedSizeFunctionName(*(scope.objectList[0])).c_str() );
+	for ( size_t i=1; i<scope.objectList.size(); ++i )
+	{
+		fprintf( header, "\telse if constexpr ( msgID::id == %s::id )\n", scope.objectList[i]->name.c_str() );
+		fprintf( header, "\t\treturn buffer.size() + %s( composer, std::forward<Args>( args )... );\n", impl_generateSerializedSizeFunctionName(*(scope.objectList[i])).c_str() );
+	}
+	fprintf( header, 
+		"\telse\n"
+		"\t\tstatic_assert( std::is_same<::globalmq::marshalling::impl::MessageNameBase, msgID>::value, \"unexpected value of msgID\" );\n"
+		"}\n\n" );
+
+	fprintf( header, 
+		"template<typename msgID, class BufferT, typename ... Args>\n"
+		"void composeMessage( BufferT& buffer, Args&& ... args )\n"
+		"{\n"
+		"\tstatic_assert( std::is_base_of<::globalmq::marshalling::impl::MessageNameBase, msgID>::value );\n" 
+		"\t::globalmq::marshalling::impl::reserveForComposing( buffer, serializedSize<msgID>( std::forward<Args>( args )... ) );\n" 
+	);
+	impl_generateScopeComposerEnvelopeBegin( header, scope );
+
+	fprintf( header, "\tif constexpr ( msgID::id == %s::id )\n", scope.objectList[0]->name.c_str() );
+	fprintf( header, "\t\t%s( composer, std::forward<Args>( args )... );\n", impl_generateComposeFunctionName(*(scope.objectList[0])).c_str() );
+	for ( size_t i=1; i<scope.objectList.size(); ++i )
+	{
+		fprintf( header, "\telse if constexpr ( msgID::id == %s::id )\n", scope.objectList[i]->name.c_str() );
+		fprintf( header, "\t\t%s( composer, std::forward<Args>( args )... );\n", impl_generateComposeFunctionName(*(scope.objectList[i])).c_str() );
+	}
+	fprintf( header, 
+		"\telse\n"
+		"\t\tstatic_assert( std::is_same<::globalmq::marshalling::impl::MessageNameBase, msgID>::value, \"unexpected value of msgID\" ); // note: should be just static_assert(false,\"...\"); but it seems that in this case clang asserts yet before looking at constexpr conditions\n" );
+	impl_generateScopeComposerEnvelopeEnd( header, scope );
 	fprintf( header, 
 		"}\n\n" );
 }
@@ -660,23 +700,23 @@ void impl_generateParamCallBlockForComposingJson( FILE* header, CompositeType& s
 		switch ( param.type.kind )
 		{
 			case MessageParameterType::KIND::INTEGER:
-				fprintf( header, "%s::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_%d_type, %s, int64_t, int64_t, (int64_t)(%lld)>(composer, \"%s\", arg_%d_type::nameAndTypeID, args...);\n", offset, count, param.type.hasDefault ? "false" : "true", (int64_t)(param.type.numericalDefault), param.name.c_str(), count );
+				fprintf( header, "%s::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_%d_type, %s, int64_t, int64_t, (int64_t)(%lld)>(composer, ::globalmq::marshalling::impl::JsonKeyForComposing( \"%s\", \"\\\"%s\\\":\" ), arg_%d_type::nameAndTypeID, args...);\n", offset, count, param.type.hasDefault ? "false" : "true", (int64_t)(param.type.numericalDefault), param.name.c_str(), param.name.c_str(), count );
 				break;
 			case MessageParameterType::KIND::UINTEGER:
-				fprintf( header, "%s::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_%d_type, %s, uint64_t, uint64_t, (uint64_t)(%llu)>(composer, \"%s\", arg_%d_type::nameAndTypeID, args...);\n", offset, count, param.type.hasDefault ? "false" : "true", (uint64_t)(param.type.numericalDefault), param.name.c_str(), count );
+				fprintf( header, "%s::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_%d_type, %s, uint64_t, uint64_t, (uint64_t)(%llu)>(composer, ::globalmq::marshalling::impl::JsonKeyForComposing( \"%s\", \"\\\"%s\\\":\" ), arg_%d_type::nameAndTypeID, args...);\n", offset, count, param.type.hasDefault ? "false" : "true", (uint64_t)(param.type.numericalDefault), param.name.c_str(), param.name.c_str(), count );
 				break;
 			case MessageParameterType::KIND::REAL:
 			{
 				FloatingParts parts(param.type.numericalDefault);
 //				fprintf( header, "%s::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_%d_type, %s, double, double, %f>(\"%s\", arg_%d_type::nameAndTypeID, composer, args...);\n", offset, count, param.type.hasDefault ? "false" : "true", param.type.numericalDefault, param.name.c_str(), count );
-				fprintf( header, "%s::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_%d_type, %s, FloatingDefault<%lldll,%lldll>, int, 0>(composer, \"%s\", arg_%d_type::nameAndTypeID, args...);\n", offset, count, param.type.hasDefault ? "false" : "true", parts.fraction, parts.exponent, param.name.c_str(), count );
+				fprintf( header, "%s::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_%d_type, %s, FloatingDefault<%lldll,%lldll>, int, 0>(composer, ::globalmq::marshalling::impl::JsonKeyForComposing( \"%s\", \"\\\"%s\\\":\" ), arg_%d_type::nameAndTypeID, args...);\n", offset, count, param.type.hasDefault ? "false" : "true", parts.fraction, parts.exponent, param.name.c_str(), param.name.c_str(), count );
 				break;
 			}
 			case MessageParameterType::KIND::CHARACTER_STRING:
 				if ( param.type.hasDefault )
-					fprintf( header, "%s::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_%d_type, false, nodecpp::string, const ::globalmq::marshalling::impl::StringLiteralForComposing*, &%s::default_%d>(composer, \"%s\", arg_%d_type::nameAndTypeID, args...);\n", offset, count, impl_MessageNameToDefaultsNamespaceName(s.name).c_str(), count, param.name.c_str(), count );
+					fprintf( header, "%s::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_%d_type, false, nodecpp::string, const ::globalmq::marshalling::impl::StringLiteralForComposing*, &%s::default_%d>(composer, ::globalmq::marshalling::impl::JsonKeyForComposing( \"%s\", \"\\\"%s\\\":\" ), arg_%d_type::nameAndTypeID, args...);\n", offset, count, impl_MessageNameToDefaultsNamespaceName(s.name).c_str(), count, param.name.c_str(), param.name.c_str(), count );
 				else
-					fprintf( header, "%s::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_%d_type, true, uint64_t, uint64_t, (uint64_t)(0)>(composer, \"%s\", arg_%d_type::nameAndTypeID, args...);\n", offset, count, param.name.c_str(), count );
+					fprintf( header, "%s::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_%d_type, true, uint64_t, uint64_t, (uint64_t)(0)>(composer, ::globalmq::marshalling::impl::JsonKeyForComposing( \"%s\", \"\\\"%s\\\":\" ), arg_%d_type::nameAndTypeID, args...);\n", offset, count, param.name.c_str(), param.name.c_str(), count );
 				break;
 			case MessageParameterType::KIND::BYTE_ARRAY:
 				break;
@@ -685,18 +725,18 @@ void impl_generateParamCallBlockForComposingJson( FILE* header, CompositeType& s
 			case MessageParameterType::KIND::ENUM:
 				break;
 			case MessageParameterType::KIND::VECTOR:
-				fprintf( header, "%s::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_%d_type, %s, int64_t, int64_t, (int64_t)(%lld)>(composer, \"%s\", arg_%d_type::nameAndTypeID, args...);\n", offset, count, param.type.hasDefault ? "false" : "true", (int64_t)(param.type.numericalDefault), param.name.c_str(), count );
+				fprintf( header, "%s::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_%d_type, %s, int64_t, int64_t, (int64_t)(%lld)>(composer, ::globalmq::marshalling::impl::JsonKeyForComposing( \"%s\", \"\\\"%s\\\":\" ), arg_%d_type::nameAndTypeID, args...);\n", offset, count, param.type.hasDefault ? "false" : "true", (int64_t)(param.type.numericalDefault), param.name.c_str(), param.name.c_str(), count );
 				break;
 			case MessageParameterType::KIND::DICTIONARY: // TODO: revise
-				fprintf( header, "%s::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_%d_type, %s, int64_t, int64_t, (int64_t)(%lld)>(composer, \"%s\", arg_%d_type::nameAndTypeID, args...);\n", offset, count, param.type.hasDefault ? "false" : "true", (int64_t)(param.type.numericalDefault), param.name.c_str(), count );
+				fprintf( header, "%s::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_%d_type, %s, int64_t, int64_t, (int64_t)(%lld)>(composer, ::globalmq::marshalling::impl::JsonKeyForComposing( \"%s\", \"\\\"%s\\\":\" ), arg_%d_type::nameAndTypeID, args...);\n", offset, count, param.type.hasDefault ? "false" : "true", (int64_t)(param.type.numericalDefault), param.name.c_str(), param.name.c_str(), count );
 				break;
 			case MessageParameterType::KIND::EXTENSION:
 				break; // TODO: ...
 			case MessageParameterType::KIND::STRUCT:
-				fprintf( header, "%s::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_%d_type, %s, int64_t, int64_t, (int64_t)(0)>(composer, \"%s\", arg_%d_type::nameAndTypeID, args...);\n", offset, count, param.type.hasDefault ? "false" : "true", param.name.c_str(), count );
+				fprintf( header, "%s::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_%d_type, %s, int64_t, int64_t, (int64_t)(0)>(composer, ::globalmq::marshalling::impl::JsonKeyForComposing( \"%s\", \"\\\"%s\\\":\" ), arg_%d_type::nameAndTypeID, args...);\n", offset, count, param.type.hasDefault ? "false" : "true", param.name.c_str(), param.name.c_str(), count );
 				break; // TODO: ...
 			case MessageParameterType::KIND::DISCRIMINATED_UNION:
-				fprintf( header, "%s::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_%d_type, %s, int64_t, int64_t, (int64_t)(0)>(composer, \"%s\", arg_%d_type::nameAndTypeID, args...);\n", offset, count, param.type.hasDefault ? "false" : "true", param.name.c_str(), count );
+				fprintf( header, "%s::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_%d_type, %s, int64_t, int64_t, (int64_t)(0)>(composer, ::globalmq::marshalling::impl::JsonKeyForComposing( \"%s\", \"\\\"%s\\\":\" ), arg_%d_type::nameAndTypeID, args...);\n", offset, count, param.type.hasDefault ? "false" : "true", param.name.c_str(), param.name.c_str(), count );
 				break;
 			default:
 			{
@@ -804,6 +844,26 @@ void impl_generateComposeFunction( FILE* header, CompositeType& s )
 	fprintf( header, "}\n\n" );
 }
 
+void impl_generateSerializedSizeFunction( FILE* header, Root& root, CompositeType& s )
+{
+	assert( s.type == CompositeType::Type::message || s.type == CompositeType::Type::structure || s.type == CompositeType::Type::discriminated_union );
+	fprintf( header, "template<class ComposerT, typename ... Args>\n"
+	"size_t %s(const ComposerT& composer, Args&& ... args)\n"
+	"{\n", impl_generateSerializedSizeFunctionName( s ).c_str() );
+
+	if ( impl_isFixedLayoutForGmq( root, s ) )
+	{
+		fprintf( header, "\tif constexpr ( ComposerT::proto == Proto::GMQ )\n" );
+		fprintf( header, "\t\treturn %s; // fixed layout: upper bound, known at compile time\n", impl_generateMaxGmqSizeExpression( root, s ).c_str() );
+		fprintf( header, "\telse\n" );
+		fprintf( header, "\t\treturn ::globalmq::marshalling::impl::measureComposedSize( composer, [&]( auto& measuringComposer ) { %s( measuringComposer, std::forward<Args>( args )... ); } );\n", impl_generateComposeFunctionName( s ).c_str() );
+	}
+	else
+		fprintf( header, "\treturn ::globalmq::marshalling::impl::measureComposedSize( composer, [&]( auto& measuringComposer ) { %s( measuringComposer, std::forward<Args>( args )... ); } );\n", impl_generateComposeFunctionName( s ).c_str() );
+
+	fprintf( header, "}\n\n" );
+}
+
 void impl_generateParseFunctionForMessagesAndAliasingStructs( FILE* header, Root& root, CompositeType& s )
 {
 	fprintf( header, "template<class ParserT>\n" );
@@ -826,6 +886,97 @@ void impl_generateParseFunctionForMessagesAndAliasingStructs( FILE* header, Root
 	fprintf( header, "}\n\n" );
 }
 
+void impl_generateMessageView( FILE* header, Root& root, CompositeType& s )
+{
+	assert( s.type == CompositeType::Type::message || s.type == CompositeType::Type::structure );
+
+	auto& members = s.getMembers();
+	string viewName = fmt::format( "{}_{}_View", s.type2string(), s.name );
+
+	fprintf( header, "// read-only view over a GMQ-serialized %s %s: positions of members are located once, at construction, and members are decoded only when accessed\n", s.type2string(), s.name.c_str() );
+	fprintf( header, "// (the view refers to the buffer, and strings are returned as views into it; therefore, the buffer must outlive both)\n" );
+	fprintf( header, "template<class ParserT>\n" );
+	fprintf( header, "class %s\n", viewName.c_str() );
+	fprintf( header, "{\n" );
+	fprintf( header, "\tusing RiterT = typename ParserT::RiterT;\n" );
+	fprintf( header, "\tusing T = %s;\n", impl_generateMessageParseFunctionRetType( s ).c_str() );
+	if ( !members.empty() )
+		fprintf( header, "\tRiterT memberPos[%zd];\n", members.size() );
+	fprintf( header, "\tbool lengthPrefixedStrings = false;\n" );
+	fprintf( header, "\n" );
+	fprintf( header, "public:\n" );
+
+	// constructor: records members' positions and leaves parser past the end of the message
+	fprintf( header, "\t%s( ParserT& parser ) : lengthPrefixedStrings( parser.isLengthPrefixedStrings() )\n", viewName.c_str() );
+	fprintf( header, "\t{\n" );
+	fprintf( header, "\t\tstatic_assert( ParserT::proto == Proto::GMQ, \"views are only supported for GMQ\" );\n" );
+	for ( size_t i=0; i<members.size(); ++i )
+	{
+		assert( members[i] != nullptr );
+		fprintf( header, "\t\tmemberPos[%zd] = parser.getIterator();\n", i );
+		fprintf( header, "\t\t%s\n", impl_generateMemberSkipStatement( root, *(members[i]) ).c_str() );
+	}
+	fprintf( header, "\t}\n" );
+
+	for ( size_t i=0; i<members.size(); ++i )
+	{
+		auto& member = *(members[i]);
+		bool isString = member.type.kind == MessageParameterType::KIND::CHARACTER_STRING;
+		string memberType = impl_templateMemberTypeName( "T", member );
+
+		fprintf( header, "\n" );
+		fprintf( header, "\t%s get_%s() const\n", isString ? "GMQ_COLL string_view" : memberType.c_str(), member.name.c_str() );
+		fprintf( header, "\t{\n" );
+		fprintf( header, "\t\tRiterT riter = memberPos[%zd];\n", i );
+		fprintf( header, "\t\tParserT parser( riter );\n" );
+		fprintf( header, "\t\tparser.setLengthPrefixedStrings( lengthPrefixedStrings );\n" );
+		fprintf( header, "\t\t%s ret;\n", isString ? "GMQ_COLL string_view" : memberType.c_str() );
+		switch ( member.type.kind )
+		{
+			case MessageParameterType::KIND::INTEGER:
+				fprintf( header, "\t\tparser.parseSignedInteger( &ret );\n" );
+				break;
+			case MessageParameterType::KIND::UINTEGER:
+				fprintf( header, "\t\tparser.parseUnsignedInteger( &ret );\n" );
+				break;
+			case MessageParameterType::KIND::REAL:
+				fprintf( header, "\t\tparser.parseReal( &ret );\n" );
+				break;
+			case MessageParameterType::KIND::CHARACTER_STRING:
+				fprintf( header, "\t\tparser.parseString( &ret );\n" );
+				break;
+			case MessageParameterType::KIND::STRUCT:
+			case MessageParameterType::KIND::DISCRIMINATED_UNION:
+				fprintf( header, "\t\t%s::parseForStateSyncOrMessageInDepth( parser, ret );\n", impl_typeToLibTypeOrTypeProcessor( member.type, member.type.kind, root ).c_str() );
+				break;
+			case MessageParameterType::KIND::VECTOR:
+				fprintf( header, "\t\tPublishableVectorProcessor::parse<ParserT, %s, %s, true>( parser, ret );\n", memberType.c_str(), vectorElementTypeToLibTypeOrTypeProcessor( member.type, root ).c_str() );
+				break;
+			case MessageParameterType::KIND::DICTIONARY:
+				fprintf( header, "\t\tPublishableDictionaryProcessor::parse<ParserT, %s, %s, %s, true>( parser, ret );\n", memberType.c_str(), dictionaryKeyTypeToLibTypeOrTypeProcessor( member.type, root ).c_str(), dictionaryValueTypeToLibTypeOrTypeProcessor( member.type, root ).c_str() );
+				break;
+			default:
+				assert( false );
+		}
+		fprintf( header, "\t\treturn ret;\n" );
+		fprintf( header, "\t}\n" );
+
+		if ( member.type.kind == MessageParameterType::KIND::VECTOR || member.type.kind == MessageParameterType::KIND::DICTIONARY )
+		{
+			fprintf( header, "\tsize_t get_%s_size() const\n", member.name.c_str() );
+			fprintf( header, "\t{\n" );
+			fprintf( header, "\t\tRiterT riter = memberPos[%zd];\n", i );
+			fprintf( header, "\t\tParserT parser( riter );\n" );
+			fprintf( header, "\t\tsize_t ret;\n" );
+			fprintf( header, "\t\tparser.parseUnsignedInteger( &ret );\n" );
+			fprintf( header, "\t\treturn ret;\n" );
+			fprintf( header, "\t}\n" );
+		}
+	}
+
+	fprintf( header, "};\n\n" );
+}
+
 void generateMessage( FILE* header, Root& root, CompositeType& s )
 {
 	// bool checked = impl_checkParamNameUniqueness(s);
@@ -837,8 +988,13 @@ void generateMessage( FILE* header, Root& root, CompositeType& s )
 	impl_GenerateMessageDefaults( header, s );
 
 	impl_generateComposeFunction( header, s );
+	impl_generateSerializedSizeFunction( header, root, s );
 	if ( s.type == CompositeType::Type::message )
+	{
 		impl_generateParseFunctionForMessagesAndAliasingStructs( header, root, s );
+		if ( s.protoList.find( Proto::gmq ) != s.protoList.end() )
+			impl_generateMessageView( header, root, s );
+	}
 }
 
 void generateMessageAlias( FILE* header, Root& root, CompositeType& s )
@@ -871,6 +1027,13 @@ void generateMessageAlias( FILE* header, Root& root, CompositeType& s )
 	fprintf( header, "\t%s_%s_compose(composer, std::forward<Args>( args )...);\n", impl_kindToString( MessageParameterType::KIND::STRUCT ), s.aliasOf.c_str() );
 	fprintf( header, "}\n\n" );
 
+	// serialized size function
+	fprintf( header, "template<class ComposerT, typename ... Args>\n"
+	"size_t %s_%s_serializedSize(const ComposerT& composer, Args&& ... args)\n", s.type2string(), s.name.c_str() );
+	fprintf( header, "{\n" );
+	fprintf( header, "\treturn %s_%s_serializedSize(composer, std::forward<Args>( args )...);\n", impl_kindToString( MessageParameterType::KIND::STRUCT ), s.aliasOf.c_str() );
+	fprintf( header, "}\n\n" );
+
 	// parse-by-param function
 	fprintf( header, "template<class ParserT, typename ... Args>\n"
 	"void %s_%s_parse(ParserT& p, Args&& ... args)\n", s.type2string(), s.name.c_str() );
@@ -885,6 +1048,13 @@ void generateMessageAlias( FILE* header, Root& root, CompositeType& s )
 	// fprintf( header, "\treturn static_cast<structures::%s::%s_%s>(%s(p));\n", s.scopeName.c_str(), s.type2string(), s.name.c_str(), impl_generateParseFunctionName( alias ).c_str() );
 	fprintf( header, "\treturn %s(p);\n", impl_generateParseFunctionName( alias ).c_str() );
 	fprintf( header, "}\n\n" );
+
+	if ( s.protoList.find( Proto::gmq ) != s.protoList.end() && !alias.isDiscriminatedUnion() )
+	{
+		// view (generated for the aliased struct along with its parse function)
+		fprintf( header, "template<class ParserT>\n" );
+		fprintf( header, "using %s_%s_View = %s_%s_View<ParserT>;\n\n", s.type2string(), s.name.c_str(), alias.type2string(), alias.name.c_str() );
+	}
 }
 
 } // namespace cpptemplates
@@ -1133,7 +1133,7 @@ void impl_GeneratePublishableStateMemberGetter4Set( FILE* header, Root& root, co
 	else
 	{
 		rootType = fmt::format( "{}_WrapperForPublisher", rootTypeNameBase );
-		addr = "GMQ_COLL vector<size_t>()";
+		addr = "::globalmq::marshalling::PublishableAddress()";
 		rootObjName = "*this";
 	}
 	if ( param.type.kind == MessageParameterType::KIND::STRUCT )
@@ -1204,7 +1204,7 @@ void impl_GeneratePublishableStateMemberGetter4Set( FILE* header, Root& root, co
 }
 
 
-void impl_generateComposeFunctionForPublishableStruct_MemberIterationBlock( FILE* header, Root& root, CompositeType& obj, const char* offset )
+void impl_generateComposeFunctionForPublishableStruct_MemberIterationBlock( FILE* header, Root& root, CompositeType& obj, const char* offset, const char* composerType )
 {
 	assert( obj.type != CompositeType::Type::discriminated_union );
 
@@ -1219,25 +1219,25 @@ void impl_generateComposeFunctionForPublishableStruct_MemberIterationBlock( FILE
 		switch ( member.type.kind )
 		{
 			case MessageParameterType::KIND::INTEGER:
-				fprintf( header, "%s::globalmq::marshalling::impl::publishableStructComposeInteger( %s, t.%s, \"%s\", %s );\n", offset, composer, impl_memberOrAccessFunctionName( member ).c_str(), member.name.c_str(), addSepar );
+				fprintf( header, "%s::globalmq::marshalling::impl::publishableStructComposeInteger( %s, t.%s, ::globalmq::marshalling::impl::JsonKeyForComposing( \"%s\", \"\\\"%s\\\":\" ), %s );\n", offset, composer, impl_memberOrAccessFunctionName( member ).c_str(), member.name.c_str(), member.name.c_str(), addSepar );
 				fprintf( header, "\n" );
 				break;
 			case MessageParameterType::KIND::UINTEGER:
-				fprintf( header, "%s::globalmq::marshalling::impl::publishableStructComposeUnsignedInteger( %s, t.%s, \"%s\", %s );\n", offset, composer, impl_memberOrAccessFunctionName( member ).c_str(), member.name.c_str(), addSepar );
+				fprintf( header, "%s::globalmq::marshalling::impl::publishableStructComposeUnsignedInteger( %s, t.%s, ::globalmq::marshalling::impl::JsonKeyForComposing( \"%s\", \"\\\"%s\\\":\" ), %s );\n", offset, composer, impl_memberOrAccessFunctionName( member ).c_str(), member.name.c_str(), member.name.c_str(), addSepar );
 				fprintf( header, "\n" );
 				break;
 			case MessageParameterType::KIND::REAL:
-				fprintf( header, "%s::globalmq::marshalling::impl::publishableStructComposeReal( %s, t.%s, \"%s\", %s );\n", offset, composer, impl_memberOrAccessFunctionName( member ).c_str(), member.name.c_str(), addSepar );
+				fprintf( header, "%s::globalmq::marshalling::impl::publishableStructComposeReal( %s, t.%s, ::globalmq::marshalling::impl::JsonKeyForComposing( \"%s\", \"\\\"%s\\\":\" ), %s );\n", offset, composer, impl_memberOrAccessFunctionName( member ).c_str(), member.name.c_str(), member.name.c_str(), addSepar );
 				fprintf( header, "\n" );
 				break;
 			case MessageParameterType::KIND::CHARACTER_STRING:
-				fprintf( header, "%s::globalmq::marshalling::impl::publishableStructComposeString( %s, t.%s, \"%s\", %s );\n", offset, composer, impl_memberOrAccessFunctionName( member ).c_str(), member.name.c_str(), addSepar );
+				fprintf( header, "%s::globalmq::marshalling::impl::publishableStructComposeString( %s, t.%s, ::globalmq::marshalling::impl::JsonKeyForComposing( \"%s\", \"\\\"%s\\\":\" ), %s );\n", offset, composer, impl_memberOrAccessFunctionName( member ).c_str(), member.name.c_str(), member.name.c_str(), addSepar );
 				fprintf( header, "\n" );
 				break;
 			case MessageParameterType::KIND::STRUCT:
 			case MessageParameterType::KIND::DISCRIMINATED_UNION: // TODO: revise DU
 			{
-				fprintf( header, "%s::globalmq::marshalling::impl::composePublishableStructBegin( %s, \"%s\" );\n", offset, composer, member.name.c_str() );
+				fprintf( header, "%s::globalmq::marshalling::impl::composePublishableStructBegin( %s, ::globalmq::marshalling::impl::JsonKeyForComposing( \"%s\", \"\\\"%s\\\":\" ) );\n", offset, composer, member.name.c_str(), member.name.c_str() );
 				fprintf( header, "%s%s::compose( %s, t.%s );\n", offset, impl_generatePublishableStructName( member ).c_str(), composer, impl_memberOrAccessFunctionName( member ).c_str() );
 				fprintf( header, "%s::globalmq::marshalling::impl::composePublishableStructEnd( %s, %s );\n", offset, composer, addSepar );
 				fprintf( header, "\n" );
@@ -1248,16 +1248,16 @@ void impl_generateComposeFunctionForPublishableStruct_MemberIterationBlock( FILE
 				switch ( member.type.vectorElemKind )
 				{
 					case MessageParameterType::KIND::INTEGER:
-						fprintf( header, "%sPublishableVectorProcessor::compose<ComposerT, %s, ::globalmq::marshalling::impl::SignedIntegralType>( %s, t.%s, \"%s\", %s );\n", offset, impl_templateMemberTypeName( "T", member).c_str(), composer, impl_memberOrAccessFunctionName( member ).c_str(), member.name.c_str(), addSepar );
+						fprintf( header, "%sPublishableVectorProcessor::compose<%s, %s, ::globalmq::marshalling::impl::SignedIntegralType>( %s, t.%s, ::globalmq::marshalling::impl::JsonKeyForComposing( \"%s\", \"\\\"%s\\\":\" ), %s );\n", offset, composerType, impl_templateMemberTypeName( "T", member).c_str(), composer, impl_memberOrAccessFunctionName( member ).c_str(), member.name.c_str(), member.name.c_str(), addSepar );
 						break;
 					case MessageParameterType::KIND::UINTEGER:
-						fprintf( header, "%sPublishableVectorProcessor::compose<ComposerT, %s, ::globalmq::marshalling::impl::UnsignedIntegralType>( %s, t.%s, \"%s\", %s );\n", offset, impl_templateMemberTypeName( "T", member).c_str(), composer, impl_memberOrAccessFunctionName( member ).c_str(), member.name.c_str(), addSepar );
+						fprintf( header, "%sPublishableVectorProcessor::compose<%s, %s, ::globalmq::marshalling::impl::UnsignedIntegralType>( %s, t.%s, ::globalmq::marshalling::impl::JsonKeyForComposing( \"%s\", \"\\\"%s\\\":\" ), %s );\n", offset, composerType, impl_templateMemberTypeName( "T", member).c_str(), composer, impl_memberOrAccessFunctionName( member ).c_str(), member.name.c_str(), member.name.c_str(), addSepar );
 						break;
 					case MessageParameterType::KIND::REAL:
-						fprintf( header, "%sPublishableVectorProcessor::compose<ComposerT, %s, ::globalmq::marshalling::impl::RealType>( %s, t.%s, \"%s\", %s );\n", offset, impl_templateMemberTypeName( "T", member).c_str(), composer, impl_memberOrAccessFunctionName( member ).c_str(), member.name.c_str(), addSepar );
+						fprintf( header, "%sPublishableVectorProcessor::compose<%s, %s, ::globalmq::marshalling::impl::RealType>( %s, t.%s, ::globalmq::marshalling::impl::JsonKeyForComposing( \"%s\", \"\\\"%s\\\":\" ), %s );\n", offset, composerType, impl_templateMemberTypeName( "T", member).c_str(), composer, impl_memberOrAccessFunctionName( member ).c_str(), member.name.c_str(), member.name.c_str(), addSepar );
 						break;
 					case MessageParameterType::KIND::CHARACTER_STRING:
-						fprintf( header, "%sPublishableVectorProcessor::compose<ComposerT, %s, ::globalmq::marshalling::impl::StringType>( %s, t.%s, \"%s\", %s );\n", offset, impl_templateMemberTypeName( "T", member).c_str(), composer, impl_memberOrAccessFunctionName( member ).c_str(), member.name.c_str(), addSepar );
+						fprintf( header, "%sPublishableVectorProcessor::compose<%s, %s, ::globalmq::marshalling::impl::StringType>( %s, t.%s, ::globalmq::marshalling::impl::JsonKeyForComposing( \"%s\", \"\\\"%s\\\":\" ), %s );\n", offset, composerType, impl_templateMemberTypeName( "T", member).c_str(), composer, impl_memberOrAccessFunctionName( member ).c_str(), member.name.c_str(), member.name.c_str(), addSepar );
 						break;
 					case MessageParameterType::KIND::VECTOR:
 					case MessageParameterType::KIND::DICTIONARY:
@@ -1266,7 +1266,7 @@ void impl_generateComposeFunctionForPublishableStruct_MemberIterationBlock( FILE
 					case MessageParameterType::KIND::STRUCT:
 					case MessageParameterType::KIND::DISCRIMINATED_UNION:
 						assert( member.type.structIdx < root.structs.size() );
-						fprintf( header, "%sPublishableVectorProcessor::compose<ComposerT, %s, %s>( %s, t.%s, \"%s\", %s );\n", offset, impl_templateMemberTypeName( "T", member).c_str(), impl_generatePublishableStructName( *(root.structs[member.type.structIdx]) ).c_str(), composer, impl_memberOrAccessFunctionName( member ).c_str(), member.name.c_str(), addSepar );
+						fprintf( header, "%sPublishableVectorProcessor::compose<%s, %s, %s>( %s, t.%s, ::globalmq::marshalling::impl::JsonKeyForComposing( \"%s\", \"\\\"%s\\\":\" ), %s );\n", offset, composerType, impl_templateMemberTypeName( "T", member).c_str(), impl_generatePublishableStructName( *(root.structs[member.type.structIdx]) ).c_str(), composer, impl_memberOrAccessFunctionName( member ).c_str(), member.name.c_str(), member.name.c_str(), addSepar );
 						break;
 					default:
 						assert( false ); // not implemented (yet)
@@ -1282,7 +1282,7 @@ void impl_generateComposeFunctionForPublishableStruct_MemberIterationBlock( FILE
 					case MessageParameterType::KIND::UINTEGER:
 					case MessageParameterType::KIND::REAL:
 					case MessageParameterType::KIND::CHARACTER_STRING:
-						fprintf( header, "%sPublishableDictionaryProcessor::compose<ComposerT, %s, %s, %s>( %s, t.%s, \"%s\", %s );\n", offset, impl_templateMemberTypeName( "T", member).c_str(), dictionaryKeyTypeToLibTypeOrTypeProcessor( member.type, root ).c_str(), dictionaryValueTypeToLibTypeOrTypeProcessor( member.type, root ).c_str(), composer, impl_memberOrAccessFunctionName( member ).c_str(), member.name.c_str(), addSepar );
+						fprintf( header, "%sPublishableDictionaryProcessor::compose<%s, %s, %s, %s>( %s, t.%s, ::globalmq::marshalling::impl::JsonKeyForComposing( \"%s\", \"\\\"%s\\\":\" ), %s );\n", offset, composerType, impl_templateMemberTypeName( "T", member).c_str(), dictionaryKeyTypeToLibTypeOrTypeProcessor( member.type, root ).c_str(), dictionaryValueTypeToLibTypeOrTypeProcessor( member.type, root ).c_str(), composer, impl_memberOrAccessFunctionName( member ).c_str(), member.name.c_str(), member.name.c_str(), addSepar );
 						break;
 					case MessageParameterType::KIND::VECTOR:
 					case MessageParameterType::KIND::DICTIONARY:
@@ -1291,7 +1291,7 @@ void impl_generateComposeFunctionForPublishableStruct_MemberIterationBlock( FILE
 					case MessageParameterType::KIND::STRUCT:
 					case MessageParameterType::KIND::DISCRIMINATED_UNION:
 						assert( member.type.structIdx < root.structs.size() );
-						fprintf( header, "%sPublishableDictionaryProcessor::compose<ComposerT, %s, %s, %s>( %s, t.%s, \"%s\", %s );\n", offset, impl_templateMemberTypeName( "T", member).c_str(), dictionaryKeyTypeToLibTypeOrTypeProcessor( member.type, root ).c_str(), impl_generatePublishableStructName( *(root.structs[member.type.structIdx]) ).c_str(), composer, impl_memberOrAccessFunctionName( member ).c_str(), member.name.c_str(), addSepar );
+						fprintf( header, "%sPublishableDictionaryProcessor::compose<%s, %s, %s, %s>( %s, t.%s, ::globalmq::marshalling::impl::JsonKeyForComposing( \"%s\", \"\\\"%s\\\":\" ), %s );\n", offset, composerType, impl_templateMemberTypeName( "T", member).c_str(), dictionaryKeyTypeToLibTypeOrTypeProcessor( member.type, root ).c_str(), impl_generatePublishableStructName( *(root.structs[member.type.structIdx]) ).c_str(), composer, impl_memberOrAccessFunctionName( member ).c_str(), member.name.c_str(), member.name.c_str(), addSepar );
 						break;
 					default:
 						assert( false ); // not implemented (yet)
@@ -1307,6 +1307,7 @@ void impl_generateComposeFunctionForPublishableStruct_MemberIterationBlock( FILE
 
 void impl_generateComposeFunctionForPublishableStruct( FILE* header, Root& root, CompositeType& obj, const string& className )
 {
+	const char* composerType = obj.type == CompositeType::Type::publishable ? "ComposerType" : "ComposerT"; // see template parameters below
 	if ( obj.type == CompositeType::Type::structure || obj.type == CompositeType::Type::discriminated_union )
 	{
 		fprintf( header, "\ttemplate<class ComposerT, class T>\n" );
@@ -1327,11 +1328,11 @@ void impl_generateComposeFunctionForPublishableStruct( FILE* header, Root& root,
 	if ( obj.isDiscriminatedUnion() )
 	{
 		fprintf( header, "\t\tuint64_t caseId = t.currentVariant();\n" );
-		fprintf( header, "\t\t::globalmq::marshalling::impl::publishableStructComposeUnsignedInteger( composer, caseId, \"caseId\", true );\n" );
+		fprintf( header, "\t\t::globalmq::marshalling::impl::publishableStructComposeUnsignedInteger( composer, caseId, ::globalmq::marshalling::impl::JsonKeyForComposing( \"caseId\", \"\\\"caseId\\\":\" ), true );\n" );
 
 		fprintf( header, "\t\tif ( caseId != T::Variants::unknown )\n" );
 		fprintf( header, "\t\t{\n" );
-		fprintf( header, "\t\t\t::globalmq::marshalling::impl::composePublishableStructBegin( composer, \"caseData\" );\n" );
+		fprintf( header, "\t\t\t::globalmq::marshalling::impl::composePublishableStructBegin( composer, ::globalmq::marshalling::impl::JsonKeyForComposing( \"caseData\", \"\\\"caseData\\\":\" ) );\n" );
 		fprintf( header, "\t\t\tswitch ( caseId )\n" );
 		fprintf( header, "\t\t\t{\n" );
 		for ( auto& it: obj.getDiscriminatedUnionCases() )
@@ -1341,7 +1342,7 @@ void impl_generateComposeFunctionForPublishableStruct( FILE* header, Root& root,
 			assert( it != nullptr );
 			CompositeType& cs = *it;
 			assert( cs.type == CompositeType::Type::discriminated_union_case );
-			impl_generateComposeFunctionForPublishableStruct_MemberIterationBlock( header, root, cs, "\t\t\t\t\t" );
+			impl_generateComposeFunctionForPublishableStruct_MemberIterationBlock( header, root, cs, "\t\t\t\t\t", composerType );
 			fprintf( header, "\t\t\t\t\tbreak;\n" );
 			fprintf( header, "\t\t\t\t}\n" );
 		}
@@ -1353,7 +1354,7 @@ void impl_generateComposeFunctionForPublishableStruct( FILE* header, Root& root,
 		fprintf( header, "\t\t}\n" );
 	}
 	else
-		impl_generateComposeFunctionForPublishableStruct_MemberIterationBlock( header, root, obj, "\t\t" );
+		impl_generateComposeFunctionForPublishableStruct_MemberIterationBlock( header, root, obj, "\t\t", composerType );
 
 	if ( obj.type == CompositeType::Type::publishable )
 	{
@@ -1469,7 +1470,7 @@ void impl_GenerateDiscriminatedUnionVariantUpdateNotifierPresenceCheckingBlock(
 void impl_generateContinueParsingFunctionForPublishableStruct( FILE* header, Root& root, CompositeType& obj, const string& className )
 {
 	fprintf( header, "\ttemplate<class ParserT, class T, class RetT>\n" );
-	fprintf( header, "\tRetT %s::parse( ParserT& parser, T& t, GMQ_COLL vector<size_t>& addr, size_t offset )\n", className.c_str() );
+	fprintf( header, "\tRetT %s::parse( ParserT& parser, T& t, ::globalmq::marshalling::PublishableAddress& addr, size_t offset )\n", className.c_str() );
 	fprintf( header, "\t{\n" );
 //	fprintf( header, "\t\t//****  ContinueParsing  **************************************************************************************************************************************************************\n" );
 	fprintf( header, "\t\tstatic_assert( std::is_same<RetT, bool>::value || std::is_same<RetT, void>::value );\n" );
@@ -1776,6 +1777,138 @@ void impl_generateParseFunctionForPublishableStructStateSyncOrMessageInDepth( FI
 	fprintf( header, "\t}\n" );
 }
 
+bool impl_isFixedLayoutForGmq( Root& root, CompositeType& s ) // NONEXTENDABLE, and only numbers and fixed-layout structs inside: GMQ-composed size is bounded
+{
+	if ( !s.isNonExtendable || s.isDiscriminatedUnion() )
+		return false;
+	for ( auto& member: s.getMembers() )
+	{
+		assert( member != nullptr );
+		switch ( member->type.kind )
+		{
+			case MessageParameterType::KIND::INTEGER:
+			case MessageParameterType::KIND::UINTEGER:
+			case MessageParameterType::KIND::REAL:
+				break;
+			case MessageParameterType::KIND::STRUCT:
+				assert( member->type.structIdx < root.structs.size() );
+				if ( !impl_isFixedLayoutForGmq( root, *(root.structs[member->type.structIdx]) ) )
+					return false;
+				break;
+			default:
+				return false;
+		}
+	}
+	return true;
+}
+
+std::string impl_generateMaxGmqSizeExpression( Root& root, CompositeType& s )
+{
+	assert( impl_isFixedLayoutForGmq( root, s ) );
+	size_t integerCount = 0;
+	size_t realCount = 0;
+	std::vector<std::string> structs;
+	for ( auto& member: s.getMembers() )
+	{
+		switch ( member->type.kind )
+		{
+			case MessageParameterType::KIND::INTEGER:
+			case MessageParameterType::KIND::UINTEGER:
+				++integerCount;
+				break;
+			case MessageParameterType::KIND::REAL:
+				++realCount;
+				break;
+			case MessageParameterType::KIND::STRUCT:
+				structs.push_back( fmt::format( "{}::maxGmqSize", impl_typeToLibTypeOrTypeProcessor( member->type, member->type.kind, root ) ) );
+				break;
+			default:
+				assert( false );
+		}
+	}
+	std::vector<std::string> terms;
+	if ( integerCount != 0 )
+		terms.push_back( fmt::format( "{} * ::globalmq::marshalling::impl::IntegralVlq::maxVlqSize", integerCount ) );
+	if ( realCount != 0 )
+		terms.push_back( fmt::format( "{} * sizeof(double)", realCount ) );
+	terms.insert( terms.end(), structs.begin(), structs.end() );
+	if ( terms.empty() )
+		return "0";
+	std::string ret = terms[0];
+	for ( size_t i=1; i<terms.size(); ++i )
+		ret += " + " + terms[i];
+	return ret;
+}
+
+std::string impl_generateMemberSkipStatement( Root& root, const MessageParameter& member )
+{
+	switch ( member.type.kind )
+	{
+		case MessageParameterType::KIND::INTEGER: return "parser.skipSignedInteger();";
+		case MessageParameterType::KIND::UINTEGER: return "parser.skipUnsignedInteger();";
+		case MessageParameterType::KIND::REAL: return "parser.skipReal();";
+		case MessageParameterType::KIND::CHARACTER_STRING: return "parser.skipString();";
+		case MessageParameterType::KIND::STRUCT:
+		case MessageParameterType::KIND::DISCRIMINATED_UNION:
+			return fmt::format( "{}::skip( parser );", impl_typeToLibTypeOrTypeProcessor( member.type, member.type.kind, root ) );
+		case MessageParameterType::KIND::VECTOR:
+			return fmt::format( "PublishableVectorProcessor::skip<ParserT, {}>( parser );", vectorElementTypeToLibTypeOrTypeProcessor( member.type, root ) );
+		case MessageParameterType::KIND::DICTIONARY:
+			return fmt::format( "PublishableDictionaryProcessor::skip<ParserT, {}, {}>( parser );", dictionaryKeyTypeToLibTypeOrTypeProcessor( member.type, root ), dictionaryValueTypeToLibTypeOrTypeProcessor( member.type, root ) );
+		default:
+			assert( false );
+			return "";
+	}
+}
+
+void impl_generateSkipFunctionForPublishableStruct( FILE* header, Root& root, CompositeType& obj, const string& className )
+{
+	assert( obj.type == CompositeType::Type::structure || obj.type == CompositeType::Type::discriminated_union );
+	fprintf( header, "\ttemplate<class ParserT>\n" );
+	fprintf( header, "\tvoid %s::skip( ParserT& parser )\n", className.c_str() );
+	fprintf( header, "\t{\n" );
+	fprintf( header, "\t\tstatic_assert( ParserT::proto == Proto::GMQ, \"skipping is only supported for GMQ\" );\n" );
+
+	if ( obj.isDiscriminatedUnion() )
+	{
+		fprintf( header, "\t\tuint64_t caseId;\n" );
+		fprintf( header, "\t\tparser.parseUnsignedInteger( &caseId );\n" );
+		fprintf( header, "\t\tif ( caseId != structures::%s::Variants::unknown )\n", obj.name.c_str() );
+		fprintf( header, "\t\t{\n" );
+		fprintf( header, "\t\t\tswitch ( caseId )\n" );
+		fprintf( header, "\t\t\t{\n" );
+
+		for ( auto& it: obj.getDiscriminatedUnionCases() )
+		{
+			assert( it != nullptr );
+			CompositeType& cs = *it;
+			assert( cs.type == CompositeType::Type::discriminated_union_case );
+			fprintf( header, "\t\t\t\tcase %zd: // IDL CASE %s\n", cs.numID, cs.name.c_str() );
+			for ( auto& member: cs.getMembers() )
+			{
+				assert( member != nullptr );
+				fprintf( header, "\t\t\t\t\t%s\n", impl_generateMemberSkipStatement( root, *member ).c_str() );
+			}
+			fprintf( header, "\t\t\t\t\tbreak;\n" );
+		}
+
+		fprintf( header, "\t\t\t\tdefault:\n" );
+		fprintf( header, "\t\t\t\t\tthrow std::exception(); // unexpected\n" );
+		fprintf( header, "\t\t\t}\n" );
+		fprintf( header, "\t\t}\n" );
+	}
+	else
+	{
+		for ( auto& member: obj.getMembers() )
+		{
+			assert( member != nullptr );
+			fprintf( header, "\t\t%s\n", impl_generateMemberSkipStatement( root, *member ).c_str() );
+		}
+	}
+
+	fprintf( header, "\t}\n" );
+}
+
 void impl_generateParseFunctionForPublishableState( FILE* header, Root& root, CompositeType& obj, bool addFullUpdateNotifierBlock )
 {
 	assert( obj.type == CompositeType::Type::publishable );
@@ -2010,6 +2143,17 @@ void impl_generatePublishableStructDeclaration( FILE* header, Root& root, Compos
 	fprintf( header, "\ttemplate<class ParserT, class T>\n" );
 	fprintf( header, "\tstatic\n" );
 	fprintf( header, "\tvoid parseForStateSyncOrMessageInDepth( ParserT& parser, T& t );\n" );
+	fprintf( header, "\n" );
+
+	fprintf( header, "\ttemplate<class ParserT>\n" );
+	fprintf( header, "\tstatic\n" );
+	fprintf( header, "\tvoid skip( ParserT& parser );\n" );
+
+	if ( impl_isFixedLayoutForGmq( root, obj ) )
+	{
+		fprintf( header, "\n" );
+		fprintf( header, "\tstatic constexpr size_t maxGmqSize = %s; // fixed layout: upper bound of GMQ-composed size\n", impl_generateMaxGmqSizeExpression( root, obj ).c_str() );
+	}
 
 	if ( obj.isStruct4Publishing )
 	{
@@ -2029,7 +2173,7 @@ void impl_generatePublishableStructDeclaration( FILE* header, Root& root, Compos
 		// impl_generateContinueParsingFunctionForPublishableStruct( header, root, obj );
 		fprintf( header, "\ttemplate<class ParserT, class T, class RetT = void>\n" );
 		fprintf( header, "\tstatic\n" );
-		fprintf( header, "\tRetT parse( ParserT& parser, T& t, GMQ_COLL vector<size_t>& addr, size_t offset );\n" );
+		fprintf( header, "\tRetT parse( ParserT& parser, T& t, ::globalmq::marshalling::PublishableAddress& addr, size_t offset );\n" );
 		fprintf( header, "\n" );
 
 		// impl_GeneratePublishableStructCopyFn( header, root, obj );
@@ -2053,6 +2197,8 @@ void impl_generatePublishableStruct( FILE* header, Root& root, CompositeType& ob
 
 	impl_generateParseFunctionForPublishableStructStateSyncOrMessageInDepth( header, root, obj, className );
 	fprintf( header, "\n" );
+	impl_generateSkipFunctionForPublishableStruct( header, root, obj, className );
+	fprintf( header, "\n" );
 
 	if ( obj.isStruct4Publishing )
 	{
@@ -2073,7 +2219,7 @@ void impl_GeneratePublishableStateMemberSetter( FILE* header, Root& root, bool f
 //	assert( (forRoot && rootName != nullptr) || (forRoot == false && rootName == nullptr) );
 	const char* composer = forRoot ? "composer" : "root.getComposer()";
 	const char* composerType = forRoot ? "ComposerT" : "decltype(root.getComposer())";
-	const char* addrVector = forRoot ? "GMQ_COLL vector<size_t>()" : "address";
+	const char* addrVector = forRoot ? "::globalmq::marshalling::PublishableAddress()" : "address";
 
 	fprintf( header, "\tvoid set_%s( %s val) { \n", param.name.c_str(), impl_templateMemberTypeName( "T", param ).c_str() );
 	fprintf( header, "\t\tt.%s = val; \n", impl_memberOrAccessFunctionName( param ).c_str() );
@@ -2192,7 +2338,7 @@ void impl_GeneratePublishableStateMemberAccessors( FILE* header, Root& root, Com
 		{
 			const char* composer = forRoot ? "composer" : "root.getComposer()";
 			const char* composerType = forRoot ? "ComposerT" : "decltype(root.getComposer())";
-			const char* addrVector = forRoot ? "GMQ_COLL vector<size_t>()" : "address";
+			const char* addrVector = forRoot ? "::globalmq::marshalling::PublishableAddress()" : "address";
 			fprintf( header, "\tvoid set_currentVariant( typename T::Variants v ) { \n" );
 			fprintf( header, "\t\tt.initAs( v ); \n" );
 			fprintf( header, "\t\t::globalmq::marshalling::impl::composeAddressInPublishable( %s, %s, %d );\n", composer, addrVector, 0 );
@@ -2219,8 +2365,8 @@ void impl_GenerateApplyUpdateMessageMemberFn( FILE* header, Root& root, Composit
 	fprintf( header, "\t{\n" );
 	fprintf( header, "\t\t::globalmq::marshalling::impl::parseStateUpdateMessageBegin( parser );\n" );
 	fprintf( header, "\t\tbool changed = false;\n" );
-	fprintf( header, "\t\tGMQ_COLL vector<size_t> addr;\n" );
-	fprintf( header, "\t\twhile( ::globalmq::marshalling::impl::parseAddressInPublishable<ParserT, GMQ_COLL vector<size_t>>( parser, addr ) )\n" );
+	fprintf( header, "\t\t::globalmq::marshalling::PublishableAddress addr;\n" );
+	fprintf( header, "\t\twhile( ::globalmq::marshalling::impl::parseAddressInPublishable<ParserT, ::globalmq::marshalling::PublishableAddress>( parser, addr ) )\n" );
 	fprintf( header, "\t\t{\n" );
 	fprintf( header, "\t\t\tGMQ_ASSERT( addr.size() );\n" );
 	fprintf( header, "\t\t\tswitch ( addr[0] )\n" );
@@ -2349,6 +2495,9 @@ void impl_GeneratePublishableStateWrapperForPublisher( FILE* header, Root& root,
 	fprintf( header, "\tComposerT& getComposer() { return composer; }\n" );
 	fprintf( header, "\tvoid startTick( BufferT&& buff ) { buffer = std::move( buff ); composer.reset(); ::globalmq::marshalling::impl::composeStateUpdateMessageBegin<ComposerT>( composer );}\n" );
 	fprintf( header, "\tBufferT&& endTick() { ::globalmq::marshalling::impl::composeStateUpdateMessageEnd( composer ); return std::move( buffer ); }\n" );
+	fprintf( header, "\tvirtual bool setLengthPrefixedStrings( bool lengthPrefixed ) { return ::globalmq::marshalling::PublishableStateMessageHeader::applyStringEncoding( composer, lengthPrefixed ); }\n" );
+	fprintf( header, "\tvirtual size_t serializedSize() { return ::globalmq::marshalling::impl::measureComposedSize( composer, [this]( auto& measuringComposer ) { compose( measuringComposer ); } ); }\n" );
+	fprintf( header, "\tvirtual uint64_t changeCount() { return composer.changeCount; }\n" );
 	fprintf( header, "\tconst char* name() { return stringTypeID; }\n" );
 	fprintf( header, "\tconst char* publishableName() { return stringTypeID; }\n" );
 	fprintf( header, "\tvirtual uint64_t stateTypeID() { return numTypeID; }\n" );
@@ -2568,15 +2717,12 @@ void impl_GeneratePublishableStructWrapper4Set( FILE* header, Root& root, Compos
 	fprintf( header, "{\n" );
 	fprintf( header, "\tT& t;\n" );
 	fprintf( header, "\tRootT& root;\n" );
-	fprintf( header, "\tGMQ_COLL vector<size_t> address;\n" );
+	fprintf( header, "\t::globalmq::marshalling::PublishableAddress address;\n" );
 
 	impl_GeneratePublishableStateMemberPresenceCheckingBlock( header, root, s );
 
 	fprintf( header, "\npublic:\n" );
-	fprintf( header, "\t%s_RefWrapper4Set( T& actual, RootT& root_, const GMQ_COLL vector<size_t> address_, size_t idx ) : t( actual ), root( root_ ) {\n", s.name.c_str() );
-	fprintf( header, "\t\taddress = address_;\n" );
-	fprintf( header, "\t\taddress.push_back (idx );\n" );
-	fprintf( header, "\t}\n" );
+	fprintf( header, "\t%s_RefWrapper4Set( T& actual, RootT& root_, const ::globalmq::marshalling::PublishableAddress& address_, size_t idx ) : t( actual ), root( root_ ), address( address_, idx ) {}\n", s.name.c_str() );
 
 	impl_GeneratePublishableStateMemberAccessors( header, root, s, true );
 
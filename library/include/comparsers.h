@@ -9,6 +9,9 @@
 #include <unordered_map>
 #include <functional>
 #include <array>
+#include <algorithm>
+#include <charconv>
+#include <utility>
 
 namespace comparsers
 {
@@ -203,39 +206,51 @@ namespace comparsers
 					buff.append("  ", 2);
 			}
 		}
-		template <typename StringT>
-		std::string implString2JsonString(const StringT& str)
+		void implInsertEscapedString(const std::string_view& str)
 		{
-			std::string out;
-			for (auto& ch : str)
+			// clean runs are appended as they are; see also impl::json::appendEscapedString()
+			size_t runBegin = 0;
+			for (size_t i = 0; i < str.size(); ++i)
 			{
+				uint8_t ch = (uint8_t)str[i];
+				if (ch >= 0x20 && ch != '\"' && ch != '\\')
+					continue;
+				if (i != runBegin)
+					buff.append(str.data() + runBegin, i - runBegin);
+				runBegin = i + 1;
 				switch (ch)
 				{
 				case '\\':
-					out += "\\\\";
+					buff.append("\\\\", 2);
 					break;
 				case '\n':
-					out += "\\n";
+					buff.append("\\n", 2);
 					break;
 				case '\r':
-					out += "\\r";
+					buff.append("\\r", 2);
 					break;
 				case '\t':
-					out += "\\t";
+					buff.append("\\t", 2);
 					break;
 				case '\"':
-					out += "\\\"";
+					buff.append("\\\"", 2);
 					break;
-				default:
-					out.push_back(ch);
+				default: // other control chars
+				{
+					static constexpr char hexDigits[] = "0123456789abcdef";
+					char escaped[6] = {'\\', 'u', '0', '0', hexDigits[ch >> 4], hexDigits[ch & 0xf]};
+					buff.append(escaped, sizeof(escaped));
+				}
 				}
 			}
-			return out;
+			if (runBegin != str.size())
+				buff.append(str.data() + runBegin, str.size() - runBegin);
 		}
 		void implInsertNamePart(const std::string_view& name)
 		{
-			auto str = fmt::format("\"{}\":", name);
-			buff.append(str.c_str(), str.size());
+			buff.append("\"", 1);
+			buff.append(name.data(), name.size());
+			buff.append("\":", 2);
 			if constexpr (Beautify)
 				buff.append(" ", 1);
 		}
@@ -261,25 +276,37 @@ namespace comparsers
 			++stack.back().count;
 		}
 		template <typename T>
+		void implInsertNumber(T t)
+		{
+			// no temporaries; reals are in their shortest round-trip form
+			char str[32];
+			auto res = std::to_chars(str, str + sizeof(str), t);
+			assert(res.ec == std::errc());
+			buff.append(str, res.ptr - str);
+		}
+		template <typename T>
 		void implInsertUnsignedInteger(T& t)
 		{
 			static_assert(std::is_arithmetic<T>::value);
-			auto str = fmt::format("{}", t);
-			buff.append(str.c_str(), str.size());
+			if constexpr (std::is_integral<T>::value && !std::is_same<T, bool>::value)
+				implInsertNumber((std::make_unsigned_t<T>)t); // as the parser reads UINT back
+			else
+				implInsertNumber(t);
 		}
 		template <typename T>
 		void implInsertSignedInteger(T& t)
 		{
 			static_assert(std::is_arithmetic<T>::value);
-			auto str = fmt::format("{}", t);
-			buff.append(str.c_str(), str.size());
+			if constexpr (std::is_integral<T>::value && !std::is_same<T, bool>::value)
+				implInsertNumber((std::make_signed_t<T>)t); // as the parser reads INT back
+			else
+				implInsertNumber(t);
 		}
 		template <typename T>
 		void implInsertReal(T& t)
 		{
 			static_assert(std::is_arithmetic<T>::value);
-			auto str = fmt::format("{}", t);
-			buff.append(str.c_str(), str.size());
+			implInsertNumber(t);
 		}
 		template <typename T>
 		void implInsertEnumValue(T& t)
@@ -312,8 +339,7 @@ namespace comparsers
 		void implInsertStringValue(const std::string_view& str)
 		{
 			buff.append("\"", 1);
-			auto str1 = implString2JsonString(str);
-			buff.append(str1.c_str(), str1.size());
+			implInsertEscapedString(str);
 			buff.append("\"", 1);
 		}
 		template <typename T>
@@ -769,6 +795,46 @@ namespace comparsers
 				throw std::exception(); // TODO
 		}
 
+		uint32_t implReadUnicodeEscape() // XXXX of \uXXXX
+		{
+			uint32_t codePoint = 0;
+			for (size_t i = 0; i < 4; ++i)
+			{
+				if (!riter.isData())
+					throw std::exception(); // TODO
+				CharT ch = riter.readChar();
+				if (ch >= '0' && ch <= '9')
+					codePoint = (codePoint << 4) | (ch - '0');
+				else if (ch >= 'a' && ch <= 'f')
+					codePoint = (codePoint << 4) | (ch - 'a' + 10);
+				else if (ch >= 'A' && ch <= 'F')
+					codePoint = (codePoint << 4) | (ch - 'A' + 10);
+				else
+					throw std::exception(); // TODO (unexpected)
+			}
+			if (codePoint >= 0xd800 && codePoint <= 0xdfff)
+				throw std::exception(); // TODO (surrogates are not supported)
+			return codePoint;
+		}
+
+		template<class StringT>
+		static void implAppendUtf8(StringT* s, uint32_t codePoint) // within BMP
+		{
+			if (codePoint < 0x80)
+				*s += (char)codePoint;
+			else if (codePoint < 0x800)
+			{
+				*s += (char)(0xc0 | (codePoint >> 6));
+				*s += (char)(0x80 | (codePoint & 0x3f));
+			}
+			else
+			{
+				*s += (char)(0xe0 | (codePoint >> 12));
+				*s += (char)(0x80 | ((codePoint >> 6) & 0x3f));
+				*s += (char)(0x80 | (codePoint & 0x3f));
+			}
+		}
+
 		template<class StringT>
 		void implContinueReadingString(StringT* s)
 		{
@@ -802,6 +868,9 @@ namespace comparsers
 					case '\"':
 						*s += '\"';
 						break;
+					case 'u':
+						implAppendUtf8(s, implReadUnicodeEscape());
+						break;
 					default:
 						throw std::exception(); // TODO (unexpected)
 					}
@@ -816,6 +885,29 @@ namespace comparsers
 //			++riter;
 		}
 
+		template<class StringT>
+		void implContinueCopyingString(StringT& buf) // as implContinueReadingString(), but escape sequences are kept as they are: the text is to be parsed again
+		{
+			while (riter.isData())
+			{
+				CharT ret = riter.readChar();
+				if (ret == '\"')
+				{
+					if (!riter.isData())
+						throw std::exception(); // TODO
+					return;
+				}
+				buf.append(1, ret);
+				if (ret == '\\')
+				{
+					if (!riter.isData())
+						throw std::exception(); // TODO
+					buf.append(1, riter.readChar());
+				}
+			}
+			throw std::exception(); // TODO
+		}
+
 		void readString(std::string* s)
 		{
 			CharT ret = skipSpacesEtc();
@@ -850,24 +942,49 @@ namespace comparsers
 				throw std::exception(); // TODO (expected ':')
 		}
 
+		struct NumberToken // on-stack: numbers are read without temporary strings
+		{
+			char buff[64];
+			size_t size = 0;
+			void push_back(CharT ch)
+			{
+				if (size == sizeof(buff))
+					throw std::exception(); // TODO: (too long for a number)
+				buff[size++] = (char)ch;
+			}
+		};
+
+		template <typename T, typename ParsedT>
+		static void implParseNumber(const NumberToken& s, T* num)
+		{
+			ParsedT retnum;
+			auto res = std::from_chars(s.buff, s.buff + s.size, retnum);
+			if (res.ec != std::errc() || res.ptr != s.buff + s.size)
+				throw std::exception(); // TODO: (not a number, or out of range)
+			if constexpr (std::is_integral<T>::value && std::is_integral<ParsedT>::value)
+			{
+				// checked against T's width only: a signed field may go as UINT (and an unsigned one as INT), composed with the hint's signedness
+				using RangeT = typename std::conditional<std::is_signed<ParsedT>::value, typename std::make_signed<T>::type, typename std::make_unsigned<T>::type>::type;
+				if (!std::in_range<RangeT>(retnum))
+					throw std::exception(); // TODO: (out of range)
+			}
+			*num = (T)retnum;
+		}
+
 		template <typename T>
 		CharT implReadUnsignedInteger(T* num, CharT retch)
 		{
 			if (retch == '-')
 				throw std::exception(); // TODO: (negative is unexpected)
-			std::string s;
+			NumberToken s;
 			while (riter.isData() && (retch >= '0' && retch <= '9'))
 			{
-				s += retch;
+				s.push_back(retch);
 				if (!riter.isData())
 					throw std::exception(); // TODO
 				retch = riter.readChar();
 			}
-			char* end = const_cast<char*>(s.c_str());
-			uint64_t retnum = strtoull(s.c_str(), &end, 10);
-			if (s.c_str() == end)
-				throw std::exception(); // TODO: (NaN)
-			*num = (T)retnum;              // TODO: add boundary checking
+			implParseNumber<T, uint64_t>(s, num);
 			return retch;
 		}
 
@@ -886,24 +1003,20 @@ namespace comparsers
 		template <typename T>
 		CharT implReadSignedInteger(T* num, CharT retch)
 		{
-			std::string s;
+			NumberToken s;
 			if (retch == '-')
 			{
-				s += retch;
+				s.push_back(retch);
 				retch = riter.readChar();
 			}
 			while (riter.isData() && (retch >= '0' && retch <= '9'))
 			{
-				s += retch;
+				s.push_back(retch);
 				if (!riter.isData())
 					throw std::exception(); // TODO
 				retch = riter.readChar();
 			}
-			char* end = const_cast<char*>(s.c_str());
-			uint64_t retnum = strtoull(s.c_str(), &end, 10);
-			if (s.c_str() == end)
-				throw std::exception(); // TODO: (NaN)
-			*num = (T)retnum;              // TODO: add boundary checking
+			implParseNumber<T, int64_t>(s, num);
 			return retch;
 		}
 
@@ -922,20 +1035,16 @@ namespace comparsers
 		template <typename T>
 		CharT implReadReal(T* num, CharT retch)
 		{
-			std::string s;
+			NumberToken s;
 			while (riter.isData() && !(retch == ' ' || retch == '\t' || retch == '\r' || retch == '\n' ||
 									   retch == ',' || retch == ']' || retch == '}')) // expected terminators
 			{
-				s += retch;
+				s.push_back(retch);
 				if (!riter.isData())
 					throw std::exception(); // TODO
 				retch = riter.readChar();
 			}
-			char* end = const_cast<char*>(s.c_str());
-			double retnum = strtod(s.c_str(), &end);
-			if (s.c_str() == end)
-				throw std::exception(); // TODO: (NaN)
-			*num = (T)retnum;              // TODO: add boundary checking
+			implParseNumber<T, double>(s, num);
 			return retch;
 		}
 
@@ -1014,6 +1123,11 @@ namespace comparsers
 			return implReadBoolean(num, skipSpacesEtc(ch));
 		}
 
+		struct SkippingSink // accepts what implReadValueAsJson() would store: used to skip a value
+		{
+			void append( size_t, CharT ) {}
+		};
+
 		template<class StringT>
 		void implReadObjectAsJson( StringT& buf )
 		{
@@ -1034,7 +1148,7 @@ namespace comparsers
 						++depth;
 						break;
 					case '\"':
-						implContinueReadingString( &buf );
+						implContinueCopyingString( buf );
 						buf.append(1, '\"');
 						break;
 					default:
@@ -1064,7 +1178,7 @@ namespace comparsers
 						++depth;
 						break;
 					case '\"':
-						implContinueReadingString( &buf );
+						implContinueCopyingString( buf );
 						buf.append(1, '\"');
 						break;
 					default:
@@ -1090,7 +1204,7 @@ namespace comparsers
 				case '\"' :
 				{
 					buf.append(1, '\"');
-					implContinueReadingString( &buf );
+					implContinueCopyingString( buf );
 					buf.append(1, '\"');
 					ch = riter.readChar();
 					break;
@@ -1193,11 +1307,17 @@ namespace comparsers
 		};
 
 	  private:
+		// fields met before they are requested: positions of their values in the input, to be parsed right into their targets later
+		// (or, if the iterator cannot be copied to keep a position, their text)
+		static constexpr bool oooAsPositions = std::is_copy_constructible<RiterT>::value && std::is_copy_assignable<RiterT>::value;
+		using OutOfOrderValueT = std::conditional_t<oooAsPositions, RiterT, std::basic_string<CharT>>;
+
 		struct In
 		{
 			InType type = InType::inUnknown;
 			uint32_t count = 0;
-			std::unordered_map<std::string, std::basic_string<CharT>> ooo;
+			std::vector<std::pair<std::string, OutOfOrderValueT>> ooo; // a few at most; searched linearly, and only if not empty
+			In( InType type_, uint32_t count_ ) : type( type_ ), count( count_ ) {}
 		};
 		std::vector<In> stack;
 		std::vector<std::string> structNameStack; // Note: at present we silently assume that all CharT = char and std::string works as such TODO: if CharT != char convert names to utf8 first
@@ -1551,25 +1671,39 @@ namespace comparsers
 		template <typename TypeHint, typename ValueT, typename ValueProc, bool hasDefault, auto DefaultValue>
 		void implRWNameValue(const std::string_view& name, ValueT& val, ValueProc&& proc)
 		{
-			auto f = stack.back().ooo.find( std::string( name ) );
-			if ( f != stack.back().ooo.end() )
+			auto& ooo = stack.back().ooo;
+			auto f = ooo.empty() ? ooo.end() : std::find_if( ooo.begin(), ooo.end(), [&]( const auto& entry ) { return entry.first == name; } );
+			if ( f != ooo.end() )
 			{
-				StringAsRiter<std::basic_string<CharT>> sr( f->second );
-				JsonParser2<StringAsRiter<std::basic_string<CharT>>, DataT> p( sr );
-				p.unknownFieldsReporter = unknownFieldsReporter;
-				p.structNameStack = structNameStack;
-				p.structNameStack.push_back( std::string( name ) ); // "popping" is in dtor
-				if constexpr ( !std::is_same<DataT, void>::value )
-					p.userdata = std::move( this->userdata );
-				p.stack.push_back({JsonParser2<StringAsRiter<std::basic_string<CharT>>, DataT>::InType::inNameVal, 0});
-				if constexpr ( std::is_same<ValueProc, VoidPlaceholder>::value )
-					p.template implRWValue<TypeHint, ValueT>(val);
+				auto readStashed = [&]( auto& p ) {
+					using StashedParserT = std::remove_reference_t<decltype( p )>;
+					p.unknownFieldsReporter = unknownFieldsReporter;
+					p.structNameStack = structNameStack;
+					p.structNameStack.push_back( std::string( name ) ); // "popping" is in dtor
+					if constexpr ( !std::is_same<DataT, void>::value )
+						p.userdata = std::move( this->userdata );
+					p.stack.push_back({StashedParserT::InType::inNameVal, 0});
+					if constexpr ( std::is_same<ValueProc, VoidPlaceholder>::value )
+						p.template implRWValue<TypeHint, ValueT>(val);
+					else
+						p.template implRWValue<TypeHint, ValueT, ValueProc>(val, std::move( proc ) );
+					p.endNamedValue();
+					if constexpr ( !std::is_same<DataT, void>::value )
+						this->userdata = std::move( p.userdata );
+				};
+				if constexpr ( oooAsPositions )
+				{
+					RiterT at = f->second;
+					JsonParser2<RiterT, DataT> p( at );
+					readStashed( p );
+				}
 				else
-					p.template implRWValue<TypeHint, ValueT, ValueProc>(val, std::move( proc ) );
-				p.endNamedValue();
-				if constexpr ( !std::is_same<DataT, void>::value )
-					this->userdata = std::move( p.userdata );
-				stack.back().ooo.erase( f );
+				{
+					StringAsRiter<std::basic_string<CharT>> sr( f->second );
+					JsonParser2<StringAsRiter<std::basic_string<CharT>>, DataT> p( sr );
+					readStashed( p );
+				}
+				ooo.erase( f );
 			}
 			else
 			{
@@ -1588,10 +1722,20 @@ namespace comparsers
 				std::string s = implProcessNamePart(ch);
 				while ( s != name )
 				{
-					std::basic_string<CharT> buf;
-					ch = this->readValueAsJson( buf );
+					if constexpr ( oooAsPositions )
+					{
+						RiterT at = this->riter;
+						typename JsonParserBase<RiterT, DataT>::SkippingSink skipped;
+						ch = this->readValueAsJson( skipped );
+						ooo.emplace_back( std::move( s ), at );
+					}
+					else
+					{
+						std::basic_string<CharT> buf;
+						ch = this->readValueAsJson( buf );
+						ooo.emplace_back( std::move( s ), std::move( buf ) );
+					}
 					++stack.back().count;
-					stack.back().ooo.insert( std::make_pair( s, buf ) );
 					ch = this->skipSpacesEtc(ch);
 					if ( ch == '}' )
 					{
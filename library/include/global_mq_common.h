@@ -29,6 +29,9 @@
 #define GLOBAL_MQ_COMMON_H
 
 #include <fmt/format.h>
+#include <memory>
+#include <mutex>
+#include <cstring>
 
 /////////////////////////////////////////
 // means for replacing std:: by nodecpp::
@@ -61,6 +64,160 @@ namespace globalmq::marshalling {
 		uint8_t* buffer;
 	};
 
+	// Process-wide size-class pool for Buffer storage.
+	// Capacities from MIN_BUFFER up to 2^MAX_CLASS_BITS are rounded up to a power of two and recycled
+	// via a per-thread cache backed by a mutex-protected global free list; larger blocks bypass the pool.
+	// Caches are bounded in bytes per size class, so that a burst of large messages does not pin much memory:
+	// a class whose block exceeds the budget of a cache is not kept there at all.
+	// All blocks are obtained with new uint8_t[] so that a block of a non-pooled size can always be delete[]'d.
+	class BufferPool
+	{
+	public:
+		static constexpr size_t MIN_CLASS_BITS = 10;
+		static constexpr size_t MAX_CLASS_BITS = 22;
+		static constexpr size_t CLASS_COUNT = MAX_CLASS_BITS - MIN_CLASS_BITS + 1;
+		static constexpr size_t MAX_THREAD_CACHED_BYTES = size_t(256) << 10; // per size class
+		static constexpr size_t MAX_GLOBAL_CACHED_BYTES = size_t(4) << 20; // per size class
+		static_assert( ( size_t(1) << MIN_CLASS_BITS ) == MIN_BUFFER );
+
+	private:
+		struct FreeBlock { FreeBlock* next; };
+
+		struct FreeList
+		{
+			FreeBlock* head = nullptr;
+			size_t count = 0;
+
+			void push( uint8_t* ptr ) {
+				FreeBlock* b = reinterpret_cast<FreeBlock*>( ptr );
+				b->next = head;
+				head = b;
+				++count;
+			}
+			uint8_t* pop() {
+				if ( head == nullptr )
+					return nullptr;
+				FreeBlock* b = head;
+				head = b->next;
+				--count;
+				return reinterpret_cast<uint8_t*>( b );
+			}
+		};
+
+		struct GlobalLists
+		{
+			std::mutex mx;
+			FreeList lists[CLASS_COUNT];
+		};
+
+		struct ThreadCache
+		{
+			FreeList lists[CLASS_COUNT];
+			~ThreadCache() {
+				GlobalLists& g = globalLists();
+				std::unique_lock<std::mutex> lock( g.mx );
+				for ( size_t i=0; i<CLASS_COUNT; ++i )
+					while ( uint8_t* ptr = lists[i].pop() )
+					{
+						if ( g.lists[i].count < maxGlobalCached( i ) )
+							g.lists[i].push( ptr );
+						else
+							delete [] ptr;
+					}
+				threadCache() = nullptr;
+			}
+		};
+
+		static GlobalLists& globalLists() {
+			static GlobalLists* lists = new GlobalLists; // intentionally never destroyed: buffers may be released during static destruction
+			return *lists;
+		}
+
+		static ThreadCache*& threadCache() {
+			static thread_local ThreadCache* cache = nullptr; // trivially destructible; reset to nullptr when the owner below goes away
+			return cache;
+		}
+
+		static ThreadCache* getThreadCache() {
+			static thread_local bool initialized = false;
+			if ( !initialized )
+			{
+				initialized = true;
+				static thread_local ThreadCache owner;
+				threadCache() = &owner;
+			}
+			return threadCache();
+		}
+
+		static size_t classIndex( size_t capacity ) { // returns CLASS_COUNT for non-pooled capacities
+			if ( capacity < MIN_BUFFER || capacity > ( size_t(1) << MAX_CLASS_BITS ) || ( capacity & ( capacity - 1 ) ) != 0 )
+				return CLASS_COUNT;
+			size_t idx = 0;
+			while ( ( size_t(MIN_BUFFER) << idx ) < capacity )
+				++idx;
+			return idx;
+		}
+
+		static size_t classSize( size_t idx ) { return size_t(MIN_BUFFER) << idx; }
+		static size_t maxThreadCached( size_t idx ) { return MAX_THREAD_CACHED_BYTES / classSize( idx ); }
+		static size_t maxGlobalCached( size_t idx ) { return MAX_GLOBAL_CACHED_BYTES / classSize( idx ); }
+
+	public:
+		static size_t roundUp( size_t sz ) {
+			if ( sz <= MIN_BUFFER )
+				return MIN_BUFFER;
+			if ( sz > ( size_t(1) << MAX_CLASS_BITS ) )
+				return sz;
+			size_t cp = MIN_BUFFER;
+			while ( cp < sz )
+				cp <<= 1;
+			return cp;
+		}
+
+		// returns a block of at least sz bytes; actual size is returned in capacity
+		static uint8_t* allocate( size_t sz, size_t& capacity ) {
+			capacity = roundUp( sz );
+			size_t idx = classIndex( capacity );
+			if ( idx < CLASS_COUNT )
+			{
+				ThreadCache* tc = getThreadCache();
+				if ( tc != nullptr )
+				{
+					if ( uint8_t* ptr = tc->lists[idx].pop() )
+						return ptr;
+				}
+				GlobalLists& g = globalLists();
+				std::unique_lock<std::mutex> lock( g.mx );
+				if ( uint8_t* ptr = g.lists[idx].pop() )
+					return ptr;
+			}
+			return new uint8_t[capacity];
+		}
+
+		static void release( uint8_t* ptr, size_t capacity ) {
+			if ( ptr == nullptr )
+				return;
+			size_t idx = classIndex( capacity );
+			if ( idx < CLASS_COUNT )
+			{
+				ThreadCache* tc = threadCache();
+				if ( tc != nullptr && tc->lists[idx].count < maxThreadCached( idx ) )
+				{
+					tc->lists[idx].push( ptr );
+					return;
+				}
+				GlobalLists& g = globalLists();
+				std::unique_lock<std::mutex> lock( g.mx );
+				if ( g.lists[idx].count < maxGlobalCached( idx ) )
+				{
+					g.lists[idx].push( ptr );
+					return;
+				}
+			}
+			delete [] ptr;
+		}
+	};
+
 	class Buffer {
 	public:
 		class ReadIter
@@ -81,6 +238,7 @@ namespace globalmq::marshalling {
 			}
 			bool isData() { return end > begin; }
 			size_t directlyAvailableSize() { return begin != nullptr ? end - begin : 0; }
+			const uint8_t* directPeek() { return begin; } // valid for directlyAvailableSize() bytes; iterator is not advanced
 			const uint8_t* directRead( size_t sz ) { 
 				if ( begin != nullptr ) { 
 					assert( end >= begin && sz <= static_cast<size_t>(end - begin) ); 
@@ -153,11 +311,12 @@ namespace globalmq::marshalling {
 				reserve(sz);
 			}
 			else if (sz > _capacity) {
-				size_t cp = std::max(sz, MIN_BUFFER);
-				std::unique_ptr<uint8_t[]> tmp(new uint8_t[cp]);
-				memcpy(tmp.get(), _data.get(), _size);
+				size_t cp = 0;
+				uint8_t* tmp = BufferPool::allocate(std::max(sz, 2 * _capacity), cp); // geometric growth: amortized O(1) per appended byte
+				memcpy(tmp, _data.get(), _size);
+				BufferPool::release(_data.release(), _capacity);
 				_capacity = cp;
-				_data = std::move(tmp);
+				_data.reset(tmp);
 			}
 		}
 
@@ -167,15 +326,16 @@ namespace globalmq::marshalling {
 			GMQ_ASSERT( _capacity == 0 );
 			GMQ_ASSERT( _data == nullptr );
 
-			size_t cp = std::max(sz, MIN_BUFFER);
-			std::unique_ptr<uint8_t[]> tmp(new uint8_t[cp]);
+			size_t cp = 0;
+			uint8_t* tmp = BufferPool::allocate(std::max(sz, MIN_BUFFER), cp);
 
 			_capacity = cp;
-			_data = std::move(tmp);
+			_data.reset(tmp);
 		}
 
 	public:
 		Buffer() {}
+		~Buffer() { BufferPool::release(_data.release(), _capacity); }
 //		Buffer(size_t res) { reserve(res); }
 		Buffer(Buffer&& p) noexcept {
 			std::swap(_size, p._size);
@@ -227,16 +387,15 @@ namespace globalmq::marshalling {
 
 		void append(ReadIteratorT it, size_t count)
 		{
-			ensureCapacity(_size + count);
 			while(count != 0 && it.isData())
-            {
-                size_t avail = it.directlyAvailableSize();
-                size_t toRead = std::min(count, avail);
-                size_t actualyRead = it.read(end(), toRead);
+			{
+				size_t avail = it.directlyAvailableSize();
+				size_t toRead = std::min(count, avail);
+				ensureCapacity(_size + toRead); // NOTE: count may be SIZE_MAX ('up to the end')
+				size_t actualyRead = it.read(end(), toRead);
 				_size += actualyRead;
-                count -= actualyRead;
-            }
-
+				count -= actualyRead;
+			}
 		}
 
 		size_t appendUint8( int8_t val ) {
@@ -245,6 +404,10 @@ namespace globalmq::marshalling {
 			return ++_size;
 		}
 
+		void reserveForAppending(size_t sz) { // NOTE: may invalidate pointers
+			ensureCapacity(_size + sz);
+		}
+
 		void set_size(size_t sz) { // NOTE: keeps pointers
 			GMQ_ASSERT( sz <= _capacity );
 			GMQ_ASSERT( _data != nullptr );
@@ -277,9 +440,45 @@ namespace globalmq::marshalling {
 		FileReadBuffer(size_t res) { Buffer::reserve(res); }
 	};
 
+	// counts appended bytes rather than storing them: composing into it yields the size of a message before it is actually composed
+	class SizeMeasuringBuffer
+	{
+		size_t _size = 0;
+
+	public:
+		size_t size() const { return _size; }
+		void append(const void*, size_t sz) { _size += sz; }
+		size_t appendUint8( int8_t ) { return ++_size; }
+		void set_size(size_t sz) { _size = sz; }
+	};
+
+	namespace impl {
+		template<class InputIterT, class OutputIterT>
+		constexpr bool isBlockCopyable = requires( InputIterT& ii, OutputIterT& oi, size_t sz ) {
+			ii.directlyAvailableSize();
+			ii.directRead( sz );
+			oi.append( (const void*)(nullptr), sz );
+		};
+	} // namespace impl
+
 	template<class InputIterT, class OutputIterT>
 	OutputIterT& copy( InputIterT& ii, OutputIterT& oi, size_t count = SIZE_MAX )
 	{
+		if constexpr ( impl::isBlockCopyable<InputIterT, OutputIterT> )
+		{
+			// contiguous chunks go by a single append() each
+			while( count != 0 && ii.isData() )
+			{
+				size_t avail = ii.directlyAvailableSize();
+				if ( avail == 0 )
+					break; // not directly readable; proceed byte by byte below
+				size_t sz = std::min( avail, count );
+				const uint8_t* chunk = ii.directRead( sz );
+				oi.append( chunk, sz );
+				count -= sz;
+			}
+		}
+
 		size_t copiedCount = 0;
 		while( copiedCount < count && ii.isData() )
 		{
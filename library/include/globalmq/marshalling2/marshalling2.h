@@ -32,12 +32,19 @@
 #define GLOBALMQ_MARSHALLING2_MARSHALLING2_H
 
 #include <functional>
+#include <algorithm>
 #include <action_on.h>
 #include <marshalling_impl.h>
 
 namespace globalmq::marshalling2 {
 
+// generated code passes member names as JsonKey( "name", "\"name\":" ), see impl::JsonKeyForComposing
+using JsonKey = globalmq::marshalling::impl::JsonKeyForComposing;
+using PublishableAddress = globalmq::marshalling::PublishableAddress;
+
 // common base to be able to use RTTI
+// generated code calls concrete (final) composers and parsers directly, so per-field calls are not virtual;
+// ComposerBase/ParserBase are only cast back to a concrete type once per message at the publisher/subscriber boundary
 class ComposerBase
 {
 public:
@@ -59,6 +66,7 @@ public:
 
 	virtual void composeSignedInteger(int64_t val) = 0;
 	virtual void composeUnsignedInteger(uint64_t val) = 0;
+	virtual void composeFixedWidthUnsignedInteger(uint64_t val) = 0;
 	virtual void composeReal(double val) = 0;
 	virtual void composeString(const GMQ_COLL string& val) = 0;
 
@@ -72,10 +80,12 @@ public:
 	virtual void dictionaryEnd() = 0;
 
 	virtual void namedParamBegin(const char* name) = 0;
+	virtual void namedParamBegin(const JsonKey& key) { namedParamBegin(key.name); }
 	virtual void leafeBegin() = 0;
 	virtual void nextElement() = 0;
 
-	virtual void changeBegin(const GMQ_COLL vector<uint64_t>& addr, uint64_t last) = 0;
+	virtual void changeBegin(const PublishableAddress& addr, uint64_t last) = 0;
+	virtual void changeBegin(const PublishableAddress& addr, uint64_t action, const PublishableAddress& keyAddress) = 0;
 	virtual void changeEnd() = 0;
 	virtual void stateUpdateBegin() = 0;
 	virtual void stateUpdateEnd() = 0;
@@ -83,13 +93,284 @@ public:
 	virtual void stateSyncEnd() = 0;
 
 	virtual void composeAction(uint64_t action) = 0;
+
+	virtual void setUpdateCoalescing(bool on) = 0;
+	virtual bool isCoalescingUpdates() const = 0;
+};
+
+// opt-in coalescing of the changes composed within one state update (see setUpdateCoalescing() of the composers below).
+// every change is remembered as a byte range of the buffer along with the part of the state it touches; a change that makes
+// earlier ones pointless drops them, and dropped ranges are squeezed out of the buffer. So a member written several times
+// per tick goes out once, with its last value, and a vector element or a dictionary key inserted and removed within
+// the same tick does not go out at all
+class UpdateCoalescer
+{
+	enum class Kind { set, vectorInsert, vectorRemove, dictionaryInsert, dictionaryUpdate, dictionaryRemove };
+
+	struct Change
+	{
+		size_t begin;
+		size_t end;
+		PublishableAddress target; // changed member or dictionary value; the vector itself for vector insertions and removals
+		uint64_t index; // of the element inserted or removed
+		Kind kind;
+		bool dropped;
+	};
+
+	static constexpr size_t squeezeThreshold = 4096; // dropped bytes tolerated in the buffer before a mid-update squeeze
+
+	bool inUpdate = false;
+	bool pending = false; // between changeBegin() and changeEnd() of the last change
+	size_t updateBegin = 0;
+	size_t droppedBytes = 0;
+	GMQ_COLL vector<Change> changes;
+
+	// number of live changes at or below an address, by address hash (open addressing, hash 0 marks a free slot);
+	// lets a change skip looking for earlier ones when there are none. Collisions only make the count too high, never too low
+	struct Counter { uint64_t hash; size_t count; };
+	GMQ_COLL vector<Counter> counters;
+	size_t countersUsed = 0;
+
+	static uint64_t hashStep( uint64_t h, uint64_t item )
+	{
+		h = ( h ^ item ) * 0x9e3779b97f4a7c15ULL;
+		h ^= h >> 29;
+		return h != 0 ? h : 1;
+	}
+
+	size_t slot( uint64_t hash ) const // of the hash, or the free one to take it
+	{
+		size_t mask = counters.size() - 1;
+		size_t i = hash & mask;
+		while ( counters[i].hash != hash && counters[i].hash != 0 )
+			i = ( i + 1 ) & mask;
+		return i;
+	}
+
+	void count( const PublishableAddress& target, bool add )
+	{
+		if ( add && ( countersUsed + target.size() ) * 2 > counters.size() )
+		{
+			size_t newSize = counters.size() < 64 ? 64 : counters.size();
+			while ( ( countersUsed + target.size() ) * 2 > newSize )
+				newSize *= 2;
+			GMQ_COLL vector<Counter> old( newSize, Counter{ 0, 0 } );
+			old.swap( counters );
+			for ( const Counter& c : old )
+				if ( c.hash != 0 )
+					counters[slot( c.hash )] = c;
+		}
+		uint64_t h = 0;
+		for ( uint64_t each : target )
+		{
+			h = hashStep( h, each );
+			Counter& c = counters[slot( h )];
+			if ( add )
+			{
+				if ( c.hash == 0 )
+				{
+					c.hash = h;
+					++countersUsed;
+				}
+				++c.count;
+			}
+			else
+			{
+				GMQ_ASSERT( c.hash == h && c.count != 0 );
+				--c.count;
+			}
+		}
+	}
+
+	size_t countAtOrBelow( const PublishableAddress& target ) const
+	{
+		if ( counters.empty() )
+			return 0;
+		uint64_t h = 0;
+		for ( uint64_t each : target )
+			h = hashStep( h, each );
+		return counters[slot( h )].count; // a free slot counts 0
+	}
+
+	void drop( Change& c )
+	{
+		c.dropped = true;
+		droppedBytes += c.end - c.begin;
+		count( c.target, false );
+	}
+
+	// drops earlier changes made pointless by n; returns false if n cancels out itself
+	bool coalesce( const Change& n )
+	{
+		if ( n.kind == Kind::vectorInsert )
+			return true;
+		size_t candidates = countAtOrBelow( n.target );
+		for ( size_t i = changes.size() - 1; i-- > 0 && candidates != 0; )
+		{
+			Change& e = changes[i];
+			if ( e.dropped )
+				continue;
+			if ( e.target.size() < n.target.size() && n.target.startsWith( e.target ) )
+				break; // above n; anything before it refers to an element that was since shifted, replaced or removed
+			if ( !e.target.startsWith( n.target ) )
+				continue;
+			--candidates;
+			switch ( n.kind )
+			{
+				case Kind::set:
+					drop( e );
+					break;
+				case Kind::vectorRemove:
+					if ( e.target.size() > n.target.size() && e.target[n.target.size()] == n.index )
+						drop( e ); // within the removed element
+					else if ( e.kind == Kind::vectorInsert && e.target.size() == n.target.size() && e.index == n.index )
+					{
+						drop( e );
+						return false;
+					}
+					else
+						return true; // elements were shifted or replaced since
+					break;
+				default: // dictionary operations
+					if ( e.target.size() > n.target.size() )
+						drop( e ); // within the value being replaced or removed
+					else
+					{
+						// the previous operation on the same key; an insertion followed by an update is kept as is
+						GMQ_ASSERT( e.kind != Kind::set && e.kind != Kind::vectorInsert && e.kind != Kind::vectorRemove );
+						if ( e.kind == Kind::dictionaryInsert && n.kind == Kind::dictionaryRemove )
+						{
+							drop( e );
+							return false;
+						}
+						if ( e.kind == Kind::dictionaryUpdate && n.kind != Kind::dictionaryInsert )
+							drop( e );
+						return true;
+					}
+					break;
+			}
+		}
+		return true;
+	}
+
+	template<class BufferT>
+	void squeeze( BufferT& buff )
+	{
+		uint8_t* data = buff.begin();
+		size_t to = updateBegin;
+		size_t from = updateBegin;
+		size_t kept = 0;
+		for ( size_t i = 0; i < changes.size(); ++i )
+		{
+			Change& c = changes[i];
+			GMQ_ASSERT( c.begin == from ); // changes are composed back to back
+			from = c.end;
+			if ( c.dropped )
+				continue;
+			size_t sz = c.end - c.begin;
+			if ( to != c.begin )
+				memmove( data + to, data + c.begin, sz );
+			c.begin = to;
+			to += sz;
+			c.end = to;
+			if ( kept != i )
+				changes[kept] = std::move( c );
+			++kept;
+		}
+		changes.erase( changes.begin() + kept, changes.end() );
+		buff.set_size( to );
+		droppedBytes = 0;
+	}
+
+public:
+	void stateUpdateBegin( size_t offset )
+	{
+		inUpdate = true;
+		pending = false;
+		updateBegin = offset;
+		droppedBytes = 0;
+		changes.clear();
+		std::fill( counters.begin(), counters.end(), Counter{ 0, 0 } );
+		countersUsed = 0;
+	}
+
+	void changeBegin( size_t offset, const PublishableAddress& addr, uint64_t last )
+	{
+		if ( !inUpdate )
+			return;
+		changes.push_back( Change{ offset, offset, addr, last, Kind::set, false } );
+		pending = true;
+	}
+
+	void dictionaryChangeBegin( size_t offset, uint64_t action, const PublishableAddress& keyAddress )
+	{
+		if ( !inUpdate )
+			return;
+		Kind kind;
+		switch ( action )
+		{
+			case globalmq::marshalling::ActionOnDictionary::insert: kind = Kind::dictionaryInsert; break;
+			case globalmq::marshalling::ActionOnDictionary::update_value: kind = Kind::dictionaryUpdate; break;
+			case globalmq::marshalling::ActionOnDictionary::remove: kind = Kind::dictionaryRemove; break;
+			default: throw std::exception(); // TODO: unexpected action
+		}
+		changes.push_back( Change{ offset, offset, keyAddress, 0, kind, false } );
+		pending = true;
+	}
+
+	void vectorAction( uint64_t action )
+	{
+		if ( !pending )
+			return;
+		Change& c = changes.back();
+		if ( action == globalmq::marshalling::ActionOnVector::insert_single_before )
+			c.kind = Kind::vectorInsert;
+		else if ( action == globalmq::marshalling::ActionOnVector::remove_at )
+			c.kind = Kind::vectorRemove;
+	}
+
+	template<class BufferT>
+	void changeEnd( BufferT& buff )
+	{
+		if ( !pending )
+			return;
+		pending = false;
+		Change& c = changes.back();
+		c.end = buff.size();
+		if ( c.kind == Kind::set )
+			c.target.push_back( c.index ); // update_at of a vector is just a set of its element
+		if ( coalesce( changes.back() ) )
+			count( changes.back().target, true );
+		else
+		{
+			changes.back().dropped = true;
+			droppedBytes += changes.back().end - changes.back().begin;
+		}
+		size_t total = buff.size() - updateBegin;
+		if ( droppedBytes > squeezeThreshold && droppedBytes * 2 > total )
+			squeeze( buff );
+	}
+
+	template<class BufferT>
+	void stateUpdateEnd( BufferT& buff )
+	{
+		if ( !inUpdate )
+			return;
+		if ( droppedBytes != 0 )
+			squeeze( buff );
+		changes.clear();
+		inUpdate = false;
+		pending = false;
+	}
 };
 
 template<class BufferT>
-class JsonComposer2 : public ComposerBase
+class JsonComposer2 final : public ComposerBase
 {
 public:
 	BufferT& buff; //public because of impl::json::composeXXX, remove
+	GMQ_COLL unique_ptr<UpdateCoalescer> coalescer; // see setUpdateCoalescing()
+	uint64_t changeCount = 0; // changes composed so far (see StatePublisherBase::changeCount())
 
 	JsonComposer2(BufferT& buff) : buff(buff) {}
 	virtual ~JsonComposer2() {}
@@ -102,6 +383,9 @@ public:
 
 	void composeSignedInteger(int64_t val) { globalmq::marshalling::impl::json::composeSignedInteger(*this, val); }
 	void composeUnsignedInteger(uint64_t val) { globalmq::marshalling::impl::json::composeUnsignedInteger(*this, val); }
+	void composeFixedWidthUnsignedInteger(uint64_t val) { globalmq::marshalling::impl::json::composeFixedWidthUnsignedInteger(*this, val); }
+	static void patchFixedWidthUnsignedInteger(uint8_t* slot, uint64_t val) { globalmq::marshalling::impl::json::patchFixedWidthUnsignedInteger(slot, val); }
+	static constexpr size_t fixedWidthUnsignedIntegerSize = globalmq::marshalling::impl::json::fixed_width_uinteger_size;
 	void composeReal(double val) { globalmq::marshalling::impl::json::composeReal(*this, val); }
 	void composeString(const GMQ_COLL string& val) { globalmq::marshalling::impl::json::composeString(*this, val); }
 
@@ -115,46 +399,79 @@ public:
 	void dictionaryEnd() { buff.appendUint8( '}' ); }
 
 	void namedParamBegin(const char* name) { globalmq::marshalling::impl::json::addNamePart(*this, name); }
-	void leafeBegin() { namedParamBegin("value"); }
+	void namedParamBegin(const JsonKey& key) { globalmq::marshalling::impl::json::addNamePart(*this, key); }
+	void leafeBegin() { namedParamBegin(JsonKey("value", "\"value\":")); }
 	void nextElement() { buff.appendUint8( ',' ); }
 
-	void changeBegin(const GMQ_COLL vector<uint64_t>& addr, uint64_t last)
+	void changeBegin(const PublishableAddress& addr, uint64_t last)
 	{
+		++changeCount;
+		if ( coalescer )
+			coalescer->changeBegin(buff.size(), addr, last);
 		structBegin();
 		composeAddressInPublishable2(*this, addr, last);
 	}
 
-	void changeEnd() { structEnd(); nextElement(); }
+	// dictionary operations; keyAddress is only needed when updates are coalesced
+	void changeBegin(const PublishableAddress& addr, uint64_t action, const PublishableAddress& keyAddress)
+	{
+		++changeCount;
+		if ( coalescer )
+			coalescer->dictionaryChangeBegin(buff.size(), action, keyAddress);
+		structBegin();
+		composeAddressInPublishable2(*this, addr, action);
+	}
+
+	void changeEnd()
+	{
+		structEnd();
+		nextElement();
+		if ( coalescer )
+			coalescer->changeEnd(buff);
+	}
 
 	void stateUpdateBegin()
 	{
 		structBegin();
-		namedParamBegin("changes");
+		namedParamBegin(JsonKey("changes", "\"changes\":"));
 		buff.appendUint8( '[' );
+		if ( coalescer )
+			coalescer->stateUpdateBegin(buff.size());
 	}
 	void stateUpdateEnd()
 	{
+		if ( coalescer )
+			coalescer->stateUpdateEnd(buff);
 		buff.appendUint8( '{' );
 		buff.appendUint8( '}' );
 		buff.appendUint8( ']' );
 		structEnd();
 	}
 
-	void stateSyncBegin() { structBegin(); namedParamBegin("hdr"); }
+	void stateSyncBegin() { structBegin(); namedParamBegin(JsonKey("hdr", "\"hdr\":")); }
 	void stateSyncEnd() { structEnd(); }
 
 	void composeAction(uint64_t action)
 	{
-		namedParamBegin("action");
+		if ( coalescer )
+			coalescer->vectorAction(action);
+		namedParamBegin(JsonKey("action", "\"action\":"));
 		composeUnsignedInteger(action);
 	}
+
+	// off by default; when on, changes composed between stateUpdateBegin() and stateUpdateEnd() are coalesced (see UpdateCoalescer)
+	void setUpdateCoalescing(bool on) { coalescer.reset( on ? new UpdateCoalescer() : nullptr ); }
+	bool isCoalescingUpdates() const { return coalescer != nullptr; }
 };
 
 template<class BufferT>
-class GmqComposer2 : public ComposerBase
+class GmqComposer2 final : public ComposerBase
 {
 public:
 	BufferT& buff; //public because of impl::json::composeXXX, remove
+	bool lengthPrefixedStrings = false; // see globalmq::marshalling::GmqComposer::lengthPrefixedStrings
+	GMQ_COLL unique_ptr<UpdateCoalescer> coalescer; // see setUpdateCoalescing()
+	uint64_t changeCount = 0; // see JsonComposer2::changeCount
 
 	GmqComposer2( BufferT& buff ) : buff(buff) {}
 	virtual ~GmqComposer2() {}
@@ -163,11 +480,18 @@ public:
 	static constexpr int proto = -1;
 
 	void reset() {}
+	void setLengthPrefixedStrings(bool lp) { lengthPrefixedStrings = lp; }
 	void appendRaw(typename BufferT::ReadIteratorT it, size_t count = SIZE_MAX) { buff.append(it, count); }
 
 	void composeSignedInteger(int64_t val) { globalmq::marshalling::impl::composeSignedInteger(*this, val); }
 	void composeUnsignedInteger(uint64_t val) { globalmq::marshalling::impl::composeUnsignedInteger(*this, val); }
+	void composeSignedIntegers(const int64_t* vals, size_t count) { globalmq::marshalling::impl::composeSignedIntegers(*this, vals, count); }
+	void composeUnsignedIntegers(const uint64_t* vals, size_t count) { globalmq::marshalling::impl::composeUnsignedIntegers(*this, vals, count); }
+	void composeFixedWidthUnsignedInteger(uint64_t val) { globalmq::marshalling::impl::composeFixedWidthUnsignedInteger(*this, val); }
+	static void patchFixedWidthUnsignedInteger(uint8_t* slot, uint64_t val) { globalmq::marshalling::impl::patchFixedWidthUnsignedInteger(slot, val); }
+	static constexpr size_t fixedWidthUnsignedIntegerSize = globalmq::marshalling::impl::fixed_width_uinteger_size;
 	void composeReal(double val) { globalmq::marshalling::impl::composeReal(*this, val); }
+	void composeReals(const double* vals, size_t count) { globalmq::marshalling::impl::composeReals(*this, vals, count); }
 	void composeString(const GMQ_COLL string& val) { globalmq::marshalling::impl::composeString(*this, val); }
 
 	void structBegin() {}
@@ -180,34 +504,67 @@ public:
 	void dictionaryEnd() {}
 
 	void namedParamBegin(const char* name) {}
+	void namedParamBegin(const JsonKey&) {}
 	void leafeBegin() {}
 	void nextElement() {}
 
-	void changeBegin(const GMQ_COLL vector<uint64_t>& addr, uint64_t last) { composeAddressInPublishable2(*this, addr, last); }
-	void changeEnd() {}
+	void changeBegin(const PublishableAddress& addr, uint64_t last)
+	{
+		++changeCount;
+		if ( coalescer )
+			coalescer->changeBegin(buff.size(), addr, last);
+		composeAddressInPublishable2(*this, addr, last);
+	}
+	void changeBegin(const PublishableAddress& addr, uint64_t action, const PublishableAddress& keyAddress)
+	{
+		++changeCount;
+		if ( coalescer )
+			coalescer->dictionaryChangeBegin(buff.size(), action, keyAddress);
+		composeAddressInPublishable2(*this, addr, action);
+	}
+	void changeEnd()
+	{
+		if ( coalescer )
+			coalescer->changeEnd(buff);
+	}
 
-	void stateUpdateBegin() {}
-	void stateUpdateEnd() { composeUnsignedInteger(0); }
+	void stateUpdateBegin()
+	{
+		if ( coalescer )
+			coalescer->stateUpdateBegin(buff.size());
+	}
+	void stateUpdateEnd()
+	{
+		if ( coalescer )
+			coalescer->stateUpdateEnd(buff);
+		composeUnsignedInteger(0);
+	}
 
 	void stateSyncBegin() {}
 	void stateSyncEnd() {}
 
-	void composeAction(uint64_t action) { composeUnsignedInteger(action); }
+	void composeAction(uint64_t action)
+	{
+		if ( coalescer )
+			coalescer->vectorAction(action);
+		composeUnsignedInteger(action);
+	}
+
+	void setUpdateCoalescing(bool on) { coalescer.reset( on ? new UpdateCoalescer() : nullptr ); } // see JsonComposer2::setUpdateCoalescing()
+	bool isCoalescingUpdates() const { return coalescer != nullptr; }
 };
 
 
 inline
-GMQ_COLL vector<uint64_t> makeAddress(const GMQ_COLL vector<uint64_t>& addr, uint64_t last)
+PublishableAddress makeAddress(const PublishableAddress& addr, uint64_t last)
 {
-	GMQ_COLL vector<uint64_t> result{addr};
-	result.push_back(last);
-	return result;
+	return PublishableAddress(addr, last);
 }
 
 template<typename ComposerT>
-void composeAddressInPublishable2( ComposerT& composer, const GMQ_COLL vector<uint64_t>& addr, uint64_t last )
+void composeAddressInPublishable2( ComposerT& composer, const PublishableAddress& addr, uint64_t last )
 {
-	composer.namedParamBegin("addr");
+	composer.namedParamBegin(JsonKey("addr", "\"addr\":"));
 	composer.vectorBegin(addr.size() + 1);
 
 	for (uint64_t each : addr )
@@ -369,6 +726,7 @@ public:
 
 	virtual int64_t parseSignedInteger() = 0;
 	virtual uint64_t parseUnsignedInteger() = 0;
+	virtual uint64_t parseFixedWidthUnsignedInteger() = 0;
 	virtual double parseReal() = 0;
 	virtual GMQ_COLL string parseString() = 0;
 
@@ -387,10 +745,11 @@ public:
 	virtual void leafeBegin() = 0;
 	virtual void nextElement() = 0;
 
-	virtual bool changeBegin(GMQ_COLL vector<uint64_t>& addr) = 0;
+	virtual bool changeBegin(PublishableAddress& addr) = 0;
 	virtual void changeEnd() = 0;
 	virtual void stateUpdateBegin() = 0;
 	virtual void stateUpdateEnd() = 0;
+	virtual void skipStateUpdate() = 0;
 	virtual void stateSyncBegin() = 0;
 	virtual void stateSyncEnd() = 0;
 
@@ -398,7 +757,7 @@ public:
 };
 
 template<class BufferT>
-class JsonParser2 : public ParserBase
+class JsonParser2 final : public ParserBase
 {
 	globalmq::marshalling::JsonParser<BufferT> p;
 
@@ -417,6 +776,15 @@ public:
 
 	int64_t parseSignedInteger() { int64_t v; p.readSignedIntegerFromJson(&v); return v; }
 	uint64_t parseUnsignedInteger() { uint64_t v; p.readUnsignedIntegerFromJson(&v); return v; }
+	uint64_t parseFixedWidthUnsignedInteger()
+	{
+		size_t start = p.getCurrentOffset();
+		uint64_t v; p.readUnsignedIntegerFromJson(&v);
+		if(p.getCurrentOffset() - start < fixedWidthUnsignedIntegerSize)
+			throw std::exception(); // not a fixed-width slot
+		return v;
+	}
+	static constexpr size_t fixedWidthUnsignedIntegerSize = globalmq::marshalling::impl::json::fixed_width_uinteger_size;
 	double parseReal() { double v; p.readRealFromJson(&v); return v; }
 	GMQ_COLL string parseString() { GMQ_COLL string v; p.readStringFromJson(&v); return v; }
 
@@ -442,7 +810,7 @@ public:
 	void leafeBegin() { namedParamBegin("value"); }
 	void nextElement() { p.skipDelimiter(','); }
 
-	bool changeBegin(GMQ_COLL vector<uint64_t>& addr)
+	bool changeBegin(PublishableAddress& addr)
 	{
 		addr.clear();
 
@@ -482,6 +850,7 @@ public:
 		p.skipDelimiter(']');
 		structEnd();
 	}
+	void skipStateUpdate() { p.skipMessageFromJson(); }
 	void stateSyncBegin() { structBegin(); namedParamBegin("hdr"); }
 	void stateSyncEnd() { structEnd(); }
 
@@ -494,11 +863,12 @@ public:
 
 
 template<class BufferT>
-class GmqParser2 : public ParserBase
+class GmqParser2 final : public ParserBase
 {
 	globalmq::marshalling::GmqParser<BufferT> p;
 
 public:
+	using BufferType = BufferT;
 	using RiterT = typename BufferT::ReadIteratorT;
 	static constexpr int proto = -1;
 
@@ -507,11 +877,19 @@ public:
 
 	size_t getCurrentOffset() const { return p.getCurrentOffset(); }
 	RiterT& getIterator() { return p.getIterator(); }
+	void setLengthPrefixedStrings(bool lp) { p.setLengthPrefixedStrings(lp); }
 
 	int64_t parseSignedInteger() { int64_t v; p.parseSignedInteger(&v); return v; }
 	uint64_t parseUnsignedInteger() { uint64_t v; p.parseUnsignedInteger(&v); return v; }
+	void parseSignedIntegers(int64_t* vals, size_t count) { p.parseSignedIntegers(vals, count); }
+	void parseUnsignedIntegers(uint64_t* vals, size_t count) { p.parseUnsignedIntegers(vals, count); }
+	uint64_t parseFixedWidthUnsignedInteger() { uint64_t v; p.parseFixedWidthUnsignedInteger(&v); return v; }
+	static constexpr size_t fixedWidthUnsignedIntegerSize = globalmq::marshalling::impl::fixed_width_uinteger_size;
 	double parseReal() { double v; p.parseReal(&v); return v; }
+	void parseReals(double* vals, size_t count) { p.parseReals(vals, count); }
 	GMQ_COLL string parseString() { GMQ_COLL string v; p.parseString(&v); return v; }
+	GMQ_COLL string_view parseStringView() { GMQ_COLL string_view v; p.parseString(&v); return v; } // refers to the buffer being parsed
+	void skipString() { p.skipString(); }
 
 	void structBegin() { }
 	void structEnd() { }
@@ -528,7 +906,7 @@ public:
 	void leafeBegin() { }
 	void nextElement() { }
 
-	bool changeBegin(GMQ_COLL vector<uint64_t>& addr)
+	bool changeBegin(PublishableAddress& addr)
 	{
 		addr.clear();
 		uint64_t sz = vectorBegin();
@@ -549,6 +927,7 @@ public:
 
 	void stateUpdateBegin() {}
 	void stateUpdateEnd() {}
+	void skipStateUpdate() {} // an update is the last part of a message, and nothing follows it
 	void stateSyncBegin() {}
 	void stateSyncEnd() {}
 
@@ -642,16 +1021,13 @@ public:
 	bool isSame(int64_t l, int64_t r) { return l == r;}
 
 	static
-	GMQ_COLL vector<uint64_t> makeAddress(const GMQ_COLL vector<uint64_t>& baseAddress, int64_t address)
+	PublishableAddress makeAddress(const PublishableAddress& baseAddress, int64_t address)
 	{
-		GMQ_COLL vector<uint64_t> result{baseAddress};
-		uint64_t val = globalmq::marshalling::impl::IntegralVlq::zigzagEncode(address);
-		result.push_back(val);
-		return result;
+		return PublishableAddress(baseAddress, globalmq::marshalling::impl::IntegralVlq::zigzagEncode(address));
 	}
 
 	static
-	int64_t fromAddress(const GMQ_COLL vector<uint64_t>& address, size_t& index)
+	int64_t fromAddress(const PublishableAddress& address, size_t& index)
 	{
 		uint64_t val = address[index];
 		int64_t result = globalmq::marshalling::impl::IntegralVlq::zigzagDecode(val);
@@ -728,15 +1104,13 @@ public:
 	bool isSame(uint64_t l, uint64_t r) { return l == r;}
 
 	static
-	GMQ_COLL vector<uint64_t> makeAddress(const GMQ_COLL vector<uint64_t>& baseAddress, uint64_t address)
+	PublishableAddress makeAddress(const PublishableAddress& baseAddress, uint64_t address)
 	{
-		GMQ_COLL vector<uint64_t> result{baseAddress};
-		result.push_back(address);
-		return result;
+		return PublishableAddress(baseAddress, address);
 	}
 
 	static
-	uint64_t fromAddress(const GMQ_COLL vector<uint64_t>& address, size_t& index)
+	uint64_t fromAddress(const PublishableAddress& address, size_t& index)
 	{
 		uint64_t result = address[index];
 		++index;
@@ -828,6 +1202,20 @@ public:
 		return parser.parseString();
 	}
 
+	// no copy, where parser supports it; result refers to the buffer being parsed (or to 'storage' otherwise)
+	template<typename ParserT>
+	static
+	GMQ_COLL string_view parseView(ParserT& parser, GMQ_COLL string& storage)
+	{
+		if constexpr ( requires { parser.parseStringView(); } )
+			return parser.parseStringView();
+		else
+		{
+			storage = parser.parseString();
+			return storage;
+		}
+	}
+
 	template<typename ParserT>
 	static
 	void parse(ParserT& parser, GMQ_COLL string& arg)
@@ -858,19 +1246,20 @@ public:
 	bool isSame(GMQ_COLL string l, GMQ_COLL string r) { return l == r;}
 
 	static
-	GMQ_COLL vector<uint64_t> makeAddress(const GMQ_COLL vector<uint64_t>& baseAddress, GMQ_COLL string address)
+	PublishableAddress makeAddress(const PublishableAddress& baseAddress, GMQ_COLL string address)
 	{
 		if(address.find_first_of('\0') != GMQ_COLL string::npos)
 			throw std::exception();
 
-		GMQ_COLL vector<uint64_t> result{baseAddress};
-		result.insert(result.end(), address.begin(), address.end());
+		PublishableAddress result{baseAddress};
+		for (char ch : address)
+			result.push_back(ch);
 		result.push_back(0);
 		return result;
 	}
 
 	static
-	GMQ_COLL string fromAddress(const GMQ_COLL vector<uint64_t>& address, size_t& index)
+	GMQ_COLL string fromAddress(const PublishableAddress& address, size_t& index)
 	{
 		GMQ_COLL string result;
 		while(address[index] != 0)
@@ -899,10 +1288,10 @@ protected:
 
 	VectorT& b;
 	RootT& root;
-	GMQ_COLL vector<uint64_t> address;
+	PublishableAddress address;
 
 public:
-	VectorRefWrapper4Set( VectorT& actual, RootT& root_, GMQ_COLL vector<uint64_t>&& address_ )
+	VectorRefWrapper4Set( VectorT& actual, RootT& root_, PublishableAddress&& address_ )
 		: b( actual ), root( root_ ), address( std::move(address_) ) { }
 
 	void remove( size_t idx ) { 
@@ -947,7 +1336,7 @@ public:
 	using VectorT = typename base_type::VectorT;
 	using CppType = VectorT;
 
-	VectorOfStructRefWrapper4Set( VectorT& actual, RootT& root_, GMQ_COLL vector<uint64_t>&& address_ ) : 
+	VectorOfStructRefWrapper4Set( VectorT& actual, RootT& root_, PublishableAddress&& address_ ) : 
 		base_type( actual, root_, std::move(address_) ) {}
 	auto get4set_at( size_t idx ) { return RefWrapper4SetT(base_type::b[idx], base_type::root, makeAddress(base_type::address, idx)); }
 };
@@ -989,6 +1378,64 @@ public:
 };
 
 
+// vectors of numbers are composed/parsed at once, if composer/parser supports it (that is, for GMQ); returns false otherwise
+template<class ElemProcT>
+class VectorBulkProcessor2
+{
+public:
+	using CppType = GMQ_COLL vector<typename ElemProcT::CppType>;
+
+	template<class ComposerT>
+	static
+	bool compose( ComposerT& composer, const CppType& what ) {
+		if constexpr ( std::is_same<ElemProcT, Int64Processor>::value && requires { composer.composeSignedIntegers( what.data(), what.size() ); } )
+		{
+			composer.composeSignedIntegers( what.data(), what.size() );
+			return true;
+		}
+		else if constexpr ( std::is_same<ElemProcT, UInt64Processor>::value && requires { composer.composeUnsignedIntegers( what.data(), what.size() ); } )
+		{
+			composer.composeUnsignedIntegers( what.data(), what.size() );
+			return true;
+		}
+		else if constexpr ( std::is_same<ElemProcT, DoubleProcessor>::value && requires { composer.composeReals( what.data(), what.size() ); } )
+		{
+			composer.composeReals( what.data(), what.size() );
+			return true;
+		}
+		else
+			return false;
+	}
+
+	template<class ParserT>
+	static
+	bool parse( ParserT& parser, CppType& dest, uint64_t collSz ) { // collSz as returned by parser.vectorBegin(); on success, completes with parser.vectorEnd()
+		if constexpr ( std::is_same<ElemProcT, Int64Processor>::value && requires { parser.parseSignedIntegers( dest.data(), dest.size() ); } )
+		{
+			dest.resize( collSz );
+			parser.parseSignedIntegers( dest.data(), dest.size() );
+			parser.vectorEnd();
+			return true;
+		}
+		else if constexpr ( std::is_same<ElemProcT, UInt64Processor>::value && requires { parser.parseUnsignedIntegers( dest.data(), dest.size() ); } )
+		{
+			dest.resize( collSz );
+			parser.parseUnsignedIntegers( dest.data(), dest.size() );
+			parser.vectorEnd();
+			return true;
+		}
+		else if constexpr ( std::is_same<ElemProcT, DoubleProcessor>::value && requires { parser.parseReals( dest.data(), dest.size() ); } )
+		{
+			dest.resize( collSz );
+			parser.parseReals( dest.data(), dest.size() );
+			parser.vectorEnd();
+			return true;
+		}
+		else
+			return false;
+	}
+};
+
 template<class ElemProcT>
 class PublishableVectorProcessor2
 {
@@ -1015,6 +1462,11 @@ public:
 		using ComposerT = typename std::remove_reference<ComposerTT>::type;
 		size_t collSz = what.size();
 		composer.vectorBegin( collSz );
+		if ( VectorBulkProcessor2<ElemProcT>::compose( composer, what ) )
+		{
+			composer.vectorEnd();
+			return;
+		}
 		for ( size_t i=0; i<collSz; ++i )
 		{
 			if(i != 0)
@@ -1030,6 +1482,8 @@ public:
 	void parse( ParserT& parser, CppType& dest ) { 
 		dest.clear();
 		uint64_t collSz = parser.vectorBegin();
+		if ( VectorBulkProcessor2<ElemProcT>::parse( parser, dest, collSz ) )
+			return;
 		if(collSz != UINT64_MAX)
 			dest.reserve( collSz );
 
@@ -1050,6 +1504,8 @@ public:
 	void parseForStateSyncOrMessageInDepth( ParserT& parser, CppType& dest ) { 
 		dest.clear();
 		uint64_t collSz = parser.vectorBegin();
+		if ( VectorBulkProcessor2<ElemProcT>::parse( parser, dest, collSz ) )
+			return;
 		if(collSz != UINT64_MAX)
 			dest.reserve( collSz );
 
@@ -1071,6 +1527,8 @@ public:
 	void parse_state_sync( ParserT& parser, CppType& dest ) { 
 		dest.clear();
 		uint64_t collSz = parser.vectorBegin();
+		if ( VectorBulkProcessor2<ElemProcT>::parse( parser, dest, collSz ) )
+			return;
 		if(collSz != UINT64_MAX)
 			dest.reserve( collSz );
 
@@ -1147,6 +1605,11 @@ public:
 		using ComposerT = typename std::remove_reference<ComposerTT>::type;
 		size_t collSz = what.size();
 		composer.vectorBegin( collSz );
+		if ( VectorBulkProcessor2<ElemProcT>::compose( composer, what ) )
+		{
+			composer.vectorEnd();
+			return;
+		}
 		for ( size_t i=0; i<collSz; ++i )
 		{
 			if(i != 0)
@@ -1163,6 +1626,8 @@ public:
 	{ 
 		dest.clear();
 		uint64_t collSz = parser.vectorBegin();
+		if ( VectorBulkProcessor2<ElemProcT>::parse( parser, dest, collSz ) )
+			return;
 		if(collSz != UINT64_MAX)
 			dest.reserve( collSz );
 
@@ -1193,6 +1658,8 @@ public:
 	{
 		dest.clear();
 		uint64_t collSz = parser.vectorBegin();
+		if ( VectorBulkProcessor2<ElemProcT>::parse( parser, dest, collSz ) )
+			return;
 		if(collSz != UINT64_MAX)
 			dest.reserve( collSz );
 
@@ -1329,12 +1796,19 @@ public:
 protected:
 	DictionaryT& b;
 	RootT& root;
-	GMQ_COLL vector<size_t> address;
+	PublishableAddress address;
 
 private:
+	void changeBegin( uint64_t action, const key_type& key )
+	{
+		if ( root.getComposer().isCoalescingUpdates() )
+			root.getComposer().changeBegin(address, action, KeyProcT::makeAddress(address, key));
+		else
+			root.getComposer().changeBegin(address, action);
+	}
 
 public:
-	DictionaryRefWrapper4Set( DictionaryT& actual, RootT& root_, GMQ_COLL vector<size_t>&& address_ ) :
+	DictionaryRefWrapper4Set( DictionaryT& actual, RootT& root_, PublishableAddress&& address_ ) :
 		b( actual ), root( root_ ), address( std::move(address_) )
 	{ }
 
@@ -1347,9 +1821,9 @@ public:
 		size_t ret = b.erase( key );
 		if ( ret != 0 )
 		{
-			root.getComposer().changeBegin(address, globalmq::marshalling::ActionOnDictionary::remove);
+			changeBegin(globalmq::marshalling::ActionOnDictionary::remove, key);
 			root.getComposer().nextElement();
-			root.getComposer().namedParamBegin("key");
+			root.getComposer().namedParamBegin(JsonKey("key", "\"key\":"));
 			KeyProcT::compose( root.getComposer(), key );
 			root.getComposer().changeEnd();
 		}
@@ -1360,12 +1834,12 @@ public:
 		auto insret = b.insert( std::make_pair( key, value ) );
 		if ( insret.second )
 		{
-			root.getComposer().changeBegin(address, globalmq::marshalling::ActionOnDictionary::insert);
+			changeBegin(globalmq::marshalling::ActionOnDictionary::insert, key);
 			root.getComposer().nextElement();
-			root.getComposer().namedParamBegin("key");
+			root.getComposer().namedParamBegin(JsonKey("key", "\"key\":"));
 			KeyProcT::compose( root.getComposer(), key );
 			root.getComposer().nextElement();
-			root.getComposer().namedParamBegin("value");
+			root.getComposer().namedParamBegin(JsonKey("value", "\"value\":"));
 			ValueProcT::compose( root.getComposer(), value );
 			root.getComposer().changeEnd();
 		}
@@ -1378,12 +1852,12 @@ public:
 		{
 			f->second = newValue;
 
-			root.getComposer().changeBegin(address, globalmq::marshalling::ActionOnDictionary::update_value);
+			changeBegin(globalmq::marshalling::ActionOnDictionary::update_value, key);
 			root.getComposer().nextElement();
-			root.getComposer().namedParamBegin("key");
+			root.getComposer().namedParamBegin(JsonKey("key", "\"key\":"));
 			KeyProcT::compose( root.getComposer(), key );
 			root.getComposer().nextElement();
-			root.getComposer().namedParamBegin("value");
+			root.getComposer().namedParamBegin(JsonKey("value", "\"value\":"));
 			ValueProcT::compose( root.getComposer(), newValue );
 			root.getComposer().changeEnd();
 
@@ -1400,7 +1874,7 @@ public:
 	using base_type = DictionaryRefWrapper4Set<KeyProcT, ValueProcT, RootT>;
 	using DictionaryT = typename base_type::DictionaryT;
 
-	DictionaryOfStructRefWrapper4Set( DictionaryT& actual, RootT& root_, GMQ_COLL vector<uint64_t>&& address_ ) : 
+	DictionaryOfStructRefWrapper4Set( DictionaryT& actual, RootT& root_, PublishableAddress&& address_ ) : 
 		base_type( actual, root_, std::move(address_) ) {}
 	auto get4set_at( const typename KeyProcT::CppType& key )
 	{
@@ -33,9 +33,14 @@
 
 #include "global_mq_common.h"
 #include "marshalling.h"
+#include <memory>
 #include <thread>
 #include <mutex>
+#include <shared_mutex>
+#include <atomic>
 #include <condition_variable>
+#include <chrono>
+#include <random>
 
 
 #ifndef GMQUEUE_CUSTOMIZED_Q_TYPES
@@ -86,8 +91,15 @@ using MessageBufferT = typename GMQueueStatePublisherSubscriberTypeInfo::BufferT
 struct PublishableStateMessageHeader
 {
 	static constexpr uint64_t invalidValue = 0xFFFFFFFFFFFFFFULL;
-	enum MsgType { undefined = 0, subscriptionRequest = 1, subscriptionResponse = 2, stateUpdate = 3, connectionRequest = 4, connectionAccepted = 5, connectionMessage = 6 };
+	static constexpr size_t invalidOffset = (size_t)(-1);
+	// resyncResponse: reply to a subscriptionRequest with a state_version that publisher still has updates since (see StateUpdateLogT);
+	// has no data part, and is followed by the missed updates as regular stateUpdate messages instead of a state sync
+	enum MsgType { undefined = 0, subscriptionRequest = 1, subscriptionResponse = 2, stateUpdate = 3, connectionRequest = 4, connectionAccepted = 5, connectionMessage = 6, resyncResponse = 7 };
 	enum ConnMsgDirection { toServer = 0, toClient = 1 };
+	static constexpr uint64_t fixedRefIdSlotsFlag = 0x40; // combined with msg_type; see fixedRefIdSlots
+	static constexpr uint64_t lengthPrefixedStringsFlag = 0x20; // combined with msg_type; see lengthPrefixedStrings
+	static constexpr uint64_t stateVersionFlag = 0x10; // combined with msg_type; see hasStateVersion
+	static constexpr uint64_t flags = fixedRefIdSlotsFlag | lengthPrefixedStringsFlag | stateVersionFlag;
 	MsgType type = MsgType::undefined;
 	uint64_t state_type_id_or_direction = invalidValue; // Note: may be removed in future versions
 	uint64_t priority = invalidValue;
@@ -95,6 +107,87 @@ struct PublishableStateMessageHeader
 	uint64_t ref_id_at_subscriber = invalidValue; // updatable
 	uint64_t ref_id_at_publisher = invalidValue; // updatable
 
+	// header layout: if set, ref ids are composed as fixed-width values and a message can be retargeted by patching them in place
+	// (see helperPatchPublishableStateMessageRefIds()); chosen by a requesting side and mirrored by a responding side
+	bool fixedRefIdSlots = false;
+	size_t ref_id_at_subscriber_slot = invalidOffset; // set by parsing; fixedRefIdSlots only
+	size_t ref_id_at_publisher_slot = invalidOffset; // set by parsing; fixedRefIdSlots only
+
+	// string encoding of everything that follows msg_type (including message body): if set, strings are composed as length followed by bytes
+	// and thus may contain NULs and may be skipped or referenced in place without scanning; chosen by a sending side per message (GMQ only),
+	// composer and parser are switched accordingly by compose() and parse() (see also applyStringEncoding())
+	bool lengthPrefixedStrings = false;
+
+	// version of a publishable state, as counted by ticks of its publisher; present (and composed right after priority) only if publisher keeps
+	// an update log (see StateUpdateLogT). subscriptionResponse and stateUpdate: version of the state they bring subscriber to;
+	// subscriptionRequest: version subscriber already has, if any; resyncResponse: current version (missed updates follow)
+	bool hasStateVersion = false;
+	uint64_t state_version = 0;
+	// instance of publisher that counts versions (random, see StateUpdateLogT::newEpoch()); composed right after state_version. Versions of different
+	// instances (say, of a restarted publisher) are unrelated, and a subscriber with a version of another one is never resynced, but gets a state sync
+	uint64_t state_epoch = 0;
+
+	template<class ComposerOrParserT>
+	static constexpr bool supportsLengthPrefixedStrings() { return requires( ComposerOrParserT& cp ) { cp.setLengthPrefixedStrings( true ); }; }
+
+	template<class ComposerOrParserT>
+	static bool applyStringEncoding( ComposerOrParserT& cp, bool lengthPrefixed ) // returns whether cp uses length-prefixed strings from now on
+	{
+		if constexpr ( supportsLengthPrefixedStrings<ComposerOrParserT>() )
+		{
+			cp.setLengthPrefixedStrings( lengthPrefixed );
+			return lengthPrefixed;
+		}
+		else
+			return false;
+	}
+
+	template<class ComposerT>
+	uint64_t msgTypeToCompose() const
+	{
+		uint64_t ret = (uint32_t)(type) | ( fixedRefIdSlots ? fixedRefIdSlotsFlag : 0 ) | ( hasStateVersion ? stateVersionFlag : 0 );
+		if constexpr ( supportsLengthPrefixedStrings<ComposerT>() )
+			ret |= lengthPrefixedStrings ? lengthPrefixedStringsFlag : 0;
+		return ret;
+	}
+
+	template<class ParserT>
+	static void parseRefId( ParserT& parser, bool fixed, uint64_t* id, size_t* slot, const char* name )
+	{
+		if ( fixed )
+			globalmq::marshalling::impl::publishableParseFixedWidthUnsignedInteger( parser, id, slot, name );
+		else
+			globalmq::marshalling::impl::publishableParseUnsignedInteger<ParserT, uint64_t>( parser, id, name );
+	}
+
+	template<class ComposerT>
+	static void composeRefId( ComposerT& composer, bool fixed, uint64_t id, const char* name, bool addSeparator )
+	{
+		if ( fixed )
+			globalmq::marshalling::impl::publishableStructComposeFixedWidthUnsignedInteger( composer, id, name, addSeparator );
+		else
+			globalmq::marshalling::impl::publishableStructComposeUnsignedInteger( composer, id, name, addSeparator );
+	}
+
+	template<class ParserT>
+	static uint64_t parseRefId2( ParserT& parser, bool fixed, size_t* slot )
+	{
+		if ( !fixed )
+			return parser.parseUnsignedInteger();
+		uint64_t ret = parser.parseFixedWidthUnsignedInteger();
+		*slot = parser.getCurrentOffset() - ParserT::fixedWidthUnsignedIntegerSize;
+		return ret;
+	}
+
+	template<class ComposerT>
+	static void composeRefId2( ComposerT& composer, bool fixed, uint64_t id )
+	{
+		if ( fixed )
+			composer.composeFixedWidthUnsignedInteger( id );
+		else
+			composer.composeUnsignedInteger( id );
+	}
+
 	struct UpdatedData
 	{
 		uint64_t ref_id_at_subscriber = invalidValue;
@@ -109,11 +202,17 @@ struct PublishableStateMessageHeader
 		globalmq::marshalling::impl::parsePublishableStructBegin( parser, "hdr" );
 		size_t msgType;
 		globalmq::marshalling::impl::publishableParseUnsignedInteger<ParserT, size_t>( parser, &msgType, "msg_type" );
+		fixedRefIdSlots = ( msgType & fixedRefIdSlotsFlag ) != 0;
+		lengthPrefixedStrings = ( msgType & lengthPrefixedStringsFlag ) != 0;
+		hasStateVersion = ( msgType & stateVersionFlag ) != 0;
+		msgType &= ~flags;
+		applyStringEncoding( parser, lengthPrefixedStrings );
 		switch ( msgType )
 		{
 			case MsgType::subscriptionRequest:
 			case MsgType::subscriptionResponse:
 			case MsgType::stateUpdate:
+			case MsgType::resyncResponse:
 				globalmq::marshalling::impl::publishableParseUnsignedInteger<ParserT, uint64_t>( parser, &state_type_id_or_direction, "state_type_id" );
 				break;
 			case MsgType::connectionRequest:
@@ -125,6 +224,11 @@ struct PublishableStateMessageHeader
 				throw std::exception(); // TODO: ... (unknown msg type)
 		}
 		globalmq::marshalling::impl::publishableParseUnsignedInteger<ParserT, uint64_t>( parser, &priority, "priority" );
+		if ( hasStateVersion )
+		{
+			globalmq::marshalling::impl::publishableParseUnsignedInteger<ParserT, uint64_t>( parser, &state_version, "state_version" );
+			globalmq::marshalling::impl::publishableParseUnsignedInteger<ParserT, uint64_t>( parser, &state_epoch, "state_epoch" );
+		}
 		switch ( msgType )
 		{
 			case MsgType::subscriptionRequest:
@@ -132,17 +236,18 @@ struct PublishableStateMessageHeader
 			{
 				type = (MsgType)(msgType);
 				globalmq::marshalling::impl::publishableParseString<ParserT, GMQ_COLL string>( parser, &path, "path" );
-				globalmq::marshalling::impl::publishableParseUnsignedInteger<ParserT, uint64_t>( parser, &ref_id_at_subscriber, "ref_id_at_subscriber" );
+				parseRefId( parser, fixedRefIdSlots, &ref_id_at_subscriber, &ref_id_at_subscriber_slot, "ref_id_at_subscriber" );
 				break;
 			}
 			case MsgType::subscriptionResponse:
 			case MsgType::stateUpdate:
+			case MsgType::resyncResponse:
 			case MsgType::connectionAccepted:
 			case MsgType::connectionMessage:
 			{
 				type = (MsgType)(msgType);
-				globalmq::marshalling::impl::publishableParseUnsignedInteger<ParserT, uint64_t>( parser, &ref_id_at_subscriber, "ref_id_at_subscriber" );
-				globalmq::marshalling::impl::publishableParseUnsignedInteger<ParserT, uint64_t>( parser, &ref_id_at_publisher, "ref_id_at_publisher" );
+				parseRefId( parser, fixedRefIdSlots, &ref_id_at_subscriber, &ref_id_at_subscriber_slot, "ref_id_at_subscriber" );
+				parseRefId( parser, fixedRefIdSlots, &ref_id_at_publisher, &ref_id_at_publisher_slot, "ref_id_at_publisher" );
 				break;
 			}
 			default:
@@ -159,12 +264,18 @@ struct PublishableStateMessageHeader
 		parser.namedParamBegin("msg_type");
 		uint64_t msgType = parser.parseUnsignedInteger();
 		parser.nextElement();
+		fixedRefIdSlots = ( msgType & fixedRefIdSlotsFlag ) != 0;
+		lengthPrefixedStrings = ( msgType & lengthPrefixedStringsFlag ) != 0;
+		hasStateVersion = ( msgType & stateVersionFlag ) != 0;
+		msgType &= ~flags;
+		applyStringEncoding( parser, lengthPrefixedStrings );
 		// globalmq::marshalling::impl::publishableParseUnsignedInteger<ParserT, size_t>( parser, &msgType, "msg_type" );
 		switch ( msgType )
 		{
 			case MsgType::subscriptionRequest:
 			case MsgType::subscriptionResponse:
 			case MsgType::stateUpdate:
+			case MsgType::resyncResponse:
 				parser.namedParamBegin("state_type_id");
 				state_type_id_or_direction = parser.parseUnsignedInteger();
 				parser.nextElement();
@@ -184,6 +295,15 @@ struct PublishableStateMessageHeader
 		parser.namedParamBegin("priority");
 		priority = parser.parseUnsignedInteger();
 		parser.nextElement();
+		if ( hasStateVersion )
+		{
+			parser.namedParamBegin("state_version");
+			state_version = parser.parseUnsignedInteger();
+			parser.nextElement();
+			parser.namedParamBegin("state_epoch");
+			state_epoch = parser.parseUnsignedInteger();
+			parser.nextElement();
+		}
 		// globalmq::marshalling::impl::publishableParseUnsignedInteger<ParserT, uint64_t>( parser, &priority, "priority" );
 		switch ( msgType )
 		{
@@ -194,21 +314,22 @@ struct PublishableStateMessageHeader
 				path = parser.parseString();
 				parser.nextElement();
 				parser.namedParamBegin("ref_id_at_subscriber");
-				ref_id_at_subscriber = parser.parseUnsignedInteger();
+				ref_id_at_subscriber = parseRefId2( parser, fixedRefIdSlots, &ref_id_at_subscriber_slot );
 
 				// globalmq::marshalling::impl::publishableParseString<ParserT, GMQ_COLL string>( parser, &path, "path" );
 				// globalmq::marshalling::impl::publishableParseUnsignedInteger<ParserT, uint64_t>( parser, &ref_id_at_subscriber, "ref_id_at_subscriber" );
 				break;
 			case MsgType::subscriptionResponse:
 			case MsgType::stateUpdate:
+			case MsgType::resyncResponse:
 			case MsgType::connectionAccepted:
 			case MsgType::connectionMessage:
 				type = (MsgType)(msgType);
 				parser.namedParamBegin("ref_id_at_subscriber");
-				ref_id_at_subscriber = parser.parseUnsignedInteger();
+				ref_id_at_subscriber = parseRefId2( parser, fixedRefIdSlots, &ref_id_at_subscriber_slot );
 				parser.nextElement();
 				parser.namedParamBegin("ref_id_at_publisher");
-				ref_id_at_publisher = parser.parseUnsignedInteger();
+				ref_id_at_publisher = parseRefId2( parser, fixedRefIdSlots, &ref_id_at_publisher_slot );
 				// globalmq::marshalling::impl::publishableParseUnsignedInteger<ParserT, uint64_t>( parser, &ref_id_at_subscriber, "ref_id_at_subscriber" );
 				// globalmq::marshalling::impl::publishableParseUnsignedInteger<ParserT, uint64_t>( parser, &ref_id_at_publisher, "ref_id_at_publisher" );
 				break;
@@ -227,13 +348,19 @@ struct PublishableStateMessageHeader
 		globalmq::marshalling::impl::parsePublishableStructBegin( parser, "hdr" );
 		size_t msgType;
 		globalmq::marshalling::impl::publishableParseUnsignedInteger<ParserT, size_t>( parser, &msgType, "msg_type" );
+		bool fixed = ( msgType & fixedRefIdSlotsFlag ) != 0;
+		bool versioned = ( msgType & stateVersionFlag ) != 0;
+		applyStringEncoding( parser, ( msgType & lengthPrefixedStringsFlag ) != 0 );
+		msgType &= ~flags;
 		uint64_t dummy;
+		size_t dummySlot;
 		GMQ_COLL string dummyStr;
 		switch ( msgType )
 		{
 			case MsgType::subscriptionRequest:
 			case MsgType::subscriptionResponse:
 			case MsgType::stateUpdate:
+			case MsgType::resyncResponse:
 				globalmq::marshalling::impl::publishableParseUnsignedInteger<ParserT, uint64_t>( parser, &dummy, "state_type_id" );
 				break;
 			case MsgType::connectionRequest:
@@ -245,6 +372,11 @@ struct PublishableStateMessageHeader
 				throw std::exception(); // TODO: ... (unknown msg type)
 		}
 		globalmq::marshalling::impl::publishableParseUnsignedInteger<ParserT, uint64_t>( parser, &dummy, "priority" );
+		if ( versioned )
+		{
+			globalmq::marshalling::impl::publishableParseUnsignedInteger<ParserT, uint64_t>( parser, &dummy, "state_version" );
+			globalmq::marshalling::impl::publishableParseUnsignedInteger<ParserT, uint64_t>( parser, &dummy, "state_epoch" );
+		}
 		switch ( msgType )
 		{
 			case MsgType::subscriptionRequest:
@@ -254,30 +386,31 @@ struct PublishableStateMessageHeader
 				assert( !udata.update_ref_id_at_publisher );
 				size_t offset = parser.getCurrentOffset();
 				::globalmq::marshalling::copy<typename ParserT::RiterT, typename ComposerT::BufferType>( msgStartParser.getIterator(), buff, offset );
-				globalmq::marshalling::impl::publishableParseUnsignedInteger<ParserT, uint64_t>( parser, &dummy, "ref_id_at_subscriber" );
+				parseRefId( parser, fixed, &dummy, &dummySlot, "ref_id_at_subscriber" );
 				if ( udata.update_ref_id_at_subscriber )
-					globalmq::marshalling::impl::publishableStructComposeUnsignedInteger( composer, udata.ref_id_at_subscriber, "ref_id_at_subscriber", false );
+					composeRefId( composer, fixed, udata.ref_id_at_subscriber, "ref_id_at_subscriber", false );
 				else
-					globalmq::marshalling::impl::publishableStructComposeUnsignedInteger( composer, dummy, "ref_id_at_subscriber", false );
+					composeRefId( composer, fixed, dummy, "ref_id_at_subscriber", false );
 				break;
 			}
 			case MsgType::subscriptionResponse:
 			case MsgType::stateUpdate:
+			case MsgType::resyncResponse:
 			case MsgType::connectionAccepted:
 			case MsgType::connectionMessage:
 			{
 				size_t offset = parser.getCurrentOffset();
 				::globalmq::marshalling::copy<typename ParserT::RiterT, typename ComposerT::BufferType>( msgStartParser.getIterator(), buff, offset );
-				globalmq::marshalling::impl::publishableParseUnsignedInteger<ParserT, uint64_t>( parser, &dummy, "ref_id_at_subscriber" );
+				parseRefId( parser, fixed, &dummy, &dummySlot, "ref_id_at_subscriber" );
 				if ( udata.update_ref_id_at_subscriber )
-					globalmq::marshalling::impl::publishableStructComposeUnsignedInteger( composer, udata.ref_id_at_subscriber, "ref_id_at_subscriber", true );
+					composeRefId( composer, fixed, udata.ref_id_at_subscriber, "ref_id_at_subscriber", true );
 				else
-					globalmq::marshalling::impl::publishableStructComposeUnsignedInteger( composer, dummy, "ref_id_at_subscriber", true );
-				globalmq::marshalling::impl::publishableParseUnsignedInteger<ParserT, uint64_t>( parser, &dummy, "ref_id_at_publisher" );
+					composeRefId( composer, fixed, dummy, "ref_id_at_subscriber", true );
+				parseRefId( parser, fixed, &dummy, &dummySlot, "ref_id_at_publisher" );
 				if ( udata.update_ref_id_at_publisher )
-					globalmq::marshalling::impl::publishableStructComposeUnsignedInteger( composer, udata.ref_id_at_publisher, "ref_id_at_publisher", false );
+					composeRefId( composer, fixed, udata.ref_id_at_publisher, "ref_id_at_publisher", false );
 				else
-					globalmq::marshalling::impl::publishableStructComposeUnsignedInteger( composer, dummy, "ref_id_at_publisher", false );
+					composeRefId( composer, fixed, dummy, "ref_id_at_publisher", false );
 				break;
 			}
 			default:
@@ -298,14 +431,20 @@ struct PublishableStateMessageHeader
 		parser.namedParamBegin("msg_type");
 		uint64_t msgType = parser.parseUnsignedInteger();
 		parser.nextElement();
+		bool fixed = ( msgType & fixedRefIdSlotsFlag ) != 0;
+		bool versioned = ( msgType & stateVersionFlag ) != 0;
+		applyStringEncoding( parser, ( msgType & lengthPrefixedStringsFlag ) != 0 );
+		msgType &= ~flags;
 
 		uint64_t dummy;
+		size_t dummySlot;
 		GMQ_COLL string dummyStr;
 		switch ( msgType )
 		{
 			case MsgType::subscriptionRequest:
 			case MsgType::subscriptionResponse:
 			case MsgType::stateUpdate:
+			case MsgType::resyncResponse:
 				parser.namedParamBegin("state_type_id");
 				dummy = parser.parseUnsignedInteger();
 				parser.nextElement();
@@ -326,6 +465,15 @@ struct PublishableStateMessageHeader
 		dummy = parser.parseUnsignedInteger();
 		parser.nextElement();
 		// globalmq::marshalling::impl::publishableParseUnsignedInteger<ParserT, uint64_t>( parser, &dummy, "priority" );
+		if ( versioned )
+		{
+			parser.namedParamBegin("state_version");
+			dummy = parser.parseUnsignedInteger();
+			parser.nextElement();
+			parser.namedParamBegin("state_epoch");
+			dummy = parser.parseUnsignedInteger();
+			parser.nextElement();
+		}
 		switch ( msgType )
 		{
 			case MsgType::subscriptionRequest:
@@ -344,20 +492,21 @@ struct PublishableStateMessageHeader
 
 
 				parser.namedParamBegin("ref_id_at_subscriber");
-				dummy = parser.parseUnsignedInteger();
+				dummy = parseRefId2( parser, fixed, &dummySlot );
 
 				// globalmq::marshalling::impl::publishableParseUnsignedInteger<ParserT, uint64_t>( parser, &dummy, "ref_id_at_subscriber" );
 				composer.namedParamBegin("ref_id_at_subscriber");
 				if ( udata.update_ref_id_at_subscriber )
-					composer.composeUnsignedInteger(udata.ref_id_at_subscriber);
+					composeRefId2( composer, fixed, udata.ref_id_at_subscriber );
 					// globalmq::marshalling::impl::publishableStructComposeUnsignedInteger( composer, udata.ref_id_at_subscriber, "ref_id_at_subscriber", false );
 				else
-					composer.composeUnsignedInteger(dummy);
+					composeRefId2( composer, fixed, dummy );
 					// globalmq::marshalling::impl::publishableStructComposeUnsignedInteger( composer, dummy, "ref_id_at_subscriber", false );
 				break;
 			}
 			case MsgType::subscriptionResponse:
 			case MsgType::stateUpdate:
+			case MsgType::resyncResponse:
 			case MsgType::connectionAccepted:
 			case MsgType::connectionMessage:
 			{
@@ -367,29 +516,29 @@ struct PublishableStateMessageHeader
 				
 				// globalmq::marshalling::impl::publishableParseUnsignedInteger<ParserT, uint64_t>( parser, &dummy, "ref_id_at_subscriber" );
 				parser.namedParamBegin("ref_id_at_subscriber");
-				dummy = parser.parseUnsignedInteger();
+				dummy = parseRefId2( parser, fixed, &dummySlot );
 				parser.nextElement();
 
 				composer.namedParamBegin("ref_id_at_subscriber");
 				if ( udata.update_ref_id_at_subscriber )
-					composer.composeUnsignedInteger(udata.ref_id_at_subscriber);
+					composeRefId2( composer, fixed, udata.ref_id_at_subscriber );
 					// globalmq::marshalling::impl::publishableStructComposeUnsignedInteger( composer, udata.ref_id_at_subscriber, "ref_id_at_subscriber", true );
 				else
-					composer.composeUnsignedInteger(dummy);
+					composeRefId2( composer, fixed, dummy );
 					// globalmq::marshalling::impl::publishableStructComposeUnsignedInteger( composer, dummy, "ref_id_at_subscriber", true );
 
 				composer.nextElement();
 
 				parser.namedParamBegin("ref_id_at_publisher");
-				dummy = parser.parseUnsignedInteger();
+				dummy = parseRefId2( parser, fixed, &dummySlot );
 				// globalmq::marshalling::impl::publishableParseUnsignedInteger<ParserT, uint64_t>( parser, &dummy, "ref_id_at_publisher" );
 
 				composer.namedParamBegin("ref_id_at_publisher");
 				if ( udata.update_ref_id_at_publisher )
-					composer.composeUnsignedInteger(udata.ref_id_at_publisher);
+					composeRefId2( composer, fixed, udata.ref_id_at_publisher );
 					// globalmq::marshalling::impl::publishableStructComposeUnsignedInteger( composer, udata.ref_id_at_publisher, "ref_id_at_publisher", false );
 				else
-					composer.composeUnsignedInteger(dummy);
+					composeRefId2( composer, fixed, dummy );
 					// globalmq::marshalling::impl::publishableStructComposeUnsignedInteger( composer, dummy, "ref_id_at_publisher", false );
 				break;
 			}
@@ -406,39 +555,47 @@ struct PublishableStateMessageHeader
 	void compose(ComposerT& composer, bool addSeparator) const
 	{
 		globalmq::marshalling::impl::composePublishableStructBegin( composer, "hdr" );
-		globalmq::marshalling::impl::publishableStructComposeUnsignedInteger( composer, (uint32_t)(type), "msg_type", true );
+		globalmq::marshalling::impl::publishableStructComposeUnsignedInteger( composer, msgTypeToCompose<ComposerT>(), globalmq::marshalling::impl::JsonKeyForComposing( "msg_type", "\"msg_type\":" ), true );
+		applyStringEncoding( composer, lengthPrefixedStrings );
 		switch ( type )
 		{
 			case MsgType::subscriptionRequest:
 			case MsgType::subscriptionResponse:
 			case MsgType::stateUpdate:
-				globalmq::marshalling::impl::publishableStructComposeUnsignedInteger( composer, state_type_id_or_direction, "state_type_id", true );
+			case MsgType::resyncResponse:
+				globalmq::marshalling::impl::publishableStructComposeUnsignedInteger( composer, state_type_id_or_direction, globalmq::marshalling::impl::JsonKeyForComposing( "state_type_id", "\"state_type_id\":" ), true );
 				break;
 			case MsgType::connectionRequest:
 			case MsgType::connectionAccepted:
 			case MsgType::connectionMessage:
-				globalmq::marshalling::impl::publishableStructComposeUnsignedInteger( composer, state_type_id_or_direction, "direction", true );
+				globalmq::marshalling::impl::publishableStructComposeUnsignedInteger( composer, state_type_id_or_direction, globalmq::marshalling::impl::JsonKeyForComposing( "direction", "\"direction\":" ), true );
 				break;
 			default:
 				throw std::exception(); // TODO: ... (unknown msg type)
 		}
-		globalmq::marshalling::impl::publishableStructComposeUnsignedInteger( composer, priority, "priority", true );
+		globalmq::marshalling::impl::publishableStructComposeUnsignedInteger( composer, priority, globalmq::marshalling::impl::JsonKeyForComposing( "priority", "\"priority\":" ), true );
+		if ( hasStateVersion )
+		{
+			globalmq::marshalling::impl::publishableStructComposeUnsignedInteger( composer, state_version, globalmq::marshalling::impl::JsonKeyForComposing( "state_version", "\"state_version\":" ), true );
+			globalmq::marshalling::impl::publishableStructComposeUnsignedInteger( composer, state_epoch, globalmq::marshalling::impl::JsonKeyForComposing( "state_epoch", "\"state_epoch\":" ), true );
+		}
 		switch ( type )
 		{
 			case MsgType::subscriptionRequest:
 			case MsgType::connectionRequest:
 			{
-				globalmq::marshalling::impl::publishableStructComposeString( composer, path, "path", true );
-				globalmq::marshalling::impl::publishableStructComposeUnsignedInteger( composer, ref_id_at_subscriber, "ref_id_at_subscriber", false );
+				globalmq::marshalling::impl::publishableStructComposeString( composer, path, globalmq::marshalling::impl::JsonKeyForComposing( "path", "\"path\":" ), true );
+				composeRefId( composer, fixedRefIdSlots, ref_id_at_subscriber, "ref_id_at_subscriber", false );
 				break;
 			}
 			case MsgType::subscriptionResponse:
 			case MsgType::stateUpdate:
+			case MsgType::resyncResponse:
 			case MsgType::connectionAccepted:
 			case MsgType::connectionMessage:
 			{
-				globalmq::marshalling::impl::publishableStructComposeUnsignedInteger( composer, ref_id_at_subscriber, "ref_id_at_subscriber", true );
-				globalmq::marshalling::impl::publishableStructComposeUnsignedInteger( composer, ref_id_at_publisher, "ref_id_at_publisher", false );
+				composeRefId( composer, fixedRefIdSlots, ref_id_at_subscriber, "ref_id_at_subscriber", true );
+				composeRefId( composer, fixedRefIdSlots, ref_id_at_publisher, "ref_id_at_publisher", false );
 				break;
 			}
 			default:
@@ -452,13 +609,15 @@ struct PublishableStateMessageHeader
 	{
 		composer.structBegin();
 		composer.namedParamBegin("msg_type");
-		composer.composeUnsignedInteger((uint32_t)(type));
+		composer.composeUnsignedInteger(msgTypeToCompose<ComposerT>());
 		composer.nextElement();
+		applyStringEncoding( composer, lengthPrefixedStrings );
 		switch ( type )
 		{
 			case MsgType::subscriptionRequest:
 			case MsgType::subscriptionResponse:
 			case MsgType::stateUpdate:
+			case MsgType::resyncResponse:
 				composer.namedParamBegin("state_type_id");
 				composer.composeUnsignedInteger(state_type_id_or_direction);
 				composer.nextElement();
@@ -477,6 +636,15 @@ struct PublishableStateMessageHeader
 		composer.namedParamBegin("priority");
 		composer.composeUnsignedInteger(priority);
 		composer.nextElement();
+		if ( hasStateVersion )
+		{
+			composer.namedParamBegin("state_version");
+			composer.composeUnsignedInteger(state_version);
+			composer.nextElement();
+			composer.namedParamBegin("state_epoch");
+			composer.composeUnsignedInteger(state_epoch);
+			composer.nextElement();
+		}
 
 		switch ( type )
 		{
@@ -486,17 +654,18 @@ struct PublishableStateMessageHeader
 				composer.composeString(path);
 				composer.nextElement();
 				composer.namedParamBegin("ref_id_at_subscriber");
-				composer.composeUnsignedInteger(ref_id_at_subscriber);
+				composeRefId2( composer, fixedRefIdSlots, ref_id_at_subscriber );
 				break;
 			case MsgType::subscriptionResponse:
 			case MsgType::stateUpdate:
+			case MsgType::resyncResponse:
 			case MsgType::connectionAccepted:
 			case MsgType::connectionMessage:
 				composer.namedParamBegin("ref_id_at_subscriber");
-				composer.composeUnsignedInteger(ref_id_at_subscriber);
+				composeRefId2( composer, fixedRefIdSlots, ref_id_at_subscriber );
 				composer.nextElement();
 				composer.namedParamBegin("ref_id_at_publisher");
-				composer.composeUnsignedInteger(ref_id_at_publisher);
+				composeRefId2( composer, fixedRefIdSlots, ref_id_at_publisher );
 				break;
 			default:
 				throw std::exception(); // TODO: ... (unknown msg type)
@@ -505,6 +674,26 @@ struct PublishableStateMessageHeader
 	}
 };
 
+// header of a message as already parsed (or just composed), along with the offset in the message buffer where the rest of the message starts;
+// passed along with the message to let next hops skip parsing header again
+struct ParsedMessageHeader
+{
+	PublishableStateMessageHeader header;
+	size_t bodyOffset = PublishableStateMessageHeader::invalidOffset;
+
+	bool isValid() const { return bodyOffset != PublishableStateMessageHeader::invalidOffset; }
+
+	static ParsedMessageHeader composed( const PublishableStateMessageHeader& header, size_t bodyOffset ) // header as composed into a message buffer; bodyOffset is buffer size right after that
+	{
+		ParsedMessageHeader ret;
+		ret.header = header;
+		ret.header.ref_id_at_subscriber_slot = PublishableStateMessageHeader::invalidOffset; // not known unless parsed
+		ret.header.ref_id_at_publisher_slot = PublishableStateMessageHeader::invalidOffset;
+		ret.bodyOffset = bodyOffset;
+		return ret;
+	}
+};
+
 template<class ComposerT>
 void helperComposePublishableStateMessageBegin(ComposerT& composer, const PublishableStateMessageHeader& header)
 {
@@ -574,6 +763,17 @@ void helperParsePublishableStateMessageEnd(ParserT& parser)
 		parser.stateSyncEnd();
 }
 
+template<class ParserT>
+void helperSkipPublishableStateMessageData(ParserT& parser) // data part of a message that is dropped unapplied; leaves parser where helperParsePublishableStateMessageEnd() expects it
+{
+	if constexpr ( ParserT::proto == Proto::JSON )
+		parser.skipMessageFromJson();
+	else if constexpr ( ParserT::proto == Proto::GMQ )
+		; // data part is the last one in a message, so there is nothing to skip to get to its end
+	else
+		parser.skipStateUpdate();
+}
+
 template<class ParserT, class ComposerT>
 void helperParseAndUpdatePublishableStateMessage( typename ParserT::BufferType& buffFrom, typename ComposerT::BufferType& buffTo, const PublishableStateMessageHeader::UpdatedData& udata )
 {
@@ -600,6 +800,226 @@ void helperParseAndUpdatePublishableStateMessage( typename ParserT::BufferType&
 	}
 }
 
+template<class ComposerT>
+void helperPatchPublishableStateMessageRefId( typename ComposerT::BufferType& buff, size_t slot, uint64_t val )
+{
+	if ( slot == PublishableStateMessageHeader::invalidOffset )
+		throw std::exception(); // TODO: ... (no such slot in this message type)
+	if constexpr ( ComposerT::proto == Proto::GMQ || ComposerT::proto == Proto::JSON )
+	{
+		GMQ_ASSERT( slot + ( ComposerT::proto == Proto::GMQ ? impl::fixed_width_uinteger_size : impl::json::fixed_width_uinteger_size ) <= buff.size() );
+		globalmq::marshalling::impl::publishablePatchFixedWidthUnsignedInteger<ComposerT>( buff.begin() + slot, val );
+	}
+	else
+	{
+		GMQ_ASSERT( slot + ComposerT::fixedWidthUnsignedIntegerSize <= buff.size() );
+		ComposerT::patchFixedWidthUnsignedInteger( buff.begin() + slot, val );
+	}
+}
+
+template<class ComposerT>
+void helperPatchPublishableStateMessageRefIds( typename ComposerT::BufferType& buff, const PublishableStateMessageHeader& header, const PublishableStateMessageHeader::UpdatedData& udata ) // header is as parsed from buff
+{
+	assert( header.fixedRefIdSlots );
+	if ( udata.update_ref_id_at_subscriber )
+		helperPatchPublishableStateMessageRefId<ComposerT>( buff, header.ref_id_at_subscriber_slot, udata.ref_id_at_subscriber );
+	if ( udata.update_ref_id_at_publisher )
+		helperPatchPublishableStateMessageRefId<ComposerT>( buff, header.ref_id_at_publisher_slot, udata.ref_id_at_publisher );
+}
+
+// retargets a message: in place, if its header has (known) fixed-width ref id slots, or by composing updated header followed by the rest of the message otherwise;
+// on input 'parsed' describes msg, on output - the returned message
+template<class ParserT, class ComposerT>
+typename ComposerT::BufferType helperUpdatePublishableStateMessage( typename ParserT::BufferType&& msg, ParsedMessageHeader& parsed, const PublishableStateMessageHeader::UpdatedData& udata )
+{
+	GMQ_ASSERT( parsed.isValid() );
+	PublishableStateMessageHeader& header = parsed.header;
+	if ( udata.update_ref_id_at_subscriber )
+		header.ref_id_at_subscriber = udata.ref_id_at_subscriber;
+	if ( udata.update_ref_id_at_publisher )
+		header.ref_id_at_publisher = udata.ref_id_at_publisher;
+
+	if constexpr ( std::is_same<typename ParserT::BufferType, typename ComposerT::BufferType>::value )
+	{
+		if ( header.fixedRefIdSlots &&
+			( !udata.update_ref_id_at_subscriber || header.ref_id_at_subscriber_slot != PublishableStateMessageHeader::invalidOffset ) &&
+			( !udata.update_ref_id_at_publisher || header.ref_id_at_publisher_slot != PublishableStateMessageHeader::invalidOffset ) )
+		{
+			helperPatchPublishableStateMessageRefIds<ComposerT>( msg, header, udata );
+			return std::move( msg );
+		}
+	}
+	typename ComposerT::BufferType msgForward;
+	ComposerT composer( msgForward );
+	helperComposePublishableStateMessageBegin( composer, header );
+	size_t bodyOffset = msgForward.size();
+	GMQ_ASSERT( parsed.bodyOffset <= msg.size() );
+	msgForward.append( msg.begin() + parsed.bodyOffset, msg.size() - parsed.bodyOffset );
+	parsed = ParsedMessageHeader::composed( header, bodyOffset );
+	return msgForward;
+}
+
+// Immutable reference-counted message body (everything that follows the header up to the end of the message).
+// Fan-out paths compose or receive the body once and share it among all recipients; only the header,
+// which differs by ref ids, is composed per recipient.
+template<class BufferT>
+class SharedMessageBodyT
+{
+	std::shared_ptr<const BufferT> buff;
+	size_t offset = 0;
+	void (*composeHeader)( BufferT&, const PublishableStateMessageHeader& ) = nullptr;
+
+	template<class ComposerT>
+	static void composeHeaderWith( BufferT& out, const PublishableStateMessageHeader& header )
+	{
+		ComposerT composer( out );
+		helperComposePublishableStateMessageBegin( composer, header );
+	}
+
+public:
+	SharedMessageBodyT() {}
+
+	// body is [offset_, buff_.size()) of buff_, and must include message end (see helperComposePublishableStateMessageEnd())
+	template<class ComposerT>
+	static SharedMessageBodyT make( BufferT&& buff_, size_t offset_ )
+	{
+		static_assert( std::is_same<typename ComposerT::BufferType, BufferT>::value );
+		GMQ_ASSERT( offset_ <= buff_.size() );
+		SharedMessageBodyT ret;
+		ret.buff = std::make_shared<const BufferT>( std::move( buff_ ) );
+		ret.offset = offset_;
+		ret.composeHeader = &composeHeaderWith<ComposerT>;
+		return ret;
+	}
+
+	bool isValid() const { return buff != nullptr; }
+	const uint8_t* begin() const { GMQ_ASSERT( isValid() ); return buff->begin() + offset; }
+	size_t size() const { GMQ_ASSERT( isValid() ); return buff->size() - offset; }
+	typename BufferT::ReadIteratorT getReadIter() const // positioned at the body, for parsing it in place
+	{
+		GMQ_ASSERT( isValid() );
+		typename BufferT::ReadIteratorT riter( *buff );
+		riter.skip( offset );
+		return riter;
+	}
+
+	size_t materialize( const PublishableStateMessageHeader& header, BufferT& out ) const // returns offset of body in out
+	{
+		GMQ_ASSERT( isValid() );
+		composeHeader( out, header );
+		size_t bodyOffset = out.size();
+		out.append( begin(), size() );
+		return bodyOffset;
+	}
+	BufferT materialize( const PublishableStateMessageHeader& header ) const
+	{
+		BufferT out;
+		materialize( header, out );
+		return out;
+	}
+};
+
+using SharedMessageBody = SharedMessageBodyT<MessageBufferT>;
+
+// Bounded log of the latest updates of a publishable state (kept by its publisher, or by a concentrator on the way to subscribers).
+// Update of version v brings the state from version v-1 to v. A subscriber that comes back with a version it already has gets just the updates
+// it has missed (see PublishableStateMessageHeader::MsgType::resyncResponse), as long as they are all still in the log; otherwise, a state sync.
+// Versions are counted per publisher instance, which is identified by epoch (see PublishableStateMessageHeader::state_epoch).
+template<class BufferT>
+class StateUpdateLogT
+{
+public:
+	struct Entry
+	{
+		SharedMessageBodyT<BufferT> body;
+		bool lengthPrefixedStrings = false; // string encoding of body; header of a re-sent update must have the same
+	};
+
+private:
+	GMQ_COLL vector<Entry> ring; // update of version v is at [v % ring.size()]
+	uint64_t currentEpoch = 0;
+	uint64_t lastVersion = 0;
+	uint64_t count = 0; // updates in ring, that is, versions (lastVersion - count, lastVersion]
+
+public:
+	// epoch of a new publisher instance; random, so that a version a subscriber has from another instance (say, from this publisher
+	// before restart) is never taken for a version of this one
+	static uint64_t newEpoch()
+	{
+		std::random_device rd;
+		uint64_t ret = ( (uint64_t)( rd() ) << 32 ) ^ rd();
+		return ret ^ (uint64_t)( std::chrono::steady_clock::now().time_since_epoch().count() ); // in case random_device is deterministic
+	}
+
+	void setDepth( size_t depth ) { ring.clear(); ring.resize( depth ); count = 0; }
+	bool isEnabled() const { return !ring.empty(); }
+	uint64_t epoch() const { return currentEpoch; }
+	uint64_t version() const { return lastVersion; }
+
+	void reset( uint64_t epoch, uint64_t version ) // state is now at version, with no updates to it known
+	{
+		for ( auto& entry : ring )
+			entry = Entry();
+		currentEpoch = epoch;
+		lastVersion = version;
+		count = 0;
+	}
+	void add( uint64_t epoch, uint64_t version, const SharedMessageBodyT<BufferT>& body, bool lengthPrefixedStrings )
+	{
+		if ( !isEnabled() ) // just follows the version
+		{
+			currentEpoch = epoch;
+			lastVersion = version;
+			return;
+		}
+		if ( epoch != currentEpoch || version != lastVersion + 1 ) // updates are missing (say, a concentrator has got a new state sync); older ones are of no use
+			reset( epoch, version - 1 );
+		Entry& entry = ring[version % ring.size()];
+		entry.body = body;
+		entry.lengthPrefixedStrings = lengthPrefixedStrings;
+		lastVersion = version;
+		if ( count < ring.size() )
+			++count;
+	}
+	bool covers( uint64_t knownEpoch, uint64_t knownVersion ) const { return isEnabled() && knownEpoch == currentEpoch && knownVersion <= lastVersion && lastVersion - knownVersion <= count; } // all updates since knownVersion are in the log
+	GMQ_COLL vector<Entry> since( uint64_t knownVersion ) const // updates of versions knownVersion + 1, ..., version(); see covers()
+	{
+		GMQ_ASSERT( knownVersion <= lastVersion && lastVersion - knownVersion <= count );
+		GMQ_COLL vector<Entry> ret;
+		ret.reserve( lastVersion - knownVersion );
+		for ( uint64_t v = knownVersion + 1; v <= lastVersion; ++v )
+			ret.push_back( ring[v % ring.size()] );
+		return ret;
+	}
+};
+
+// answers a subscriptionRequest with a state version covered by an update log (see StateUpdateLogT::since()): resyncResponse with a current version,
+// followed by missed updates as regular (and, this way, uniformly processed) stateUpdate messages; hdr: ref ids and priority of subscription response
+template<class ComposerT, class PostmanT>
+void helperPostStateResync( PostmanT& postman, const PublishableStateMessageHeader& hdr, uint64_t epoch, uint64_t knownVersion, const GMQ_COLL vector<typename StateUpdateLogT<typename ComposerT::BufferType>::Entry>& missed )
+{
+	using BufferT = typename ComposerT::BufferType;
+	PublishableStateMessageHeader hdrBack = hdr;
+	hdrBack.type = PublishableStateMessageHeader::MsgType::resyncResponse;
+	hdrBack.hasStateVersion = true;
+	hdrBack.state_epoch = epoch;
+	hdrBack.state_version = knownVersion + missed.size();
+	hdrBack.lengthPrefixedStrings = false; // nothing to encode
+	BufferT buff;
+	ComposerT composer( buff );
+	helperComposePublishableStateMessageBegin( composer, hdrBack );
+	helperComposePublishableStateMessageEnd( composer );
+	postman.postMessage( std::move( buff ) );
+
+	hdrBack.type = PublishableStateMessageHeader::MsgType::stateUpdate;
+	for ( size_t i=0; i<missed.size(); ++i )
+	{
+		hdrBack.state_version = knownVersion + 1 + i;
+		hdrBack.lengthPrefixedStrings = missed[i].lengthPrefixedStrings;
+		postman.postSharedMessage( hdrBack, missed[i].body );
+	}
+}
+
 template<class StringT>
 struct GmqPathHelperT
 {
@@ -797,6 +1217,15 @@ class InProcessMessagePostmanBase
 public:
 	InProcessMessagePostmanBase() {};
 	virtual void postMessage( MessageBufferT&& ) = 0;
+	// header of the message is already known; postmen that can pass it along to recipient (see ThreadQueueItem) may override this
+	virtual void postParsedMessage( MessageBufferT&& msg, const ParsedMessageHeader& ) { postMessage( std::move( msg ) ); }
+	// fan-out: 'body' is shared by all recipients; postmen that can pass it by reference override this (see ThreadQueuePostman),
+	// others get here, at the boundary where the message has to become a whole buffer, and the body is copied
+	virtual void postSharedMessage( const PublishableStateMessageHeader& header, const SharedMessageBody& body ) {
+		MessageBufferT msg;
+		size_t bodyOffset = body.materialize( header, msg );
+		postParsedMessage( std::move( msg ), ParsedMessageHeader::composed( header, bodyOffset ) );
+	}
 	virtual ~InProcessMessagePostmanBase() {}
 };
 
@@ -854,7 +1283,7 @@ struct StringSelector<std::allocator>
 template<template<typename> typename AllocatorT = std::allocator>
 class AddressableLocations // one per process; provides process-unique Slot with Postman and returns its SlotIdx
 {
-	std::vector<AddressableLocation, typename AllocatorSelector<AddressableLocation, AllocatorT>::AllocatorT> slots; // mx-protected!
+	std::vector<AddressableLocation, typename AllocatorSelector<AddressableLocation, AllocatorT>::AllocatorT> slots; // mxLocations-protected!
 public:
 	SlotIdx add( InProcessMessagePostmanBase* postman )
 	{ 
@@ -906,14 +1335,18 @@ class GMQueue
 		return authority == myAuthority || authority.empty();
 	}
 
-	class ConcentratorWrapper
+	class ConcentratorWrapper // its state (but address and idInQueue, which are immutable after creation) is mx-protected
 	{
 		friend class GMQueue<PlatformSupportT>;
 
+		std::mutex mx;
 		StateConcentratorBase<InputBufferT, ComposerT>* ptr = nullptr;
 		bool subscriptionResponseReceived = false;
 		static constexpr uint64_t invalidValue = 0xFFFFFFFFFFFFFFFFULL;
 		uint64_t idAtPublisher = invalidValue; // one for all subscriber using this concentrator
+		SharedMessageBody stateSyncSnapshot; // state sync for new subscribers; composed on demand, dropped by any change of the state
+		bool stateVersioned = false; // whether publisher tags the state with versions; if so, the current one is updateLog.version()
+		StateUpdateLogT<MessageBufferT> updateLog; // latest updates from publisher, for subscribers that come back (see GMQueue::setUpdateLogDepth())
 
 	public:
 		struct SubscriberData
@@ -921,8 +1354,24 @@ class GMQueue
 			uint64_t ref_id_at_subscriber = invalidValue;
 			uint64_t ref_id_at_publisher = invalidValue;
 			SlotIdx senderSlotIdx;
+			bool pending = false; // its state sync (or resync) is being posted (unlocked); messages for subscribers are held for it meanwhile (see GMQueue::postPendingMessages())
+		};
+		using SubscribersT = std::vector<SubscriberData, typename AllocatorSelector<SubscriberData, AllocatorT>::AllocatorT>;
+		// copy-on-write: message forwarding takes a snapshot under mx and iterates it unlocked, while (rare) adding a subscriber replaces the whole list
+		std::shared_ptr<const SubscribersT> subscribers = std::allocate_shared<const SubscribersT>( typename AllocatorSelector<SubscribersT, AllocatorT>::AllocatorT() );
+
+		struct PendingMessage
+		{
+			PublishableStateMessageHeader mh; // as received from publisher
+			SharedMessageBody body;
 		};
-		std::vector<SubscriberData, typename AllocatorSelector<SubscriberData, AllocatorT>::AllocatorT> subscribers;
+		using PendingMessagesT = std::vector<PendingMessage, typename AllocatorSelector<PendingMessage, AllocatorT>::AllocatorT>;
+		struct PendingSubscriber
+		{
+			uint64_t ref_id_at_publisher = invalidValue;
+			PendingMessagesT messages;
+		};
+		std::vector<PendingSubscriber, typename AllocatorSelector<PendingSubscriber, AllocatorT>::AllocatorT> pendingSubscribers; // those with pending flag set; usually none
 
 	public:
 		ConcentratorWrapper( StateConcentratorBase<InputBufferT, ComposerT>* ptr_ ) : ptr( ptr_ ) {}
@@ -939,8 +1388,43 @@ class GMQueue
 	public:
 		uint64_t addSubscriber( SubscriberData sd )
 		{
-			subscribers.push_back( sd );
-			return subscribers.size() - 1;
+			SubscribersT updated( *subscribers );
+			updated.push_back( sd );
+			subscribers = std::allocate_shared<const SubscribersT>( typename AllocatorSelector<SubscribersT, AllocatorT>::AllocatorT(), std::move( updated ) );
+			if ( sd.pending )
+			{
+				PendingSubscriber ps;
+				ps.ref_id_at_publisher = sd.ref_id_at_publisher;
+				pendingSubscribers.push_back( std::move( ps ) );
+			}
+			return subscribers->size() - 1;
+		}
+
+		void holdForPendingSubscribers( const PublishableStateMessageHeader& mh, const SharedMessageBody& body ) // message is being forwarded to other subscribers
+		{
+			for ( auto& ps : pendingSubscribers )
+				ps.messages.push_back( PendingMessage{ mh, body } );
+		}
+
+		// moves messages held for a pending subscriber to 'messages'; if there are none, subscriber is no longer pending, and false is returned
+		bool takePendingMessages( uint64_t ref_id_at_publisher, PendingMessagesT& messages )
+		{
+			auto ps = pendingSubscribers.begin();
+			while ( ps != pendingSubscribers.end() && ps->ref_id_at_publisher != ref_id_at_publisher )
+				++ps;
+			assert( ps != pendingSubscribers.end() );
+			if ( ps->messages.size() != 0 )
+			{
+				messages.swap( ps->messages );
+				return true;
+			}
+			pendingSubscribers.erase( ps );
+			SubscribersT updated( *subscribers );
+			for ( auto& sd : updated )
+				if ( sd.ref_id_at_publisher == ref_id_at_publisher )
+					sd.pending = false;
+			subscribers = std::allocate_shared<const SubscribersT>( typename AllocatorSelector<SubscribersT, AllocatorT>::AllocatorT(), std::move( updated ) );
+			return false;
 		}
 
 		bool isSsubscriptionResponseReceived() { return subscriptionResponseReceived; }
@@ -956,10 +1440,23 @@ class GMQueue
 				ptr->publishableGenerateStateSync( composer );
 		}
 
-		void onSubscriptionResponseMessage( ParserT& parser, uint64_t idAtPublisher_ ) 
+		const SharedMessageBody& getStateSyncBody() // subscription response body; shared by all subscribers that come while the state stays the same
+		{
+			if ( !stateSyncSnapshot.isValid() )
+			{
+				typename ComposerT::BufferType buff;
+				ComposerT composer( buff );
+				generateStateSyncMessage( composer );
+				helperComposePublishableStateMessageEnd( composer );
+				stateSyncSnapshot = SharedMessageBody::make<ComposerT>( std::move( buff ), 0 );
+			}
+			return stateSyncSnapshot;
+		}
+
+		void onSubscriptionResponseMessage( ParserT& parser, const PublishableStateMessageHeader& mh ) 
 		{
 			assert( ptr != nullptr );
-			assert( subscribers.size() != 0 ); // current implementation does not practically assume removing subscribers 
+			assert( subscribers->size() != 0 ); // current implementation does not practically assume removing subscribers 
 			if constexpr ( ParserT::proto == globalmq::marshalling::Proto::JSON )
 				ptr->applyJsonStateSyncMessage( parser );
 			else if constexpr ( ParserT::proto == globalmq::marshalling::Proto::GMQ )
@@ -967,8 +1464,11 @@ class GMQueue
 			else
 				ptr->publishableApplyStateSync( parser );
 
+			stateSyncSnapshot = SharedMessageBody();
 			subscriptionResponseReceived = true;
-			idAtPublisher = idAtPublisher_;
+			idAtPublisher = mh.ref_id_at_publisher;
+			stateVersioned = mh.hasStateVersion;
+			updateLog.reset( mh.hasStateVersion ? mh.state_epoch : 0, mh.hasStateVersion ? mh.state_version : 0 );
 		}
 
 		void onStateUpdateMessage( ParserT& parser ) 
@@ -980,12 +1480,23 @@ class GMQueue
 				ptr->applyGmqMessageWithUpdates( parser );
 			else
 				ptr->publishableApplyUpdates( parser );
+			stateSyncSnapshot = SharedMessageBody();
+		}
+
+		void logUpdate( const PublishableStateMessageHeader& mh, const SharedMessageBody& body )
+		{
+			stateVersioned = mh.hasStateVersion;
+			if ( stateVersioned )
+				updateLog.add( mh.state_epoch, mh.state_version, body, mh.lengthPrefixedStrings );
 		}
+
+		bool canResync( const PublishableStateMessageHeader& mh ) { return stateVersioned && mh.hasStateVersion && updateLog.covers( mh.state_epoch, mh.state_version ); } // mh: subscription request
 	};
 
-	class Connections
+	class Connections // sharded by connection ID; both IDs of a connection belong to the same shard
 	{
 		static constexpr uint64_t invalidValue = 0xFFFFFFFFFFFFFFFFULL;
+		static constexpr size_t shardCount = 16;
 		struct Connection
 		{
 			enum Status {uninitialized, connRequestSent, connected };
@@ -1003,9 +1514,18 @@ class GMQueue
 			StorableStringT address;
 		};
 
-		std::unordered_map<uint64_t, Connection, std::hash<uint64_t>, std::equal_to<uint64_t>, typename AllocatorSelector<std::pair<const uint64_t, Connection>, AllocatorT>::AllocatorT> idToConnectionStorage; // used as storage, mx-protected
-		std::unordered_map<uint64_t, Connection*, std::hash<uint64_t>, std::equal_to<uint64_t>, typename AllocatorSelector<std::pair<const uint64_t, Connection*>, AllocatorT>::AllocatorT> idToConnection; // used for searching, mx-protected
-		uint64_t connectionIDBase = 0;
+		struct alignas(64) Shard
+		{
+			std::mutex mx;
+			std::unordered_map<uint64_t, Connection, std::hash<uint64_t>, std::equal_to<uint64_t>, typename AllocatorSelector<std::pair<const uint64_t, Connection>, AllocatorT>::AllocatorT> idToConnectionStorage; // used as storage, mx-protected
+			std::unordered_map<uint64_t, Connection*, std::hash<uint64_t>, std::equal_to<uint64_t>, typename AllocatorSelector<std::pair<const uint64_t, Connection*>, AllocatorT>::AllocatorT> idToConnection; // used for searching, mx-protected
+			uint64_t connectionIDBase = 0; // mx-protected
+		};
+		Shard shards[shardCount];
+		std::atomic<size_t> nextShard = 0;
+
+		// IDs are issued by shards so that shard of any ID is ID % shardCount
+		uint64_t newConnectionID( size_t shardIdx ) { return ++(shards[shardIdx].connectionIDBase) * shardCount + shardIdx; }
 
 	public:
 		Connections() {}
@@ -1024,16 +1544,19 @@ class GMQueue
 
 		FieldsForSending onConnRequest( uint64_t ref_id_at_conn_initiator, SlotIdx initiatorSlotIdx, SlotIdx acceptorSlotIdx, StorableStringT address )
 		{
+			size_t shardIdx = nextShard.fetch_add( 1, std::memory_order_relaxed ) % shardCount;
+			Shard& shard = shards[shardIdx];
+			std::unique_lock<std::mutex> lock(shard.mx);
 			Connection conn;
 			conn.status = Connection::Status::connRequestSent;
 			conn.ref_id_at_conn_initiator = ref_id_at_conn_initiator;
 			conn.initiatorSlotIdx = initiatorSlotIdx;
 			conn.acceptorSlotIdx = acceptorSlotIdx;
 			conn.address = address;
-			conn.idInQueueForAcceptor = ++connectionIDBase;
-			auto ins = idToConnectionStorage.insert( std::make_pair( conn.idInQueueForAcceptor, conn ) );
+			conn.idInQueueForAcceptor = newConnectionID( shardIdx );
+			auto ins = shard.idToConnectionStorage.insert( std::make_pair( conn.idInQueueForAcceptor, conn ) );
 			assert( ins.second );
-			auto ins2 = idToConnection.insert( std::make_pair( conn.idInQueueForAcceptor, &(ins.first->second) ) );
+			auto ins2 = shard.idToConnection.insert( std::make_pair( conn.idInQueueForAcceptor, &(ins.first->second) ) );
 			assert( ins2.second );
 			FieldsForSending ffs;
 			ffs.idAtSource = conn.idInQueueForAcceptor;
@@ -1044,8 +1567,11 @@ class GMQueue
 		
 		FieldsForSending onConnAccepted( uint64_t connID, uint64_t ref_id_at_conn_acceptor, SlotIdx acceptorSlotIdx )
 		{
-			auto f = idToConnection.find( connID );
-			if ( f == idToConnection.end() )
+			size_t shardIdx = connID % shardCount;
+			Shard& shard = shards[shardIdx];
+			std::unique_lock<std::mutex> lock(shard.mx);
+			auto f = shard.idToConnection.find( connID );
+			if ( f == shard.idToConnection.end() )
 				throw std::exception();
 			auto& conn = *(f->second);
 			assert( connID == conn.idInQueueForAcceptor ); // self-consistency
@@ -1056,8 +1582,8 @@ class GMQueue
 			if ( conn.acceptorSlotIdx != acceptorSlotIdx )
 				throw std::exception();
 			conn.ref_id_at_conn_acceptor = ref_id_at_conn_acceptor;
-			conn.idInQueueForInitiator = ++connectionIDBase;
-			auto ins = idToConnection.insert( std::make_pair( conn.idInQueueForInitiator, &(*(f->second)) ) );
+			conn.idInQueueForInitiator = newConnectionID( shardIdx );
+			auto ins = shard.idToConnection.insert( std::make_pair( conn.idInQueueForInitiator, &(*(f->second)) ) );
 			assert( ins.second );
 			FieldsForSending ffs;
 			ffs.idAtSource = conn.idInQueueForInitiator;
@@ -1067,8 +1593,10 @@ class GMQueue
 		}
 		FieldsForSending onConnMsg( uint64_t connID, uint64_t refIdAtCaller, SlotIdx callerSlotIdx )
 		{
-			auto f = idToConnection.find( connID );
-			if ( f == idToConnection.end() )
+			Shard& shard = shards[connID % shardCount];
+			std::unique_lock<std::mutex> lock(shard.mx);
+			auto f = shard.idToConnection.find( connID );
+			if ( f == shard.idToConnection.end() )
 				throw std::exception();
 			auto& conn = *(f->second);
 			assert( connID == conn.idInQueueForInitiator || connID == conn.idInQueueForAcceptor );
@@ -1098,34 +1626,45 @@ class GMQueue
 			return ffs;
 		}
 	};
-	Connections connections;
+	Connections connections; // self-synchronized
 
-	std::mutex mx;
+	// Locking: tables below are read on each message and modified rarely; they are split by lock (and each is a reader-writer one),
+	// so that routing of messages of different publishers or connections does not serialize.
+	// Lock order (if ever nested): ConcentratorWrapper::mx -> mxConcentratorSubscriberPairs; other locks are never nested.
+	// No lock is held while calling postmen (which may block on a full queue). Therefore, a new subscriber's state sync (or resync) is posted
+	// after unlocking concentrator's mx; messages forwarded meanwhile are held for this subscriber until then (see postPendingMessages()).
 
+	std::shared_mutex mxLocations; // addressableLocations, namedRecipients, senders, myAuthority
 
-	std::unordered_map<StorableStringT, ConcentratorWrapper, StorableStringHasherT, std::equal_to<StorableStringT>, typename AllocatorSelector<std::pair<const StorableStringT, ConcentratorWrapper>, AllocatorT>::AllocatorT> addressesToStateConcentrators; // address to concentrator mapping, 1 - 1, mx-protected
-	std::unordered_map<uint64_t, ConcentratorWrapper*, std::hash<uint64_t>, std::equal_to<uint64_t>, typename AllocatorSelector<std::pair<const uint64_t, ConcentratorWrapper*>, AllocatorT>::AllocatorT> idToStateConcentrators; // id to concentrator mapping, many - 1, mx-protected
+	std::shared_mutex mxConcentrators; // addressesToStateConcentrators, idToStateConcentrators, stateConcentratorFactory, updateLogDepth
+	std::unordered_map<StorableStringT, ConcentratorWrapper, StorableStringHasherT, std::equal_to<StorableStringT>, typename AllocatorSelector<std::pair<const StorableStringT, ConcentratorWrapper>, AllocatorT>::AllocatorT> addressesToStateConcentrators; // address to concentrator mapping, 1 - 1, mxConcentrators-protected
+	std::unordered_map<uint64_t, ConcentratorWrapper*, std::hash<uint64_t>, std::equal_to<uint64_t>, typename AllocatorSelector<std::pair<const uint64_t, ConcentratorWrapper*>, AllocatorT>::AllocatorT> idToStateConcentrators; // id to concentrator mapping, many - 1, mxConcentrators-protected
 	uint64_t concentratorIDBase = 0;
+	size_t updateLogDepth = 0; // of concentrators' update logs (see setUpdateLogDepth())
 
 //	GMQ_COLL unordered_map<StorableStringT, AddressableLocation> namedRecipients; // node name to location, mx-protected
-	std::unordered_map<StorableStringT, SlotIdx, StorableStringHasherT, std::equal_to<StorableStringT>, typename AllocatorSelector<std::pair<const StorableStringT, SlotIdx>, AllocatorT>::AllocatorT> namedRecipients; // node name to location, mx-protected
+	std::unordered_map<StorableStringT, SlotIdx, StorableStringHasherT, std::equal_to<StorableStringT>, typename AllocatorSelector<std::pair<const StorableStringT, SlotIdx>, AllocatorT>::AllocatorT> namedRecipients; // node name to location, mxLocations-protected
 
-	std::unordered_map<uint64_t, SlotIdx, std::hash<uint64_t>, std::equal_to<uint64_t>, typename AllocatorSelector<std::pair<const uint64_t, SlotIdx>, AllocatorT>::AllocatorT> senders; // node name to location, mx-protected
+	std::unordered_map<uint64_t, SlotIdx, std::hash<uint64_t>, std::equal_to<uint64_t>, typename AllocatorSelector<std::pair<const uint64_t, SlotIdx>, AllocatorT>::AllocatorT> senders; // node name to location, mxLocations-protected
 	uint64_t senderIDBase = 0;
 
-	std::unordered_map<uint64_t, std::pair<uint64_t, uint64_t>, std::hash<uint64_t>, std::equal_to<uint64_t>, typename AllocatorSelector<std::pair<const uint64_t, std::pair<uint64_t, uint64_t>>, AllocatorT>::AllocatorT> ID2ConcentratorSubscriberPairMapping;
-	uint64_t publisherAndItsConcentratorBase = 0;
+	std::mutex mxConcentratorSubscriberPairs;
+	std::unordered_map<uint64_t, std::pair<uint64_t, uint64_t>, std::hash<uint64_t>, std::equal_to<uint64_t>, typename AllocatorSelector<std::pair<const uint64_t, std::pair<uint64_t, uint64_t>>, AllocatorT>::AllocatorT> ID2ConcentratorSubscriberPairMapping; // mxConcentratorSubscriberPairs-protected
+	std::atomic<uint64_t> publisherAndItsConcentratorBase = 0;
 
 	StateConcentratorFactoryBase<InputBufferT, ComposerT>* stateConcentratorFactory = nullptr;
 
 	void addConcentratorSubscriberPair( uint64_t id, uint64_t concentratorID, uint64_t subscriberDataID ) {
+		std::unique_lock<std::mutex> lock(mxConcentratorSubscriberPairs);
 		auto ins = ID2ConcentratorSubscriberPairMapping.insert( std::make_pair( id, std::make_pair( concentratorID, subscriberDataID ) ) );
 		assert( ins.second );
 	}
 	void removeConcentratorSubscriberPair( uint64_t ID ) {
+		std::unique_lock<std::mutex> lock(mxConcentratorSubscriberPairs);
 		ID2ConcentratorSubscriberPairMapping.erase( ID );
 	}
 	std::pair<uint64_t, uint64_t> findConcentratorSubscriberPair( uint64_t ID ) {
+		std::unique_lock<std::mutex> lock(mxConcentratorSubscriberPairs);
 		auto f = ID2ConcentratorSubscriberPairMapping.find( ID );
 		if ( f != ID2ConcentratorSubscriberPairMapping.end() )
 			return f->second;
@@ -1136,7 +1675,14 @@ class GMQueue
 	// concentrators (address2concentrators)
 	std::pair<ConcentratorWrapper*, bool> findOrAddStateConcentrator( StorableStringT path, uint64_t stateTypeID ) {
 		assert( !path.empty() );
-		auto f = addressesToStateConcentrators.find( path );
+		{
+			std::shared_lock<std::shared_mutex> lock(mxConcentrators);
+			auto f = addressesToStateConcentrators.find( path );
+			if ( f != addressesToStateConcentrators.end() )
+				return std::make_pair(&(f->second), true);
+		}
+		std::unique_lock<std::shared_mutex> lock(mxConcentrators);
+		auto f = addressesToStateConcentrators.find( path ); // might be added meanwhile
 		if ( f != addressesToStateConcentrators.end() )
 			return std::make_pair(&(f->second), true);
 		else
@@ -1154,11 +1700,13 @@ class GMQueue
 			assert( ins1.second );
 			c->address = path;
 			c->idInQueue = concentratorID;
+			c->updateLog.setDepth( updateLogDepth );
 			return std::make_pair(c, false);
 		}
 	}
 	ConcentratorWrapper* findStateConcentrator( uint64_t id ) {
 		assert( id != 0 );
+		std::shared_lock<std::shared_mutex> lock(mxConcentrators);
 		auto f = idToStateConcentrators.find( id );
 		if ( f != idToStateConcentrators.end() )
 			return f->second;
@@ -1173,12 +1721,12 @@ class GMQueue
 	}*/
 
 	// named local objects (namedRecipients)
-	void addNamedLocation( StorableStringT name, SlotIdx idx ) {
+	void addNamedLocation( StorableStringT name, SlotIdx idx ) { // under exclusive mxLocations
 		assert( !name.empty() );
 		auto ins = namedRecipients.insert( std::make_pair( name, idx ) );
 		assert( ins.second );
 	}
-	void removeNamedLocation( StorableStringT name ) {
+	void removeNamedLocation( StorableStringT name ) { // under exclusive mxLocations
 		assert( !name.empty() );
 		namedRecipients.erase( name );
 	}
@@ -1186,6 +1734,7 @@ class GMQueue
 	public:
 	SlotIdx locationNameToSlotIdx( StorableStringT name ) {
 		assert( !name.empty() );
+		std::shared_lock<std::shared_mutex> lock(mxLocations);
 		auto f = namedRecipients.find( name );
 		if ( f != namedRecipients.end() )
 			return f->second;
@@ -1194,21 +1743,31 @@ class GMQueue
 	}
 
 	private:
-	uint64_t addSender( SlotIdx idx ) {
+	uint64_t addSender( SlotIdx idx ) { // under exclusive mxLocations
 		uint64_t id = ++senderIDBase;
 		auto ins = senders.insert( std::make_pair( id, idx ) );
 		assert( ins.second );
 		return id;
 	}
-	void removeSender( uint64_t id, SlotIdx idx ) {
+	void removeSender( uint64_t id, SlotIdx idx ) { // under exclusive mxLocations
 		auto f = senders.find( id );
 		assert( f != senders.end() );
 		assert( f->second.idx == idx.idx );
 		assert( f->second.reincarnation == idx.reincarnation );
 		senders.erase( id );
 	}
+	InProcessMessagePostmanBase* getPostman( SlotIdx idx ) {
+		std::shared_lock<std::shared_mutex> lock(mxLocations);
+		return addressableLocations.getPostman( idx ); // NOTE: remains valid after unlocking as long as postmans are not released; rework otherwise
+	}
+	bool isMyAuthorityLocked( const StorableStringT& authority ) {
+		std::shared_lock<std::shared_mutex> lock(mxLocations);
+		return isMyAuthority( authority );
+	}
+
 	public:
 	SlotIdx senderIDToSlotIdx( uint64_t id ) {
+		std::shared_lock<std::shared_mutex> lock(mxLocations);
 		auto f = senders.find( id );
 		if ( f != senders.end() )
 			return f->second;
@@ -1216,6 +1775,44 @@ class GMQueue
 			return SlotIdx();
 	}
 
+	// forwards message to all concentrator's subscribers (but pending ones, see ConcentratorWrapper::holdForPendingSubscribers()); message body is shared, only headers are per subscriber
+	void forwardToSubscribers( const typename ConcentratorWrapper::SubscribersT& subscribers, const PublishableStateMessageHeader& mh, const SharedMessageBody& body )
+	{
+		PublishableStateMessageHeader hdrForward = mh;
+		for ( auto& subscriber : subscribers )
+		{
+			if ( subscriber.pending )
+				continue;
+			hdrForward.ref_id_at_subscriber = subscriber.ref_id_at_subscriber;
+			hdrForward.ref_id_at_publisher = subscriber.ref_id_at_publisher;
+			getPostman( subscriber.senderSlotIdx )->postSharedMessage( hdrForward, body );
+		}
+	}
+
+	// called once state sync of a pending subscriber is posted: posts messages held for it meanwhile, in order, until there are no more;
+	// then, subscriber is no longer pending, and messages from now on are forwarded to it as usual
+	void postPendingMessages( ConcentratorWrapper* concentrator, const typename ConcentratorWrapper::SubscriberData& subscriber )
+	{
+		InProcessMessagePostmanBase* postman = getPostman( subscriber.senderSlotIdx );
+		typename ConcentratorWrapper::PendingMessagesT messages;
+		for ( ;; )
+		{
+			{
+				std::unique_lock<std::mutex> lock(concentrator->mx);
+				if ( !concentrator->takePendingMessages( subscriber.ref_id_at_publisher, messages ) )
+					return;
+			}
+			for ( auto& pm : messages )
+			{
+				PublishableStateMessageHeader hdrForward = pm.mh;
+				hdrForward.ref_id_at_subscriber = subscriber.ref_id_at_subscriber;
+				hdrForward.ref_id_at_publisher = subscriber.ref_id_at_publisher;
+				postman->postSharedMessage( hdrForward, pm.body );
+			}
+			messages.clear();
+		}
+	}
+
 public:
 	GMQueue() {}
 	GMQueue( const GMQueue& ) = delete;
@@ -1224,7 +1821,7 @@ public:
 	GMQueue& operator = ( GMQueue&& ) = delete;
 	~GMQueue()
 	{ 
-		std::unique_lock<std::mutex> lock(mx);
+		std::unique_lock<std::shared_mutex> lock(mxConcentrators);
 
 		if ( stateConcentratorFactory != nullptr )
 			delete stateConcentratorFactory;
@@ -1233,32 +1830,110 @@ public:
 	template<class StateFactoryT>
 	void initStateConcentratorFactory() // Note: potentially, temporary solution
 	{
-		std::unique_lock<std::mutex> lock(mx);
+		std::unique_lock<std::shared_mutex> lock(mxConcentrators);
 
 		assert( stateConcentratorFactory == nullptr ); // must be called just once
 		stateConcentratorFactory = new StateFactoryT;
 	}
+	// concentrators created from now on keep up to depth latest updates of a state, if its publisher tags them with versions
+	// (see StatePublisherPool::setUpdateLogDepth()), to bring subscribers that come back up to date without a state sync
+	void setUpdateLogDepth( size_t depth )
+	{
+		std::unique_lock<std::shared_mutex> lock(mxConcentrators);
+		updateLogDepth = depth;
+	}
 	void setAuthority( StorableStringT authority )
 	{ 
-		std::unique_lock<std::mutex> lock(mx);
+		std::unique_lock<std::shared_mutex> lock(mxLocations);
 
 		assert( myAuthority.empty() ); // set just once
 		myAuthority = authority;
 	}
 	std::pair<bool, StorableStringT> isStateConcentratorFactoryInitialized() // Note: potentially, temporary solution
 	{
-		std::unique_lock<std::mutex> lock(mx);
-		return std::make_pair(stateConcentratorFactory != nullptr, myAuthority);
+		bool initialized;
+		{
+			std::shared_lock<std::shared_mutex> lock(mxConcentrators);
+			initialized = stateConcentratorFactory != nullptr;
+		}
+		std::shared_lock<std::shared_mutex> lock(mxLocations);
+		return std::make_pair(initialized, myAuthority);
 	}
 
 	void postMessage( MessageBufferT&& msg, uint64_t senderID, SlotIdx senderSlotIdx )
 	{
-		PublishableStateMessageHeader mh;
+		ParsedMessageHeader parsed;
 		auto riter = msg.getReadIter();
 		ParserT parser( riter );
-		helperParsePublishableStateMessageBegin( parser, mh );
+		helperParsePublishableStateMessageBegin( parser, parsed.header );
+		parsed.bodyOffset = parser.getCurrentOffset();
+		routeMessage( std::move( msg ), parsed, senderID, senderSlotIdx );
+	}
+
+	// header of the message is already known (for instance, message has just been composed)
+	void postMessage( MessageBufferT&& msg, const ParsedMessageHeader& parsed_, uint64_t senderID, SlotIdx senderSlotIdx )
+	{
+		if ( !parsed_.isValid() )
+		{
+			postMessage( std::move( msg ), senderID, senderSlotIdx );
+			return;
+		}
+		ParsedMessageHeader parsed = parsed_;
+		routeMessage( std::move( msg ), parsed, senderID, senderSlotIdx );
+	}
+
+	// message body is shared with other recipients (see SharedMessageBodyT); subscription responses and state updates are parsed
+	// and forwarded to subscribers in place, with the body passed on by reference
+	void postSharedMessage( const PublishableStateMessageHeader& header, const SharedMessageBody& body, uint64_t senderID, SlotIdx senderSlotIdx )
+	{
+		if ( header.type != PublishableStateMessageHeader::MsgType::subscriptionResponse && header.type != PublishableStateMessageHeader::MsgType::stateUpdate )
+		{
+			MessageBufferT msg;
+			size_t bodyOffset = body.materialize( header, msg );
+			postMessage( std::move( msg ), ParsedMessageHeader::composed( header, bodyOffset ), senderID, senderSlotIdx );
+			return;
+		}
+
+		SlotIdx senderIdx = senderIDToSlotIdx( senderID );
+		assert( senderIdx.idx == senderSlotIdx.idx );
+		assert( senderIdx.reincarnation == senderSlotIdx.reincarnation );
+
+		routeSharedMessage( header, body );
+	}
+
+private:
+	void routeSharedMessage( const PublishableStateMessageHeader& mh, const SharedMessageBody& body ) // subscriptionResponse or stateUpdate
+	{
+		// publisher addresses concentrator by its idInQueue, which was reported to it as ref_id_at_subscriber (ref_id_at_publisher is publisher's own)
+		ConcentratorWrapper* concentrator = findStateConcentrator( mh.ref_id_at_subscriber );
+		if ( concentrator == nullptr )
+			throw std::exception(); // TODO: ?
+
+		auto riter = body.getReadIter();
+		ParserT parser( riter );
+		PublishableStateMessageHeader::applyStringEncoding( parser, mh.lengthPrefixedStrings );
+
+		std::shared_ptr<const typename ConcentratorWrapper::SubscribersT> subscribers;
+		{
+			std::unique_lock<std::mutex> lock(concentrator->mx);
+			if ( mh.type == PublishableStateMessageHeader::MsgType::subscriptionResponse )
+				concentrator->onSubscriptionResponseMessage( parser, mh );
+			else
+			{
+				concentrator->onStateUpdateMessage( parser );
+				concentrator->logUpdate( mh, body );
+			}
+			concentrator->holdForPendingSubscribers( mh, body );
+			subscribers = concentrator->subscribers;
+		}
+
+		forwardToSubscribers( *subscribers, mh, body );
+	}
 
-		std::unique_lock<std::mutex> lock(mx);
+	void routeMessage( MessageBufferT&& msg, ParsedMessageHeader& parsed, uint64_t senderID, SlotIdx senderSlotIdx ) // body, if any, is parsed (or passed on) from parsed.bodyOffset
+	{
+		PublishableStateMessageHeader& mh = parsed.header;
+		size_t bodyOffset = parsed.bodyOffset; // meaningful only for messages with data part
 
 		SlotIdx senderIdx = senderIDToSlotIdx( senderID );
 		assert( senderIdx.idx == senderSlotIdx.idx );
@@ -1275,7 +1950,7 @@ public:
 					throw std::exception(); // TODO: ... (bad path)
 
 				StorableStringT addr = GmqPathHelper4GMQ::localPart( pc );
-				if ( isMyAuthority( pc.authority ) ) // local
+				if ( isMyAuthorityLocked( pc.authority ) ) // local
 				{
 					assert( !pc.nodeName.empty() );
 
@@ -1287,47 +1962,74 @@ public:
 					sd.ref_id_at_subscriber = mh.ref_id_at_subscriber;
 					sd.ref_id_at_publisher = ++publisherAndItsConcentratorBase;
 					sd.senderSlotIdx = senderSlotIdx;
+					std::unique_lock<std::mutex> lock(concentrator->mx);
+					// otherwise, this subscriber will receive subscription response when it comes from publisher (see below)
+					sd.pending = findCr.second && concentrator->isSsubscriptionResponseReceived();
 					uint64_t sid = concentrator->addSubscriber( sd );
 					addConcentratorSubscriberPair( sd.ref_id_at_publisher, sid, concentrator->idInQueue );
 
 					if ( findCr.second )
 					{
-						if ( concentrator->isSsubscriptionResponseReceived() )
+						if ( sd.pending )
 						{
 							PublishableStateMessageHeader hdrBack;
 							hdrBack.type = PublishableStateMessageHeader::MsgType::subscriptionResponse;
+							hdrBack.fixedRefIdSlots = mh.fixedRefIdSlots;
 							hdrBack.priority = mh.priority;
 							hdrBack.ref_id_at_subscriber = mh.ref_id_at_subscriber;
 							hdrBack.ref_id_at_publisher = sd.ref_id_at_publisher;
 
-							typename ComposerT::BufferType msgBack;
-							ComposerT composer( msgBack );
-							helperComposePublishableStateMessageBegin( composer, hdrBack );
-							concentrator->generateStateSyncMessage( composer );
-							helperComposePublishableStateMessageEnd( composer );
-
-							InProcessMessagePostmanBase* postman = addressableLocations.getPostman( senderSlotIdx );
-							lock.unlock(); // NOTE: this is correct as long as postans are not released; rework otherwise
-							postman->postMessage( std::move( msgBack ) );
+							if ( concentrator->canResync( mh ) ) // subscriber is coming back; just updates it has missed
+							{
+								auto missed = concentrator->updateLog.since( mh.state_version ); // a copy (of references to shared bodies): the log moves on once unlocked
+								lock.unlock();
+
+								// as with a state sync below, later updates are held while missed ones are posted
+								helperPostStateResync<ComposerT>( *getPostman( senderSlotIdx ), hdrBack, mh.state_epoch, mh.state_version, missed );
+								postPendingMessages( concentrator, sd );
+								break;
+							}
+
+							hdrBack.hasStateVersion = concentrator->stateVersioned;
+							hdrBack.state_version = concentrator->updateLog.version();
+							hdrBack.state_epoch = concentrator->updateLog.epoch();
+							SharedMessageBody body = concentrator->getStateSyncBody(); // composed once for all subscribers coming in between updates
+							lock.unlock();
+
+							// subscriber is pending: updates forwarded from now on are held, so that they do not overtake its state
+							getPostman( senderSlotIdx )->postSharedMessage( hdrBack, body );
+							postPendingMessages( concentrator, sd );
 						}
 					}
 					else
 					{
+						lock.unlock();
 						// TODO: revise!
 						SlotIdx targetIdx = locationNameToSlotIdx( pc.nodeName );
 						if ( targetIdx.idx == SlotIdx::invalid_idx )
 							throw std::exception(); // TODO: post permanent error message to sender instead or in addition; remove concentrator
 
+						InProcessMessagePostmanBase* postman = getPostman( targetIdx );
+						if ( mh.hasStateVersion ) // a version of this subscriber means nothing to a new concentrator, which needs a state sync anyway
+						{
+							PublishableStateMessageHeader hdrForward = mh;
+							hdrForward.hasStateVersion = false;
+							hdrForward.ref_id_at_subscriber = concentrator->idInQueue;
+							typename ComposerT::BufferType msgForward;
+							ComposerT composer( msgForward );
+							helperComposePublishableStateMessageBegin( composer, hdrForward );
+							helperComposePublishableStateMessageEnd( composer );
+							postman->postMessage( std::move( msgForward ) );
+							break;
+						}
+
 						globalmq::marshalling::PublishableStateMessageHeader::UpdatedData ud;
 						ud.ref_id_at_subscriber = concentrator->idInQueue;
 						ud.update_ref_id_at_subscriber = true;
 
-						typename ComposerT::BufferType msgForward;
-						helperParseAndUpdatePublishableStateMessage<ParserT, ComposerT>( msg, msgForward, ud );
+						typename ComposerT::BufferType msgForward = helperUpdatePublishableStateMessage<ParserT, ComposerT>( std::move( msg ), parsed, ud );
 
-						InProcessMessagePostmanBase* postman = addressableLocations.getPostman( targetIdx );
-						lock.unlock(); // NOTE: this is correct as long as postans are not released; rework otherwise
-						postman->postMessage( std::move( msgForward ) );
+						postman->postParsedMessage( std::move( msgForward ), parsed );
 					}
 				}
 				else
@@ -1337,55 +2039,9 @@ public:
 				break;
 			}
 			case PublishableStateMessageHeader::MsgType::subscriptionResponse:
-			{
-				ConcentratorWrapper* concentrator = findStateConcentrator( mh.ref_id_at_publisher );
-				concentrator->onSubscriptionResponseMessage( parser, mh.ref_id_at_publisher );
-
-				// forward message to all concentrator's subscribers
-				PublishableStateMessageHeader::UpdatedData ud;
-				ud.update_ref_id_at_publisher = true;
-				ud.update_ref_id_at_subscriber = true;
-				for ( auto& subscriber : concentrator->subscribers )
-				{
-					ud.ref_id_at_subscriber = subscriber.ref_id_at_subscriber;
-					ud.ref_id_at_publisher = subscriber.ref_id_at_publisher;
-					typename ComposerT::BufferType msgForward;
-					helperParseAndUpdatePublishableStateMessage<ParserT, ComposerT>( msg, msgForward, ud );
-
-					InProcessMessagePostmanBase* postman = addressableLocations.getPostman( subscriber.senderSlotIdx );
-					lock.unlock(); // NOTE: this is correct as long as postans are not released; rework otherwise
-					postman->postMessage( std::move( msgForward ) );
-					lock.lock();
-				}
-
-				break;
-			}
 			case PublishableStateMessageHeader::MsgType::stateUpdate: // so far we have the same processing
-			{
-				ConcentratorWrapper* concentrator = findStateConcentrator( mh.ref_id_at_publisher );
-				if ( concentrator == nullptr )
-					throw std::exception(); // TODO: ?
-				concentrator->onStateUpdateMessage( parser );
-
-				// forward message to all concentrator's subscribers
-				PublishableStateMessageHeader::UpdatedData ud;
-				ud.update_ref_id_at_publisher = true;
-				ud.update_ref_id_at_subscriber = true;
-				for ( auto& subscriber : concentrator->subscribers )
-				{
-					ud.ref_id_at_subscriber = subscriber.ref_id_at_subscriber;
-					ud.ref_id_at_publisher = subscriber.ref_id_at_publisher;
-					typename ComposerT::BufferType msgForward;
-					helperParseAndUpdatePublishableStateMessage<ParserT, ComposerT>( msg, msgForward, ud );
-
-					InProcessMessagePostmanBase* postman = addressableLocations.getPostman( subscriber.senderSlotIdx );
-					lock.unlock(); // NOTE: this is correct as long as postans are not released; rework otherwise
-					postman->postMessage( std::move( msgForward ) );
-					lock.lock();
-				}
-
+				routeSharedMessage( mh, SharedMessageBody::make<ComposerT>( std::move( msg ), bodyOffset ) );
 				break;
-			}
 			case PublishableStateMessageHeader::MsgType::connectionRequest:
 			{
 				typename GmqPathHelper4GMQ::PathComponents pc;
@@ -1395,7 +2051,7 @@ public:
 					throw std::exception(); // TODO: ... (bad path)
 
 				StorableStringT addr = GmqPathHelper4GMQ::localPart( pc );
-				if ( isMyAuthority( pc.authority ) ) // local
+				if ( isMyAuthorityLocked( pc.authority ) ) // local
 				{
 					assert( !pc.nodeName.empty() );
 
@@ -1408,12 +2064,10 @@ public:
 					ud.ref_id_at_subscriber = fields.idAtSource;
 					ud.update_ref_id_at_subscriber = true;
 
-					typename ComposerT::BufferType msgForward;
-					helperParseAndUpdatePublishableStateMessage<ParserT, ComposerT>( msg, msgForward, ud );
+					typename ComposerT::BufferType msgForward = helperUpdatePublishableStateMessage<ParserT, ComposerT>( std::move( msg ), parsed, ud );
 
-					InProcessMessagePostmanBase* postman = addressableLocations.getPostman( targetIdx );
-					lock.unlock(); // NOTE: this is correct as long as postans are not released; rework otherwise
-					postman->postMessage( std::move( msgForward ) );
+					InProcessMessagePostmanBase* postman = getPostman( targetIdx );
+					postman->postParsedMessage( std::move( msgForward ), parsed );
 				}
 				else
 				{
@@ -1431,12 +2085,10 @@ public:
 				ud.ref_id_at_subscriber = fields.idAtTarget;
 				ud.ref_id_at_publisher = fields.idAtSource;
 
-				typename ComposerT::BufferType msgForward;
-				helperParseAndUpdatePublishableStateMessage<ParserT, ComposerT>( msg, msgForward, ud );
+				typename ComposerT::BufferType msgForward = helperUpdatePublishableStateMessage<ParserT, ComposerT>( std::move( msg ), parsed, ud );
 
-				InProcessMessagePostmanBase* postman = addressableLocations.getPostman( fields.targetSlotIdx );
-				lock.unlock(); // NOTE: this is correct as long as postans are not released; rework otherwise
-				postman->postMessage( std::move( msgForward ) );
+				InProcessMessagePostmanBase* postman = getPostman( fields.targetSlotIdx );
+				postman->postParsedMessage( std::move( msgForward ), parsed );
 
 				break;
 			}
@@ -1462,12 +2114,10 @@ public:
 					ud.ref_id_at_publisher = fields.idAtSource;
 				}
 
-				typename ComposerT::BufferType msgForward;
-				helperParseAndUpdatePublishableStateMessage<ParserT, ComposerT>( msg, msgForward, ud );
+				typename ComposerT::BufferType msgForward = helperUpdatePublishableStateMessage<ParserT, ComposerT>( std::move( msg ), parsed, ud );
 
-				InProcessMessagePostmanBase* postman = addressableLocations.getPostman( fields.targetSlotIdx );
-				lock.unlock(); // NOTE: this is correct as long as postans are not released; rework otherwise
-				postman->postMessage( std::move( msgForward ) );
+				InProcessMessagePostmanBase* postman = getPostman( fields.targetSlotIdx );
+				postman->postParsedMessage( std::move( msgForward ), parsed );
 
 				break;
 			}
@@ -1476,11 +2126,12 @@ public:
 		}
 	}
 
+public:
 	uint64_t add( StorableStringT name, InProcessMessagePostmanBase* postman, SlotIdx& idx )
 	{
 		assert( !name.empty() );
 
-		std::unique_lock<std::mutex> lock(mx);
+		std::unique_lock<std::shared_mutex> lock(mxLocations);
 
 		idx = addressableLocations.add( postman );
 		addNamedLocation( name, idx );
@@ -1488,14 +2139,14 @@ public:
 	}
 	uint64_t add( InProcessMessagePostmanBase* postman, SlotIdx& idx )
 	{
-		std::unique_lock<std::mutex> lock(mx);
+		std::unique_lock<std::shared_mutex> lock(mxLocations);
 
 		idx = addressableLocations.add( postman );
 		return addSender( idx );
 	}
 	void remove( StorableStringT name, SlotIdx idx )
 	{
-		std::unique_lock<std::mutex> lock(mx);
+		std::unique_lock<std::shared_mutex> lock(mxLocations);
 
 		if ( !name.empty() )
 			removeNamedLocation( name );
@@ -1572,6 +2223,14 @@ public:
 		assert( idx.isInitialized() );
 		gmq.postMessage( std::move( msg ), id, idx );
 	}
+	void postParsedMessage( MessageBufferT&& msg, const ParsedMessageHeader& parsed ){
+		assert( idx.isInitialized() );
+		gmq.postMessage( std::move( msg ), parsed, id, idx );
+	}
+	void postSharedMessage( const PublishableStateMessageHeader& header, const SharedMessageBody& body ){
+		assert( idx.isInitialized() );
+		gmq.postSharedMessage( header, body, id, idx );
+	}
 
 public:
 	InProcTransferrable<PlatformSupportT> makeTransferrable()
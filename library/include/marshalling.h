@@ -171,6 +171,27 @@ public:
 			return false;
 	}
 	template<class ExpectedType, class ComposerT>
+	void compose_all_to_gmq( ComposerT& composer )
+	{
+		if constexpr ( std::is_same<typename ExpectedType::value_type, impl::SignedIntegralType>::value && std::is_integral<value_type>::value && sizeof( value_type ) == impl::integer_max_size )
+		{
+			impl::composeSignedIntegers( composer, coll.data() + ( it - coll.begin() ), coll.end() - it );
+			it = coll.end();
+		}
+		else if constexpr ( std::is_same<typename ExpectedType::value_type, impl::UnsignedIntegralType>::value && std::is_integral<value_type>::value && sizeof( value_type ) == impl::integer_max_size )
+		{
+			impl::composeUnsignedIntegers( composer, coll.data() + ( it - coll.begin() ), coll.end() - it );
+			it = coll.end();
+		}
+		else if constexpr ( std::is_same<typename ExpectedType::value_type, impl::RealType>::value && std::is_same<value_type, double>::value )
+		{
+			impl::composeReals( composer, coll.data() + ( it - coll.begin() ), coll.end() - it );
+			it = coll.end();
+		}
+		else
+			while ( compose_next_to_gmq<ExpectedType>( composer ) );
+	}
+	template<class ExpectedType, class ComposerT>
 	bool compose_next_to_json( ComposerT& composer )
 	{ 
 		if ( it != coll.end() )
@@ -350,11 +371,10 @@ void composeParamToGmq(ComposerT& composer, const typename TypeToPick::NameAndTy
 		{
 			if constexpr ( std::is_base_of<VectorOfSympleTypesBase, typename TypeToPick::Type>::value && std::is_base_of<SimpleTypeCollectionWrapperBase, typename Agr0Type::Type>::value )
 			{
-				auto& coll = arg0.get();
+				auto coll = arg0.get(); // a copy (a reference and a position): the argument can be composed again, as when its size is measured first
 				size_t collSz = coll.size();
 				composeUnsignedInteger( composer, collSz );
-				for ( size_t i=0; i<collSz; ++i )
-					coll.template compose_next_to_gmq<typename TypeToPick::Type>(composer);
+				coll.template compose_all_to_gmq<typename TypeToPick::Type>(composer);
 			}
 			else if constexpr ( (std::is_base_of<VectorOfNonextMessageTypesBase, typename TypeToPick::Type>::value || std::is_base_of<VectorOfNonextDiscriminatedUnionTypesBase, typename TypeToPick::Type>::value) && std::is_base_of<CollectionWrapperBase, typename Agr0Type::Type>::value )
 			{
@@ -429,8 +449,8 @@ void composeParamToGmq(ComposerT& composer, const typename TypeToPick::NameAndTy
 
 namespace json {
 
-template<typename ComposerT, typename ParamTypeClassifier, typename ArgT>
-void composeEntryToJson(ComposerT& composer, GMQ_COLL string name, ArgT& arg)
+template<typename ComposerT, typename ParamTypeClassifier, typename ArgT, typename NameT>
+void composeEntryToJson(ComposerT& composer, const NameT& name, ArgT& arg)
 {
 	using AgrType = typename std::remove_reference<typename special_decay_t<ArgT>::Type>::type;
 
@@ -449,7 +469,7 @@ void composeEntryToJson(ComposerT& composer, GMQ_COLL string name, ArgT& arg)
 			{
 				json::addNamePart( composer, name );
 				composer.buff.appendUint8( '[' );
-				auto& coll = arg.get();
+				auto coll = arg.get(); // a copy (see composeParamToGmq())
 				size_t collSz = coll.size();
 				for ( size_t i=0; i<collSz; ++i )
 				{
@@ -527,8 +547,8 @@ void composeEntryToJson(ComposerT& composer, GMQ_COLL string name, ArgT& arg)
 	}
 }
 
-template<typename ComposerT, typename TypeToPick, bool required, class AssumedDefaultT, class DefaultT, DefaultT defaultValue>
-void composeParamToJson(ComposerT& composer, GMQ_COLL string name, const typename TypeToPick::NameAndTypeID expected)
+template<typename ComposerT, typename TypeToPick, bool required, class AssumedDefaultT, class DefaultT, DefaultT defaultValue, typename NameT>
+void composeParamToJson(ComposerT& composer, const NameT& name, const typename TypeToPick::NameAndTypeID expected)
 {
 		static_assert( !required, "required parameter" );
 		if constexpr ( std::is_same<typename TypeToPick::Type, SignedIntegralType>::value )
@@ -572,8 +592,8 @@ void composeParamToJson(ComposerT& composer, GMQ_COLL string name, const typenam
 			static_assert( std::is_same<typename TypeToPick::Type, AllowedDataType>::value, "unsupported type" );
 }
 
-template<typename ComposerT, typename TypeToPick, bool required, class AssumedDefaultT, class DefaultT, DefaultT defaultValue, typename Arg0, typename ... Args>
-void composeParamToJson(ComposerT& composer, GMQ_COLL string name, const typename TypeToPick::NameAndTypeID expected, Arg0&& arg0, Args&& ... args)
+template<typename ComposerT, typename TypeToPick, bool required, class AssumedDefaultT, class DefaultT, DefaultT defaultValue, typename NameT, typename Arg0, typename ... Args>
+void composeParamToJson(ComposerT& composer, const NameT& name, const typename TypeToPick::NameAndTypeID expected, Arg0&& arg0, Args&& ... args)
 {
 	using Agr0Type = special_decay_t<Arg0>;
 	if constexpr ( std::is_same<typename special_decay_t<Arg0>::Name, typename TypeToPick::Name>::value ) // same parameter name
@@ -900,6 +920,59 @@ void publishableParseUnsignedInteger(ParserT& p, ArgT* arg, NameT expectedName)
 	}
 }
 
+template<typename ComposerT, typename NameT>
+void publishableStructComposeFixedWidthUnsignedInteger(ComposerT& composer, uint64_t arg, NameT name, bool addListSeparator)
+{
+	if constexpr ( ComposerT::proto == Proto::GMQ )
+		composeFixedWidthUnsignedInteger( composer, arg );
+	else
+	{
+		static_assert( ComposerT::proto == Proto::JSON, "unexpected protocol id" );
+		json::addNamePart( composer, name );
+		json::composeFixedWidthUnsignedInteger( composer, arg );
+		if ( addListSeparator )
+			composer.buff.append( ",", 1 );
+	}
+}
+
+template<typename ParserT, typename NameT>
+void publishableParseFixedWidthUnsignedInteger(ParserT& p, uint64_t* arg, size_t* slotOffset, NameT expectedName) // slotOffset: where the value can be patched in place
+{
+	if constexpr ( ParserT::proto == Proto::GMQ )
+	{
+		p.parseFixedWidthUnsignedInteger( arg );
+		*slotOffset = p.getCurrentOffset() - fixed_width_uinteger_size;
+	}
+	else
+	{
+		static_assert( ParserT::proto == Proto::JSON, "unexpected protocol id" );
+		std::string key;
+		p.readKey( &key );
+		if ( key != expectedName )
+			throw std::exception(); // bad format
+		size_t start = p.getCurrentOffset();
+		p.readUnsignedIntegerFromJson( arg );
+		size_t end = p.getCurrentOffset();
+		if ( end - start < json::fixed_width_uinteger_size )
+			throw std::exception(); // bad format (not a fixed-width slot)
+		*slotOffset = end - json::fixed_width_uinteger_size;
+		if ( p.isDelimiter( ',' ) )
+			p.skipDelimiter( ',' );
+	}
+}
+
+template<typename ComposerT>
+void publishablePatchFixedWidthUnsignedInteger(uint8_t* slot, uint64_t arg)
+{
+	if constexpr ( ComposerT::proto == Proto::GMQ )
+		patchFixedWidthUnsignedInteger( slot, arg );
+	else
+	{
+		static_assert( ComposerT::proto == Proto::JSON, "unexpected protocol id" );
+		json::patchFixedWidthUnsignedInteger( slot, arg );
+	}
+}
+
 template<typename ComposerT, typename ArgT, typename NameT>
 void publishableStructComposeReal(ComposerT& composer, ArgT arg, NameT name, bool addListSeparator)
 {
@@ -1373,7 +1446,7 @@ void publishableComposeLeafeStructBegin(ComposerT& composer)
 	else
 	{
 		static_assert( ComposerT::proto == Proto::JSON, "unexpected protocol id" );
-		json::addNamePart( composer, "value" );
+		json::addNamePart( composer, JsonKeyForComposing( "value", "\"value\":" ) );
 		composer.buff.append( "{", 1 );
 	}
 }
@@ -1386,7 +1459,7 @@ void publishableComposeLeafeValueBegin(ComposerT& composer)
 	else
 	{
 		static_assert( ComposerT::proto == Proto::JSON, "unexpected protocol id" );
-		json::addNamePart( composer, "value" );
+		json::addNamePart( composer, JsonKeyForComposing( "value", "\"value\":" ) );
 	}
 }
 
@@ -1457,7 +1530,7 @@ void publishableComposeLeafeVectorBegin(ComposerT& composer)
 	else
 	{
 		static_assert( ComposerT::proto == Proto::JSON, "unexpected protocol id" );
-		json::addNamePart( composer, "value" );
+		json::addNamePart( composer, JsonKeyForComposing( "value", "\"value\":" ) );
 		composer.buff.append( "[", 1 );
 	}
 }
@@ -1537,8 +1610,9 @@ void publishableParseLeafeDictionaryEnd(ParserT& p)
 
 
 template<typename ComposerT>
-void composeAddressInPublishable( ComposerT& composer, const GMQ_COLL vector<size_t>& addr, size_t last )
+void composeAddressInPublishable( ComposerT& composer, const PublishableAddress& addr, size_t last )
 {
+	++composer.changeCount;
 	if constexpr ( ComposerT::proto == Proto::GMQ )
 	{
 		size_t collSz = addr.size();
@@ -1550,7 +1624,7 @@ void composeAddressInPublishable( ComposerT& composer, const GMQ_COLL vector<siz
 	else
 	{
 		composer.buff.append( "{", 1 );
-		json::addNamePart( composer, "addr" );
+		json::addNamePart( composer, JsonKeyForComposing( "addr", "\"addr\":" ) );
 		composer.buff.appendUint8( '[' );
 		size_t collSz = addr.size();
 		for ( size_t i=0; i<collSz; ++i )
@@ -1565,7 +1639,7 @@ void composeAddressInPublishable( ComposerT& composer, const GMQ_COLL vector<siz
 }
 
 template<typename ParserT, typename ArgT>
-bool parseAddressInPublishable(ParserT& p, GMQ_COLL vector<size_t>& addr)
+bool parseAddressInPublishable(ParserT& p, ArgT& addr)
 {
 	if constexpr ( ParserT::proto == Proto::GMQ )
 	{
@@ -1645,7 +1719,7 @@ void composeActionInPublishable( ComposerT& composer, size_t action, bool noData
 	}
 	else
 	{
-		json::addNamePart( composer, "action" );
+		json::addNamePart( composer, JsonKeyForComposing( "action", "\"action\":" ) );
 		json::composeUnsignedInteger( composer, action );
 		if ( noData )
 		{
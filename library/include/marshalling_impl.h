@@ -31,6 +31,16 @@
 #include "global_mq_common.h"
 #include <tuple>
 #include <cstddef>
+#include <cstdint>
+#include <bit>
+#include <charconv>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || ( defined(_M_IX86_FP) && _M_IX86_FP >= 2 )
+#include <emmintrin.h>
+#define GMQ_VLQ_SSE2
+#define GMQ_JSON_SSE2
+#endif
 
 
 namespace globalmq::marshalling {
@@ -72,6 +82,68 @@ struct FloatingDefault
 	}
 };
 
+// path to a member of a publishable state, as carried by state updates; paths are short, so up to inlineDepth items are stored in place and only deeper ones go to the heap
+class PublishableAddress
+{
+public:
+	using value_type = uint64_t;
+	static constexpr size_t inlineDepth = 8;
+
+private:
+	size_t sz = 0;
+	uint64_t inlineItems[inlineDepth] = {};
+	GMQ_COLL vector<uint64_t> spilled; // all items, once there are more than inlineDepth of them
+
+public:
+	PublishableAddress() {}
+	PublishableAddress( const PublishableAddress& base, uint64_t last ) : PublishableAddress( base ) { push_back( last ); }
+	PublishableAddress( const PublishableAddress& ) = default;
+	PublishableAddress& operator = ( const PublishableAddress& ) = default;
+	PublishableAddress( PublishableAddress&& other ) noexcept : sz( other.sz ), spilled( std::move( other.spilled ) )
+	{
+		memcpy( inlineItems, other.inlineItems, sizeof( inlineItems ) );
+		other.sz = 0;
+	}
+	PublishableAddress& operator = ( PublishableAddress&& other ) noexcept
+	{
+		sz = other.sz;
+		memcpy( inlineItems, other.inlineItems, sizeof( inlineItems ) );
+		spilled = std::move( other.spilled );
+		other.sz = 0;
+		other.spilled.clear();
+		return *this;
+	}
+
+	size_t size() const { return sz; }
+	bool empty() const { return sz == 0; }
+	const uint64_t* data() const { return sz <= inlineDepth ? inlineItems : spilled.data(); }
+	uint64_t* data() { return sz <= inlineDepth ? inlineItems : spilled.data(); }
+	const uint64_t* begin() const { return data(); }
+	const uint64_t* end() const { return data() + sz; }
+	uint64_t operator [] ( size_t idx ) const { GMQ_ASSERT( idx < sz ); return data()[idx]; }
+	uint64_t& operator [] ( size_t idx ) { GMQ_ASSERT( idx < sz ); return data()[idx]; }
+	bool startsWith( const PublishableAddress& prefix ) const { return prefix.sz <= sz && memcmp( prefix.data(), data(), prefix.sz * sizeof( uint64_t ) ) == 0; }
+
+	void push_back( uint64_t val )
+	{
+		if ( sz < inlineDepth )
+			inlineItems[sz] = val;
+		else
+		{
+			if ( sz == inlineDepth )
+				spilled.assign( inlineItems, inlineItems + inlineDepth );
+			spilled.push_back( val );
+		}
+		++sz;
+	}
+
+	void clear()
+	{
+		sz = 0;
+		spilled.clear();
+	}
+};
+
 
 enum Proto { GMQ, JSON };
 
@@ -84,6 +156,7 @@ public: // just temporary TODO: rework!
 	static constexpr Proto proto = Proto::JSON;
 	using BufferType = BufferT;
 	BufferT& buff;
+	uint64_t changeCount = 0; // changes of a publishable state composed so far (see StatePublisherBase::changeCount())
 
 public:
 	JsonComposer( BufferT& buff_ ) : buff( buff_ ) {}
@@ -97,10 +170,13 @@ public: // just temporary TODO: rework!
 	static constexpr Proto proto = Proto::GMQ;
 	using BufferType = BufferT;
 	BufferT& buff;
+	bool lengthPrefixedStrings = false; // strings as VLQ-encoded length followed by bytes, rather than NUL-terminated (see PublishableStateMessageHeader::lengthPrefixedStrings)
+	uint64_t changeCount = 0; // see JsonComposer::changeCount
 
 public:
 	GmqComposer( BufferT& buff_ ) : buff( buff_ ) {}
 	void reset() {} // TODO: add extra functionality, if starting over requires that. Do not clear buff!!! - it may already have some data in it
+	void setLengthPrefixedStrings( bool lp ) { lengthPrefixedStrings = lp; }
 };
 
 } // namespace globalmq::marshalling
@@ -158,37 +234,206 @@ struct StringLiteralForComposing
 	constexpr StringLiteralForComposing( const char* const str_, const size_t size_ ) : str( str_ ), size( size_ ) {}
 };
 
+// a member name as JSON composers write it, with quotes and colon (see json::addNamePart()); generated code makes these from literals, so a composer appends a key with a single call
+struct JsonKeyForComposing
+{
+	const char* const name; // as is, for composers that need just a name
+	const char* const token; // "\"name\":"
+	const size_t tokenSize;
+	template<size_t nameN, size_t tokenN>
+	constexpr JsonKeyForComposing( const char (&name_)[nameN], const char (&token_)[tokenN] ) : name( name_ ), token( token_ ), tokenSize( tokenN - 1 ) { static_assert( tokenN == nameN + 3 ); }
+};
+
 struct IntegralVlq
 {
+	// wire format: 7-bit groups, most significant first; all groups but the last one have 0x80 bit set
+	static constexpr size_t maxVlqSize = 10;
+
+	static size_t vlqSize(uint64_t val)
+	{
+		return val < 0x80 ? 1 : ( std::bit_width( val ) + 6 ) / 7;
+	}
+
 	template<typename ComposerT> 
 	static void writeVlqIntegral(ComposerT& composer, uint64_t val)
 	{
-		uint8_t intTemp[10];
-		int ix = 0;
-		uint8_t current = (uint8_t)(val & 0x7f);
-		val >>= 7;
-		intTemp[ix] = current;
-		bool done = val == 0;
-
-		while (!done)
+		if ( val < 0x80 )
 		{
+			composer.buff.appendUint8( (uint8_t)val );
+			return;
+		}
+		uint8_t intTemp[maxVlqSize];
+		size_t sz = writeVlqIntegral( intTemp, val );
+		composer.buff.append( intTemp, sz ); // single capacity check
+	}
 
-			current = (uint8_t)(val & 0x7f);
-			current += 0x80;
+	static size_t writeVlqIntegral(uint8_t* out, uint64_t val) // out must have room for maxVlqSize bytes; returns number of bytes written
+	{
+		size_t sz = vlqSize( val );
+		uint8_t* p = out + sz - 1;
+		*p = (uint8_t)(val & 0x7f);
+		while ( p != out )
+		{
 			val >>= 7;
-			++ix;
-			intTemp[ix] = current;
-			done = val == 0;
+			*--p = (uint8_t)(val | 0x80);
+		}
+		return sz;
+	}
+
+	// bulk versions for arrays of 64-bit integers; byte-identical to per-element writeVlqIntegral()/readVlqIntegral() with optional zigzag transform
+
+	template<bool zigzag, typename ComposerT, typename T>
+	static void writeVlqIntegrals(ComposerT& composer, const T* vals, size_t count)
+	{
+		static_assert( sizeof( T ) == sizeof( uint64_t ) && std::is_integral<T>::value );
+		constexpr size_t chunkSize = 64; // values are encoded to a stack buffer first, one append() per chunk
+		constexpr size_t blockSize = 16;
+		uint8_t intTemp[chunkSize * maxVlqSize];
+		while ( count != 0 )
+		{
+			size_t n = count < chunkSize ? count : chunkSize;
+			uint8_t* out = intTemp;
+			size_t i = 0;
+			for ( ; i + blockSize <= n; i += blockSize )
+			{
+				uint64_t block[blockSize];
+				uint64_t all = 0;
+				for ( size_t j=0; j<blockSize; ++j )
+				{
+					block[j] = zigzag ? zigzagEncode( (int64_t)vals[i + j] ) : (uint64_t)vals[i + j];
+					all |= block[j];
+				}
+				if ( all < 0x80 ) // typical for small numbers; loops above and below are vectorized by compiler
+				{
+					for ( size_t j=0; j<blockSize; ++j )
+						out[j] = (uint8_t)block[j];
+					out += blockSize;
+				}
+				else
+					for ( size_t j=0; j<blockSize; ++j )
+						out += writeVlqIntegral( out, block[j] );
+			}
+			for ( ; i<n; ++i )
+				out += writeVlqIntegral( out, zigzag ? zigzagEncode( (int64_t)vals[i] ) : (uint64_t)vals[i] );
+			composer.buff.append( intTemp, out - intTemp );
+			vals += n;
+			count -= n;
+		}
+	}
+
+	template<bool zigzag, typename RiterT, typename T>
+	static void readVlqIntegrals(RiterT& riter, T* vals, size_t count)
+	{
+		static_assert( sizeof( T ) == sizeof( uint64_t ) && std::is_integral<T>::value );
+		size_t i = 0;
+		if constexpr ( std::endian::native == std::endian::little )
+		{
+			// directly available span is decoded in place: runs of single-byte values are widened in blocks, other values are decoded one by one;
+			// values longer than 8 bytes and the last few bytes of the span go through readVlqIntegral()
+			constexpr size_t margin = 2 * sizeof( uint64_t );
+			while ( i < count && riter.directlyAvailableSize() >= margin )
+			{
+				const uint8_t* begin = riter.directPeek();
+				const uint8_t* last = begin + riter.directlyAvailableSize() - margin;
+				const uint8_t* p = begin;
+				while ( i < count && p <= last )
+				{
+					if ( *p >= 0x80 )
+					{
+						uint64_t v;
+						if ( !decodeDirectMultiByte( p, v ) )
+							break;
+						vals[i++] = (T)( zigzag ? (uint64_t)zigzagDecode( v ) : v );
+						continue;
+					}
+					uint32_t multiByteMask = singleByteBlockMask( p ); // bit per first bytes of multi-byte values
+					if ( multiByteMask == 0 && count - i >= singleByteBlockSize )
+					{
+						widenSingleByteBlock<zigzag>( p, vals + i );
+						p += singleByteBlockSize;
+						i += singleByteBlockSize;
+						continue;
+					}
+					size_t run = multiByteMask != 0 ? std::countr_zero( multiByteMask ) : singleByteBlockSize;
+					if ( run > count - i )
+						run = count - i;
+					for ( size_t j=0; j<run; ++j )
+						vals[i + j] = (T)( zigzag ? (uint64_t)zigzagDecode( p[j] ) : p[j] );
+					p += run;
+					i += run;
+				}
+				riter.directRead( p - begin );
+				if ( p <= last && i < count ) // long value
+				{
+					uint64_t v = readVlqIntegral( riter );
+					vals[i++] = (T)( zigzag ? (uint64_t)zigzagDecode( v ) : v );
+				}
+				else
+					break;
+			}
+		}
+		for ( ; i<count; ++i )
+		{
+			uint64_t v = readVlqIntegral( riter );
+			vals[i] = (T)( zigzag ? (uint64_t)zigzagDecode( v ) : v );
 		}
+	}
+
+#ifdef GMQ_VLQ_SSE2
+	static constexpr size_t singleByteBlockSize = 16;
 
-		while(ix != 0)
+	static uint32_t singleByteBlockMask(const uint8_t* p)
+	{
+		return (uint32_t)_mm_movemask_epi8( _mm_loadu_si128( (const __m128i*)p ) );
+	}
+
+	template<bool zigzag, typename T>
+	static void widenSingleByteBlock(const uint8_t* p, T* vals) // 16 bytes, each < 0x80, to 16 64-bit values
+	{
+		__m128i zero = _mm_setzero_si128();
+		__m128i bytes = _mm_loadu_si128( (const __m128i*)p );
+		__m128i ext = zero; // bytes of sign extension
+		if constexpr ( zigzag )
 		{
-			composer.buff.appendUint8(intTemp[ix]);
-			--ix;
+			// (b >> 1) ^ -(b & 1), bytewise
+			__m128i half = _mm_and_si128( _mm_srli_epi16( bytes, 1 ), _mm_set1_epi8( 0x7f ) );
+			__m128i neg = _mm_sub_epi8( zero, _mm_and_si128( bytes, _mm_set1_epi8( 1 ) ) );
+			bytes = _mm_xor_si128( half, neg );
+			ext = neg;
 		}
-		composer.buff.appendUint8(intTemp[0]);
+		__m128i w[2] = { _mm_unpacklo_epi8( bytes, ext ), _mm_unpackhi_epi8( bytes, ext ) };
+		for ( size_t k=0; k<2; ++k )
+		{
+			__m128i ext16 = zigzag ? _mm_srai_epi16( w[k], 15 ) : zero;
+			__m128i d[2] = { _mm_unpacklo_epi16( w[k], ext16 ), _mm_unpackhi_epi16( w[k], ext16 ) };
+			for ( size_t m=0; m<2; ++m )
+			{
+				__m128i ext32 = zigzag ? _mm_srai_epi32( d[m], 31 ) : zero;
+				__m128i* out = (__m128i*)( vals + k * 8 + m * 4 );
+				_mm_storeu_si128( out, _mm_unpacklo_epi32( d[m], ext32 ) );
+				_mm_storeu_si128( out + 1, _mm_unpackhi_epi32( d[m], ext32 ) );
+			}
+		}
+	}
+#else
+	static constexpr size_t singleByteBlockSize = 8;
+
+	static uint32_t singleByteBlockMask(const uint8_t* p)
+	{
+		uint64_t word;
+		memcpy( &word, p, sizeof( word ) );
+		word &= 0x8080808080808080ULL;
+		return (uint32_t)( ( word * 0x0002040810204081ULL ) >> 56 ); // gathers high bits of all bytes, first byte to lowest bit
 	}
 
+	template<bool zigzag, typename T>
+	static void widenSingleByteBlock(const uint8_t* p, T* vals)
+	{
+		for ( size_t j=0; j<singleByteBlockSize; ++j )
+			vals[j] = (T)( zigzag ? (uint64_t)zigzagDecode( p[j] ) : p[j] );
+	}
+#endif
+
 	static uint64_t zigzagEncode(int64_t i)
 	{
 		return ((uint64_t)(i >> 63)) ^ ((uint64_t)(i << 1));
@@ -198,6 +443,24 @@ struct IntegralVlq
 	static uint64_t readVlqIntegral(RiterT& riter)
 	{
 		uint64_t result = 0;
+		if constexpr ( std::endian::native == std::endian::little )
+		{
+			if ( riter.directlyAvailableSize() >= sizeof( uint64_t ) )
+			{
+				const uint8_t* begin = riter.directPeek();
+				const uint8_t* p = begin;
+				if ( decodeDirect( p, result ) )
+				{
+					riter.directRead( p - begin );
+					return result;
+				}
+				uint64_t word;
+				memcpy( &word, begin, sizeof( word ) );
+				// more than 8 groups; proceed with the rest below
+				riter.directRead( sizeof( uint64_t ) );
+				result = compactGroups( byteSwap( word ) );
+			}
+		}
 		bool done = false;
 		while (!done && riter.isData())
 		{
@@ -211,6 +474,58 @@ struct IntegralVlq
 		return result;
 	}
 
+	static bool decodeDirect(const uint8_t*& p, uint64_t& val) // requires at least 8 readable bytes at p; returns false (leaving p as is) if value is longer than 8 bytes
+	{
+		if ( p[0] < 0x80 )
+		{
+			val = *p++;
+			return true;
+		}
+		if ( p[1] < 0x80 )
+		{
+			val = ( (uint64_t)( p[0] & 0x7f ) << 7 ) | p[1];
+			p += 2;
+			return true;
+		}
+		return decodeDirectMultiByte( p, val );
+	}
+
+	static bool decodeDirectMultiByte(const uint8_t*& p, uint64_t& val) // same as decodeDirect() without branches for short values; sizes of values in large vectors are hardly predictable
+	{
+		// load 8 bytes at once and find terminating byte, if any
+		uint64_t word;
+		memcpy( &word, p, sizeof( word ) );
+		uint64_t stops = ~word & 0x8080808080808080ULL;
+		if ( stops == 0 )
+			return false;
+		size_t sz = ( std::countr_zero( stops ) >> 3 ) + 1;
+		val = compactGroups( byteSwap( word << ( ( 8 - sz ) * 8 ) ) ); // drop bytes beyond the terminating one
+		p += sz;
+		return true;
+	}
+
+	static uint64_t compactGroups(uint64_t word) // 8 groups, most significant group in most significant byte
+	{
+		word &= 0x7f7f7f7f7f7f7f7fULL;
+		word = ( ( word & 0x7f007f007f007f00ULL ) >> 1 ) | ( word & 0x007f007f007f007fULL );
+		word = ( ( word & 0x3fff00003fff0000ULL ) >> 2 ) | ( word & 0x00003fff00003fffULL );
+		word = ( ( word & 0x0fffffff00000000ULL ) >> 4 ) | ( word & 0x000000000fffffffULL );
+		return word;
+	}
+
+	static uint64_t byteSwap(uint64_t x)
+	{
+#if defined(__GNUC__)
+		return __builtin_bswap64( x );
+#elif defined(_MSC_VER)
+		return _byteswap_uint64( x );
+#else
+		x = ( ( x & 0x00ff00ff00ff00ffULL ) << 8 ) | ( ( x >> 8 ) & 0x00ff00ff00ff00ffULL );
+		x = ( ( x & 0x0000ffff0000ffffULL ) << 16 ) | ( ( x >> 16 ) & 0x0000ffff0000ffffULL );
+		return ( x << 32 ) | ( x >> 32 );
+#endif
+	}
+
 	static int64_t zigzagDecode(uint64_t i)
 	{
 		return ((int64_t)(i >> 1)) ^ (-(int64_t)(i & 1));
@@ -249,6 +564,27 @@ void composeUnsignedInteger(ComposerT& composer, T num )
 	}
 }
 
+// contiguous arrays of 64-bit integers (VECTOR<INTEGER>, VECTOR<UINTEGER>); same bytes as element by element composing
+template<typename ComposerT, typename T>
+void composeSignedIntegers(ComposerT& composer, const T* nums, size_t count )
+{
+	static_assert( std::is_integral<T>::value && sizeof( T ) == integer_max_size );
+	if constexpr ( std::is_unsigned<T>::value )
+		for ( size_t i=0; i<count; ++i )
+			GMQ_ASSERT( nums[i] <= INT64_MAX );
+	IntegralVlq::writeVlqIntegrals<true>( composer, nums, count );
+}
+
+template<typename ComposerT, typename T>
+void composeUnsignedIntegers(ComposerT& composer, const T* nums, size_t count )
+{
+	static_assert( std::is_integral<T>::value && sizeof( T ) == integer_max_size );
+	if constexpr ( std::is_signed<T>::value )
+		for ( size_t i=0; i<count; ++i )
+			GMQ_ASSERT( nums[i] >= 0 );
+	IntegralVlq::writeVlqIntegrals<false>( composer, nums, count );
+}
+
 template<typename ComposerT, typename T>
 void composeReal(ComposerT& composer, T num )
 {
@@ -258,32 +594,202 @@ void composeReal(ComposerT& composer, T num )
 	}
 }
 
+// contiguous arrays of doubles (VECTOR<REAL>): reals are fixed-width anyway, so that the whole array goes as a single block
 template<typename ComposerT>
-void composeString(ComposerT& composer, const GMQ_COLL string& str )
+void composeReals(ComposerT& composer, const double* nums, size_t count )
 {
-	composer.buff.append( str.c_str(), str.size() );
+	composer.buff.append( nums, count * sizeof( double ) );
+}
+
+// fixed-width unsigned integer: takes the same space whatever the value is (8 bytes, little-endian), and thus can be patched in place
+static constexpr size_t fixed_width_uinteger_size = 8;
+
+inline
+void patchFixedWidthUnsignedInteger( uint8_t* slot, uint64_t num ) // little-endian, whatever the platform is
+{
+	for ( size_t i=0; i<fixed_width_uinteger_size; ++i )
+		slot[i] = (uint8_t)( num >> ( 8 * i ) );
+}
+
+inline
+uint64_t readFixedWidthUnsignedInteger( const uint8_t* slot )
+{
+	uint64_t num = 0;
+	for ( size_t i=0; i<fixed_width_uinteger_size; ++i )
+		num |= (uint64_t)( slot[i] ) << ( 8 * i );
+	return num;
+}
+
+template<typename ComposerT>
+void composeFixedWidthUnsignedInteger(ComposerT& composer, uint64_t num )
+{
+	uint8_t slot[fixed_width_uinteger_size];
+	patchFixedWidthUnsignedInteger( slot, num );
+	composer.buff.append( slot, fixed_width_uinteger_size );
+}
+
+// strings are either NUL-terminated (default), or, if composer says so, prefixed by VLQ-encoded length (then they may contain NULs
+// and can be skipped or referenced in place by a parser without scanning)
+template<typename ComposerT>
+void composeString(ComposerT& composer, const char* str, size_t sz )
+{
+	if constexpr ( requires { composer.lengthPrefixedStrings; } )
+	{
+		if ( composer.lengthPrefixedStrings )
+		{
+			IntegralVlq::writeVlqIntegral( composer, sz );
+			composer.buff.append( str, sz );
+			return;
+		}
+	}
+	GMQ_ASSERT( memchr( str, 0, sz ) == nullptr ); // would be read back truncated
+	composer.buff.append( str, sz );
 	composer.buff.appendUint8( 0 );
 }
 
+template<typename ComposerT>
+void composeString(ComposerT& composer, const GMQ_COLL string& str )
+{
+	composeString( composer, str.c_str(), str.size() );
+}
+
 template<typename ComposerT>
 void composeString(ComposerT& composer, const StringLiteralForComposing* str )
 {
-	composer.buff.append( str->str, str->size );
-	composer.buff.appendUint8( 0 );
+	composeString( composer, str->str, str->size );
 }
 
 template<typename ComposerT>
 void composeString(ComposerT& composer, const char* str )
 {
-	size_t sz = strlen( str );
-	composer.buff.append( str, sz );
-	composer.buff.appendUint8( 0 );
+	composeString( composer, str, strlen( str ) );
 }
 
 namespace json
 {
 	// NOTE: to achieve protocol independence of nested messages never add non-mandatory elements (like spaces) at the end of a composed item
 
+// structural scanning of contiguous spans (see JsonParser): 16 bytes at a time with SSE2, byte by byte otherwise
+inline bool isSpace( uint8_t ch ) { return ch == ' ' || ch == '\t' || ch == '\r' || ch == '\n'; }
+
+#ifdef GMQ_JSON_SSE2
+static constexpr size_t scanBlockSize = 16;
+
+inline __m128i scanBlockEq( __m128i block, char ch ) { return _mm_cmpeq_epi8( block, _mm_set1_epi8( ch ) ); }
+inline uint32_t scanBlockMask( __m128i matches ) { return (uint32_t)_mm_movemask_epi8( matches ); }
+#endif
+
+inline size_t findNonSpace( const uint8_t* p, size_t sz ) // index of the first non-whitespace char, or sz
+{
+	size_t i = 0;
+#ifdef GMQ_JSON_SSE2
+	for ( ; i + scanBlockSize <= sz; i += scanBlockSize )
+	{
+		__m128i block = _mm_loadu_si128( (const __m128i*)( p + i ) );
+		uint32_t spaces = scanBlockMask( _mm_or_si128( _mm_or_si128( scanBlockEq( block, ' ' ), scanBlockEq( block, '\t' ) ), _mm_or_si128( scanBlockEq( block, '\r' ), scanBlockEq( block, '\n' ) ) ) );
+		if ( spaces != 0xffff )
+			return i + std::countr_zero( ~spaces );
+	}
+#endif
+	while ( i < sz && isSpace( p[i] ) )
+		++i;
+	return i;
+}
+
+inline size_t findQuoteOrBackslash( const uint8_t* p, size_t sz ) // within a string: index of its end or of an escape sequence, or sz
+{
+	size_t i = 0;
+#ifdef GMQ_JSON_SSE2
+	for ( ; i + scanBlockSize <= sz; i += scanBlockSize )
+	{
+		__m128i block = _mm_loadu_si128( (const __m128i*)( p + i ) );
+		uint32_t found = scanBlockMask( _mm_or_si128( scanBlockEq( block, '\"' ), scanBlockEq( block, '\\' ) ) );
+		if ( found != 0 )
+			return i + std::countr_zero( found );
+	}
+#endif
+	while ( i < sz && p[i] != '\"' && p[i] != '\\' )
+		++i;
+	return i;
+}
+
+inline size_t findQuoteOrBracket( const uint8_t* p, size_t sz, char left, char right ) // within a block: index of a string beginning or of a (nested) block bound, or sz
+{
+	size_t i = 0;
+#ifdef GMQ_JSON_SSE2
+	for ( ; i + scanBlockSize <= sz; i += scanBlockSize )
+	{
+		__m128i block = _mm_loadu_si128( (const __m128i*)( p + i ) );
+		uint32_t found = scanBlockMask( _mm_or_si128( scanBlockEq( block, '\"' ), _mm_or_si128( scanBlockEq( block, left ), scanBlockEq( block, right ) ) ) );
+		if ( found != 0 )
+			return i + std::countr_zero( found );
+	}
+#endif
+	while ( i < sz && p[i] != '\"' && p[i] != left && p[i] != right )
+		++i;
+	return i;
+}
+
+inline size_t findCharToEscape( const uint8_t* p, size_t sz ) // index of the first '"', '\\' or control char, or sz
+{
+	size_t i = 0;
+#ifdef GMQ_JSON_SSE2
+	for ( ; i + scanBlockSize <= sz; i += scanBlockSize )
+	{
+		__m128i block = _mm_loadu_si128( (const __m128i*)( p + i ) );
+		__m128i controls = _mm_cmpeq_epi8( _mm_max_epu8( block, _mm_set1_epi8( 0x1f ) ), _mm_set1_epi8( 0x1f ) ); // unsigned block <= 0x1f
+		uint32_t found = scanBlockMask( _mm_or_si128( controls, _mm_or_si128( scanBlockEq( block, '\"' ), scanBlockEq( block, '\\' ) ) ) );
+		if ( found != 0 )
+			return i + std::countr_zero( found );
+	}
+#endif
+	while ( i < sz && p[i] >= 0x20 && p[i] != '\"' && p[i] != '\\' )
+		++i;
+	return i;
+}
+
+inline int hexDigitValue( uint8_t ch ) // -1 if not a hex digit
+{
+	if ( ch >= '0' && ch <= '9' )
+		return ch - '0';
+	if ( ch >= 'a' && ch <= 'f' )
+		return ch - 'a' + 10;
+	if ( ch >= 'A' && ch <= 'F' )
+		return ch - 'A' + 10;
+	return -1;
+}
+
+template<class StringT>
+void appendUtf8( StringT& s, uint32_t codePoint ) // within BMP
+{
+	if ( codePoint < 0x80 )
+		s += (char)codePoint;
+	else if ( codePoint < 0x800 )
+	{
+		s += (char)( 0xc0 | ( codePoint >> 6 ) );
+		s += (char)( 0x80 | ( codePoint & 0x3f ) );
+	}
+	else
+	{
+		s += (char)( 0xe0 | ( codePoint >> 12 ) );
+		s += (char)( 0x80 | ( ( codePoint >> 6 ) & 0x3f ) );
+		s += (char)( 0x80 | ( codePoint & 0x3f ) );
+	}
+}
+
+// numbers are printed into a stack buffer (no temporaries); reals are in their shortest round-trip form
+static constexpr size_t max_number_text_size = 32;
+
+template<typename ComposerT, typename T>
+void appendNumber(ComposerT& composer, T num )
+{
+	static_assert( std::is_arithmetic<T>::value && !std::is_same<T, bool>::value );
+	char str[max_number_text_size];
+	auto res = std::to_chars( str, str + max_number_text_size, num );
+	GMQ_ASSERT( res.ec == std::errc() );
+	composer.buff.append( str, res.ptr - str );
+}
+
 template<typename ComposerT, typename T>
 void composeSignedInteger(ComposerT& composer, T num )
 {
@@ -292,8 +798,7 @@ void composeSignedInteger(ComposerT& composer, T num )
 	{
 		GMQ_ASSERT( num <= INT64_MAX );
 	}
-	auto str = fmt::format( "{}", (int64_t)num );
-	composer.buff.append( str.c_str(), str.size() );
+	appendNumber( composer, (int64_t)num );
 }
 
 template<typename ComposerT, typename T>
@@ -303,87 +808,139 @@ void composeUnsignedInteger(ComposerT& composer, T num )
 	{
 		GMQ_ASSERT( num >= 0 );
 	}
-	auto str = fmt::format( "{}", (uint64_t)num );
-	composer.buff.append( str.c_str(), str.size() );
+	appendNumber( composer, (uint64_t)num );
+}
+
+// fixed-width unsigned integer: right-aligned and padded with (insignificant) leading spaces up to the length of UINT64_MAX
+static constexpr size_t fixed_width_uinteger_size = 20;
+
+inline
+void patchFixedWidthUnsignedInteger( uint8_t* slot, uint64_t num )
+{
+	size_t pos = fixed_width_uinteger_size;
+	do
+	{
+		slot[--pos] = (uint8_t)( '0' + num % 10 );
+		num /= 10;
+	}
+	while ( num != 0 );
+	while ( pos != 0 )
+		slot[--pos] = ' ';
+}
+
+template<typename ComposerT>
+void composeFixedWidthUnsignedInteger(ComposerT& composer, uint64_t num )
+{
+	uint8_t slot[fixed_width_uinteger_size];
+	patchFixedWidthUnsignedInteger( slot, num );
+	composer.buff.append( slot, fixed_width_uinteger_size );
 }
 
 template<typename ComposerT, typename T>
 void composeReal(ComposerT& composer, T num )
 {
 	static_assert ( std::is_arithmetic<T>::value );
-	auto str = fmt::format( "{}", num );
-	composer.buff.append( str.c_str(), str.size() );
+	appendNumber( composer, num );
 }
 
-template<class StringT>
-GMQ_COLL string string2JsonString( const StringT& str )
+// clean runs are copied to the buffer as they are; characters that require escaping are written one by one
+template<typename BufferT>
+void appendEscapedString( BufferT& buff, GMQ_COLL string_view str )
 {
-	GMQ_COLL string out;
-	for ( auto& ch : str )
+	const uint8_t* p = reinterpret_cast<const uint8_t*>( str.data() );
+	size_t sz = str.size();
+	size_t pos = 0;
+	for (;;)
 	{
+		size_t run = findCharToEscape( p + pos, sz - pos );
+		if ( run != 0 )
+			buff.append( p + pos, run );
+		pos += run;
+		if ( pos == sz )
+			return;
+		uint8_t ch = p[pos++];
 		switch ( ch )
 		{
 			case '\\':
-				out += "\\\\";
+				buff.append( "\\\\", 2 );
 				break;
 			case '\n':
-				out += "\\n";
+				buff.append( "\\n", 2 );
 				break;
 			case '\r':
-				out += "\\r";
+				buff.append( "\\r", 2 );
 				break;
 			case '\t':
-				out += "\\t";
+				buff.append( "\\t", 2 );
 				break;
 			case '\"':
-				out += "\\\"";
+				buff.append( "\\\"", 2 );
 				break;
-			default:
-				out.push_back( ch );
+			default: // other control chars
+			{
+				static constexpr char hexDigits[] = "0123456789abcdef";
+				char escaped[6] = { '\\', 'u', '0', '0', hexDigits[ch >> 4], hexDigits[ch & 0xf] };
+				buff.append( escaped, sizeof( escaped ) );
+			}
 		}
 	}
-	return out;
+}
+
+template<class StringT>
+GMQ_COLL string string2JsonString( const StringT& str ) // to a separate string, e.g. for diagnostics
+{
+	struct StringAppender
+	{
+		GMQ_COLL string out;
+		void append( const void* dt, size_t sz ) { out.append( reinterpret_cast<const char*>( dt ), sz ); }
+	} appender;
+	appendEscapedString( appender, GMQ_COLL string_view( reinterpret_cast<const char*>( std::to_address( str.begin() ) ), str.size() ) );
+	return appender.out;
 }
 
 template<typename ComposerT>
-void composeString(ComposerT& composer, const GMQ_COLL string& str )
+void composeEscapedString(ComposerT& composer, GMQ_COLL string_view str )
 {
 	composer.buff.appendUint8( '\"' );
-	auto str1 = string2JsonString( str );
-	composer.buff.append( str1.c_str(), str1.size() );
+	appendEscapedString( composer.buff, str );
 	composer.buff.appendUint8( '\"' );
 }
 
+template<typename ComposerT>
+void composeString(ComposerT& composer, const GMQ_COLL string& str )
+{
+	composeEscapedString( composer, str );
+}
+
 template<typename ComposerT>
 void composeString(ComposerT& composer, const StringLiteralForComposing* str )
 {
-	composer.buff.appendUint8( '\"' );
-	auto str1 = string2JsonString( *str );
-	composer.buff.append( str1.c_str(), str1.size() );
-	composer.buff.appendUint8( '\"' );
+	composeEscapedString( composer, GMQ_COLL string_view( str->str, str->size ) );
 }
 
 template<typename ComposerT>
 void composeString(ComposerT& composer, const char* str )
 {
-	size_t sz = strlen( str );
-	composer.buff.appendUint8( '\"' );
-	auto str1 = string2JsonString( GMQ_COLL string( str ) );
-	composer.buff.append( str1.c_str(), str1.size() );
-	composer.buff.appendUint8( '\"' );
+	composeEscapedString( composer, str );
 }
 
 template<typename ComposerT>
-void addNamePart(ComposerT& composer, GMQ_COLL string name )
+void addNamePart(ComposerT& composer, GMQ_COLL string_view name )
 {
 	composer.buff.appendUint8( '\"' );
-	composer.buff.append( name.c_str(), name.size() );
+	composer.buff.append( name.data(), name.size() );
 	composer.buff.appendUint8( '\"' );
 	composer.buff.appendUint8( ':' );
 }
 
-template<typename ComposerT, typename T>
-void composeNamedSignedInteger(ComposerT& composer, GMQ_COLL string name, T num )
+template<typename ComposerT>
+void addNamePart(ComposerT& composer, const JsonKeyForComposing& key )
+{
+	composer.buff.append( key.token, key.tokenSize );
+}
+
+template<typename ComposerT, typename NameT, typename T>
+void composeNamedSignedInteger(ComposerT& composer, const NameT& name, T num )
 {
 	static_assert( std::is_integral<T>::value );
 	if constexpr ( std::is_unsigned<T>::value && sizeof( T ) >= integer_max_size )
@@ -391,52 +948,70 @@ void composeNamedSignedInteger(ComposerT& composer, GMQ_COLL string name, T num
 		GMQ_ASSERT( num <= INT64_MAX );
 	}
 	addNamePart( composer, name );
-	auto str = fmt::format( "{}", (int64_t)num );
-	composer.buff.append( str.c_str(), str.size() );
+	appendNumber( composer, (int64_t)num );
 }
 
-template<typename ComposerT, typename T>
-void composeNamedUnsignedInteger(ComposerT& composer, GMQ_COLL string name, T num )
+template<typename ComposerT, typename NameT, typename T>
+void composeNamedUnsignedInteger(ComposerT& composer, const NameT& name, T num )
 {
 	if constexpr ( std::is_signed<T>::value )
 	{
 		GMQ_ASSERT( num >= 0 );
 	}
 	addNamePart( composer, name );
-	auto str = fmt::format( "{}", (uint64_t)num );
-	composer.buff.append( str.c_str(), str.size() );
+	appendNumber( composer, (uint64_t)num );
 }
 
-template<typename ComposerT, typename T>
-void composeNamedReal(ComposerT& composer, GMQ_COLL string name, T num )
+template<typename ComposerT, typename NameT, typename T>
+void composeNamedReal(ComposerT& composer, const NameT& name, T num )
 {
 	addNamePart( composer, name );
-	auto str = fmt::format( "{}", num );
-	composer.buff.append( str.c_str(), str.size() );
+	appendNumber( composer, num );
 }
 
-template<typename ComposerT>
-void composeNamedString(ComposerT& composer, GMQ_COLL string name, const GMQ_COLL string& str )
+template<typename ComposerT, typename NameT>
+void composeNamedString(ComposerT& composer, const NameT& name, const GMQ_COLL string& str )
 {
 	addNamePart( composer, name );
-	composer.buff.appendUint8( '\"' );
-	auto str1 = string2JsonString( str );
-	composer.buff.append( str1.c_str(), str1.size() );
-	composer.buff.appendUint8( '\"' );
+	composeEscapedString( composer, str );
 }
 
-template<typename ComposerT>
-void composeNamedString(ComposerT& composer, GMQ_COLL string name, const StringLiteralForComposing* str )
+template<typename ComposerT, typename NameT>
+void composeNamedString(ComposerT& composer, const NameT& name, const StringLiteralForComposing* str )
 {
 	addNamePart( composer, name );
-	composer.buff.appendUint8( '\"' );
-	auto str1 = string2JsonString( *str );
-	composer.buff.append( str1.c_str(), str1.size() );
-	composer.buff.appendUint8( '\"' );
+	composeEscapedString( composer, GMQ_COLL string_view( str->str, str->size ) );
 }
 
 } // namespace json
 
+// measuring: compose( measuringComposer ) is called with a composer of the same protocol and settings as a given one, writing to SizeMeasuringBuffer
+template<class ComposerT, class ComposeFnT>
+size_t measureComposedSize( const ComposerT& composer, ComposeFnT&& compose )
+{
+	SizeMeasuringBuffer buff;
+	if constexpr ( ComposerT::proto == Proto::GMQ )
+	{
+		GmqComposer<SizeMeasuringBuffer> measuringComposer( buff );
+		measuringComposer.setLengthPrefixedStrings( composer.lengthPrefixedStrings );
+		compose( measuringComposer );
+	}
+	else
+	{
+		static_assert( ComposerT::proto == Proto::JSON );
+		JsonComposer<SizeMeasuringBuffer> measuringComposer( buff );
+		compose( measuringComposer );
+	}
+	return buff.size();
+}
+
+template<class BufferT>
+void reserveForComposing( BufferT& buff, size_t sz ) // room for sz more bytes, if BufferT supports that
+{
+	if constexpr ( requires { buff.reserveForAppending( sz ); } )
+		buff.reserveForAppending( sz );
+}
+
 } // namespace globalmq::marshalling::impl
 
 // parsing
@@ -455,17 +1030,98 @@ public:
 
 private:
 	RiterT& riter;
+	bool lengthPrefixedStrings = false; // see GmqComposer::lengthPrefixedStrings
+
+	size_t parseDirectStringSize() // length-prefixed: size of string at current position, which must be directly available
+	{
+		uint64_t sz = impl::IntegralVlq::readVlqIntegral( riter );
+		if ( sz > riter.directlyAvailableSize() )
+			throw std::exception(); // TODO: ... (truncated string)
+		return sz;
+	}
+
+	size_t findDirectStringEnd() // NUL-terminated: size of string at current position, which must be directly available with its terminator; terminator is not included
+	{
+		const uint8_t* start = riter.directPeek();
+		const void* term = start != nullptr ? memchr( start, 0, riter.directlyAvailableSize() ) : nullptr;
+		if ( term == nullptr )
+			throw std::exception(); // TODO: ... (unterminated string)
+		return reinterpret_cast<const uint8_t*>( term ) - start;
+	}
+
+	// the following two read a string that may be split across chunks of the buffer: a span at a time, byte by byte where no span is exposed
+	// characters are appended to dest, if any
+
+	void impl_readStringBytes( size_t sz, GMQ_COLL string* dest )
+	{
+		while ( sz != 0 )
+		{
+			size_t avail = riter.directlyAvailableSize();
+			if ( avail != 0 )
+			{
+				avail = avail < sz ? avail : sz;
+				const uint8_t* start = riter.directRead( avail );
+				if ( dest != nullptr )
+					dest->append( reinterpret_cast<const char*>( start ), avail );
+				sz -= avail;
+			}
+			else if ( riter.isData() )
+			{
+				if ( dest != nullptr )
+					dest->push_back( *riter );
+				++riter;
+				--sz;
+			}
+			else
+				throw std::exception(); // TODO: ... (truncated string)
+		}
+	}
+
+	void impl_readNulTerminatedString( GMQ_COLL string* dest ) // terminator is consumed, but not appended
+	{
+		for ( ;; )
+		{
+			const uint8_t* start = riter.directPeek();
+			size_t avail = riter.directlyAvailableSize();
+			if ( start != nullptr && avail != 0 )
+			{
+				const void* term = memchr( start, 0, avail );
+				size_t sz = term != nullptr ? reinterpret_cast<const uint8_t*>( term ) - start : avail;
+				if ( dest != nullptr )
+					dest->append( reinterpret_cast<const char*>( start ), sz );
+				if ( term != nullptr )
+				{
+					riter.directRead( sz + 1 );
+					return;
+				}
+				riter.directRead( sz );
+			}
+			else if ( riter.isData() )
+			{
+				uint8_t ch = *riter;
+				++riter;
+				if ( ch == 0 )
+					return;
+				if ( dest != nullptr )
+					dest->push_back( ch );
+			}
+			else
+				throw std::exception(); // TODO: ... (unterminated string)
+		}
+	}
 
 public:
 	GmqParser( RiterT& riter_ ) : riter( riter_ ) {}
-	GmqParser( const GmqParser& other ) : riter( other.riter ) {}
-	GmqParser& operator = ( const GmqParser& other ) { riter = other.riter; return *this; }
-	GmqParser( GmqParser&& other ) { riter = std::move( other.riter ); }
-	GmqParser& operator = ( GmqParser&& other ) { riter = std::move( other.riter ); return *this; }
+	GmqParser( const GmqParser& other ) : riter( other.riter ), lengthPrefixedStrings( other.lengthPrefixedStrings ) {}
+	GmqParser& operator = ( const GmqParser& other ) { riter = other.riter; lengthPrefixedStrings = other.lengthPrefixedStrings; return *this; }
+	GmqParser( GmqParser&& other ) { riter = std::move( other.riter ); lengthPrefixedStrings = other.lengthPrefixedStrings; }
+	GmqParser& operator = ( GmqParser&& other ) { riter = std::move( other.riter ); lengthPrefixedStrings = other.lengthPrefixedStrings; return *this; }
 	~GmqParser() {}
 
 	RiterT& getIterator() { return riter; }
 	size_t getCurrentOffset() const { return riter.offset(); }
+	void setLengthPrefixedStrings( bool lp ) { lengthPrefixedStrings = lp; }
+	bool isLengthPrefixedStrings() const { return lengthPrefixedStrings; }
 
 	template <typename T>
 	void parseSignedInteger( T* num )
@@ -596,6 +1252,49 @@ public:
 		static_assert( impl::integer_max_size == 8, "revise implementation otherwise" );
 	}
 
+	// contiguous arrays of 64-bit integers; same as parsing element by element
+	template <typename T>
+	void parseSignedIntegers( T* nums, size_t count )
+	{
+		static_assert( std::is_integral<T>::value && sizeof( T ) == impl::integer_max_size );
+		impl::IntegralVlq::readVlqIntegrals<true>( riter, nums, count );
+		if constexpr ( std::is_unsigned<T>::value )
+			for ( size_t i=0; i<count; ++i )
+				GMQ_ASSERT( nums[i] <= INT64_MAX );
+	}
+	template <typename T>
+	void parseUnsignedIntegers( T* nums, size_t count )
+	{
+		static_assert( std::is_integral<T>::value && sizeof( T ) == impl::integer_max_size );
+		impl::IntegralVlq::readVlqIntegrals<false>( riter, nums, count );
+		if constexpr ( std::is_signed<T>::value )
+			for ( size_t i=0; i<count; ++i )
+				GMQ_ASSERT( (uint64_t)nums[i] <= INT64_MAX );
+	}
+
+	void parseFixedWidthUnsignedInteger( uint64_t* num )
+	{
+		uint8_t slot[impl::fixed_width_uinteger_size];
+		size_t dsz = riter.read( slot, impl::fixed_width_uinteger_size );
+		if ( dsz != impl::fixed_width_uinteger_size )
+			throw std::exception(); // TODO (unexpected end of data)
+		*num = impl::readFixedWidthUnsignedInteger( slot );
+	}
+
+	// contiguous arrays of doubles; same as parsing element by element
+	void parseReals( double* nums, size_t count )
+	{
+		size_t dsz = riter.read( nums, count * sizeof( double ) );
+		GMQ_ASSERT( dsz == count * sizeof( double ) );
+	}
+
+	void skipReals( size_t count ) // count comes from the wire: bound it before computing the byte size
+	{
+		if ( count > SIZE_MAX / sizeof( double ) )
+			throw std::exception(); // TODO: ... (truncated vector)
+		adjustParsingPos( count * sizeof( double ) );
+	}
+
 	template <typename T>
 	void parseReal( T* num )
 	{
@@ -673,28 +1372,28 @@ public:
 	void parseString( GMQ_COLL string* str )
 	{
 		str->clear();
-		while( riter.isData() && *riter != 0 )
-		{
-			*str += *riter;
-			++riter;
-		}
-		GMQ_ASSERT( riter.isData() );
-		++riter;
+		if ( lengthPrefixedStrings )
+			impl_readStringBytes( impl::IntegralVlq::readVlqIntegral( riter ), str );
+		else
+			impl_readNulTerminatedString( str );
 	}
 
-	/*void parseString( GMQ_COLL string_view* str )
+	// result refers to the buffer being parsed and is valid as long as the buffer is
+	// therefore, the string must be directly available (that is, not split across chunks of the buffer); parse it to GMQ_COLL string otherwise
+	void parseString( GMQ_COLL string_view* str )
 	{
-		const char* start = reinterpret_cast<char*>(begin);
-		while( *begin++ != 0 );
-		*str = GMQ_COLL string_view( start, reinterpret_cast<char*>(begin) - start - 1 );
-	}*/
+		size_t sz = lengthPrefixedStrings ? parseDirectStringSize() : findDirectStringEnd();
+		*str = GMQ_COLL string_view( reinterpret_cast<const char*>( riter.directRead( sz ) ), sz );
+		if ( !lengthPrefixedStrings )
+			riter.directRead( 1 );
+	}
 
 	void skipString()
 	{
-		while( riter.isData() && *riter != 0 )
-			++riter;
-		GMQ_ASSERT( riter.isData() );
-		++riter;
+		if ( lengthPrefixedStrings )
+			impl_readStringBytes( impl::IntegralVlq::readVlqIntegral( riter ), nullptr );
+		else
+			impl_readNulTerminatedString( nullptr );
 	}
 
 	void adjustParsingPos( size_t sz )
@@ -729,6 +1428,18 @@ public:
 		size_t ctr = 1;
 		while ( riter.isData() )
 		{
+			const uint8_t* start = riter.directPeek();
+			if ( start != nullptr )
+			{
+				riter.directRead( impl::json::findQuoteOrBracket( start, riter.directlyAvailableSize(), left, right ) );
+				if ( !riter.isData() )
+					break;
+			}
+			if ( *riter == '\"' ) // brackets within strings do not count
+			{
+				impl_skipStringBody();
+				continue;
+			}
 			if ( *riter == left )
 				++ctr;
 			else if ( *riter == right )
@@ -744,6 +1455,117 @@ public:
 		}
 	}
 
+	void impl_skipStringBody() // from the opening quote to past the closing one
+	{
+		++riter;
+		while ( riter.isData() )
+		{
+			const uint8_t* start = riter.directPeek();
+			if ( start != nullptr )
+			{
+				riter.directRead( impl::json::findQuoteOrBackslash( start, riter.directlyAvailableSize() ) );
+				if ( !riter.isData() )
+					break;
+			}
+			switch ( *riter )
+			{
+				case '\"':
+					++riter;
+					return;
+				case '\\':
+					++riter;
+					if ( !riter.isData() )
+						throw std::exception(); // TODO
+					switch ( *riter )
+					{
+						case '\\':
+						case 't':
+						case 'r':
+						case 'n':
+						case '\"':
+							break;
+						case 'u':
+							impl_readUnicodeEscape();
+							break;
+						default:
+							throw std::exception(); // TODO (unexpected)
+					}
+					++riter;
+					break;
+				default:
+					++riter;
+			}
+		}
+		throw std::exception(); // TODO
+	}
+
+	uint32_t impl_readUnicodeEscape() // at 'u' of \uXXXX; like with other escape sequences, stops at its last char
+	{
+		uint32_t codePoint = 0;
+		for ( size_t i=0; i<4; ++i )
+		{
+			++riter;
+			if ( !riter.isData() )
+				throw std::exception(); // TODO
+			int digit = impl::json::hexDigitValue( *riter );
+			if ( digit < 0 )
+				throw std::exception(); // TODO (unexpected)
+			codePoint = ( codePoint << 4 ) | digit;
+		}
+		if ( codePoint >= 0xd800 && codePoint <= 0xdfff )
+			throw std::exception(); // TODO (surrogates are not supported)
+		return codePoint;
+	}
+
+	static bool impl_isDigit( uint8_t ch ) { return ch >= '0' && ch <= '9'; }
+	static bool impl_isSignedIntegerChar( uint8_t ch ) { return impl_isDigit( ch ) || ch == '-'; }
+	static bool impl_isRealChar( uint8_t ch ) { return !(ch == ' ' || ch == '\t' || ch == '\r' || ch == '\n' || ch == ',' || ch == ']' || ch == '}'); } // up to expected terminators
+
+	static constexpr size_t max_number_token_size = 64;
+
+	// a token at the current position made of isTokenChar() chars: in place if the iterator exposes it contiguously, otherwise copied to tokenBuff
+	template<class IsTokenCharT>
+	GMQ_COLL string_view impl_readNumberToken( char (&tokenBuff)[max_number_token_size], IsTokenCharT isTokenChar )
+	{
+		const uint8_t* start = riter.directPeek();
+		size_t avail = riter.directlyAvailableSize();
+		if ( start != nullptr )
+		{
+			size_t sz = 0;
+			while ( sz < avail && isTokenChar( start[sz] ) )
+				++sz;
+			if ( sz < avail ) // terminated within the span
+			{
+				riter.directRead( sz );
+				return GMQ_COLL string_view( reinterpret_cast<const char*>( start ), sz );
+			}
+		}
+		size_t sz = 0;
+		while ( riter.isData() && isTokenChar( *riter ) )
+		{
+			if ( sz == max_number_token_size )
+				throw std::exception(); // TODO: (too long for a number)
+			tokenBuff[sz++] = *riter;
+			++riter;
+		}
+		return GMQ_COLL string_view( tokenBuff, sz );
+	}
+
+	template <typename T, typename ParsedT>
+	static void impl_parseNumberToken( GMQ_COLL string_view token, T* num )
+	{
+		ParsedT ret;
+		auto res = std::from_chars( token.data(), token.data() + token.size(), ret );
+		if ( res.ec != std::errc() || res.ptr != token.data() + token.size() )
+			throw std::exception(); // TODO: (not a number, or out of range)
+		if constexpr ( std::is_integral<T>::value && std::is_integral<ParsedT>::value )
+		{
+			if ( !std::in_range<T>( ret ) )
+				throw std::exception(); // TODO: (out of range)
+		}
+		*num = (T)ret;
+	}
+
 public:
 //	JsonParser( MessageT& msg ) : riter( msg.getReadIter() ) {}
 	JsonParser( RiterT& riter_ ) : riter( riter_ ) {}
@@ -755,7 +1577,12 @@ public:
 
 	void skipSpacesEtc()
 	{
-		while ( riter.isData() && ( *riter == ' ' || *riter == '\t' || *riter == '\r' || *riter == '\n' ) ) ++riter;
+		if ( riter.isData() && !impl::json::isSpace( *riter ) ) // most common
+			return;
+		const uint8_t* start = riter.directPeek();
+		if ( start != nullptr )
+			riter.directRead( impl::json::findNonSpace( start, riter.directlyAvailableSize() ) );
+		while ( riter.isData() && impl::json::isSpace( *riter ) ) ++riter;
 	}
 
 	bool isComma()
@@ -797,6 +1624,15 @@ public:
 		bool done = false;
 		while ( (!done) && riter.isData()  )
 		{
+			const uint8_t* start = riter.directPeek();
+			if ( start != nullptr )
+			{
+				size_t sz = impl::json::findQuoteOrBackslash( start, riter.directlyAvailableSize() );
+				s->append( reinterpret_cast<const char*>( start ), sz );
+				riter.directRead( sz );
+				if ( !riter.isData() )
+					break;
+			}
 			switch ( *riter )
 			{
 				case '\"':
@@ -823,6 +1659,9 @@ public:
 						case '\"':
 							*s += '\"';
 							break;
+						case 'u':
+							impl::json::appendUtf8( *s, impl_readUnicodeEscape() );
+							break;
 						default:
 							throw std::exception(); // TODO (unexpected)
 					}
@@ -855,38 +1694,7 @@ public:
 		skipSpacesEtc();
 		if ( *riter != '\"' )
 			throw std::exception(); // TODO
-		++riter;
-		bool done = false;
-		while ( (!done) && riter.isData()  )
-		{
-			switch ( *riter )
-			{
-				case '\"':
-					done = true;
-					break;
-				case '\\':
-					++riter;
-					if ( !riter.isData() )
-						throw std::exception(); // TODO
-					switch ( *riter )
-					{
-						case '\\':
-						case 't':
-						case 'r':
-						case 'n':
-						case '\"':
-							break;
-						default:
-							throw std::exception(); // TODO (unexpected)
-					}
-					++riter;
-				default:
-					++riter;
-			}
-		}
-		if ( !riter.isData() )
-			throw std::exception(); // TODO
-		++riter;
+		impl_skipStringBody();
 	}
 
 	void skipVectorFromJson()
@@ -904,100 +1712,48 @@ public:
 		skipSpacesEtc();
 		if ( *riter == '-' )
 			throw std::exception(); // TODO: (negative is unexpected)
-		GMQ_COLL string s;
-		while ( riter.isData() && (*riter >= '0' && *riter <= '9') )
-		{
-			s += *riter;
-			++riter;
-		}
+		char tokenBuff[max_number_token_size];
+		auto token = impl_readNumberToken( tokenBuff, impl_isDigit );
 		if ( !riter.isData() )
 			throw std::exception(); // TODO
-		char* end = const_cast<char*>(s.c_str());
-		uint64_t ret = strtoull( s.c_str(), &end, 10 );
-		if ( s.c_str() == end )
-			throw std::exception(); // TODO: (NaN)
-		*num = (T)ret; // TODO: add boundary checking
+		impl_parseNumberToken<T, uint64_t>( token, num );
 	}
 	void skipUnsignedIntegerFromJson()
 	{
-		skipSpacesEtc();
-		if ( *riter == '-' )
-			throw std::exception(); // TODO: (negative is unexpected)
-		while ( riter.isData() && (*riter >= '0' && *riter <= '9') )
-			++riter;
-		if ( !riter.isData() )
-			throw std::exception(); // TODO
+		uint64_t dummy;
+		readUnsignedIntegerFromJson( &dummy );
 	}
 
 	template <typename T>
 	void readSignedIntegerFromJson( T* num )
 	{
 		skipSpacesEtc();
-		GMQ_COLL string s;
-		if ( *riter == '-' )
-		{
-			s += *riter;
-			++riter;
-		}
-		while ( riter.isData() && (*riter >= '0' && *riter <= '9') )
-		{
-			s += *riter;
-			++riter;
-		}
+		char tokenBuff[max_number_token_size];
+		auto token = impl_readNumberToken( tokenBuff, impl_isSignedIntegerChar );
 		if ( !riter.isData() )
 			throw std::exception(); // TODO
-		char* end = const_cast<char*>(s.c_str());
-		uint64_t ret = strtoull( s.c_str(), &end, 10 );
-		if ( s.c_str() == end )
-			throw std::exception(); // TODO: (NaN)
-		*num = (T)ret; // TODO: add boundary checking
+		impl_parseNumberToken<T, int64_t>( token, num );
 	}
 	void skipSignedIntegerFromJson()
 	{
-		skipSpacesEtc();
-		if ( *riter == '-' )
-			++riter;
-		while ( riter.isData() && (*riter >= '0' && *riter <= '9') )
-			++riter;
-		if ( !riter.isData() )
-			throw std::exception(); // TODO
+		int64_t dummy;
+		readSignedIntegerFromJson( &dummy );
 	}
 
 	template <typename T>
 	void readRealFromJson( T* num )
 	{
 		skipSpacesEtc();
-		GMQ_COLL string s;
-//		while ( riter.isData() && ((*riter >= '0' && *riter <= '9') || *riter == '.') ) // TODO: more than one '.' in json with errors
-		while ( riter.isData() && !(*riter == ' ' || *riter == '\t' || *riter == '\r' || *riter == '\n' || *riter == ',' || *riter == ']' || *riter == '}') ) // expected terminators
-		{
-			s += *riter;
-			++riter;
-		}
+		char tokenBuff[max_number_token_size];
+		auto token = impl_readNumberToken( tokenBuff, impl_isRealChar );
 		if ( !riter.isData() )
 			throw std::exception(); // TODO
-		char* end = const_cast<char*>(s.c_str());
-		double ret = strtod( s.c_str(), &end );
-		if ( s.c_str() == end )
-			throw std::exception(); // TODO: (NaN)
-		*num = (T)ret; // TODO: add boundary checking
+		impl_parseNumberToken<T, double>( token, num );
 	}
 	void skipRealFromJson()
 	{
-		skipSpacesEtc();
-		GMQ_COLL string s;
-//		while ( riter.isData() && ((*riter >= '0' && *riter <= '9') || *riter == '.') ) // TODO: more than one '.' in json with errors
-		while ( riter.isData() && !(*riter == ' ' || *riter == '\t' || *riter == '\r' || *riter == '\n' || *riter == ',' || *riter == ']' || *riter == '}') ) // expected terminators
-		{
-			s += *riter;
-			++riter;
-		}
-		if ( !riter.isData() )
-			throw std::exception(); // TODO
-		char* end = const_cast<char*>(s.c_str());
-		strtod( s.c_str(), &end ); // let it decide whether it's a number and not some bs
-		if ( s.c_str() == end )
-			throw std::exception(); // TODO: (NaN)
+		double dummy; // let from_chars() decide whether it's a number and not some bs
+		readRealFromJson( &dummy );
 	}
 
 	void readKey(GMQ_COLL string* s)
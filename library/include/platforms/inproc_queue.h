@@ -34,6 +34,11 @@
 #include <thread>
 #include <mutex>
 #include <condition_variable>
+#include <atomic>
+#include <chrono>
+#if defined(_MSC_VER) && ( defined(_M_X64) || defined(_M_IX86) )
+#include <intrin.h>
+#endif
 
 namespace globalmq::marshalling {
 
@@ -114,6 +119,11 @@ public:
 	MWSRFixedSizeQueueWithFlowControl& operator = ( const MWSRFixedSizeQueueWithFlowControl& ) = delete;
 	MWSRFixedSizeQueueWithFlowControl( MWSRFixedSizeQueueWithFlowControl&& ) = delete;
 	MWSRFixedSizeQueueWithFlowControl& operator = ( MWSRFixedSizeQueueWithFlowControl&& ) = delete;
+
+	// stats
+	int getNFulls() { std::unique_lock<std::mutex> lock(mx); return nfulls; }
+	size_t getHwmSize() { std::unique_lock<std::mutex> lock(mx); return hwmsize; }
+
 	void push_back(T&& it) {
 		//if the queue is full, BLOCKS until some space is freed
 		{//creating scope for lock
@@ -204,46 +214,471 @@ public:
 	}
 };
 
+inline void cpuRelax()
+{
+#if defined(__x86_64__) || defined(__i386__)
+	__builtin_ia32_pause();
+#elif defined(_MSC_VER) && ( defined(_M_X64) || defined(_M_IX86) )
+	_mm_pause();
+#elif defined(__aarch64__)
+	asm volatile( "yield" );
+#endif
+}
+
+// Multi-producer/single-consumer ring (cells carry sequence numbers, as in D.Vyukov's bounded queue).
+// Same interface and blocking/timeout/kill semantics as MWSRFixedSizeQueueWithFlowControl,
+// but neither producers nor consumer take a lock unless they have to wait (for a free cell or for a message, respectively);
+// before parking each side spins (on multi-core machines) and then yields for a while.
+// Capacity is set at construction (default: 1 << defaultsz_bits). When the queue is full
+//   - in blocking mode (default) producers block as soon as queue size reaches high watermark, and resume when it drops to low watermark;
+//   - in spill mode producers never block: extra items go to an (unbounded) segmented overflow list, which is drained in order.
+template <class T_, size_t defaultsz_bits>
+class MPSCRingQueueWithFlowControl {
+	static constexpr size_t cacheLineSize = 64;
+	static constexpr unsigned maxSpinCount = 256;
+	static constexpr unsigned yieldCount = 16;
+	static unsigned spinCount() { // spinning on a single core only delays the thread we are waiting for
+		static const unsigned cnt = std::thread::hardware_concurrency() > 1 ? maxSpinCount : 0;
+		return cnt;
+	}
+	static bool backOff( unsigned& attempt ) { // spin, then yield; returns false when it's time to park
+		if ( attempt < spinCount() )
+			cpuRelax();
+		else if ( attempt < spinCount() + yieldCount )
+			std::this_thread::yield();
+		else
+			return false;
+		++attempt;
+		return true;
+	}
+
+	struct alignas(cacheLineSize) Cell
+	{
+		std::atomic<size_t> seq;
+		alignas(T_) uint8_t data[sizeof(T_)];
+		T_* t() { return reinterpret_cast<T_*>(data); }
+	};
+
+	struct SpillSegment
+	{
+		static constexpr size_t segsz = 64;
+		alignas(T_) uint8_t data[segsz * sizeof(T_)]; // as in Cell: items are constructed when spilled and destroyed when read, so that T_ need not be default-constructible
+		SpillSegment* next = nullptr;
+		T_* t( size_t idx ) { return reinterpret_cast<T_*>(data + (idx * sizeof(T_))); }
+	};
+
+	size_t bufsz;
+	size_t mask;
+	size_t highWatermark;
+	size_t lowWatermark;
+	bool spillWhenFull;
+	std::unique_ptr<Cell[]> cells;
+	alignas(cacheLineSize) std::atomic<size_t> enqueuePos = 0; // shared by producers
+	alignas(cacheLineSize) std::atomic<size_t> dequeuePos = 0; // written by consumer only
+
+	// overflow list (spill mode only)
+	alignas(cacheLineSize) std::mutex spillMx;
+	SpillSegment* spillHead = nullptr;
+	SpillSegment* spillTail = nullptr;
+	SpillSegment* spareSegment = nullptr;
+	size_t spillHeadIdx = 0; // next to read from spillHead
+	size_t spillTailIdx = SpillSegment::segsz; // next to write to spillTail
+	std::atomic<size_t> spillSize = 0;
+
+	// parking (slow path only)
+	alignas(cacheLineSize) std::mutex mx;
+	std::condition_variable waitrd;
+	std::condition_variable waitwr;
+	std::atomic<bool> readerParked = false;
+	std::atomic<int> writersParked = 0;
+	std::atomic<bool> killflag = false;
+
+	//stats:
+	std::atomic<int> nfulls = 0;
+	std::atomic<size_t> hwmsize = 0;//high watermark on queue size
+	std::atomic<size_t> nspilled = 0;
+
+public:
+	using T = T_;
+	static constexpr size_t defaultCapacity = (size_t)1 << defaultsz_bits;
+
+	explicit MPSCRingQueueWithFlowControl( size_t capacity = defaultCapacity, bool spillWhenFull_ = false ) : spillWhenFull( spillWhenFull_ ) {
+		GMQ_ASSERT( capacity > 0 );
+		bufsz = 1;
+		while ( bufsz < capacity )
+			bufsz <<= 1;
+		mask = bufsz - 1;
+		highWatermark = bufsz;
+		lowWatermark = bufsz - 1;
+		cells.reset( new Cell[bufsz] );
+		for ( size_t i=0; i<bufsz; ++i )
+			cells[i].seq.store( i, std::memory_order_relaxed );
+	}
+	MPSCRingQueueWithFlowControl( const MPSCRingQueueWithFlowControl& ) = delete;
+	MPSCRingQueueWithFlowControl& operator = ( const MPSCRingQueueWithFlowControl& ) = delete;
+	MPSCRingQueueWithFlowControl( MPSCRingQueueWithFlowControl&& ) = delete;
+	MPSCRingQueueWithFlowControl& operator = ( MPSCRingQueueWithFlowControl&& ) = delete;
+	~MPSCRingQueueWithFlowControl() {
+		size_t pos = dequeuePos.load( std::memory_order_relaxed );
+		for ( ;; ++pos )
+		{
+			Cell& cell = cells[pos & mask];
+			if ( cell.seq.load( std::memory_order_acquire ) != pos + 1 )
+				break;
+			cell.t()->~T();
+			cell.seq.store( pos + bufsz, std::memory_order_relaxed );
+		}
+		while ( spillHead != nullptr )
+		{
+			size_t end = spillHead == spillTail ? spillTailIdx : SpillSegment::segsz;
+			for ( ; spillHeadIdx < end; ++spillHeadIdx )
+				spillHead->t( spillHeadIdx )->~T();
+			SpillSegment* next = spillHead->next;
+			delete spillHead;
+			spillHead = next;
+			spillHeadIdx = 0;
+		}
+		delete spareSegment;
+	}
+
+	// blocking mode: producers block when size reaches high, and resume when it goes down to low (low < high <= capacity)
+	// to be called before the queue is used
+	void setWatermarks( size_t high, size_t low ) {
+		GMQ_ASSERT( low < high && high <= bufsz );
+		highWatermark = high;
+		lowWatermark = low;
+	}
+
+	size_t capacity() const { return bufsz; }
+	size_t size() const {
+		size_t dq = dequeuePos.load( std::memory_order_relaxed );
+		size_t eq = enqueuePos.load( std::memory_order_relaxed );
+		return ( eq > dq ? eq - dq : 0 ) + spillSize.load( std::memory_order_relaxed );
+	}
+
+	// stats
+	int getNFulls() const { return nfulls.load( std::memory_order_relaxed ); } // number of times producers had to block
+	size_t getHwmSize() const { return hwmsize.load( std::memory_order_relaxed ); } // max observed size
+	size_t getSpilledCount() const { return nspilled.load( std::memory_order_relaxed ); } // items that went to overflow list
+
+	void push_back(T&& it) {
+		//if the queue is full, BLOCKS until some space is freed (or spills, see above)
+		if ( killflag.load( std::memory_order_relaxed ) )
+			return;
+		if ( spillWhenFull )
+		{
+			pushOrSpill( std::move( it ) );
+			return;
+		}
+
+		size_t pos;
+		Cell* cell;
+		for ( unsigned spins = 0; ; )
+		{
+			if ( size() < highWatermark && tryAcquireCell( pos, cell ) )
+				break;
+			if ( killflag.load( std::memory_order_relaxed ) )
+				return;
+			if ( backOff( spins ) )
+				continue;
+			// park until the consumer brings the size down to low watermark
+			std::unique_lock<std::mutex> lock(mx);
+			writersParked.fetch_add( 1, std::memory_order_relaxed );
+			std::atomic_thread_fence( std::memory_order_seq_cst );
+			if ( size() > lowWatermark && !killflag.load( std::memory_order_relaxed ) )
+			{
+				waitwr.wait(lock);
+				++nfulls;
+				//this will also count spurious wakeups,
+				//  but they're supposedly rare
+			}
+			writersParked.fetch_sub( 1, std::memory_order_relaxed );
+			spins = 0;
+		}
+
+		new(cell->t()) T(std::move(it));
+		cell->seq.store( pos + 1, std::memory_order_release );
+		onPushed();
+	}
+
+	std::pair<bool, T> pop_front() {
+		waitForMessage( nullptr );
+		if (killflag.load( std::memory_order_acquire ))
+			return std::pair<bool, T>(false, T());
+
+		T ret;
+		size_t popped = popAvailable( &ret, 1 );
+		GMQ_ASSERT( popped == 1 );
+		return std::pair<bool, T>(true, std::move(ret));
+	}
+
+	size_t pop_front( T* messages, size_t count ) {
+		waitForMessage( nullptr );
+		if (killflag.load( std::memory_order_acquire ))
+			return 0;
+
+		size_t popped = popAvailable( messages, count );
+		GMQ_ASSERT( popped > 0 );
+		return popped;
+	}
+
+	size_t pop_front( T* messages, size_t count, uint64_t timeout ) {
+		waitForMessage( &timeout );
+		if (killflag.load( std::memory_order_acquire ))
+			return 0;
+
+		return popAvailable( messages, count );
+	}
+
+	void kill() {
+		{//creating scope for lock
+			std::unique_lock<std::mutex> lock(mx);
+			killflag.store( true, std::memory_order_seq_cst );
+		}//unlocking mx
+
+		waitrd.notify_all();
+		waitwr.notify_all();
+	}
+
+private:
+	bool tryAcquireCell( size_t& pos, Cell*& cell ) {
+		pos = enqueuePos.load( std::memory_order_relaxed );
+		for (;;)
+		{
+			cell = &cells[pos & mask];
+			size_t seq = cell->seq.load( std::memory_order_acquire );
+			intptr_t dif = (intptr_t)seq - (intptr_t)pos;
+			if ( dif == 0 )
+			{
+				if ( enqueuePos.compare_exchange_weak( pos, pos + 1, std::memory_order_relaxed ) )
+					return true;
+			}
+			else if ( dif < 0 )
+				return false; // full
+			else
+				pos = enqueuePos.load( std::memory_order_relaxed );
+		}
+	}
+
+	void pushOrSpill( T&& it ) {
+		// once anything is spilled, everything goes to overflow list until it is drained (otherwise per-producer order might break)
+		size_t pos;
+		Cell* cell;
+		if ( spillSize.load( std::memory_order_acquire ) == 0 && tryAcquireCell( pos, cell ) )
+		{
+			new(cell->t()) T(std::move(it));
+			cell->seq.store( pos + 1, std::memory_order_release );
+		}
+		else
+		{
+			std::unique_lock<std::mutex> lock(spillMx);
+			if ( spillTailIdx == SpillSegment::segsz )
+			{
+				SpillSegment* seg = spareSegment != nullptr ? spareSegment : new SpillSegment;
+				spareSegment = nullptr;
+				seg->next = nullptr;
+				if ( spillTail != nullptr )
+					spillTail->next = seg;
+				else
+				{
+					spillHead = seg;
+					spillHeadIdx = 0;
+				}
+				spillTail = seg;
+				spillTailIdx = 0;
+			}
+			new(spillTail->t( spillTailIdx++ )) T(std::move(it));
+			spillSize.fetch_add( 1, std::memory_order_release );
+			++nspilled;
+		}
+		onPushed();
+	}
+
+	void onPushed() {
+		size_t sz = size();
+		size_t hwm = hwmsize.load( std::memory_order_relaxed );
+		while ( sz > hwm && !hwmsize.compare_exchange_weak( hwm, sz, std::memory_order_relaxed ) );
+
+		std::atomic_thread_fence( std::memory_order_seq_cst );
+		if ( readerParked.load( std::memory_order_relaxed ) )
+		{
+			{ std::unique_lock<std::mutex> lock(mx); }
+			waitrd.notify_one();
+		}
+	}
+
+	bool isReadable() { // consumer side only
+		size_t pos = dequeuePos.load( std::memory_order_relaxed );
+		if ( cells[pos & mask].seq.load( std::memory_order_acquire ) == pos + 1 )
+			return true;
+		// overflow list is read only after everything preceding it in the ring is read
+		return spillSize.load( std::memory_order_acquire ) != 0 && enqueuePos.load( std::memory_order_relaxed ) == pos;
+	}
+
+	void waitForMessage( const uint64_t* timeout ) { // returns when a message is readable, the queue is killed, or timeout expired
+		if ( timeout == nullptr || *timeout != 0 )
+			for ( unsigned spins = 0; ; )
+			{
+				if ( isReadable() || killflag.load( std::memory_order_relaxed ) )
+					return;
+				if ( !backOff( spins ) )
+					break;
+			}
+
+		std::unique_lock<std::mutex> lock(mx);
+		readerParked.store( true, std::memory_order_relaxed );
+		std::atomic_thread_fence( std::memory_order_seq_cst );
+		bool expired = false;
+		while (!isReadable() && !expired && !killflag.load( std::memory_order_relaxed )) {
+			if ( timeout == nullptr )
+				waitrd.wait(lock);
+			else
+				expired = waitrd.wait_for(lock, std::chrono::milliseconds(*timeout)) == std::cv_status::timeout;
+		}
+		readerParked.store( false, std::memory_order_relaxed );
+	}
+
+	size_t popAvailable( T* messages, size_t count ) { // consumer side only
+		size_t pos = dequeuePos.load( std::memory_order_relaxed );
+		size_t sz2move = 0;
+		for ( ; sz2move < count; ++sz2move, ++pos )
+		{
+			Cell& cell = cells[pos & mask];
+			if ( cell.seq.load( std::memory_order_acquire ) != pos + 1 )
+				break;
+			messages[sz2move] = std::move( *cell.t() );
+			cell.t()->~T();
+			cell.seq.store( pos + bufsz, std::memory_order_release );
+		}
+		dequeuePos.store( pos, std::memory_order_relaxed );
+
+		if ( sz2move < count && spillSize.load( std::memory_order_acquire ) != 0 && enqueuePos.load( std::memory_order_relaxed ) == pos )
+			sz2move += popSpilled( messages + sz2move, count - sz2move );
+
+		if ( sz2move )
+		{
+			std::atomic_thread_fence( std::memory_order_seq_cst );
+			int parked = writersParked.load( std::memory_order_relaxed );
+			if ( parked )
+			{
+				size_t sz = size();
+				if ( sz <= lowWatermark )
+				{
+					{ std::unique_lock<std::mutex> lock(mx); }
+					// wake as many writers as can proceed (avoids a herd when many writers are parked)
+					for ( size_t i=0; i<highWatermark - sz && i<(size_t)parked; ++i )
+						waitwr.notify_one();
+				}
+			}
+		}
+		return sz2move;
+	}
+
+	size_t popSpilled( T* messages, size_t count ) { // consumer side only
+		std::unique_lock<std::mutex> lock(spillMx);
+		size_t sz2move = 0;
+		while ( sz2move < count && spillHead != nullptr )
+		{
+			size_t end = spillHead == spillTail ? spillTailIdx : SpillSegment::segsz;
+			for ( ; spillHeadIdx < end && sz2move < count; ++spillHeadIdx )
+			{
+				messages[sz2move++] = std::move( *spillHead->t( spillHeadIdx ) );
+				spillHead->t( spillHeadIdx )->~T();
+			}
+			if ( spillHeadIdx < SpillSegment::segsz )
+				break; // segment is not yet exhausted
+			SpillSegment* done = spillHead;
+			spillHead = done->next;
+			spillHeadIdx = 0;
+			if ( spillHead == nullptr )
+			{
+				spillTail = nullptr;
+				spillTailIdx = SpillSegment::segsz;
+			}
+			if ( spareSegment == nullptr )
+				spareSegment = done;
+			else
+				delete done;
+		}
+		spillSize.fetch_sub( sz2move, std::memory_order_release );
+		return sz2move;
+	}
+};
+
 template<class InterThreadMsgT>
 struct ThreadQueueItem
 {
 	static constexpr uint64_t invalidRecipientID = (uint64_t)(-1);
 	InterThreadMsgT msg;
 	uint64_t recipientID = invalidRecipientID;
+	ParsedMessageHeader parsedHeader; // if valid, header of msg as already parsed by sender (see MetaPool::onMessage())
+	SharedMessageBodyT<InterThreadMsgT> sharedBody; // if valid, message is parsedHeader.header followed by this body shared with other recipients, and msg is empty; only if recipient asked for that (see ThreadQueuePostman::sharedBodies)
 	ThreadQueueItem() {}
 	ThreadQueueItem( InterThreadMsgT&& msg_, uint64_t recipientID_ ) : msg( std::move( msg_ ) ), recipientID( recipientID_ ) {}
+	ThreadQueueItem( InterThreadMsgT&& msg_, uint64_t recipientID_, const ParsedMessageHeader& parsedHeader_ ) : msg( std::move( msg_ ) ), recipientID( recipientID_ ), parsedHeader( parsedHeader_ ) {}
+	ThreadQueueItem( const PublishableStateMessageHeader& header, const SharedMessageBodyT<InterThreadMsgT>& body, uint64_t recipientID_ ) : recipientID( recipientID_ ), parsedHeader( ParsedMessageHeader::composed( header, 0 ) ), sharedBody( body ) {}
 	ThreadQueueItem( const ThreadQueueItem& other ) = delete;
 	ThreadQueueItem& operator = ( const ThreadQueueItem& other ) = delete;
 	ThreadQueueItem( ThreadQueueItem&& other ) noexcept {
 		msg = std::move( other.msg );
 		recipientID = other.recipientID;
 		other.recipientID = invalidRecipientID;
+		parsedHeader = std::move( other.parsedHeader );
+		other.parsedHeader.bodyOffset = PublishableStateMessageHeader::invalidOffset;
+		sharedBody = std::move( other.sharedBody );
 	}
 	ThreadQueueItem& operator = ( ThreadQueueItem&& other ) noexcept {
 		msg = std::move( other.msg );
 		recipientID = other.recipientID;
 		other.recipientID = invalidRecipientID;
+		parsedHeader = std::move( other.parsedHeader );
+		other.parsedHeader.bodyOffset = PublishableStateMessageHeader::invalidOffset;
+		sharedBody = std::move( other.sharedBody );
 		return *this;
 	}
+
+	// msg as a whole; a shared body is copied into it, so only for recipients that need the message bytes (for instance, to send them on)
+	InterThreadMsgT& materialize()
+	{
+		if ( sharedBody.isValid() )
+		{
+			GMQ_ASSERT( msg.size() == 0 );
+			parsedHeader.bodyOffset = sharedBody.materialize( parsedHeader.header, msg );
+			sharedBody = SharedMessageBodyT<InterThreadMsgT>();
+		}
+		return msg;
+	}
 };
 
 template<class InterThreadMsgT>
 class ThreadQueuePostman : public InProcessMessagePostmanBase
 {
 public:
-	using MsgQueue = MWSRFixedSizeQueueWithFlowControl<CircularBuffer<ThreadQueueItem<InterThreadMsgT>, 4>>; // TODO: revise the second param value
+	using MsgQueue = MPSCRingQueueWithFlowControl<ThreadQueueItem<InterThreadMsgT>, 8>; // default capacity; can be set (as well as watermarks and spill mode) per queue
 
 private:
 	MsgQueue& msgQueue;
 	uint64_t recipientID;
+	bool sharedBodies = false; // recipient takes fan-out messages as ThreadQueueItem::sharedBody (see MetaPool::onMessage( msg, parsedHeader, sharedBody )); otherwise, they come as a whole in ThreadQueueItem::msg
 
 public:
-	ThreadQueuePostman( MsgQueue& msgQueue_, uint64_t recipientID_ ) : msgQueue( msgQueue_ ), recipientID( recipientID_ ) {}
+	ThreadQueuePostman( MsgQueue& msgQueue_, uint64_t recipientID_, bool sharedBodies_ = false ) : msgQueue( msgQueue_ ), recipientID( recipientID_ ), sharedBodies( sharedBodies_ ) {}
 	virtual ~ThreadQueuePostman() {}
 	virtual void postMessage( InterThreadMsgT&& msg ) override
 	{
 		msgQueue.push_back( ThreadQueueItem<InterThreadMsgT>({std::move( msg ), recipientID}) );
 	}
+	virtual void postParsedMessage( InterThreadMsgT&& msg, const ParsedMessageHeader& parsed ) override
+	{
+		msgQueue.push_back( ThreadQueueItem<InterThreadMsgT>( std::move( msg ), recipientID, parsed ) );
+	}
+	virtual void postSharedMessage( const PublishableStateMessageHeader& header, const SharedMessageBody& body ) override
+	{
+		if ( sharedBodies )
+			msgQueue.push_back( ThreadQueueItem<InterThreadMsgT>( header, body, recipientID ) );
+		else
+			InProcessMessagePostmanBase::postSharedMessage( header, body );
+	}
 };
 
 template<class PlatformSupportT>
@@ -252,8 +687,8 @@ class GMQThreadQueueTransport : public GMQTransportBase<PlatformSupportT>
 	using BufferT = typename PlatformSupportT::BufferT;
 
 public:
-	GMQThreadQueueTransport( GMQueue<PlatformSupportT>& gmq, GMQ_COLL string name, typename ThreadQueuePostman<BufferT>::MsgQueue& queue, uint64_t recipientID ) : GMQTransportBase<PlatformSupportT>( gmq, name, gmq.template allocPostman<ThreadQueuePostman<BufferT>>( queue, recipientID ) )/*, postman( queue, recipientID )*/ {}
-	GMQThreadQueueTransport( GMQueue<PlatformSupportT>& gmq, typename ThreadQueuePostman<BufferT>::MsgQueue& queue, int recipientID ) : GMQTransportBase<PlatformSupportT>( gmq, gmq.template allocPostman<ThreadQueuePostman<BufferT>>( queue, recipientID ) )/*, postman( queue, recipientID )*/ {}
+	GMQThreadQueueTransport( GMQueue<PlatformSupportT>& gmq, GMQ_COLL string name, typename ThreadQueuePostman<BufferT>::MsgQueue& queue, uint64_t recipientID, bool sharedBodies = false ) : GMQTransportBase<PlatformSupportT>( gmq, name, gmq.template allocPostman<ThreadQueuePostman<BufferT>>( queue, recipientID, sharedBodies ) )/*, postman( queue, recipientID )*/ {}
+	GMQThreadQueueTransport( GMQueue<PlatformSupportT>& gmq, typename ThreadQueuePostman<BufferT>::MsgQueue& queue, int recipientID, bool sharedBodies = false ) : GMQTransportBase<PlatformSupportT>( gmq, gmq.template allocPostman<ThreadQueuePostman<BufferT>>( queue, recipientID, sharedBodies ) )/*, postman( queue, recipientID )*/ {}
 	virtual ~GMQThreadQueueTransport() {}
 };
 
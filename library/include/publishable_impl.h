@@ -109,13 +109,10 @@ class VectorRefWrapper4Set
 protected:
 	VectorT& b;
 	RootT& root;
-	GMQ_COLL vector<size_t> address;
+	PublishableAddress address;
 
 public:
-	VectorRefWrapper4Set( VectorT& actual, RootT& root_, const GMQ_COLL vector<size_t> address_, size_t idx ) : b( actual ), root( root_ ) {
-		address = address_;
-		address.push_back (idx );
-	}
+	VectorRefWrapper4Set( VectorT& actual, RootT& root_, const PublishableAddress& address_, size_t idx ) : b( actual ), root( root_ ), address( address_, idx ) {}
 
 	void remove( size_t idx ) { 
 		GMQ_ASSERT( idx < b.size()); 
@@ -145,7 +142,7 @@ template<class VectorT, class ElemTypeT, class RootT, class RefWrapper4SetT>
 class VectorOfStructRefWrapper4Set : public VectorRefWrapper4Set<VectorT, ElemTypeT, RootT>
 {
 public:
-	VectorOfStructRefWrapper4Set( VectorT& actual, RootT& root_, const GMQ_COLL vector<size_t> address_, size_t idx ) : 
+	VectorOfStructRefWrapper4Set( VectorT& actual, RootT& root_, const PublishableAddress& address_, size_t idx ) : 
 		VectorRefWrapper4Set<VectorT, ElemTypeT, RootT>( actual, root_, address_, idx ) {}
 	auto get4set_at( size_t idx ) { return RefWrapper4SetT(VectorRefWrapper4Set<VectorT, ElemTypeT, RootT>::b[idx], VectorRefWrapper4Set<VectorT, ElemTypeT, RootT>::root, VectorRefWrapper4Set<VectorT, ElemTypeT, RootT>::address, idx); }
 };
@@ -208,24 +205,33 @@ public:
 		if constexpr ( ComposerT::proto == Proto::GMQ )
 		{
 			impl::composeUnsignedInteger( composer, collSz );
-			for ( size_t i=0; i<collSz; ++i )
+			if constexpr ( std::is_same<ElemTypeT, impl::SignedIntegralType>::value && std::is_integral<typename VectorT::value_type>::value && sizeof( typename VectorT::value_type ) == impl::integer_max_size )
+				impl::composeSignedIntegers( composer, what.data(), collSz );
+			else if constexpr ( std::is_same<ElemTypeT, impl::UnsignedIntegralType>::value && std::is_integral<typename VectorT::value_type>::value && sizeof( typename VectorT::value_type ) == impl::integer_max_size )
+				impl::composeUnsignedIntegers( composer, what.data(), collSz );
+			else if constexpr ( std::is_same<ElemTypeT, impl::RealType>::value && std::is_same<typename VectorT::value_type, double>::value )
+				impl::composeReals( composer, what.data(), collSz );
+			else
 			{
-				if constexpr ( std::is_same<ElemTypeT, impl::SignedIntegralType>::value )
-					impl::composeSignedInteger( composer, what[i] );
-				else if constexpr ( std::is_same<ElemTypeT, impl::UnsignedIntegralType>::value )
-					impl::composeUnsignedInteger( composer, what[i] );
-				else if constexpr ( std::is_same<ElemTypeT, impl::RealType>::value )
-					impl::composeReal( composer, what[i] );
-				else if constexpr ( std::is_same<ElemTypeT, impl::StringType>::value )
-					impl::composeString( composer, what[i] );
-				else if constexpr ( std::is_base_of<impl::StructType, ElemTypeT>::value )
+				for ( size_t i=0; i<collSz; ++i )
 				{
-					impl::composeStructBegin( composer );
-					ElemTypeT::compose( composer, what[i] );
-					impl::composeStructEnd( composer );
+					if constexpr ( std::is_same<ElemTypeT, impl::SignedIntegralType>::value )
+						impl::composeSignedInteger( composer, what[i] );
+					else if constexpr ( std::is_same<ElemTypeT, impl::UnsignedIntegralType>::value )
+						impl::composeUnsignedInteger( composer, what[i] );
+					else if constexpr ( std::is_same<ElemTypeT, impl::RealType>::value )
+						impl::composeReal( composer, what[i] );
+					else if constexpr ( std::is_same<ElemTypeT, impl::StringType>::value )
+						impl::composeString( composer, what[i] );
+					else if constexpr ( std::is_base_of<impl::StructType, ElemTypeT>::value )
+					{
+						impl::composeStructBegin( composer );
+						ElemTypeT::compose( composer, what[i] );
+						impl::composeStructEnd( composer );
+					}
+					else
+						static_assert( std::is_same<ElemTypeT, AllowedDataType>::value, "unsupported type" );
 				}
-				else
-					static_assert( std::is_same<ElemTypeT, AllowedDataType>::value, "unsupported type" );
 			}
 		}
 		else
@@ -280,30 +286,48 @@ public:
 		{
 			size_t collSz;
 			parser.parseUnsignedInteger( &collSz );
-			dest.reserve( collSz );
-			for ( size_t i=0; i<collSz; ++i )
+			if constexpr ( std::is_same<ElemTypeT, impl::SignedIntegralType>::value && std::is_integral<typename VectorT::value_type>::value && sizeof( typename VectorT::value_type ) == impl::integer_max_size )
 			{
-				typename VectorT::value_type what;
-				if constexpr ( std::is_same<ElemTypeT, impl::SignedIntegralType>::value )
-					parser.parseSignedInteger( &what );
-				else if constexpr ( std::is_same<ElemTypeT, impl::UnsignedIntegralType>::value )
-					parser.parseUnsignedInteger( &what );
-				else if constexpr ( std::is_same<ElemTypeT, impl::RealType>::value )
-					parser.parseReal( &what );
-				else if constexpr ( std::is_same<ElemTypeT, impl::StringType>::value )
-					parser.parseString( &what );
-				else if constexpr ( std::is_base_of<impl::StructType, ElemTypeT>::value )
+				dest.resize( collSz );
+				parser.parseSignedIntegers( dest.data(), collSz );
+			}
+			else if constexpr ( std::is_same<ElemTypeT, impl::UnsignedIntegralType>::value && std::is_integral<typename VectorT::value_type>::value && sizeof( typename VectorT::value_type ) == impl::integer_max_size )
+			{
+				dest.resize( collSz );
+				parser.parseUnsignedIntegers( dest.data(), collSz );
+			}
+			else if constexpr ( std::is_same<ElemTypeT, impl::RealType>::value && std::is_same<typename VectorT::value_type, double>::value )
+			{
+				dest.resize( collSz );
+				parser.parseReals( dest.data(), collSz );
+			}
+			else
+			{
+				dest.reserve( collSz );
+				for ( size_t i=0; i<collSz; ++i )
 				{
-					impl::parseStructBegin( parser );
-					if constexpr( suppressNotifications )
-						ElemTypeT::parseForStateSyncOrMessageInDepth( parser, what );
+					typename VectorT::value_type what;
+					if constexpr ( std::is_same<ElemTypeT, impl::SignedIntegralType>::value )
+						parser.parseSignedInteger( &what );
+					else if constexpr ( std::is_same<ElemTypeT, impl::UnsignedIntegralType>::value )
+						parser.parseUnsignedInteger( &what );
+					else if constexpr ( std::is_same<ElemTypeT, impl::RealType>::value )
+						parser.parseReal( &what );
+					else if constexpr ( std::is_same<ElemTypeT, impl::StringType>::value )
+						parser.parseString( &what );
+					else if constexpr ( std::is_base_of<impl::StructType, ElemTypeT>::value )
+					{
+						impl::parseStructBegin( parser );
+						if constexpr( suppressNotifications )
+							ElemTypeT::parseForStateSyncOrMessageInDepth( parser, what );
+						else
+							ElemTypeT::parse( parser, what );
+						impl::parseStructEnd( parser );
+					}
 					else
-						ElemTypeT::parse( parser, what );
-					impl::parseStructEnd( parser );
+						static_assert( std::is_same<ElemTypeT, AllowedDataType>::value, "unsupported type" );
+					dest.push_back( what );
 				}
-				else
-					static_assert( std::is_same<ElemTypeT, AllowedDataType>::value, "unsupported type" );
-				dest.push_back( what );
 			}
 		}
 		else
@@ -355,6 +379,40 @@ public:
 				parser.skipDelimiter( ',' );
 		}
 	}
+
+	// skipping (GMQ only): lets views (see generated *_View classes) locate members without decoding preceding ones
+	template<class ParserT, class ProcType>
+	static
+	void skipSingleValue( ParserT& parser ) { 
+		static_assert( ParserT::proto == Proto::GMQ, "skipping is only supported for GMQ" );
+		if constexpr ( std::is_same<ProcType, impl::SignedIntegralType>::value )
+			parser.skipSignedInteger();
+		else if constexpr ( std::is_same<ProcType, impl::UnsignedIntegralType>::value )
+			parser.skipUnsignedInteger();
+		else if constexpr ( std::is_same<ProcType, impl::RealType>::value )
+			parser.skipReal();
+		else if constexpr ( std::is_same<ProcType, impl::StringType>::value )
+			parser.skipString();
+		else if constexpr ( std::is_base_of<impl::StructType, ProcType>::value )
+			ProcType::skip( parser );
+		else
+			static_assert( std::is_same<ProcType, AllowedDataType>::value, "unsupported type" );
+	}
+
+	template<class ParserT, class ElemTypeT>
+	static
+	void skip( ParserT& parser ) { 
+		static_assert( ParserT::proto == Proto::GMQ, "skipping is only supported for GMQ" );
+		size_t collSz;
+		parser.parseUnsignedInteger( &collSz );
+		if constexpr ( std::is_same<ElemTypeT, impl::RealType>::value )
+			parser.skipReals( collSz );
+		else
+		{
+			for ( size_t i=0; i<collSz; ++i )
+				skipSingleValue<ParserT, ElemTypeT>( parser );
+		}
+	}
 };
 
 namespace impl {
@@ -715,6 +773,19 @@ public:
 				parser.skipDelimiter( ',' );
 		}
 	}
+
+	template<class ParserT, class KeyTypeT, class ValueTypeT>
+	static
+	void skip( ParserT& parser ) { 
+		static_assert( ParserT::proto == Proto::GMQ, "skipping is only supported for GMQ" );
+		size_t collSz;
+		parser.parseUnsignedInteger( &collSz );
+		for ( size_t i=0; i<collSz; ++i )
+		{
+			PublishableVectorProcessor::skipSingleValue<ParserT, KeyTypeT>( parser );
+			PublishableVectorProcessor::skipSingleValue<ParserT, ValueTypeT>( parser );
+		}
+	}
 };
 
 template<class DictionaryT>
@@ -783,7 +854,7 @@ public:
 protected:
 	DictionaryT& b;
 	RootT& root;
-	GMQ_COLL vector<size_t> address;
+	PublishableAddress address;
 
 private:
 	/*void finalizeInsertOrUpdateOperation( KeyTypeT key, ValueTypeT value ) { 
@@ -835,10 +906,7 @@ private:
 	}
 
 public:
-	DictionaryRefWrapper4Set( DictionaryT& actual, RootT& root_, const GMQ_COLL vector<size_t> address_, size_t idx ) : b( actual ), root( root_ ) {
-		address = address_;
-		address.push_back (idx );
-	}
+	DictionaryRefWrapper4Set( DictionaryT& actual, RootT& root_, const PublishableAddress& address_, size_t idx ) : b( actual ), root( root_ ), address( address_, idx ) {}
 
 	size_t remove( const key_type& key ) { 
 		size_t ret = b.erase( key );
@@ -889,7 +957,7 @@ template<class DictionaryT, class KeyTypeT, class ValueTypeT, class RootT, class
 class DictionaryOfStructRefWrapper4Set : public DictionaryRefWrapper4Set<DictionaryT, KeyTypeT, ValueTypeT, RootT>
 {
 public:
-	DictionaryOfStructRefWrapper4Set( DictionaryT& actual, RootT& root_, const GMQ_COLL vector<size_t> address_, size_t idx ) : 
+	DictionaryOfStructRefWrapper4Set( DictionaryT& actual, RootT& root_, const PublishableAddress& address_, size_t idx ) : 
 		DictionaryRefWrapper4Set<DictionaryT, KeyTypeT, ValueTypeT, RootT>( actual, root_, address_, idx ) {}
 //	auto get4set_at( size_t idx ) { return RefWrapper4SetT(DictionaryRefWrapper4Set<DictionaryT, ElemTypeT, RootT>::b[idx], DictionaryRefWrapper4Set<DictionaryT, ElemTypeT, RootT>::root, DictionaryRefWrapper4Set<DictionaryT, ElemTypeT, RootT>::address, idx); }
 };
@@ -984,6 +1052,7 @@ struct StateSubscriberData
 {
 	uint64_t IdInPool; // for indexing purposes
 	uint64_t ref_id_at_subscriber;
+	bool fixedRefIdSlots = false; // header layout requested by subscriber
 };
 
 template<class PlatformSupportT>
@@ -999,6 +1068,7 @@ class StatePublisherBase
 public:
 	using ComposerT = ComposerTT;
 	using BufferT = typename ComposerT::BufferType;
+	static constexpr uint64_t unknownChangeCount = invalidValue;
 
 public:
 	uint64_t idx = invalidValue; // for use in pools, etc
@@ -1007,8 +1077,11 @@ public:
 	virtual ~StatePublisherBase() {}
 	// interaction with state wrapper
 	virtual void generateStateSyncMessage( ComposerT& composer ) = 0;
+	virtual size_t serializedSize() { return 0; } // of what generateStateSyncMessage() composes; 0 if unknown
+	virtual uint64_t changeCount() { return unknownChangeCount; } // changes made to the state so far; while it stays the same, so does what generateStateSyncMessage() composes
 	virtual void startTick( BufferT&& buff ) = 0;
 	virtual BufferT&& endTick() = 0;
+	virtual bool setLengthPrefixedStrings( bool /*lengthPrefixed*/ ) { return false; } // for updates composed from next tick on; returns whether they will be length-prefixed
     virtual const char* name() { throw std::exception(); }
 	virtual uint64_t stateTypeID() = 0;
 
@@ -1027,26 +1100,47 @@ class StatePublisherData
 	globalmq::marshalling::StatePublisherBase<ComposerT>* publisher = nullptr;
 	GMQ_COLL vector<StateSubscriberData<PlatformSupportT>> subscribers;
 	uint64_t idx; // in pool
+	bool lengthPrefixedStrings = false; // string encoding of messages of this publisher (of the update of the current tick, in particular)
+
+	// body of subscription responses (state sync), shared by all subscribers that come while the state stays the same
+	SharedMessageBodyT<BufferT> stateSyncSnapshot;
+	uint64_t snapshotChangeCount = StatePublisherBase<ComposerT>::unknownChangeCount;
+	bool snapshotLengthPrefixedStrings = false;
+
+	// latest updates, for subscribers that come back with a state version they have; versions are used only if the log is enabled
+	StateUpdateLogT<BufferT> updateLog;
 
 public:
-	StatePublisherData( uint64_t idx_, globalmq::marshalling::StatePublisherBase<ComposerT>* publisher_ ) : publisher( publisher_ ) {
+	StatePublisherData( uint64_t idx_, globalmq::marshalling::StatePublisherBase<ComposerT>* publisher_, bool lengthPrefixed ) : publisher( publisher_ ) {
 		assert( publisher != nullptr );
 		idx = idx_;
 		publisher->idx = idx_;
+		updateLog.reset( StateUpdateLogT<BufferT>::newEpoch(), 0 );
 		BufferT buff; // just empty
-		publisher->startTick( std::move( buff ) );
+		startTick( std::move( buff ), lengthPrefixed );
 	}
-	void setPublisher( globalmq::marshalling::StatePublisherBase<ComposerT>* publisher_ ) {
+	void setPublisher( globalmq::marshalling::StatePublisherBase<ComposerT>* publisher_, bool lengthPrefixed ) {
 		assert( publisher == nullptr );
 		assert( publisher_ != nullptr );
 		publisher = publisher_;
+		stateSyncSnapshot = SharedMessageBodyT<BufferT>();
+		updateLog.reset( StateUpdateLogT<BufferT>::newEpoch(), 0 );
 		publisher->idx = idx;
 		BufferT buff; // just empty
-		publisher->startTick( std::move( buff ) );
+		startTick( std::move( buff ), lengthPrefixed );
 	}
 	void setUnused( globalmq::marshalling::StatePublisherBase<ComposerT>* publisher_ ) { 
 		assert( publisher == publisher_ );
 		publisher = nullptr;
+		stateSyncSnapshot = SharedMessageBodyT<BufferT>();
+		updateLog.reset( 0, 0 );
+	}
+	void setUpdateLogDepth( size_t depth )
+	{
+		uint64_t epoch = updateLog.epoch();
+		uint64_t version = updateLog.version();
+		updateLog.setDepth( depth );
+		updateLog.reset( epoch, version );
 	}
 	bool isUsed() { return publisher != nullptr; }
 	uint64_t stateTypeID() {
@@ -1055,15 +1149,46 @@ public:
 	}
 
 	// processing requests (by now they seem to be independent on state wrappers)
-	uint64_t onSubscriptionRequest( uint64_t IdInPool, uint64_t ref_id_at_subscriber )
+	uint64_t onSubscriptionRequest( uint64_t IdInPool, uint64_t ref_id_at_subscriber, bool fixedRefIdSlots )
 	{
 		// TODO: who will check uniqueness?
-		subscribers.push_back( StateSubscriberData<PlatformSupportT>({IdInPool, ref_id_at_subscriber}) );
+		subscribers.push_back( StateSubscriberData<PlatformSupportT>({IdInPool, ref_id_at_subscriber, fixedRefIdSlots}) );
 		return subscribers.size() - 1;
 	}
 	void generateStateSyncMessage( ComposerT& composer ) { assert( publisher != nullptr ); publisher->generateStateSyncMessage( composer ); }
+	size_t serializedSize() { assert( publisher != nullptr ); return publisher->serializedSize(); }
+	const SharedMessageBodyT<BufferT>& getStateSyncBody() // composes state sync only if the state has changed since it was composed last time
+	{
+		assert( publisher != nullptr );
+		uint64_t changeCount = publisher->changeCount();
+		if ( stateSyncSnapshot.isValid() && changeCount != StatePublisherBase<ComposerT>::unknownChangeCount &&
+			changeCount == snapshotChangeCount && lengthPrefixedStrings == snapshotLengthPrefixedStrings )
+			return stateSyncSnapshot;
+
+		BufferT buff;
+		ComposerT composer( buff );
+		PublishableStateMessageHeader::applyStringEncoding( composer, lengthPrefixedStrings ); // as if it followed the header
+		if constexpr ( ComposerT::proto == Proto::GMQ || ComposerT::proto == Proto::JSON )
+		{
+			size_t stateSyncSize = serializedSize();
+			if ( stateSyncSize != 0 ) // whole body at once
+				impl::reserveForComposing( buff, stateSyncSize + impl::measureComposedSize( composer, [&]( auto& measuringComposer ) {
+					helperComposePublishableStateMessageEnd( measuringComposer );
+				} ) );
+		}
+		generateStateSyncMessage( composer );
+		helperComposePublishableStateMessageEnd( composer );
+		stateSyncSnapshot = SharedMessageBodyT<BufferT>::template make<ComposerT>( std::move( buff ), 0 );
+		snapshotChangeCount = changeCount;
+		snapshotLengthPrefixedStrings = lengthPrefixedStrings;
+		return stateSyncSnapshot;
+	}
 	BufferT&& getStateUpdateBuff() { return publisher->endTick(); }
-	void startTick( BufferT&& buff ) { assert( publisher != nullptr ); publisher->startTick( std::move( buff ) ); }
+	void startTick( BufferT&& buff, bool lengthPrefixed ) {
+		assert( publisher != nullptr );
+		lengthPrefixedStrings = publisher->setLengthPrefixedStrings( lengthPrefixed );
+		publisher->startTick( std::move( buff ) );
+	}
 	BufferT&& endTick() { assert( publisher != nullptr ); return std::move( publisher->endTick() ); }
 };
 
@@ -1088,6 +1213,8 @@ protected:
 	using BasePublisherT = StatePublisherBase<ComposerT>;
 
 	GMQTransportBase<PlatformSupportT>* transport = nullptr;
+	bool lengthPrefixedStrings = false; // string encoding of messages of publishers, if they support it (see PublishableStateMessageHeader::lengthPrefixedStrings)
+	size_t updateLogDepth = 0; // see setUpdateLogDepth()
 
 public: // TODO: just a tmp approach to continue immediate dev
 	GMQ_COLL vector<StatePublisherData<PlatformSupportT>> publishers;
@@ -1111,12 +1238,14 @@ public:
 		for ( size_t i=0; i<publishers.size(); ++i )
 			if ( !publishers[i].isUsed() )
 			{
-				publishers[i].setPublisher( publisher );
+				publishers[i].setPublisher( publisher, lengthPrefixedStrings );
+				publishers[i].setUpdateLogDepth( updateLogDepth );
 				auto ins = name2publisherMapping.insert( std::move( std::make_pair(publisher->publishableName(), &(publishers[i] ) ) ) );
 				assert( ins.second ); // this should never happen as all names are distinct and we assume only a single state of a particular type in a given pool
 				return i;
 			}
-		publishers.push_back( std::move( StatePublisherData<PlatformSupportT>(publishers.size(), publisher) ) );
+		publishers.push_back( std::move( StatePublisherData<PlatformSupportT>(publishers.size(), publisher, lengthPrefixedStrings) ) );
+		publishers.back().setUpdateLogDepth( updateLogDepth );
 		auto ins = name2publisherMapping.insert( std::move( std::make_pair(publisher->publishableName(), &(publishers[publishers.size() - 1] ) ) ) );
 		assert( ins.second ); // this should never happen as all names are distinct and we assume only a single state of a particular type in a given pool
 		return publishers.size() - 1;
@@ -1135,11 +1264,25 @@ public:
 	}
 
 	void setTransport( GMQTransportBase<PlatformSupportT>* tr ) { transport = tr; }
+	void setLengthPrefixedStrings( bool lengthPrefixed ) { lengthPrefixedStrings = lengthPrefixed; } // takes effect for each publisher from its next tick on
+
+	// if non-zero, messages of publishers are tagged with state versions (see PublishableStateMessageHeader::state_version), and each publisher
+	// keeps up to depth latest updates, so that a subscriber that comes back with a recent enough version gets just updates it has missed
+	void setUpdateLogDepth( size_t depth )
+	{
+		updateLogDepth = depth;
+		for ( auto& publisher : publishers )
+			publisher.setUpdateLogDepth( depth );
+	}
 
 	void onMessage( ParserT& parser )
 	{
 		PublishableStateMessageHeader mh;
 		helperParsePublishableStateMessageBegin( parser, mh );
+		onMessage( parser, mh );
+	}
+	void onMessage( ParserT& parser, const PublishableStateMessageHeader& mh ) // parser is positioned right after header
+	{
 		switch ( mh.type )
 		{
 			case PublishableStateMessageHeader::MsgType::subscriptionRequest:
@@ -1156,24 +1299,32 @@ public:
 					throw std::exception(); // not found / misdirected
 
 				uint64_t id = ++publisherAndItsSubscriberBase;
-				size_t refIdAtPublisher = findres->second->onSubscriptionRequest( id, mh.ref_id_at_subscriber );
+				size_t refIdAtPublisher = findres->second->onSubscriptionRequest( id, mh.ref_id_at_subscriber, mh.fixedRefIdSlots );
 				auto ret = ID2PublisherAndItsSubscriberMapping.insert( std::make_pair( id, std::make_pair( findres->second->idx, refIdAtPublisher ) ) );
 				assert( ret.second );
 
 				PublishableStateMessageHeader hdrBack;
 				hdrBack.type = PublishableStateMessageHeader::MsgType::subscriptionResponse;
+				hdrBack.fixedRefIdSlots = mh.fixedRefIdSlots;
+				hdrBack.lengthPrefixedStrings = findres->second->lengthPrefixedStrings;
 				hdrBack.state_type_id_or_direction = findres->second->stateTypeID();
 				hdrBack.priority = mh.priority;
 				hdrBack.ref_id_at_subscriber = mh.ref_id_at_subscriber;
 				hdrBack.ref_id_at_publisher = id;
 
-				BufferT msgBack;
-				ComposerT composer( msgBack );
-				helperComposePublishableStateMessageBegin( composer, hdrBack );
-				findres->second->generateStateSyncMessage( composer );
-				helperComposePublishableStateMessageEnd( composer );
+				const StateUpdateLogT<BufferT>& updateLog = findres->second->updateLog;
 				assert( transport != nullptr );
-				transport->postMessage( std::move( msgBack ) );
+				if ( mh.hasStateVersion && updateLog.covers( mh.state_epoch, mh.state_version ) ) // subscriber is coming back; just updates it has missed
+				{
+					helperPostStateResync<ComposerT>( *transport, hdrBack, mh.state_epoch, mh.state_version, updateLog.since( mh.state_version ) );
+					break;
+				}
+				hdrBack.hasStateVersion = updateLog.isEnabled();
+				hdrBack.state_version = updateLog.version();
+				hdrBack.state_epoch = updateLog.epoch();
+
+				// a burst of subscribers (say, reconnecting ones) costs a single state sync; each of them gets just own header
+				transport->postSharedMessage( hdrBack, findres->second->getStateSyncBody() );
 
 				break;
 			}
@@ -1193,34 +1344,34 @@ public:
 			mhBase.priority = 0; // TODO: source
 			mhBase.ref_id_at_subscriber = 0; // later
 			mhBase.ref_id_at_publisher = 0; // later
+			mhBase.lengthPrefixedStrings = publisher.lengthPrefixedStrings;
 
 			BufferT stateUpdateBuff = publisher.getStateUpdateBuff();
 
-			BufferT msgBase;
-			ComposerT composer( msgBase );
-			helperComposePublishableStateMessageBegin( composer, mhBase );
-			auto riter = stateUpdateBuff.getReadIter();
-			ParserT stateUpdateBuffParser( riter );
-			copy<typename ParserT::RiterT, typename ComposerT::BufferType>( stateUpdateBuffParser.getIterator(), msgBase );
+			// the update itself (closed as a message body) is shared by all subscribers; only headers are per subscriber
+			ComposerT composer( stateUpdateBuff );
 			helperComposePublishableStateMessageEnd( composer );
+			SharedMessageBodyT<BufferT> body = SharedMessageBodyT<BufferT>::template make<ComposerT>( std::move( stateUpdateBuff ), 0 );
+			if ( publisher.updateLog.isEnabled() )
+			{
+				mhBase.hasStateVersion = true;
+				mhBase.state_version = publisher.updateLog.version() + 1;
+				mhBase.state_epoch = publisher.updateLog.epoch();
+				publisher.updateLog.add( mhBase.state_epoch, mhBase.state_version, body, mhBase.lengthPrefixedStrings );
+			}
 
 			for ( auto& subscriber : publisher.subscribers )
 			{
-				PublishableStateMessageHeader::UpdatedData ud;
-				ud.ref_id_at_publisher = subscriber.IdInPool;
-				ud.update_ref_id_at_publisher = true;
-				ud.update_ref_id_at_subscriber = true;
-//				ud.ref_id_at_subscriber = subscriber.info.ref_id_at_subscriber;
-				ud.ref_id_at_subscriber = subscriber.ref_id_at_subscriber;
-				typename ComposerT::BufferType msgForward;
-				helperParseAndUpdatePublishableStateMessage<ParserT, ComposerT>( msgBase, msgForward, ud );
+				mhBase.ref_id_at_publisher = subscriber.IdInPool;
+				mhBase.ref_id_at_subscriber = subscriber.ref_id_at_subscriber;
+				mhBase.fixedRefIdSlots = subscriber.fixedRefIdSlots;
 
 //				PlatformSupportT::sendMsgFromPublisherToSubscriber( msgForward, subscriber.address.nodeAddr );
 				assert( transport != nullptr );
-				transport->postMessage( std::move( msgForward ) );
+				transport->postSharedMessage( mhBase, body );
 			}
 			BufferT newBuff; // just empty
-			publisher.startTick( std::move( newBuff ) );
+			publisher.startTick( std::move( newBuff ), lengthPrefixedStrings );
 		}
 	}
 };
@@ -1274,11 +1425,15 @@ protected:
 		StateSubscriberT* subscriber;
 		uint64_t ref_id_at_subscriber;
 		uint64_t ref_id_at_publisher;
+		bool hasStateVersion = false; // if publisher tags the state with versions (see StatePublisherPool::setUpdateLogDepth())
+		uint64_t stateVersion = 0; // version of the state subscriber has; subscribing again with it may bring just updates it has missed
+		uint64_t stateEpoch = 0; // publisher instance stateVersion is counted by
 	};
 
 	GMQ_COLL vector<Subscriber> subscribers; // TODO: consider mapping ID -> ptr, if states are supposed to be added and removede dynamically
 
 	GMQTransportBase<PlatformSupportT>* transport = nullptr;
+	bool fixedRefIdSlots = false; // header layout to request; publisher mirrors it in its messages
 
 public:
 
@@ -1318,6 +1473,7 @@ public:
 	}
 
 	void setTransport( GMQTransportBase<PlatformSupportT>* tr ) { transport = tr; }
+	void setFixedRefIdSlots( bool fixed ) { fixedRefIdSlots = fixed; }
 
 	void subscribe( StateSubscriberT* subscriber, GMQ_COLL string path )
 	{
@@ -1328,11 +1484,15 @@ public:
 				ComposerT composer( buff );
 				PublishableStateMessageHeader mh;
 				mh.type = globalmq::marshalling::PublishableStateMessageHeader::MsgType::subscriptionRequest;
+				mh.fixedRefIdSlots = fixedRefIdSlots;
 				mh.priority = 0; // TODO: source
 				mh.state_type_id_or_direction = subscriber->stateTypeID();
 				mh.path = path;
 				assert( subscribers[i].ref_id_at_subscriber == i );
 				mh.ref_id_at_subscriber = subscribers[i].ref_id_at_subscriber;
+				mh.hasStateVersion = subscribers[i].hasStateVersion;
+				mh.state_version = subscribers[i].stateVersion;
+				mh.state_epoch = subscribers[i].stateEpoch;
 				helperComposePublishableStateMessageBegin( composer, mh );
 				helperComposePublishableStateMessageEnd( composer );
 				assert( transport != nullptr );
@@ -1341,10 +1501,14 @@ public:
 			}
 		assert( false ); // not found
 	}
-	void onMessage( ParserT& parser ) 
+	void onMessage( ParserT& parser )
 	{
 		PublishableStateMessageHeader mh;
 		helperParsePublishableStateMessageBegin( parser, mh );
+		onMessage( parser, mh );
+	}
+	void onMessage( ParserT& parser, const PublishableStateMessageHeader& mh ) // parser is positioned right after header
+	{
 		switch ( mh.type )
 		{
 			case PublishableStateMessageHeader::MsgType::subscriptionResponse:
@@ -1352,6 +1516,9 @@ public:
 				if ( mh.ref_id_at_subscriber >= subscribers.size() )
 					throw std::exception(); // TODO: ... (invalid ID)
 				subscribers[mh.ref_id_at_subscriber].ref_id_at_publisher = mh.ref_id_at_publisher;
+				subscribers[mh.ref_id_at_subscriber].hasStateVersion = mh.hasStateVersion;
+				subscribers[mh.ref_id_at_subscriber].stateVersion = mh.state_version;
+				subscribers[mh.ref_id_at_subscriber].stateEpoch = mh.state_epoch;
 				if constexpr ( ParserT::proto == globalmq::marshalling::Proto::JSON )
 					subscribers[mh.ref_id_at_subscriber].subscriber->applyJsonStateSyncMessage( parser );
 				else if constexpr ( ParserT::proto == globalmq::marshalling::Proto::GMQ )
@@ -1367,6 +1534,18 @@ public:
 				// TODO: consider the following:
 				//if ( subscribers[mh.ref_id_at_subscriber].ref_id_at_publisher != mh.ref_id_at_publisher )
 				//	throw std::exception(); // TODO: ... (invalid source)
+				if ( mh.hasStateVersion )
+				{
+					Subscriber& s = subscribers[mh.ref_id_at_subscriber];
+					if ( s.hasStateVersion && mh.state_epoch == s.stateEpoch && mh.state_version <= s.stateVersion )
+					{
+						helperSkipPublishableStateMessageData( parser ); // already applied (say, both before and after subscribing again)
+						break;
+					}
+					s.hasStateVersion = true;
+					s.stateVersion = mh.state_version;
+					s.stateEpoch = mh.state_epoch;
+				}
 				if constexpr ( ParserT::proto == globalmq::marshalling::Proto::JSON )
 					subscribers[mh.ref_id_at_subscriber].subscriber->applyJsonMessageWithUpdates( parser );
 				else if constexpr ( ParserT::proto == globalmq::marshalling::Proto::GMQ )
@@ -1376,6 +1555,13 @@ public:
 
 				break;
 			}
+			case PublishableStateMessageHeader::MsgType::resyncResponse: // state is kept; missed updates follow
+			{
+				if ( mh.ref_id_at_subscriber >= subscribers.size() )
+					throw std::exception(); // TODO: ... (invalid ID)
+				subscribers[mh.ref_id_at_subscriber].ref_id_at_publisher = mh.ref_id_at_publisher;
+				break;
+			}
 			default:
 				throw std::exception(); // TODO: ... (unknown msg type)
 		}
@@ -1459,9 +1645,11 @@ protected:
 	uint64_t connIdxBase = 0;
 
 	GMQTransportBase<PlatformSupportT>* transport = nullptr;
+	bool fixedRefIdSlots = false; // header layout to request; server mirrors it in its messages
 
 public:
 	void setTransport( GMQTransportBase<PlatformSupportT>* tr ) { transport = tr; }
+	void setFixedRefIdSlots( bool fixed ) { fixedRefIdSlots = fixed; }
 
 	uint64_t add( ConnectionT* connection ) // returns connection ID
 	{
@@ -1494,6 +1682,7 @@ public:
 		ComposerT composer( buff );
 		PublishableStateMessageHeader mh;
 		mh.type = globalmq::marshalling::PublishableStateMessageHeader::connectionRequest;
+		mh.fixedRefIdSlots = fixedRefIdSlots;
 		mh.priority = 0; // TODO: source
 		mh.state_type_id_or_direction = PublishableStateMessageHeader::ConnMsgDirection::toServer;
 		mh.path = path;
@@ -1517,6 +1706,7 @@ public:
 		ComposerT composer( buff );
 		PublishableStateMessageHeader mh;
 		mh.type = globalmq::marshalling::PublishableStateMessageHeader::connectionMessage;
+		mh.fixedRefIdSlots = fixedRefIdSlots;
 		mh.priority = 0; // TODO: source
 		mh.state_type_id_or_direction = PublishableStateMessageHeader::ConnMsgDirection::toServer;
 		assert( conn.ref_id_at_client == connID );
@@ -1524,18 +1714,23 @@ public:
 		assert( conn.ref_id_at_server != 0 );
 		mh.ref_id_at_publisher = conn.ref_id_at_server;
 		helperComposePublishableStateMessageBegin( composer, mh );
+		size_t bodyOffset = buff.size();
 		auto riter = msgBuff.getReadIter();
 		::globalmq::marshalling::copy<typename ParserT::RiterT, typename ComposerT::BufferType>( riter, buff );
 
 		helperComposePublishableStateMessageEnd( composer );
 		assert( transport != nullptr );
-		transport->postMessage( std::move( buff ) );
+		transport->postParsedMessage( std::move( buff ), ParsedMessageHeader::composed( mh, bodyOffset ) );
 	}
 
-	void onMessage( ParserT& parser ) 
+	void onMessage( ParserT& parser )
 	{
 		PublishableStateMessageHeader mh;
 		helperParsePublishableStateMessageBegin( parser, mh );
+		onMessage( parser, mh );
+	}
+	void onMessage( ParserT& parser, const PublishableStateMessageHeader& mh ) // parser is positioned right after header
+	{
 		switch ( mh.type )
 		{
 			case PublishableStateMessageHeader::MsgType::connectionAccepted:
@@ -1597,6 +1792,7 @@ protected:
 		OwningPtrToConnection connection;
 		uint64_t ref_id_at_server = 0; // that is, local id
 		uint64_t ref_id_at_client = 0;
+		bool fixedRefIdSlots = false; // header layout requested by client
 	};
 
 	GMQ_COLL unordered_map<uint64_t, ServerConnection> connections;
@@ -1627,24 +1823,29 @@ public:
 		ComposerT composer( buff );
 		PublishableStateMessageHeader mh;
 		mh.type = globalmq::marshalling::PublishableStateMessageHeader::connectionMessage;
+		mh.fixedRefIdSlots = conn.fixedRefIdSlots;
 		mh.priority = 0; // TODO: source
 		mh.state_type_id_or_direction = PublishableStateMessageHeader::ConnMsgDirection::toClient;
 		mh.ref_id_at_subscriber = conn.ref_id_at_client;
 		mh.ref_id_at_publisher = conn.ref_id_at_server;
 		helperComposePublishableStateMessageBegin( composer, mh );
-
+		size_t bodyOffset = buff.size();
 		auto riter = msgBuff.getReadIter();
 		::globalmq::marshalling::copy<typename ParserT::RiterT, typename ComposerT::BufferType>( riter, buff );
 
 		helperComposePublishableStateMessageEnd( composer );
 		assert( transport != nullptr );
-		transport->postMessage( std::move( buff ) );
+		transport->postParsedMessage( std::move( buff ), ParsedMessageHeader::composed( mh, bodyOffset ) );
 	}
 
-	void onMessage( ParserT& parser ) 
+	void onMessage( ParserT& parser )
 	{
 		PublishableStateMessageHeader mh;
 		helperParsePublishableStateMessageBegin( parser, mh );
+		onMessage( parser, mh );
+	}
+	void onMessage( ParserT& parser, const PublishableStateMessageHeader& mh ) // parser is positioned right after header
+	{
 		switch ( mh.type )
 		{
 			case PublishableStateMessageHeader::MsgType::connectionRequest:
@@ -1663,6 +1864,7 @@ public:
 				ServerConnection sc;
 				sc.connection = connFactory.create();
 				sc.ref_id_at_client = mh.ref_id_at_subscriber;
+				sc.fixedRefIdSlots = mh.fixedRefIdSlots;
 				sc.ref_id_at_server = ++connIdxBase;
 				sc.connection->pool = this;
 				sc.connection->connID = sc.ref_id_at_server;
@@ -1672,6 +1874,7 @@ public:
 
 				PublishableStateMessageHeader hdrBack;
 				hdrBack.type = PublishableStateMessageHeader::MsgType::connectionAccepted;
+				hdrBack.fixedRefIdSlots = mh.fixedRefIdSlots;
 				hdrBack.state_type_id_or_direction = PublishableStateMessageHeader::ConnMsgDirection::toClient;
 				hdrBack.priority = mh.priority; // TODO: source?
 				hdrBack.ref_id_at_subscriber = mh.ref_id_at_subscriber;
@@ -1725,6 +1928,13 @@ public:
 		ServerSimpleConnectionPool<PlatformSupportT>::setTransport( tr );
 	}
 
+	// header layout of subscription and connection requests (and, as mirrored by responding sides, of all messages they imply)
+	void setFixedRefIdSlots( bool fixed )
+	{
+		StateSubscriberPool<PlatformSupportT>::setFixedRefIdSlots( fixed );
+		ClientSimpleConnectionPool<PlatformSupportT>::setFixedRefIdSlots( fixed );
+	}
+
 	void addSimpleConnectionFactory( ConnectionFactoryBase<PlatformSupportT>* connFactory, GMQ_COLL string name )
 	{
 		ServerSimpleConnectionPool<PlatformSupportT>::addSimpleConnectionFactory( connFactory, name );
@@ -1760,33 +1970,37 @@ public:
 
 	void onMessage( ParserT& parser )
 	{
-		typename ParserT::RiterT riter( parser.getIterator() );
-		ParserT parser1( riter );
 		PublishableStateMessageHeader mh;
-		helperParsePublishableStateMessageBegin( parser1, mh );
+		helperParsePublishableStateMessageBegin( parser, mh );
+		onMessage( parser, mh );
+	}
+
+	void onMessage( ParserT& parser, const PublishableStateMessageHeader& mh ) // parser is positioned right after header
+	{
 		switch ( mh.type )
 		{
 			case PublishableStateMessageHeader::MsgType::subscriptionResponse:
 			case PublishableStateMessageHeader::MsgType::stateUpdate:
-				StateSubscriberPool<PlatformSupportT>::onMessage( parser );
+			case PublishableStateMessageHeader::MsgType::resyncResponse:
+				StateSubscriberPool<PlatformSupportT>::onMessage( parser, mh );
 				break;
 			case PublishableStateMessageHeader::MsgType::subscriptionRequest:
-				StatePublisherPool<PlatformSupportT>::onMessage( parser );
+				StatePublisherPool<PlatformSupportT>::onMessage( parser, mh );
 				break;
 			case PublishableStateMessageHeader::MsgType::connectionRequest:
-				ServerSimpleConnectionPool<PlatformSupportT>::onMessage( parser );
+				ServerSimpleConnectionPool<PlatformSupportT>::onMessage( parser, mh );
 				break;
 			case PublishableStateMessageHeader::MsgType::connectionAccepted:
-				ClientSimpleConnectionPool<PlatformSupportT>::onMessage( parser );
+				ClientSimpleConnectionPool<PlatformSupportT>::onMessage( parser, mh );
 				break;
 			case PublishableStateMessageHeader::MsgType::connectionMessage:
 				switch ( mh.state_type_id_or_direction )
 				{
 					case PublishableStateMessageHeader::ConnMsgDirection::toClient:
-						ClientSimpleConnectionPool<PlatformSupportT>::onMessage( parser );
+						ClientSimpleConnectionPool<PlatformSupportT>::onMessage( parser, mh );
 						break;
 					case PublishableStateMessageHeader::ConnMsgDirection::toServer:
-						ServerSimpleConnectionPool<PlatformSupportT>::onMessage( parser );
+						ServerSimpleConnectionPool<PlatformSupportT>::onMessage( parser, mh );
 						break;
 					default:
 						throw std::exception(); // TODO: ... (unknown msg type)
@@ -1805,6 +2019,39 @@ public:
 		onMessage( parser );
 	}
 
+	// header of the message may be already parsed by sender (see ThreadQueueItem)
+	void onMessage( BufferT& buffer, const ParsedMessageHeader& parsed )
+	{
+		if ( !parsed.isValid() )
+		{
+			onMessage( buffer );
+			return;
+		}
+		auto riter = buffer.getReadIter();
+		riter.skip( parsed.bodyOffset );
+		ParserT parser( riter );
+		PublishableStateMessageHeader::applyStringEncoding( parser, parsed.header.lengthPrefixedStrings );
+		onMessage( parser, parsed.header );
+	}
+
+	// body of the message is shared with other recipients (see ThreadQueueItem::sharedBody), and is parsed in place
+	void onMessage( const PublishableStateMessageHeader& header, const SharedMessageBodyT<BufferT>& body )
+	{
+		auto riter = body.getReadIter();
+		ParserT parser( riter );
+		PublishableStateMessageHeader::applyStringEncoding( parser, header.lengthPrefixedStrings );
+		onMessage( parser, header );
+	}
+
+	// for recipients of ThreadQueueItem's that take shared bodies (see ThreadQueuePostman::sharedBodies)
+	void onMessage( BufferT& buffer, const ParsedMessageHeader& parsed, const SharedMessageBodyT<BufferT>& sharedBody )
+	{
+		if ( sharedBody.isValid() )
+			onMessage( parsed.header, sharedBody );
+		else
+			onMessage( buffer, parsed );
+	}
+
 	void postAllUpdates()
 	{
 		StatePublisherPool<PlatformSupportT>::postAllUpdates();
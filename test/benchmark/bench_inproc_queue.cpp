@@ -0,0 +1,98 @@
+/* -------------------------------------------------------------------------------
+* Copyright (c) 2021, OLogN Technologies AG
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*	 * Redistributions of source code must retain the above copyright
+*	   notice, this list of conditions and the following disclaimer.
+*	 * Redistributions in binary form must reproduce the above copyright
+*	   notice, this list of conditions and the following disclaimer in the
+*	   documentation and/or other materials provided with the distribution.
+*	 * Neither the name of the OLogN Technologies AG nor the
+*	   names of its contributors may be used to endorse or promote products
+*	   derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL OLogN Technologies AG BE LIABLE FOR ANY
+* DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+* ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* -------------------------------------------------------------------------------*/
+
+// Compares MWSRFixedSizeQueueWithFlowControl (mutex + condvars) and MPSCRingQueueWithFlowControl (lock-free)
+// as used by ThreadQueuePostman: N producer threads, one consumer popping in batches
+
+#include <gmqueue.h>
+#include <platforms/inproc_queue.h>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace globalmq::marshalling;
+
+using ItemT = ThreadQueueItem<Buffer>;
+using MutexQueueT = MWSRFixedSizeQueueWithFlowControl<CircularBuffer<ItemT, 4>>;
+using RingQueueT = MPSCRingQueueWithFlowControl<ItemT, 4>;
+
+template<class QueueT>
+double runOnce( size_t producerCount, size_t msgsPerProducer ) // returns msgs per second
+{
+	QueueT queue;
+	std::vector<std::thread> producers;
+	auto start = std::chrono::steady_clock::now();
+	for ( size_t p=0; p<producerCount; ++p )
+		producers.emplace_back( [&queue, p, msgsPerProducer]() {
+			for ( size_t i=0; i<msgsPerProducer; ++i )
+			{
+				Buffer b;
+				b.append( &i, sizeof(i) );
+				queue.push_back( ItemT( std::move( b ), p ) );
+			}
+		} );
+
+	constexpr size_t maxMsg = 16;
+	ItemT messages[maxMsg];
+	size_t total = producerCount * msgsPerProducer;
+	size_t received = 0;
+	std::vector<size_t> lastSeen( producerCount, 0 );
+	while ( received < total )
+	{
+		size_t popped = queue.pop_front( messages, maxMsg );
+		for ( size_t i=0; i<popped; ++i )
+		{
+			// per-producer order must be preserved
+			size_t val;
+			memcpy( &val, messages[i].msg.begin(), sizeof(val) );
+			if ( val != lastSeen[messages[i].recipientID]++ )
+				throw std::exception();
+		}
+		received += popped;
+	}
+	auto end = std::chrono::steady_clock::now();
+	for ( auto& t : producers )
+		t.join();
+
+	double sec = std::chrono::duration<double>( end - start ).count();
+	return total / sec;
+}
+
+int main( int argc, char* argv[] )
+{
+	size_t totalMsgs = argc > 1 ? strtoull( argv[1], nullptr, 10 ) : 2000000;
+	fmt::print( "{:>10} {:>16} {:>16} {:>8}\n", "producers", "mutex, msg/s", "ring, msg/s", "ratio" );
+	for ( size_t producerCount : { 1, 4, 16 } )
+	{
+		size_t perProducer = totalMsgs / producerCount;
+		double mutexRate = runOnce<MutexQueueT>( producerCount, perProducer );
+		double ringRate = runOnce<RingQueueT>( producerCount, perProducer );
+		fmt::print( "{:>10} {:>16.0f} {:>16.0f} {:>8.2f}\n", producerCount, mutexRate, ringRate, ringRate / mutexRate );
+	}
+	return 0;
+}
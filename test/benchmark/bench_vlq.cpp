@@ -0,0 +1,216 @@
+/* -------------------------------------------------------------------------------
+* Copyright (c) 2021, OLogN Technologies AG
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*	 * Redistributions of source code must retain the above copyright
+*	   notice, this list of conditions and the following disclaimer.
+*	 * Redistributions in binary form must reproduce the above copyright
+*	   notice, this list of conditions and the following disclaimer in the
+*	   documentation and/or other materials provided with the distribution.
+*	 * Neither the name of the OLogN Technologies AG nor the
+*	   names of its contributors may be used to endorse or promote products
+*	   derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL OLogN Technologies AG BE LIABLE FOR ANY
+* DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+* ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* -------------------------------------------------------------------------------*/
+
+// Compares IntegralVlq (element by element, and bulk, as used for VECTOR<INTEGER>/VECTOR<UINTEGER>) with the byte-at-a-time reference codec it replaced,
+// on integers taken from the .gmq files of interop1 test data (any byte stream is a valid sequence of VLQ-encoded integers, so files are simply split into such integers);
+// also checks that all produce identical bytes
+
+#include <marshalling.h>
+
+#include <chrono>
+#include <filesystem>
+#include <vector>
+
+using namespace globalmq::marshalling;
+
+struct ReferenceVlq
+{
+	template<typename ComposerT>
+	static void writeVlqIntegral(ComposerT& composer, uint64_t val)
+	{
+		uint8_t intTemp[10];
+		int ix = 0;
+		uint8_t current = (uint8_t)(val & 0x7f);
+		val >>= 7;
+		intTemp[ix] = current;
+		bool done = val == 0;
+		while (!done)
+		{
+			current = (uint8_t)(val & 0x7f);
+			current += 0x80;
+			val >>= 7;
+			++ix;
+			intTemp[ix] = current;
+			done = val == 0;
+		}
+		while(ix != 0)
+		{
+			composer.buff.appendUint8(intTemp[ix]);
+			--ix;
+		}
+		composer.buff.appendUint8(intTemp[0]);
+	}
+
+	template<typename RiterT>
+	static uint64_t readVlqIntegral(RiterT& riter)
+	{
+		uint64_t result = 0;
+		bool done = false;
+		while (!done && riter.isData())
+		{
+			uint8_t current = *riter;
+			++riter;
+			done = current < 0x80;
+			result <<= 7;
+			result = result | ((uint64_t)current & 0x7f);
+		}
+		return result;
+	}
+};
+
+struct BufferHolder
+{
+	Buffer buff;
+};
+
+template<class VlqT>
+double encode( const std::vector<uint64_t>& values, size_t rounds, Buffer& out ) // returns ns per value
+{
+	auto start = std::chrono::steady_clock::now();
+	for ( size_t r=0; r<rounds; ++r )
+	{
+		BufferHolder composer;
+		for ( auto v : values )
+			VlqT::writeVlqIntegral( composer, v );
+		out = std::move( composer.buff );
+	}
+	auto end = std::chrono::steady_clock::now();
+	return std::chrono::duration<double, std::nano>( end - start ).count() / ( rounds * values.size() );
+}
+
+template<class VlqT>
+double decode( Buffer& in, size_t count, size_t rounds, uint64_t& checksum ) // returns ns per value
+{
+	auto start = std::chrono::steady_clock::now();
+	for ( size_t r=0; r<rounds; ++r )
+	{
+		auto riter = in.getReadIter();
+		for ( size_t i=0; i<count; ++i )
+			checksum += VlqT::readVlqIntegral( riter );
+	}
+	auto end = std::chrono::steady_clock::now();
+	return std::chrono::duration<double, std::nano>( end - start ).count() / ( rounds * count );
+}
+
+double encodeBulk( const std::vector<uint64_t>& values, size_t rounds, Buffer& out ) // returns ns per value
+{
+	auto start = std::chrono::steady_clock::now();
+	for ( size_t r=0; r<rounds; ++r )
+	{
+		BufferHolder composer;
+		impl::IntegralVlq::writeVlqIntegrals<false>( composer, values.data(), values.size() );
+		out = std::move( composer.buff );
+	}
+	auto end = std::chrono::steady_clock::now();
+	return std::chrono::duration<double, std::nano>( end - start ).count() / ( rounds * values.size() );
+}
+
+double decodeBulk( Buffer& in, size_t count, size_t rounds, uint64_t& checksum ) // returns ns per value
+{
+	std::vector<uint64_t> values( count );
+	auto start = std::chrono::steady_clock::now();
+	for ( size_t r=0; r<rounds; ++r )
+	{
+		auto riter = in.getReadIter();
+		impl::IntegralVlq::readVlqIntegrals<false>( riter, values.data(), count );
+		for ( auto v : values )
+			checksum += v;
+	}
+	auto end = std::chrono::steady_clock::now();
+	return std::chrono::duration<double, std::nano>( end - start ).count() / ( rounds * count );
+}
+
+bool run( const char* name, const std::vector<uint64_t>& values, size_t rounds )
+{
+	Buffer refOut, newOut, bulkOut;
+	double refEnc = encode<ReferenceVlq>( values, rounds, refOut );
+	double newEnc = encode<impl::IntegralVlq>( values, rounds, newOut );
+	double bulkEnc = encodeBulk( values, rounds, bulkOut );
+	if ( refOut.size() != newOut.size() || memcmp( refOut.begin(), newOut.begin(), refOut.size() ) != 0 ||
+		refOut.size() != bulkOut.size() || memcmp( refOut.begin(), bulkOut.begin(), refOut.size() ) != 0 )
+	{
+		fmt::print( "{}: encoded data differs\n", name );
+		return false;
+	}
+
+	uint64_t refSum = 0, newSum = 0, bulkSum = 0;
+	double refDec = decode<ReferenceVlq>( refOut, values.size(), rounds, refSum );
+	double newDec = decode<impl::IntegralVlq>( newOut, values.size(), rounds, newSum );
+	double bulkDec = decodeBulk( newOut, values.size(), rounds, bulkSum );
+	if ( refSum != newSum || refSum != bulkSum )
+	{
+		fmt::print( "{}: decoded data differs\n", name );
+		return false;
+	}
+
+	fmt::print( "{:>8} {:>8} {:>16.2f} {:>16.2f} {:>10.2f} {:>8.2f} {:>8.2f}\n", name, "encode", refEnc, newEnc, bulkEnc, refEnc / newEnc, refEnc / bulkEnc );
+	fmt::print( "{:>8} {:>8} {:>16.2f} {:>16.2f} {:>10.2f} {:>8.2f} {:>8.2f}\n", "", "decode", refDec, newDec, bulkDec, refDec / newDec, refDec / bulkDec );
+	return true;
+}
+
+int main( int argc, char* argv[] )
+{
+	std::filesystem::path dataDir = argc > 1 ? argv[1] : "test/interop/interop1/data";
+	size_t rounds = argc > 2 ? strtoull( argv[2], nullptr, 10 ) : 2000;
+	constexpr size_t wideCount = 50000;
+
+	std::vector<uint64_t> values;
+	for ( auto& entry : std::filesystem::directory_iterator( dataDir ) )
+	{
+		if ( entry.path().extension() != ".gmq" )
+			continue;
+		FILE* f = fopen( entry.path().string().c_str(), "rb" );
+		if ( f == nullptr )
+			continue;
+		Buffer b;
+		b.read_file( f );
+		fclose( f );
+		auto riter = b.getReadIter();
+		while ( riter.isData() )
+			values.push_back( ReferenceVlq::readVlqIntegral( riter ) );
+	}
+	if ( values.empty() )
+	{
+		fmt::print( "no .gmq files found in {}\n", dataDir.string() );
+		return 1;
+	}
+
+	// the same integers scaled up to random encoded sizes, to see multi-byte cases (ids, sizes, timestamps) as well;
+	// as many as in a large vector, so that branch predictor cannot learn the sequence
+	std::vector<uint64_t> wideValues;
+	uint64_t seed = 1;
+	for ( size_t i=0; i<wideCount; ++i )
+	{
+		seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+		wideValues.push_back( ( values[i % values.size()] | 1 ) << ( seed >> 58 ) );
+	}
+
+	fmt::print( "{:>8} {:>8} {:>16} {:>16} {:>10} {:>8} {:>8}\n", "", "", "reference, ns", "IntegralVlq, ns", "bulk, ns", "ratio", "bulk" );
+	if ( !run( "corpus", values, rounds ) || !run( "wide", wideValues, rounds * values.size() / wideCount + 1 ) )
+		return 1;
+	return 0;
+}
@@ -11,6 +11,7 @@ int main()
 	testParsingJsonFile();
 	testMessageAliases();
 	testScopedMessageComposingAndParsing();
+	testGmqViews();
 	// publishableTestOne();
 	publishableTestTwo();
 	//quickTestForGmqParts();
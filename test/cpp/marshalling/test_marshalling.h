@@ -890,6 +890,10 @@ struct publishable_STRUCT_AnimZone : public ::globalmq::marshalling::impl::Struc
 	template<class ParserT, class T>
 	static
 	void parseForStateSyncOrMessageInDepth( ParserT& parser, T& t );
+
+	template<class ParserT>
+	static
+	void skip( ParserT& parser );
 };
 
 struct publishable_DISCRIMINATED_UNION_HtmlTextOrTags : public ::globalmq::marshalling::impl::StructType
@@ -898,6 +902,10 @@ struct publishable_DISCRIMINATED_UNION_HtmlTextOrTags : public ::globalmq::marsh
 	static
 	void parseForStateSyncOrMessageInDepth( ParserT& parser, T& t );
 
+	template<class ParserT>
+	static
+	void skip( ParserT& parser );
+
 	template<class ComposerT, class T>
 	static
 	void compose( ComposerT& composer, const T& t );
@@ -908,7 +916,7 @@ struct publishable_DISCRIMINATED_UNION_HtmlTextOrTags : public ::globalmq::marsh
 
 	template<class ParserT, class T, class RetT = void>
 	static
-	RetT parse( ParserT& parser, T& t, GMQ_COLL vector<size_t>& addr, size_t offset );
+	RetT parse( ParserT& parser, T& t, ::globalmq::marshalling::PublishableAddress& addr, size_t offset );
 
 	template<typename UserT>
 	static void copy(const UserT& src, UserT& dst);
@@ -923,6 +931,10 @@ struct publishable_STRUCT_point3D : public ::globalmq::marshalling::impl::Struct
 	static
 	void parseForStateSyncOrMessageInDepth( ParserT& parser, T& t );
 
+	template<class ParserT>
+	static
+	void skip( ParserT& parser );
+
 	template<class ComposerT, class T>
 	static
 	void compose( ComposerT& composer, const T& t );
@@ -933,7 +945,7 @@ struct publishable_STRUCT_point3D : public ::globalmq::marshalling::impl::Struct
 
 	template<class ParserT, class T, class RetT = void>
 	static
-	RetT parse( ParserT& parser, T& t, GMQ_COLL vector<size_t>& addr, size_t offset );
+	RetT parse( ParserT& parser, T& t, ::globalmq::marshalling::PublishableAddress& addr, size_t offset );
 
 	template<typename UserT>
 	static void copy(const UserT& src, UserT& dst);
@@ -947,6 +959,12 @@ struct publishable_STRUCT_Vertex : public ::globalmq::marshalling::impl::StructT
 	template<class ParserT, class T>
 	static
 	void parseForStateSyncOrMessageInDepth( ParserT& parser, T& t );
+
+	template<class ParserT>
+	static
+	void skip( ParserT& parser );
+
+	static constexpr size_t maxGmqSize = 3 * ::globalmq::marshalling::impl::IntegralVlq::maxVlqSize; // fixed layout: upper bound of GMQ-composed size
 };
 
 struct publishable_STRUCT_SIZE : public ::globalmq::marshalling::impl::StructType
@@ -955,6 +973,10 @@ struct publishable_STRUCT_SIZE : public ::globalmq::marshalling::impl::StructTyp
 	static
 	void parseForStateSyncOrMessageInDepth( ParserT& parser, T& t );
 
+	template<class ParserT>
+	static
+	void skip( ParserT& parser );
+
 	template<class ComposerT, class T>
 	static
 	void compose( ComposerT& composer, const T& t );
@@ -965,7 +987,7 @@ struct publishable_STRUCT_SIZE : public ::globalmq::marshalling::impl::StructTyp
 
 	template<class ParserT, class T, class RetT = void>
 	static
-	RetT parse( ParserT& parser, T& t, GMQ_COLL vector<size_t>& addr, size_t offset );
+	RetT parse( ParserT& parser, T& t, ::globalmq::marshalling::PublishableAddress& addr, size_t offset );
 
 	template<typename UserT>
 	static void copy(const UserT& src, UserT& dst);
@@ -979,6 +1001,10 @@ struct publishable_STRUCT_Line_ : public ::globalmq::marshalling::impl::StructTy
 	template<class ParserT, class T>
 	static
 	void parseForStateSyncOrMessageInDepth( ParserT& parser, T& t );
+
+	template<class ParserT>
+	static
+	void skip( ParserT& parser );
 };
 
 struct publishable_STRUCT_PolygonSt : public ::globalmq::marshalling::impl::StructType
@@ -986,6 +1012,10 @@ struct publishable_STRUCT_PolygonSt : public ::globalmq::marshalling::impl::Stru
 	template<class ParserT, class T>
 	static
 	void parseForStateSyncOrMessageInDepth( ParserT& parser, T& t );
+
+	template<class ParserT>
+	static
+	void skip( ParserT& parser );
 };
 
 struct publishable_STRUCT_HtmlTag : public ::globalmq::marshalling::impl::StructType
@@ -994,6 +1024,10 @@ struct publishable_STRUCT_HtmlTag : public ::globalmq::marshalling::impl::Struct
 	static
 	void parseForStateSyncOrMessageInDepth( ParserT& parser, T& t );
 
+	template<class ParserT>
+	static
+	void skip( ParserT& parser );
+
 	template<class ComposerT, class T>
 	static
 	void compose( ComposerT& composer, const T& t );
@@ -1004,7 +1038,7 @@ struct publishable_STRUCT_HtmlTag : public ::globalmq::marshalling::impl::Struct
 
 	template<class ParserT, class T, class RetT = void>
 	static
-	RetT parse( ParserT& parser, T& t, GMQ_COLL vector<size_t>& addr, size_t offset );
+	RetT parse( ParserT& parser, T& t, ::globalmq::marshalling::PublishableAddress& addr, size_t offset );
 
 	template<typename UserT>
 	static void copy(const UserT& src, UserT& dst);
@@ -1019,6 +1053,10 @@ struct publishable_DISCRIMINATED_UNION_du_one : public ::globalmq::marshalling::
 	static
 	void parseForStateSyncOrMessageInDepth( ParserT& parser, T& t );
 
+	template<class ParserT>
+	static
+	void skip( ParserT& parser );
+
 	template<class ComposerT, class T>
 	static
 	void compose( ComposerT& composer, const T& t );
@@ -1029,7 +1067,7 @@ struct publishable_DISCRIMINATED_UNION_du_one : public ::globalmq::marshalling::
 
 	template<class ParserT, class T, class RetT = void>
 	static
-	RetT parse( ParserT& parser, T& t, GMQ_COLL vector<size_t>& addr, size_t offset );
+	RetT parse( ParserT& parser, T& t, ::globalmq::marshalling::PublishableAddress& addr, size_t offset );
 
 	template<typename UserT>
 	static void copy(const UserT& src, UserT& dst);
@@ -1043,6 +1081,12 @@ struct publishable_STRUCT_point : public ::globalmq::marshalling::impl::StructTy
 	template<class ParserT, class T>
 	static
 	void parseForStateSyncOrMessageInDepth( ParserT& parser, T& t );
+
+	template<class ParserT>
+	static
+	void skip( ParserT& parser );
+
+	static constexpr size_t maxGmqSize = 2 * ::globalmq::marshalling::impl::IntegralVlq::maxVlqSize; // fixed layout: upper bound of GMQ-composed size
 };
 
 struct publishable_STRUCT_PolygonMap : public ::globalmq::marshalling::impl::StructType
@@ -1050,6 +1094,10 @@ struct publishable_STRUCT_PolygonMap : public ::globalmq::marshalling::impl::Str
 	template<class ParserT, class T>
 	static
 	void parseForStateSyncOrMessageInDepth( ParserT& parser, T& t );
+
+	template<class ParserT>
+	static
+	void skip( ParserT& parser );
 };
 
 struct publishable_STRUCT_ObstacleMap : public ::globalmq::marshalling::impl::StructType
@@ -1057,6 +1105,10 @@ struct publishable_STRUCT_ObstacleMap : public ::globalmq::marshalling::impl::St
 	template<class ParserT, class T>
 	static
 	void parseForStateSyncOrMessageInDepth( ParserT& parser, T& t );
+
+	template<class ParserT>
+	static
+	void skip( ParserT& parser );
 };
 
 struct publishable_STRUCT_Line : public ::globalmq::marshalling::impl::StructType
@@ -1064,6 +1116,10 @@ struct publishable_STRUCT_Line : public ::globalmq::marshalling::impl::StructTyp
 	template<class ParserT, class T>
 	static
 	void parseForStateSyncOrMessageInDepth( ParserT& parser, T& t );
+
+	template<class ParserT>
+	static
+	void skip( ParserT& parser );
 };
 
 struct publishable_STRUCT_LineMap : public ::globalmq::marshalling::impl::StructType
@@ -1071,6 +1127,10 @@ struct publishable_STRUCT_LineMap : public ::globalmq::marshalling::impl::Struct
 	template<class ParserT, class T>
 	static
 	void parseForStateSyncOrMessageInDepth( ParserT& parser, T& t );
+
+	template<class ParserT>
+	static
+	void skip( ParserT& parser );
 };
 
 struct publishable_STRUCT_POINT3DREAL : public ::globalmq::marshalling::impl::StructType
@@ -1079,6 +1139,10 @@ struct publishable_STRUCT_POINT3DREAL : public ::globalmq::marshalling::impl::St
 	static
 	void parseForStateSyncOrMessageInDepth( ParserT& parser, T& t );
 
+	template<class ParserT>
+	static
+	void skip( ParserT& parser );
+
 	template<class ComposerT, class T>
 	static
 	void compose( ComposerT& composer, const T& t );
@@ -1089,7 +1153,7 @@ struct publishable_STRUCT_POINT3DREAL : public ::globalmq::marshalling::impl::St
 
 	template<class ParserT, class T, class RetT = void>
 	static
-	RetT parse( ParserT& parser, T& t, GMQ_COLL vector<size_t>& addr, size_t offset );
+	RetT parse( ParserT& parser, T& t, ::globalmq::marshalling::PublishableAddress& addr, size_t offset );
 
 	template<typename UserT>
 	static void copy(const UserT& src, UserT& dst);
@@ -1104,6 +1168,10 @@ struct publishable_STRUCT_CharacterParamStruct : public ::globalmq::marshalling:
 	static
 	void parseForStateSyncOrMessageInDepth( ParserT& parser, T& t );
 
+	template<class ParserT>
+	static
+	void skip( ParserT& parser );
+
 	template<class ComposerT, class T>
 	static
 	void compose( ComposerT& composer, const T& t );
@@ -1114,7 +1182,7 @@ struct publishable_STRUCT_CharacterParamStruct : public ::globalmq::marshalling:
 
 	template<class ParserT, class T, class RetT = void>
 	static
-	RetT parse( ParserT& parser, T& t, GMQ_COLL vector<size_t>& addr, size_t offset );
+	RetT parse( ParserT& parser, T& t, ::globalmq::marshalling::PublishableAddress& addr, size_t offset );
 
 	template<typename UserT>
 	static void copy(const UserT& src, UserT& dst);
@@ -1129,6 +1197,10 @@ struct publishable_STRUCT_StructWithVectorOfSize : public ::globalmq::marshallin
 	static
 	void parseForStateSyncOrMessageInDepth( ParserT& parser, T& t );
 
+	template<class ParserT>
+	static
+	void skip( ParserT& parser );
+
 	template<class ComposerT, class T>
 	static
 	void compose( ComposerT& composer, const T& t );
@@ -1139,7 +1211,7 @@ struct publishable_STRUCT_StructWithVectorOfSize : public ::globalmq::marshallin
 
 	template<class ParserT, class T, class RetT = void>
 	static
-	RetT parse( ParserT& parser, T& t, GMQ_COLL vector<size_t>& addr, size_t offset );
+	RetT parse( ParserT& parser, T& t, ::globalmq::marshalling::PublishableAddress& addr, size_t offset );
 
 	template<typename UserT>
 	static void copy(const UserT& src, UserT& dst);
@@ -1154,6 +1226,10 @@ struct publishable_STRUCT_StructWithVectorOfInt : public ::globalmq::marshalling
 	static
 	void parseForStateSyncOrMessageInDepth( ParserT& parser, T& t );
 
+	template<class ParserT>
+	static
+	void skip( ParserT& parser );
+
 	template<class ComposerT, class T>
 	static
 	void compose( ComposerT& composer, const T& t );
@@ -1164,7 +1240,7 @@ struct publishable_STRUCT_StructWithVectorOfInt : public ::globalmq::marshalling
 
 	template<class ParserT, class T, class RetT = void>
 	static
-	RetT parse( ParserT& parser, T& t, GMQ_COLL vector<size_t>& addr, size_t offset );
+	RetT parse( ParserT& parser, T& t, ::globalmq::marshalling::PublishableAddress& addr, size_t offset );
 
 	template<typename UserT>
 	static void copy(const UserT& src, UserT& dst);
@@ -1184,6 +1260,14 @@ struct publishable_STRUCT_StructWithVectorOfInt : public ::globalmq::marshalling
 
 	}
 
+	template<class ParserT>
+	void publishable_STRUCT_AnimZone::skip( ParserT& parser )
+	{
+		static_assert( ParserT::proto == Proto::GMQ, "skipping is only supported for GMQ" );
+		PublishableVectorProcessor::skip<ParserT, publishable_STRUCT_Line_>( parser );
+		PublishableVectorProcessor::skip<ParserT, ::globalmq::marshalling::impl::RealType>( parser );
+	}
+
 	template<class ParserT, class T>
 	void publishable_DISCRIMINATED_UNION_HtmlTextOrTags::parseForStateSyncOrMessageInDepth( ParserT& parser, T& t )
 	{
@@ -1215,25 +1299,47 @@ struct publishable_STRUCT_StructWithVectorOfInt : public ::globalmq::marshalling
 		}
 	}
 
+	template<class ParserT>
+	void publishable_DISCRIMINATED_UNION_HtmlTextOrTags::skip( ParserT& parser )
+	{
+		static_assert( ParserT::proto == Proto::GMQ, "skipping is only supported for GMQ" );
+		uint64_t caseId;
+		parser.parseUnsignedInteger( &caseId );
+		if ( caseId != structures::HtmlTextOrTags::Variants::unknown )
+		{
+			switch ( caseId )
+			{
+				case 21: // IDL CASE text
+					parser.skipString();
+					break;
+				case 22: // IDL CASE taglists
+					PublishableVectorProcessor::skip<ParserT, publishable_STRUCT_HtmlTag>( parser );
+					break;
+				default:
+					throw std::exception(); // unexpected
+			}
+		}
+	}
+
 	template<class ComposerT, class T>
 	void publishable_DISCRIMINATED_UNION_HtmlTextOrTags::compose( ComposerT& composer, const T& t )
 	{
 		uint64_t caseId = t.currentVariant();
-		::globalmq::marshalling::impl::publishableStructComposeUnsignedInteger( composer, caseId, "caseId", true );
+		::globalmq::marshalling::impl::publishableStructComposeUnsignedInteger( composer, caseId, ::globalmq::marshalling::impl::JsonKeyForComposing( "caseId", "\"caseId\":" ), true );
 		if ( caseId != T::Variants::unknown )
 		{
-			::globalmq::marshalling::impl::composePublishableStructBegin( composer, "caseData" );
+			::globalmq::marshalling::impl::composePublishableStructBegin( composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "caseData", "\"caseData\":" ) );
 			switch ( caseId )
 			{
 				case 21: // IDL CASE text
 				{
-					::globalmq::marshalling::impl::publishableStructComposeString( composer, t.str(), "str", false );
+					::globalmq::marshalling::impl::publishableStructComposeString( composer, t.str(), ::globalmq::marshalling::impl::JsonKeyForComposing( "str", "\"str\":" ), false );
 
 					break;
 				}
 				case 22: // IDL CASE taglists
 				{
-					PublishableVectorProcessor::compose<ComposerT, typename T::Case_taglists_tags_T, publishable_STRUCT_HtmlTag>( composer, t.tags(), "tags", false );
+					PublishableVectorProcessor::compose<ComposerT, typename T::Case_taglists_tags_T, publishable_STRUCT_HtmlTag>( composer, t.tags(), ::globalmq::marshalling::impl::JsonKeyForComposing( "tags", "\"tags\":" ), false );
 
 					break;
 				}
@@ -1334,7 +1440,7 @@ struct publishable_STRUCT_StructWithVectorOfInt : public ::globalmq::marshalling
 	}
 
 	template<class ParserT, class T, class RetT>
-	RetT publishable_DISCRIMINATED_UNION_HtmlTextOrTags::parse( ParserT& parser, T& t, GMQ_COLL vector<size_t>& addr, size_t offset )
+	RetT publishable_DISCRIMINATED_UNION_HtmlTextOrTags::parse( ParserT& parser, T& t, ::globalmq::marshalling::PublishableAddress& addr, size_t offset )
 	{
 		static_assert( std::is_same<RetT, bool>::value || std::is_same<RetT, void>::value );
 		constexpr bool reportChanges = std::is_same<RetT, bool>::value;
@@ -1431,7 +1537,7 @@ struct publishable_STRUCT_StructWithVectorOfInt : public ::globalmq::marshalling
 							{
 								typename T::Case_taglists_tags_T oldVectorVal;
 								bool currentChanged = false;
-								constexpr bool alwaysCollectChanges = has_any_notifier_for_tags;
+								constexpr bool alwaysCollectChanges = reportChanges || has_any_notifier_for_tags;
 								if constexpr( alwaysCollectChanges )
 									::globalmq::marshalling::impl::copyVector<typename T::Case_taglists_tags_T, publishable_STRUCT_HtmlTag>( t.tags(), oldVectorVal );
 								if ( addr.size() > offset + 1 ) // one of actions over elements of the vector
@@ -1682,14 +1788,23 @@ struct publishable_STRUCT_StructWithVectorOfInt : public ::globalmq::marshalling
 
 	}
 
+	template<class ParserT>
+	void publishable_STRUCT_point3D::skip( ParserT& parser )
+	{
+		static_assert( ParserT::proto == Proto::GMQ, "skipping is only supported for GMQ" );
+		parser.skipSignedInteger();
+		parser.skipSignedInteger();
+		parser.skipSignedInteger();
+	}
+
 	template<class ComposerT, class T>
 	void publishable_STRUCT_point3D::compose( ComposerT& composer, const T& t )
 	{
-		::globalmq::marshalling::impl::publishableStructComposeInteger( composer, t.x, "x", true );
+		::globalmq::marshalling::impl::publishableStructComposeInteger( composer, t.x, ::globalmq::marshalling::impl::JsonKeyForComposing( "x", "\"x\":" ), true );
 
-		::globalmq::marshalling::impl::publishableStructComposeInteger( composer, t.y, "y", true );
+		::globalmq::marshalling::impl::publishableStructComposeInteger( composer, t.y, ::globalmq::marshalling::impl::JsonKeyForComposing( "y", "\"y\":" ), true );
 
-		::globalmq::marshalling::impl::publishableStructComposeInteger( composer, t.z, "z", false );
+		::globalmq::marshalling::impl::publishableStructComposeInteger( composer, t.z, ::globalmq::marshalling::impl::JsonKeyForComposing( "z", "\"z\":" ), false );
 
 	}
 
@@ -1776,7 +1891,7 @@ struct publishable_STRUCT_StructWithVectorOfInt : public ::globalmq::marshalling
 	}
 
 	template<class ParserT, class T, class RetT>
-	RetT publishable_STRUCT_point3D::parse( ParserT& parser, T& t, GMQ_COLL vector<size_t>& addr, size_t offset )
+	RetT publishable_STRUCT_point3D::parse( ParserT& parser, T& t, ::globalmq::marshalling::PublishableAddress& addr, size_t offset )
 	{
 		static_assert( std::is_same<RetT, bool>::value || std::is_same<RetT, void>::value );
 		constexpr bool reportChanges = std::is_same<RetT, bool>::value;
@@ -1904,6 +2019,15 @@ struct publishable_STRUCT_StructWithVectorOfInt : public ::globalmq::marshalling
 
 	}
 
+	template<class ParserT>
+	void publishable_STRUCT_Vertex::skip( ParserT& parser )
+	{
+		static_assert( ParserT::proto == Proto::GMQ, "skipping is only supported for GMQ" );
+		parser.skipSignedInteger();
+		parser.skipSignedInteger();
+		parser.skipSignedInteger();
+	}
+
 	template<class ParserT, class T>
 	void publishable_STRUCT_SIZE::parseForStateSyncOrMessageInDepth( ParserT& parser, T& t )
 	{
@@ -1915,14 +2039,23 @@ struct publishable_STRUCT_StructWithVectorOfInt : public ::globalmq::marshalling
 
 	}
 
+	template<class ParserT>
+	void publishable_STRUCT_SIZE::skip( ParserT& parser )
+	{
+		static_assert( ParserT::proto == Proto::GMQ, "skipping is only supported for GMQ" );
+		parser.skipReal();
+		parser.skipReal();
+		parser.skipReal();
+	}
+
 	template<class ComposerT, class T>
 	void publishable_STRUCT_SIZE::compose( ComposerT& composer, const T& t )
 	{
-		::globalmq::marshalling::impl::publishableStructComposeReal( composer, t.X, "X", true );
+		::globalmq::marshalling::impl::publishableStructComposeReal( composer, t.X, ::globalmq::marshalling::impl::JsonKeyForComposing( "X", "\"X\":" ), true );
 
-		::globalmq::marshalling::impl::publishableStructComposeReal( composer, t.Y, "Y", true );
+		::globalmq::marshalling::impl::publishableStructComposeReal( composer, t.Y, ::globalmq::marshalling::impl::JsonKeyForComposing( "Y", "\"Y\":" ), true );
 
-		::globalmq::marshalling::impl::publishableStructComposeReal( composer, t.Z, "Z", false );
+		::globalmq::marshalling::impl::publishableStructComposeReal( composer, t.Z, ::globalmq::marshalling::impl::JsonKeyForComposing( "Z", "\"Z\":" ), false );
 
 	}
 
@@ -2009,7 +2142,7 @@ struct publishable_STRUCT_StructWithVectorOfInt : public ::globalmq::marshalling
 	}
 
 	template<class ParserT, class T, class RetT>
-	RetT publishable_STRUCT_SIZE::parse( ParserT& parser, T& t, GMQ_COLL vector<size_t>& addr, size_t offset )
+	RetT publishable_STRUCT_SIZE::parse( ParserT& parser, T& t, ::globalmq::marshalling::PublishableAddress& addr, size_t offset )
 	{
 		static_assert( std::is_same<RetT, bool>::value || std::is_same<RetT, void>::value );
 		constexpr bool reportChanges = std::is_same<RetT, bool>::value;
@@ -2139,6 +2272,14 @@ struct publishable_STRUCT_StructWithVectorOfInt : public ::globalmq::marshalling
 
 	}
 
+	template<class ParserT>
+	void publishable_STRUCT_Line_::skip( ParserT& parser )
+	{
+		static_assert( ParserT::proto == Proto::GMQ, "skipping is only supported for GMQ" );
+		publishable_STRUCT_Vertex::skip( parser );
+		publishable_STRUCT_Vertex::skip( parser );
+	}
+
 	template<class ParserT, class T>
 	void publishable_STRUCT_PolygonSt::parseForStateSyncOrMessageInDepth( ParserT& parser, T& t )
 	{
@@ -2151,6 +2292,14 @@ struct publishable_STRUCT_StructWithVectorOfInt : public ::globalmq::marshalling
 
 	}
 
+	template<class ParserT>
+	void publishable_STRUCT_PolygonSt::skip( ParserT& parser )
+	{
+		static_assert( ParserT::proto == Proto::GMQ, "skipping is only supported for GMQ" );
+		PublishableVectorProcessor::skip<ParserT, publishable_STRUCT_Line_>( parser );
+		publishable_STRUCT_AnimZone::skip( parser );
+	}
+
 	template<class ParserT, class T>
 	void publishable_STRUCT_HtmlTag::parseForStateSyncOrMessageInDepth( ParserT& parser, T& t )
 	{
@@ -2165,14 +2314,23 @@ struct publishable_STRUCT_StructWithVectorOfInt : public ::globalmq::marshalling
 
 	}
 
+	template<class ParserT>
+	void publishable_STRUCT_HtmlTag::skip( ParserT& parser )
+	{
+		static_assert( ParserT::proto == Proto::GMQ, "skipping is only supported for GMQ" );
+		parser.skipString();
+		PublishableDictionaryProcessor::skip<ParserT, ::globalmq::marshalling::impl::StringType, ::globalmq::marshalling::impl::StringType>( parser );
+		publishable_DISCRIMINATED_UNION_HtmlTextOrTags::skip( parser );
+	}
+
 	template<class ComposerT, class T>
 	void publishable_STRUCT_HtmlTag::compose( ComposerT& composer, const T& t )
 	{
-		::globalmq::marshalling::impl::publishableStructComposeString( composer, t.name, "name", true );
+		::globalmq::marshalling::impl::publishableStructComposeString( composer, t.name, ::globalmq::marshalling::impl::JsonKeyForComposing( "name", "\"name\":" ), true );
 
-		PublishableDictionaryProcessor::compose<ComposerT, decltype(T::properties), ::globalmq::marshalling::impl::StringType, ::globalmq::marshalling::impl::StringType>( composer, t.properties, "properties", true );
+		PublishableDictionaryProcessor::compose<ComposerT, decltype(T::properties), ::globalmq::marshalling::impl::StringType, ::globalmq::marshalling::impl::StringType>( composer, t.properties, ::globalmq::marshalling::impl::JsonKeyForComposing( "properties", "\"properties\":" ), true );
 
-		::globalmq::marshalling::impl::composePublishableStructBegin( composer, "tags" );
+		::globalmq::marshalling::impl::composePublishableStructBegin( composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "tags", "\"tags\":" ) );
 		publishable_DISCRIMINATED_UNION_HtmlTextOrTags::compose( composer, t.tags );
 		::globalmq::marshalling::impl::composePublishableStructEnd( composer, false );
 
@@ -2249,7 +2407,6 @@ struct publishable_STRUCT_StructWithVectorOfInt : public ::globalmq::marshalling
 			bool changedCurrent = publishable_DISCRIMINATED_UNION_HtmlTextOrTags::parse<ParserT, decltype(T::tags), bool>( parser, t.tags );
 			if ( changedCurrent )
 			{
-				changed = true;
 				if constexpr ( reportChanges || has_update_notifier )
 					changed = true;
 				if constexpr( has_void_update_notifier_for_tags )
@@ -2269,7 +2426,11 @@ struct publishable_STRUCT_StructWithVectorOfInt : public ::globalmq::marshalling
 			}
 		}
 		else if constexpr ( reportChanges || has_update_notifier )
-			changed = publishable_DISCRIMINATED_UNION_HtmlTextOrTags::parse<ParserT, decltype(T::tags), bool>( parser, t.tags );
+		{
+			bool changedCurrent = publishable_DISCRIMINATED_UNION_HtmlTextOrTags::parse<ParserT, decltype(T::tags), bool>( parser, t.tags );
+			if ( changedCurrent )
+				changed = true;
+		}
 		else
 			publishable_DISCRIMINATED_UNION_HtmlTextOrTags::parse( parser, t.tags );
 		::globalmq::marshalling::impl::parsePublishableStructEnd( parser );
@@ -2284,7 +2445,7 @@ struct publishable_STRUCT_StructWithVectorOfInt : public ::globalmq::marshalling
 	}
 
 	template<class ParserT, class T, class RetT>
-	RetT publishable_STRUCT_HtmlTag::parse( ParserT& parser, T& t, GMQ_COLL vector<size_t>& addr, size_t offset )
+	RetT publishable_STRUCT_HtmlTag::parse( ParserT& parser, T& t, ::globalmq::marshalling::PublishableAddress& addr, size_t offset )
 	{
 		static_assert( std::is_same<RetT, bool>::value || std::is_same<RetT, void>::value );
 		constexpr bool reportChanges = std::is_same<RetT, bool>::value;
@@ -2343,7 +2504,7 @@ struct publishable_STRUCT_StructWithVectorOfInt : public ::globalmq::marshalling
 				{
 					decltype(T::properties) oldDictionaryVal;
 					bool currentChanged = false;
-					constexpr bool alwaysCollectChanges = has_any_notifier_for_properties;
+					constexpr bool alwaysCollectChanges = reportChanges || has_any_notifier_for_properties;
 					//~~~~~~~~~~XXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXX
 					if ( addr.size() > offset + 1 ) // one of actions over elements of the dictionary
 					{
@@ -2520,7 +2681,11 @@ struct publishable_STRUCT_StructWithVectorOfInt : public ::globalmq::marshalling
 					else
 					{
 						if constexpr ( reportChanges || has_update_notifier )
-							changed = publishable_DISCRIMINATED_UNION_HtmlTextOrTags::parse<ParserT, decltype(T::tags), bool>( parser, t.tags );
+						{
+							bool changedCurrent = publishable_DISCRIMINATED_UNION_HtmlTextOrTags::parse<ParserT, decltype(T::tags), bool>( parser, t.tags );
+							if ( changedCurrent )
+								changed = true;
+						}
 						else
 							publishable_DISCRIMINATED_UNION_HtmlTextOrTags::parse( parser, t.tags );
 					}
@@ -2535,7 +2700,6 @@ struct publishable_STRUCT_StructWithVectorOfInt : public ::globalmq::marshalling
 						bool changedCurrent = publishable_DISCRIMINATED_UNION_HtmlTextOrTags::parse<ParserT, decltype(T::tags), bool>( parser, t.tags, addr, offset + 1 );
 						if ( changedCurrent )
 						{
-							changed = true;
 							if constexpr ( reportChanges || has_update_notifier )
 								changed = true;
 							if constexpr( has_void_update_notifier_for_tags )
@@ -2555,7 +2719,11 @@ struct publishable_STRUCT_StructWithVectorOfInt : public ::globalmq::marshalling
 						}
 					}
 					else if constexpr ( reportChanges || has_update_notifier )
-						changed = publishable_DISCRIMINATED_UNION_HtmlTextOrTags::parse<ParserT, decltype(T::tags), bool>( parser, t.tags, addr, offset + 1 );
+					{
+						bool changedCurrent = publishable_DISCRIMINATED_UNION_HtmlTextOrTags::parse<ParserT, decltype(T::tags), bool>( parser, t.tags, addr, offset + 1 );
+						if ( changedCurrent )
+							changed = true;
+					}
 					else
 						publishable_DISCRIMINATED_UNION_HtmlTextOrTags::parse( parser, t.tags, addr, offset + 1 );
 				}
@@ -2626,31 +2794,55 @@ struct publishable_STRUCT_StructWithVectorOfInt : public ::globalmq::marshalling
 		}
 	}
 
+	template<class ParserT>
+	void publishable_DISCRIMINATED_UNION_du_one::skip( ParserT& parser )
+	{
+		static_assert( ParserT::proto == Proto::GMQ, "skipping is only supported for GMQ" );
+		uint64_t caseId;
+		parser.parseUnsignedInteger( &caseId );
+		if ( caseId != structures::du_one::Variants::unknown )
+		{
+			switch ( caseId )
+			{
+				case 1: // IDL CASE one
+					publishable_STRUCT_point3D::skip( parser );
+					parser.skipSignedInteger();
+					break;
+				case 2: // IDL CASE two
+					parser.skipSignedInteger();
+					PublishableVectorProcessor::skip<ParserT, ::globalmq::marshalling::impl::RealType>( parser );
+					break;
+				default:
+					throw std::exception(); // unexpected
+			}
+		}
+	}
+
 	template<class ComposerT, class T>
 	void publishable_DISCRIMINATED_UNION_du_one::compose( ComposerT& composer, const T& t )
 	{
 		uint64_t caseId = t.currentVariant();
-		::globalmq::marshalling::impl::publishableStructComposeUnsignedInteger( composer, caseId, "caseId", true );
+		::globalmq::marshalling::impl::publishableStructComposeUnsignedInteger( composer, caseId, ::globalmq::marshalling::impl::JsonKeyForComposing( "caseId", "\"caseId\":" ), true );
 		if ( caseId != T::Variants::unknown )
 		{
-			::globalmq::marshalling::impl::composePublishableStructBegin( composer, "caseData" );
+			::globalmq::marshalling::impl::composePublishableStructBegin( composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "caseData", "\"caseData\":" ) );
 			switch ( caseId )
 			{
 				case 1: // IDL CASE one
 				{
-					::globalmq::marshalling::impl::composePublishableStructBegin( composer, "pt3d_1" );
+					::globalmq::marshalling::impl::composePublishableStructBegin( composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "pt3d_1", "\"pt3d_1\":" ) );
 					publishable_STRUCT_point3D::compose( composer, t.pt3d_1() );
 					::globalmq::marshalling::impl::composePublishableStructEnd( composer, true );
 
-					::globalmq::marshalling::impl::publishableStructComposeInteger( composer, t.i_1(), "i_1", false );
+					::globalmq::marshalling::impl::publishableStructComposeInteger( composer, t.i_1(), ::globalmq::marshalling::impl::JsonKeyForComposing( "i_1", "\"i_1\":" ), false );
 
 					break;
 				}
 				case 2: // IDL CASE two
 				{
-					::globalmq::marshalling::impl::publishableStructComposeInteger( composer, t.i_2(), "i_2", true );
+					::globalmq::marshalling::impl::publishableStructComposeInteger( composer, t.i_2(), ::globalmq::marshalling::impl::JsonKeyForComposing( "i_2", "\"i_2\":" ), true );
 
-					PublishableVectorProcessor::compose<ComposerT, typename T::Case_two_vp_2_T, ::globalmq::marshalling::impl::RealType>( composer, t.vp_2(), "vp_2", false );
+					PublishableVectorProcessor::compose<ComposerT, typename T::Case_two_vp_2_T, ::globalmq::marshalling::impl::RealType>( composer, t.vp_2(), ::globalmq::marshalling::impl::JsonKeyForComposing( "vp_2", "\"vp_2\":" ), false );
 
 					break;
 				}
@@ -2710,7 +2902,6 @@ struct publishable_STRUCT_StructWithVectorOfInt : public ::globalmq::marshalling
 						bool changedCurrent = publishable_STRUCT_point3D::parse<ParserT, typename T::Case_one_pt3d_1_T, bool>( parser, t.pt3d_1() );
 						if ( changedCurrent )
 						{
-							changed = true;
 							if constexpr ( reportChanges || has_update_notifier )
 								changed = true;
 							if constexpr( has_void_update_notifier_for_pt3d_1 )
@@ -2730,7 +2921,11 @@ struct publishable_STRUCT_StructWithVectorOfInt : public ::globalmq::marshalling
 						}
 					}
 					else if constexpr ( reportChanges || has_update_notifier )
-						changed = publishable_STRUCT_point3D::parse<ParserT, typename T::Case_one_pt3d_1_T, bool>( parser, t.pt3d_1() );
+					{
+						bool changedCurrent = publishable_STRUCT_point3D::parse<ParserT, typename T::Case_one_pt3d_1_T, bool>( parser, t.pt3d_1() );
+						if ( changedCurrent )
+							changed = true;
+					}
 					else
 						publishable_STRUCT_point3D::parse( parser, t.pt3d_1() );
 					::globalmq::marshalling::impl::parsePublishableStructEnd( parser );
@@ -2807,7 +3002,7 @@ struct publishable_STRUCT_StructWithVectorOfInt : public ::globalmq::marshalling
 	}
 
 	template<class ParserT, class T, class RetT>
-	RetT publishable_DISCRIMINATED_UNION_du_one::parse( ParserT& parser, T& t, GMQ_COLL vector<size_t>& addr, size_t offset )
+	RetT publishable_DISCRIMINATED_UNION_du_one::parse( ParserT& parser, T& t, ::globalmq::marshalling::PublishableAddress& addr, size_t offset )
 	{
 		static_assert( std::is_same<RetT, bool>::value || std::is_same<RetT, void>::value );
 		constexpr bool reportChanges = std::is_same<RetT, bool>::value;
@@ -2906,7 +3101,11 @@ struct publishable_STRUCT_StructWithVectorOfInt : public ::globalmq::marshalling
 								else
 								{
 									if constexpr ( reportChanges || has_update_notifier )
-										changed = publishable_STRUCT_point3D::parse<ParserT, typename T::Case_one_pt3d_1_T, bool>( parser, t.pt3d_1() );
+									{
+										bool changedCurrent = publishable_STRUCT_point3D::parse<ParserT, typename T::Case_one_pt3d_1_T, bool>( parser, t.pt3d_1() );
+										if ( changedCurrent )
+											changed = true;
+									}
 									else
 										publishable_STRUCT_point3D::parse( parser, t.pt3d_1() );
 								}
@@ -2921,7 +3120,6 @@ struct publishable_STRUCT_StructWithVectorOfInt : public ::globalmq::marshalling
 									bool changedCurrent = publishable_STRUCT_point3D::parse<ParserT, typename T::Case_one_pt3d_1_T, bool>( parser, t.pt3d_1(), addr, offset + 1 );
 									if ( changedCurrent )
 									{
-										changed = true;
 										if constexpr ( reportChanges || has_update_notifier )
 											changed = true;
 										if constexpr( has_void_update_notifier_for_pt3d_1 )
@@ -2941,7 +3139,11 @@ struct publishable_STRUCT_StructWithVectorOfInt : public ::globalmq::marshalling
 									}
 								}
 								else if constexpr ( reportChanges || has_update_notifier )
-									changed = publishable_STRUCT_point3D::parse<ParserT, typename T::Case_one_pt3d_1_T, bool>( parser, t.pt3d_1(), addr, offset + 1 );
+								{
+									bool changedCurrent = publishable_STRUCT_point3D::parse<ParserT, typename T::Case_one_pt3d_1_T, bool>( parser, t.pt3d_1(), addr, offset + 1 );
+									if ( changedCurrent )
+										changed = true;
+								}
 								else
 									publishable_STRUCT_point3D::parse( parser, t.pt3d_1(), addr, offset + 1 );
 							}
@@ -3007,7 +3209,7 @@ struct publishable_STRUCT_StructWithVectorOfInt : public ::globalmq::marshalling
 							{
 								typename T::Case_two_vp_2_T oldVectorVal;
 								bool currentChanged = false;
-								constexpr bool alwaysCollectChanges = has_any_notifier_for_vp_2;
+								constexpr bool alwaysCollectChanges = reportChanges || has_any_notifier_for_vp_2;
 								if constexpr( alwaysCollectChanges )
 									::globalmq::marshalling::impl::copyVector<typename T::Case_two_vp_2_T, ::globalmq::marshalling::impl::RealType>( t.vp_2(), oldVectorVal );
 								if ( addr.size() > offset + 1 ) // one of actions over elements of the vector
@@ -3218,6 +3420,14 @@ struct publishable_STRUCT_StructWithVectorOfInt : public ::globalmq::marshalling
 
 	}
 
+	template<class ParserT>
+	void publishable_STRUCT_point::skip( ParserT& parser )
+	{
+		static_assert( ParserT::proto == Proto::GMQ, "skipping is only supported for GMQ" );
+		parser.skipSignedInteger();
+		parser.skipSignedInteger();
+	}
+
 	template<class ParserT, class T>
 	void publishable_STRUCT_PolygonMap::parseForStateSyncOrMessageInDepth( ParserT& parser, T& t )
 	{
@@ -3226,6 +3436,13 @@ struct publishable_STRUCT_StructWithVectorOfInt : public ::globalmq::marshalling
 
 	}
 
+	template<class ParserT>
+	void publishable_STRUCT_PolygonMap::skip( ParserT& parser )
+	{
+		static_assert( ParserT::proto == Proto::GMQ, "skipping is only supported for GMQ" );
+		PublishableVectorProcessor::skip<ParserT, publishable_STRUCT_Vertex>( parser );
+	}
+
 	template<class ParserT, class T>
 	void publishable_STRUCT_ObstacleMap::parseForStateSyncOrMessageInDepth( ParserT& parser, T& t )
 	{
@@ -3234,6 +3451,13 @@ struct publishable_STRUCT_StructWithVectorOfInt : public ::globalmq::marshalling
 
 	}
 
+	template<class ParserT>
+	void publishable_STRUCT_ObstacleMap::skip( ParserT& parser )
+	{
+		static_assert( ParserT::proto == Proto::GMQ, "skipping is only supported for GMQ" );
+		PublishableVectorProcessor::skip<ParserT, publishable_STRUCT_PolygonMap>( parser );
+	}
+
 	template<class ParserT, class T>
 	void publishable_STRUCT_Line::parseForStateSyncOrMessageInDepth( ParserT& parser, T& t )
 	{
@@ -3245,6 +3469,14 @@ struct publishable_STRUCT_StructWithVectorOfInt : public ::globalmq::marshalling
 
 	}
 
+	template<class ParserT>
+	void publishable_STRUCT_Line::skip( ParserT& parser )
+	{
+		static_assert( ParserT::proto == Proto::GMQ, "skipping is only supported for GMQ" );
+		PublishableVectorProcessor::skip<ParserT, publishable_STRUCT_Vertex>( parser );
+		PublishableVectorProcessor::skip<ParserT, publishable_STRUCT_Vertex>( parser );
+	}
+
 	template<class ParserT, class T>
 	void publishable_STRUCT_LineMap::parseForStateSyncOrMessageInDepth( ParserT& parser, T& t )
 	{
@@ -3253,6 +3485,13 @@ struct publishable_STRUCT_StructWithVectorOfInt : public ::globalmq::marshalling
 
 	}
 
+	template<class ParserT>
+	void publishable_STRUCT_LineMap::skip( ParserT& parser )
+	{
+		static_assert( ParserT::proto == Proto::GMQ, "skipping is only supported for GMQ" );
+		PublishableVectorProcessor::skip<ParserT, publishable_STRUCT_Line>( parser );
+	}
+
 	template<class ParserT, class T>
 	void publishable_STRUCT_POINT3DREAL::parseForStateSyncOrMessageInDepth( ParserT& parser, T& t )
 	{
@@ -3264,14 +3503,23 @@ struct publishable_STRUCT_StructWithVectorOfInt : public ::globalmq::marshalling
 
 	}
 
+	template<class ParserT>
+	void publishable_STRUCT_POINT3DREAL::skip( ParserT& parser )
+	{
+		static_assert( ParserT::proto == Proto::GMQ, "skipping is only supported for GMQ" );
+		parser.skipReal();
+		parser.skipReal();
+		parser.skipReal();
+	}
+
 	template<class ComposerT, class T>
 	void publishable_STRUCT_POINT3DREAL::compose( ComposerT& composer, const T& t )
 	{
-		::globalmq::marshalling::impl::publishableStructComposeReal( composer, t.X, "X", true );
+		::globalmq::marshalling::impl::publishableStructComposeReal( composer, t.X, ::globalmq::marshalling::impl::JsonKeyForComposing( "X", "\"X\":" ), true );
 
-		::globalmq::marshalling::impl::publishableStructComposeReal( composer, t.Y, "Y", true );
+		::globalmq::marshalling::impl::publishableStructComposeReal( composer, t.Y, ::globalmq::marshalling::impl::JsonKeyForComposing( "Y", "\"Y\":" ), true );
 
-		::globalmq::marshalling::impl::publishableStructComposeReal( composer, t.Z, "Z", false );
+		::globalmq::marshalling::impl::publishableStructComposeReal( composer, t.Z, ::globalmq::marshalling::impl::JsonKeyForComposing( "Z", "\"Z\":" ), false );
 
 	}
 
@@ -3358,7 +3606,7 @@ struct publishable_STRUCT_StructWithVectorOfInt : public ::globalmq::marshalling
 	}
 
 	template<class ParserT, class T, class RetT>
-	RetT publishable_STRUCT_POINT3DREAL::parse( ParserT& parser, T& t, GMQ_COLL vector<size_t>& addr, size_t offset )
+	RetT publishable_STRUCT_POINT3DREAL::parse( ParserT& parser, T& t, ::globalmq::marshalling::PublishableAddress& addr, size_t offset )
 	{
 		static_assert( std::is_same<RetT, bool>::value || std::is_same<RetT, void>::value );
 		constexpr bool reportChanges = std::is_same<RetT, bool>::value;
@@ -3486,12 +3734,20 @@ struct publishable_STRUCT_StructWithVectorOfInt : public ::globalmq::marshalling
 
 	}
 
+	template<class ParserT>
+	void publishable_STRUCT_CharacterParamStruct::skip( ParserT& parser )
+	{
+		static_assert( ParserT::proto == Proto::GMQ, "skipping is only supported for GMQ" );
+		parser.skipSignedInteger();
+		publishable_STRUCT_SIZE::skip( parser );
+	}
+
 	template<class ComposerT, class T>
 	void publishable_STRUCT_CharacterParamStruct::compose( ComposerT& composer, const T& t )
 	{
-		::globalmq::marshalling::impl::publishableStructComposeInteger( composer, t.ID, "ID", true );
+		::globalmq::marshalling::impl::publishableStructComposeInteger( composer, t.ID, ::globalmq::marshalling::impl::JsonKeyForComposing( "ID", "\"ID\":" ), true );
 
-		::globalmq::marshalling::impl::composePublishableStructBegin( composer, "Size" );
+		::globalmq::marshalling::impl::composePublishableStructBegin( composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "Size", "\"Size\":" ) );
 		publishable_STRUCT_SIZE::compose( composer, t.Size );
 		::globalmq::marshalling::impl::composePublishableStructEnd( composer, false );
 
@@ -3538,7 +3794,6 @@ struct publishable_STRUCT_StructWithVectorOfInt : public ::globalmq::marshalling
 			bool changedCurrent = publishable_STRUCT_SIZE::parse<ParserT, decltype(T::Size), bool>( parser, t.Size );
 			if ( changedCurrent )
 			{
-				changed = true;
 				if constexpr ( reportChanges || has_update_notifier )
 					changed = true;
 				if constexpr( has_void_update_notifier_for_Size )
@@ -3558,7 +3813,11 @@ struct publishable_STRUCT_StructWithVectorOfInt : public ::globalmq::marshalling
 			}
 		}
 		else if constexpr ( reportChanges || has_update_notifier )
-			changed = publishable_STRUCT_SIZE::parse<ParserT, decltype(T::Size), bool>( parser, t.Size );
+		{
+			bool changedCurrent = publishable_STRUCT_SIZE::parse<ParserT, decltype(T::Size), bool>( parser, t.Size );
+			if ( changedCurrent )
+				changed = true;
+		}
 		else
 			publishable_STRUCT_SIZE::parse( parser, t.Size );
 		::globalmq::marshalling::impl::parsePublishableStructEnd( parser );
@@ -3573,7 +3832,7 @@ struct publishable_STRUCT_StructWithVectorOfInt : public ::globalmq::marshalling
 	}
 
 	template<class ParserT, class T, class RetT>
-	RetT publishable_STRUCT_CharacterParamStruct::parse( ParserT& parser, T& t, GMQ_COLL vector<size_t>& addr, size_t offset )
+	RetT publishable_STRUCT_CharacterParamStruct::parse( ParserT& parser, T& t, ::globalmq::marshalling::PublishableAddress& addr, size_t offset )
 	{
 		static_assert( std::is_same<RetT, bool>::value || std::is_same<RetT, void>::value );
 		constexpr bool reportChanges = std::is_same<RetT, bool>::value;
@@ -3646,7 +3905,11 @@ struct publishable_STRUCT_StructWithVectorOfInt : public ::globalmq::marshalling
 					else
 					{
 						if constexpr ( reportChanges || has_update_notifier )
-							changed = publishable_STRUCT_SIZE::parse<ParserT, decltype(T::Size), bool>( parser, t.Size );
+						{
+							bool changedCurrent = publishable_STRUCT_SIZE::parse<ParserT, decltype(T::Size), bool>( parser, t.Size );
+							if ( changedCurrent )
+								changed = true;
+						}
 						else
 							publishable_STRUCT_SIZE::parse( parser, t.Size );
 					}
@@ -3661,7 +3924,6 @@ struct publishable_STRUCT_StructWithVectorOfInt : public ::globalmq::marshalling
 						bool changedCurrent = publishable_STRUCT_SIZE::parse<ParserT, decltype(T::Size), bool>( parser, t.Size, addr, offset + 1 );
 						if ( changedCurrent )
 						{
-							changed = true;
 							if constexpr ( reportChanges || has_update_notifier )
 								changed = true;
 							if constexpr( has_void_update_notifier_for_Size )
@@ -3681,7 +3943,11 @@ struct publishable_STRUCT_StructWithVectorOfInt : public ::globalmq::marshalling
 						}
 					}
 					else if constexpr ( reportChanges || has_update_notifier )
-						changed = publishable_STRUCT_SIZE::parse<ParserT, decltype(T::Size), bool>( parser, t.Size, addr, offset + 1 );
+					{
+						bool changedCurrent = publishable_STRUCT_SIZE::parse<ParserT, decltype(T::Size), bool>( parser, t.Size, addr, offset + 1 );
+						if ( changedCurrent )
+							changed = true;
+					}
 					else
 						publishable_STRUCT_SIZE::parse( parser, t.Size, addr, offset + 1 );
 				}
@@ -3723,12 +3989,20 @@ struct publishable_STRUCT_StructWithVectorOfInt : public ::globalmq::marshalling
 
 	}
 
+	template<class ParserT>
+	void publishable_STRUCT_StructWithVectorOfSize::skip( ParserT& parser )
+	{
+		static_assert( ParserT::proto == Proto::GMQ, "skipping is only supported for GMQ" );
+		PublishableVectorProcessor::skip<ParserT, publishable_STRUCT_SIZE>( parser );
+		parser.skipSignedInteger();
+	}
+
 	template<class ComposerT, class T>
 	void publishable_STRUCT_StructWithVectorOfSize::compose( ComposerT& composer, const T& t )
 	{
-		PublishableVectorProcessor::compose<ComposerT, decltype(T::sizes), publishable_STRUCT_SIZE>( composer, t.sizes, "sizes", true );
+		PublishableVectorProcessor::compose<ComposerT, decltype(T::sizes), publishable_STRUCT_SIZE>( composer, t.sizes, ::globalmq::marshalling::impl::JsonKeyForComposing( "sizes", "\"sizes\":" ), true );
 
-		::globalmq::marshalling::impl::publishableStructComposeInteger( composer, t.NN, "NN", false );
+		::globalmq::marshalling::impl::publishableStructComposeInteger( composer, t.NN, ::globalmq::marshalling::impl::JsonKeyForComposing( "NN", "\"NN\":" ), false );
 
 	}
 
@@ -3801,7 +4075,7 @@ struct publishable_STRUCT_StructWithVectorOfInt : public ::globalmq::marshalling
 	}
 
 	template<class ParserT, class T, class RetT>
-	RetT publishable_STRUCT_StructWithVectorOfSize::parse( ParserT& parser, T& t, GMQ_COLL vector<size_t>& addr, size_t offset )
+	RetT publishable_STRUCT_StructWithVectorOfSize::parse( ParserT& parser, T& t, ::globalmq::marshalling::PublishableAddress& addr, size_t offset )
 	{
 		static_assert( std::is_same<RetT, bool>::value || std::is_same<RetT, void>::value );
 		constexpr bool reportChanges = std::is_same<RetT, bool>::value;
@@ -3833,7 +4107,7 @@ struct publishable_STRUCT_StructWithVectorOfInt : public ::globalmq::marshalling
 				{
 					decltype(T::sizes) oldVectorVal;
 					bool currentChanged = false;
-					constexpr bool alwaysCollectChanges = has_any_notifier_for_sizes;
+					constexpr bool alwaysCollectChanges = reportChanges || has_any_notifier_for_sizes;
 					if constexpr( alwaysCollectChanges )
 						::globalmq::marshalling::impl::copyVector<decltype(T::sizes), publishable_STRUCT_SIZE>( t.sizes, oldVectorVal );
 					if ( addr.size() > offset + 1 ) // one of actions over elements of the vector
@@ -4068,12 +4342,20 @@ struct publishable_STRUCT_StructWithVectorOfInt : public ::globalmq::marshalling
 
 	}
 
+	template<class ParserT>
+	void publishable_STRUCT_StructWithVectorOfInt::skip( ParserT& parser )
+	{
+		static_assert( ParserT::proto == Proto::GMQ, "skipping is only supported for GMQ" );
+		parser.skipSignedInteger();
+		PublishableVectorProcessor::skip<ParserT, ::globalmq::marshalling::impl::SignedIntegralType>( parser );
+	}
+
 	template<class ComposerT, class T>
 	void publishable_STRUCT_StructWithVectorOfInt::compose( ComposerT& composer, const T& t )
 	{
-		::globalmq::marshalling::impl::publishableStructComposeInteger( composer, t.ID, "ID", true );
+		::globalmq::marshalling::impl::publishableStructComposeInteger( composer, t.ID, ::globalmq::marshalling::impl::JsonKeyForComposing( "ID", "\"ID\":" ), true );
 
-		PublishableVectorProcessor::compose<ComposerT, decltype(T::signedInts), ::globalmq::marshalling::impl::SignedIntegralType>( composer, t.signedInts, "signedInts", false );
+		PublishableVectorProcessor::compose<ComposerT, decltype(T::signedInts), ::globalmq::marshalling::impl::SignedIntegralType>( composer, t.signedInts, ::globalmq::marshalling::impl::JsonKeyForComposing( "signedInts", "\"signedInts\":" ), false );
 
 	}
 
@@ -4146,7 +4428,7 @@ struct publishable_STRUCT_StructWithVectorOfInt : public ::globalmq::marshalling
 	}
 
 	template<class ParserT, class T, class RetT>
-	RetT publishable_STRUCT_StructWithVectorOfInt::parse( ParserT& parser, T& t, GMQ_COLL vector<size_t>& addr, size_t offset )
+	RetT publishable_STRUCT_StructWithVectorOfInt::parse( ParserT& parser, T& t, ::globalmq::marshalling::PublishableAddress& addr, size_t offset )
 	{
 		static_assert( std::is_same<RetT, bool>::value || std::is_same<RetT, void>::value );
 		constexpr bool reportChanges = std::is_same<RetT, bool>::value;
@@ -4201,7 +4483,7 @@ struct publishable_STRUCT_StructWithVectorOfInt : public ::globalmq::marshalling
 				{
 					decltype(T::signedInts) oldVectorVal;
 					bool currentChanged = false;
-					constexpr bool alwaysCollectChanges = has_any_notifier_for_signedInts;
+					constexpr bool alwaysCollectChanges = reportChanges || has_any_notifier_for_signedInts;
 					if constexpr( alwaysCollectChanges )
 						::globalmq::marshalling::impl::copyVector<decltype(T::signedInts), ::globalmq::marshalling::impl::SignedIntegralType>( t.signedInts, oldVectorVal );
 					if ( addr.size() > offset + 1 ) // one of actions over elements of the vector
@@ -4469,6 +4751,12 @@ void MESSAGE_point3D_compose(ComposerT& composer, Args&& ... args)
 	STRUCT_point3D_compose(composer, std::forward<Args>( args )...);
 }
 
+template<class ComposerT, typename ... Args>
+size_t MESSAGE_point3D_serializedSize(const ComposerT& composer, Args&& ... args)
+{
+	return STRUCT_point3D_serializedSize(composer, std::forward<Args>( args )...);
+}
+
 template<class ParserT, typename ... Args>
 void MESSAGE_point3D_parse(ParserT& p, Args&& ... args)
 {
@@ -4492,6 +4780,12 @@ void MESSAGE_point3D_alias_compose(ComposerT& composer, Args&& ... args)
 	STRUCT_point3D_compose(composer, std::forward<Args>( args )...);
 }
 
+template<class ComposerT, typename ... Args>
+size_t MESSAGE_point3D_alias_serializedSize(const ComposerT& composer, Args&& ... args)
+{
+	return STRUCT_point3D_serializedSize(composer, std::forward<Args>( args )...);
+}
+
 template<class ParserT, typename ... Args>
 void MESSAGE_point3D_alias_parse(ParserT& p, Args&& ... args)
 {
@@ -4515,6 +4809,12 @@ void MESSAGE_point_alias_compose(ComposerT& composer, Args&& ... args)
 	STRUCT_point_compose(composer, std::forward<Args>( args )...);
 }
 
+template<class ComposerT, typename ... Args>
+size_t MESSAGE_point_alias_serializedSize(const ComposerT& composer, Args&& ... args)
+{
+	return STRUCT_point_serializedSize(composer, std::forward<Args>( args )...);
+}
+
 template<class ParserT, typename ... Args>
 void MESSAGE_point_alias_parse(ParserT& p, Args&& ... args)
 {
@@ -4527,15 +4827,37 @@ structures::scope_one::MESSAGE_point_alias MESSAGE_point_alias_parse(ParserT& p)
 	return STRUCT_point_parse(p);
 }
 
+template<typename msgID, typename ... Args>
+size_t serializedSize( Args&& ... args )
+{
+	static_assert( std::is_base_of<::globalmq::marshalling::impl::MessageNameBase, msgID>::value );
+	::globalmq::marshalling::SizeMeasuringBuffer buffer;
+	globalmq::marshalling::JsonComposer composer( buffer );
+	composer.buff.append( "{\n  ", sizeof("{\n  ") - 1 );
+	::globalmq::marshalling::impl::json::composeNamedSignedInteger( composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "msgid", "\"msgid\":" ), msgID::id);
+	composer.buff.append( ",\n  ", sizeof(",\n  ") - 1 );
+	::globalmq::marshalling::impl::json::addNamePart( composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "msgbody", "\"msgbody\":" ) );
+	composer.buff.append( "\n}", 2 );
+	if constexpr ( msgID::id == point3D::id )
+		return buffer.size() + MESSAGE_point3D_serializedSize( composer, std::forward<Args>( args )... );
+	else if constexpr ( msgID::id == point3D_alias::id )
+		return buffer.size() + MESSAGE_point3D_alias_serializedSize( composer, std::forward<Args>( args )... );
+	else if constexpr ( msgID::id == point_alias::id )
+		return buffer.size() + MESSAGE_point_alias_serializedSize( composer, std::forward<Args>( args )... );
+	else
+		static_assert( std::is_same<::globalmq::marshalling::impl::MessageNameBase, msgID>::value, "unexpected value of msgID" );
+}
+
 template<typename msgID, class BufferT, typename ... Args>
 void composeMessage( BufferT& buffer, Args&& ... args )
 {
 	static_assert( std::is_base_of<::globalmq::marshalling::impl::MessageNameBase, msgID>::value );
+	::globalmq::marshalling::impl::reserveForComposing( buffer, serializedSize<msgID>( std::forward<Args>( args )... ) );
 	globalmq::marshalling::JsonComposer composer( buffer );
 	composer.buff.append( "{\n  ", sizeof("{\n  ") - 1 );
-	::globalmq::marshalling::impl::json::composeNamedSignedInteger( composer, "msgid", msgID::id);
+	::globalmq::marshalling::impl::json::composeNamedSignedInteger( composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "msgid", "\"msgid\":" ), msgID::id);
 	composer.buff.append( ",\n  ", sizeof(",\n  ") - 1 );
-	::globalmq::marshalling::impl::json::addNamePart( composer, "msgbody" );
+	::globalmq::marshalling::impl::json::addNamePart( composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "msgbody", "\"msgbody\":" ) );
 	if constexpr ( msgID::id == point3D::id )
 		MESSAGE_point3D_compose( composer, std::forward<Args>( args )... );
 	else if constexpr ( msgID::id == point3D_alias::id )
@@ -4629,12 +4951,18 @@ void MESSAGE_LevelTraceData_compose(ComposerT& composer, Args&& ... args)
 
 	static_assert( ComposerT::proto == Proto::JSON, "this MESSAGE assumes only JSON protocol" );
 	composer.buff.append( "{\n  ", sizeof("{\n  ") - 1 );
-	::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_1_type, true, int64_t, int64_t, (int64_t)(0)>(composer, "CharacterParam", arg_1_type::nameAndTypeID, args...);
+	::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_1_type, true, int64_t, int64_t, (int64_t)(0)>(composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "CharacterParam", "\"CharacterParam\":" ), arg_1_type::nameAndTypeID, args...);
 	composer.buff.append( ",\n  ", 4 );
-	::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_2_type, true, int64_t, int64_t, (int64_t)(0)>(composer, "Points", arg_2_type::nameAndTypeID, args...);
+	::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_2_type, true, int64_t, int64_t, (int64_t)(0)>(composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "Points", "\"Points\":" ), arg_2_type::nameAndTypeID, args...);
 	composer.buff.append( "\n}", 2 );
 }
 
+template<class ComposerT, typename ... Args>
+size_t MESSAGE_LevelTraceData_serializedSize(const ComposerT& composer, Args&& ... args)
+{
+	return ::globalmq::marshalling::impl::measureComposedSize( composer, [&]( auto& measuringComposer ) { MESSAGE_LevelTraceData_compose( measuringComposer, std::forward<Args>( args )... ); } );
+}
+
 template<class ParserT>
 structures::level_trace::MESSAGE_LevelTraceData MESSAGE_LevelTraceData_parse(ParserT& parser)
 {
@@ -4655,15 +4983,33 @@ structures::level_trace::MESSAGE_LevelTraceData MESSAGE_LevelTraceData_parse(Par
 	return t;
 }
 
+template<typename msgID, typename ... Args>
+size_t serializedSize( Args&& ... args )
+{
+	static_assert( std::is_base_of<::globalmq::marshalling::impl::MessageNameBase, msgID>::value );
+	::globalmq::marshalling::SizeMeasuringBuffer buffer;
+	globalmq::marshalling::JsonComposer composer( buffer );
+	composer.buff.append( "{\n  ", sizeof("{\n  ") - 1 );
+	::globalmq::marshalling::impl::json::composeNamedSignedInteger( composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "msgid", "\"msgid\":" ), msgID::id);
+	composer.buff.append( ",\n  ", sizeof(",\n  ") - 1 );
+	::globalmq::marshalling::impl::json::addNamePart( composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "msgbody", "\"msgbody\":" ) );
+	composer.buff.append( "\n}", 2 );
+	if constexpr ( msgID::id == LevelTraceData::id )
+		return buffer.size() + MESSAGE_LevelTraceData_serializedSize( composer, std::forward<Args>( args )... );
+	else
+		static_assert( std::is_same<::globalmq::marshalling::impl::MessageNameBase, msgID>::value, "unexpected value of msgID" );
+}
+
 template<typename msgID, class BufferT, typename ... Args>
 void composeMessage( BufferT& buffer, Args&& ... args )
 {
 	static_assert( std::is_base_of<::globalmq::marshalling::impl::MessageNameBase, msgID>::value );
+	::globalmq::marshalling::impl::reserveForComposing( buffer, serializedSize<msgID>( std::forward<Args>( args )... ) );
 	globalmq::marshalling::JsonComposer composer( buffer );
 	composer.buff.append( "{\n  ", sizeof("{\n  ") - 1 );
-	::globalmq::marshalling::impl::json::composeNamedSignedInteger( composer, "msgid", msgID::id);
+	::globalmq::marshalling::impl::json::composeNamedSignedInteger( composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "msgid", "\"msgid\":" ), msgID::id);
 	composer.buff.append( ",\n  ", sizeof(",\n  ") - 1 );
-	::globalmq::marshalling::impl::json::addNamePart( composer, "msgbody" );
+	::globalmq::marshalling::impl::json::addNamePart( composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "msgbody", "\"msgbody\":" ) );
 	if constexpr ( msgID::id == LevelTraceData::id )
 		MESSAGE_LevelTraceData_compose( composer, std::forward<Args>( args )... );
 	else
@@ -4758,6 +5104,12 @@ void MESSAGE_PolygonSt_compose(ComposerT& composer, Args&& ... args)
 	::globalmq::marshalling::impl::gmq::composeParamToGmq<ComposerT, arg_6_type, true, FloatingDefault<0ll,-1023ll>, int, 0>(composer, arg_6_type::nameAndTypeID, args...);
 }
 
+template<class ComposerT, typename ... Args>
+size_t MESSAGE_PolygonSt_serializedSize(const ComposerT& composer, Args&& ... args)
+{
+	return ::globalmq::marshalling::impl::measureComposedSize( composer, [&]( auto& measuringComposer ) { MESSAGE_PolygonSt_compose( measuringComposer, std::forward<Args>( args )... ); } );
+}
+
 template<class ParserT>
 structures::infrastructural::MESSAGE_PolygonSt MESSAGE_PolygonSt_parse(ParserT& parser)
 {
@@ -4788,21 +5140,150 @@ structures::infrastructural::MESSAGE_PolygonSt MESSAGE_PolygonSt_parse(ParserT&
 	return t;
 }
 
-//**********************************************************************
-// MESSAGE "point" NONEXTENDABLE Targets: GMQ (1 parameters)
-//  1. STRUCT point pt (REQUIRED)
-//**********************************************************************
-
-template<class ComposerT, typename ... Args>
-void MESSAGE_point_compose(ComposerT& composer, Args&& ... args)
+// read-only view over a GMQ-serialized MESSAGE PolygonSt: positions of members are located once, at construction, and members are decoded only when accessed
+// (the view refers to the buffer, and strings are returned as views into it; therefore, the buffer must outlive both)
+template<class ParserT>
+class MESSAGE_PolygonSt_View
 {
-	static_assert( std::is_base_of<ComposerBase, ComposerT>::value, "Composer must be one of GmqComposer<> or JsonComposer<>" );
-
-	using arg_1_type = NamedParameterWithType<::globalmq::marshalling::impl::MessageType, pt_Type::Name>;
+	using RiterT = typename ParserT::RiterT;
+	using T = structures::infrastructural::MESSAGE_PolygonSt;
+	RiterT memberPos[6];
+	bool lengthPrefixedStrings = false;
 
-	constexpr size_t matchCount = isMatched(arg_1_type::nameAndTypeID, Args::nameAndTypeID...);
-	constexpr size_t argCount = sizeof ... (Args);
-	if constexpr ( argCount != 0 )
+public:
+	MESSAGE_PolygonSt_View( ParserT& parser ) : lengthPrefixedStrings( parser.isLengthPrefixedStrings() )
+	{
+		static_assert( ParserT::proto == Proto::GMQ, "views are only supported for GMQ" );
+		memberPos[0] = parser.getIterator();
+		PublishableVectorProcessor::skip<ParserT, publishable_STRUCT_PolygonMap>( parser );
+		memberPos[1] = parser.getIterator();
+		PublishableVectorProcessor::skip<ParserT, publishable_STRUCT_PolygonMap>( parser );
+		memberPos[2] = parser.getIterator();
+		PublishableVectorProcessor::skip<ParserT, publishable_STRUCT_ObstacleMap>( parser );
+		memberPos[3] = parser.getIterator();
+		PublishableVectorProcessor::skip<ParserT, publishable_STRUCT_LineMap>( parser );
+		memberPos[4] = parser.getIterator();
+		PublishableVectorProcessor::skip<ParserT, publishable_STRUCT_LineMap>( parser );
+		memberPos[5] = parser.getIterator();
+		parser.skipReal();
+	}
+
+	decltype(T::polygonMap) get_polygonMap() const
+	{
+		RiterT riter = memberPos[0];
+		ParserT parser( riter );
+		parser.setLengthPrefixedStrings( lengthPrefixedStrings );
+		decltype(T::polygonMap) ret;
+		PublishableVectorProcessor::parse<ParserT, decltype(T::polygonMap), publishable_STRUCT_PolygonMap, true>( parser, ret );
+		return ret;
+	}
+	size_t get_polygonMap_size() const
+	{
+		RiterT riter = memberPos[0];
+		ParserT parser( riter );
+		size_t ret;
+		parser.parseUnsignedInteger( &ret );
+		return ret;
+	}
+
+	decltype(T::concaveMap) get_concaveMap() const
+	{
+		RiterT riter = memberPos[1];
+		ParserT parser( riter );
+		parser.setLengthPrefixedStrings( lengthPrefixedStrings );
+		decltype(T::concaveMap) ret;
+		PublishableVectorProcessor::parse<ParserT, decltype(T::concaveMap), publishable_STRUCT_PolygonMap, true>( parser, ret );
+		return ret;
+	}
+	size_t get_concaveMap_size() const
+	{
+		RiterT riter = memberPos[1];
+		ParserT parser( riter );
+		size_t ret;
+		parser.parseUnsignedInteger( &ret );
+		return ret;
+	}
+
+	decltype(T::obstacleMap) get_obstacleMap() const
+	{
+		RiterT riter = memberPos[2];
+		ParserT parser( riter );
+		parser.setLengthPrefixedStrings( lengthPrefixedStrings );
+		decltype(T::obstacleMap) ret;
+		PublishableVectorProcessor::parse<ParserT, decltype(T::obstacleMap), publishable_STRUCT_ObstacleMap, true>( parser, ret );
+		return ret;
+	}
+	size_t get_obstacleMap_size() const
+	{
+		RiterT riter = memberPos[2];
+		ParserT parser( riter );
+		size_t ret;
+		parser.parseUnsignedInteger( &ret );
+		return ret;
+	}
+
+	decltype(T::portalMap) get_portalMap() const
+	{
+		RiterT riter = memberPos[3];
+		ParserT parser( riter );
+		parser.setLengthPrefixedStrings( lengthPrefixedStrings );
+		decltype(T::portalMap) ret;
+		PublishableVectorProcessor::parse<ParserT, decltype(T::portalMap), publishable_STRUCT_LineMap, true>( parser, ret );
+		return ret;
+	}
+	size_t get_portalMap_size() const
+	{
+		RiterT riter = memberPos[3];
+		ParserT parser( riter );
+		size_t ret;
+		parser.parseUnsignedInteger( &ret );
+		return ret;
+	}
+
+	decltype(T::jumpMap) get_jumpMap() const
+	{
+		RiterT riter = memberPos[4];
+		ParserT parser( riter );
+		parser.setLengthPrefixedStrings( lengthPrefixedStrings );
+		decltype(T::jumpMap) ret;
+		PublishableVectorProcessor::parse<ParserT, decltype(T::jumpMap), publishable_STRUCT_LineMap, true>( parser, ret );
+		return ret;
+	}
+	size_t get_jumpMap_size() const
+	{
+		RiterT riter = memberPos[4];
+		ParserT parser( riter );
+		size_t ret;
+		parser.parseUnsignedInteger( &ret );
+		return ret;
+	}
+
+	decltype(T::polygonSpeed) get_polygonSpeed() const
+	{
+		RiterT riter = memberPos[5];
+		ParserT parser( riter );
+		parser.setLengthPrefixedStrings( lengthPrefixedStrings );
+		decltype(T::polygonSpeed) ret;
+		parser.parseReal( &ret );
+		return ret;
+	}
+};
+
+//**********************************************************************
+// MESSAGE "point" NONEXTENDABLE Targets: GMQ (1 parameters)
+//  1. STRUCT point pt (REQUIRED)
+//**********************************************************************
+
+template<class ComposerT, typename ... Args>
+void MESSAGE_point_compose(ComposerT& composer, Args&& ... args)
+{
+	static_assert( std::is_base_of<ComposerBase, ComposerT>::value, "Composer must be one of GmqComposer<> or JsonComposer<>" );
+
+	using arg_1_type = NamedParameterWithType<::globalmq::marshalling::impl::MessageType, pt_Type::Name>;
+
+	constexpr size_t matchCount = isMatched(arg_1_type::nameAndTypeID, Args::nameAndTypeID...);
+	constexpr size_t argCount = sizeof ... (Args);
+	if constexpr ( argCount != 0 )
 		ensureUniqueness(args.nameAndTypeID...);
 	static_assert( argCount == matchCount, "unexpected arguments found" );
 
@@ -4810,6 +5291,15 @@ void MESSAGE_point_compose(ComposerT& composer, Args&& ... args)
 	::globalmq::marshalling::impl::gmq::composeParamToGmq<ComposerT, arg_1_type, true, uint64_t, uint64_t, (uint64_t)(0)>(composer, arg_1_type::nameAndTypeID, args...);
 }
 
+template<class ComposerT, typename ... Args>
+size_t MESSAGE_point_serializedSize(const ComposerT& composer, Args&& ... args)
+{
+	if constexpr ( ComposerT::proto == Proto::GMQ )
+		return publishable_STRUCT_point::maxGmqSize; // fixed layout: upper bound, known at compile time
+	else
+		return ::globalmq::marshalling::impl::measureComposedSize( composer, [&]( auto& measuringComposer ) { MESSAGE_point_compose( measuringComposer, std::forward<Args>( args )... ); } );
+}
+
 template<class ParserT>
 structures::infrastructural::MESSAGE_point MESSAGE_point_parse(ParserT& parser)
 {
@@ -4827,6 +5317,35 @@ structures::infrastructural::MESSAGE_point MESSAGE_point_parse(ParserT& parser)
 	return t;
 }
 
+// read-only view over a GMQ-serialized MESSAGE point: positions of members are located once, at construction, and members are decoded only when accessed
+// (the view refers to the buffer, and strings are returned as views into it; therefore, the buffer must outlive both)
+template<class ParserT>
+class MESSAGE_point_View
+{
+	using RiterT = typename ParserT::RiterT;
+	using T = structures::infrastructural::MESSAGE_point;
+	RiterT memberPos[1];
+	bool lengthPrefixedStrings = false;
+
+public:
+	MESSAGE_point_View( ParserT& parser ) : lengthPrefixedStrings( parser.isLengthPrefixedStrings() )
+	{
+		static_assert( ParserT::proto == Proto::GMQ, "views are only supported for GMQ" );
+		memberPos[0] = parser.getIterator();
+		publishable_STRUCT_point::skip( parser );
+	}
+
+	decltype(T::pt) get_pt() const
+	{
+		RiterT riter = memberPos[0];
+		ParserT parser( riter );
+		parser.setLengthPrefixedStrings( lengthPrefixedStrings );
+		decltype(T::pt) ret;
+		publishable_STRUCT_point::parseForStateSyncOrMessageInDepth( parser, ret );
+		return ret;
+	}
+};
+
 //**********************************************************************
 // MESSAGE "point3D" NONEXTENDABLE Targets: GMQ (3 parameters)
 //  1. STRUCT point3D pt (REQUIRED)
@@ -4857,6 +5376,12 @@ void MESSAGE_point3D_compose(ComposerT& composer, Args&& ... args)
 	::globalmq::marshalling::impl::gmq::composeParamToGmq<ComposerT, arg_3_type, true, uint64_t, uint64_t, (uint64_t)(0)>(composer, arg_3_type::nameAndTypeID, args...);
 }
 
+template<class ComposerT, typename ... Args>
+size_t MESSAGE_point3D_serializedSize(const ComposerT& composer, Args&& ... args)
+{
+	return ::globalmq::marshalling::impl::measureComposedSize( composer, [&]( auto& measuringComposer ) { MESSAGE_point3D_compose( measuringComposer, std::forward<Args>( args )... ); } );
+}
+
 template<class ParserT>
 structures::infrastructural::MESSAGE_point3D MESSAGE_point3D_parse(ParserT& parser)
 {
@@ -4881,10 +5406,89 @@ structures::infrastructural::MESSAGE_point3D MESSAGE_point3D_parse(ParserT& pars
 	return t;
 }
 
+// read-only view over a GMQ-serialized MESSAGE point3D: positions of members are located once, at construction, and members are decoded only when accessed
+// (the view refers to the buffer, and strings are returned as views into it; therefore, the buffer must outlive both)
+template<class ParserT>
+class MESSAGE_point3D_View
+{
+	using RiterT = typename ParserT::RiterT;
+	using T = structures::infrastructural::MESSAGE_point3D;
+	RiterT memberPos[3];
+	bool lengthPrefixedStrings = false;
+
+public:
+	MESSAGE_point3D_View( ParserT& parser ) : lengthPrefixedStrings( parser.isLengthPrefixedStrings() )
+	{
+		static_assert( ParserT::proto == Proto::GMQ, "views are only supported for GMQ" );
+		memberPos[0] = parser.getIterator();
+		publishable_STRUCT_point3D::skip( parser );
+		memberPos[1] = parser.getIterator();
+		publishable_DISCRIMINATED_UNION_du_one::skip( parser );
+		memberPos[2] = parser.getIterator();
+		PublishableDictionaryProcessor::skip<ParserT, ::globalmq::marshalling::impl::UnsignedIntegralType, ::globalmq::marshalling::impl::StringType>( parser );
+	}
+
+	decltype(T::pt) get_pt() const
+	{
+		RiterT riter = memberPos[0];
+		ParserT parser( riter );
+		parser.setLengthPrefixedStrings( lengthPrefixedStrings );
+		decltype(T::pt) ret;
+		publishable_STRUCT_point3D::parseForStateSyncOrMessageInDepth( parser, ret );
+		return ret;
+	}
+
+	decltype(T::du_one_instance) get_du_one_instance() const
+	{
+		RiterT riter = memberPos[1];
+		ParserT parser( riter );
+		parser.setLengthPrefixedStrings( lengthPrefixedStrings );
+		decltype(T::du_one_instance) ret;
+		publishable_DISCRIMINATED_UNION_du_one::parseForStateSyncOrMessageInDepth( parser, ret );
+		return ret;
+	}
+
+	decltype(T::num2stringDictionary) get_num2stringDictionary() const
+	{
+		RiterT riter = memberPos[2];
+		ParserT parser( riter );
+		parser.setLengthPrefixedStrings( lengthPrefixedStrings );
+		decltype(T::num2stringDictionary) ret;
+		PublishableDictionaryProcessor::parse<ParserT, decltype(T::num2stringDictionary), ::globalmq::marshalling::impl::UnsignedIntegralType, ::globalmq::marshalling::impl::StringType, true>( parser, ret );
+		return ret;
+	}
+	size_t get_num2stringDictionary_size() const
+	{
+		RiterT riter = memberPos[2];
+		ParserT parser( riter );
+		size_t ret;
+		parser.parseUnsignedInteger( &ret );
+		return ret;
+	}
+};
+
+template<typename msgID, typename ... Args>
+size_t serializedSize( Args&& ... args )
+{
+	static_assert( std::is_base_of<::globalmq::marshalling::impl::MessageNameBase, msgID>::value );
+	::globalmq::marshalling::SizeMeasuringBuffer buffer;
+	globalmq::marshalling::GmqComposer composer( buffer );
+	::globalmq::marshalling::impl::composeUnsignedInteger( composer, msgID::id );
+	if constexpr ( msgID::id == PolygonSt::id )
+		return buffer.size() + MESSAGE_PolygonSt_serializedSize( composer, std::forward<Args>( args )... );
+	else if constexpr ( msgID::id == point::id )
+		return buffer.size() + MESSAGE_point_serializedSize( composer, std::forward<Args>( args )... );
+	else if constexpr ( msgID::id == point3D::id )
+		return buffer.size() + MESSAGE_point3D_serializedSize( composer, std::forward<Args>( args )... );
+	else
+		static_assert( std::is_same<::globalmq::marshalling::impl::MessageNameBase, msgID>::value, "unexpected value of msgID" );
+}
+
 template<typename msgID, class BufferT, typename ... Args>
 void composeMessage( BufferT& buffer, Args&& ... args )
 {
 	static_assert( std::is_base_of<::globalmq::marshalling::impl::MessageNameBase, msgID>::value );
+	::globalmq::marshalling::impl::reserveForComposing( buffer, serializedSize<msgID>( std::forward<Args>( args )... ) );
 	globalmq::marshalling::GmqComposer composer( buffer );
 	::globalmq::marshalling::impl::composeUnsignedInteger( composer, msgID::id );
 	if constexpr ( msgID::id == PolygonSt::id )
@@ -4996,6 +5600,12 @@ void MESSAGE_message_one_compose(ComposerT& composer, Args&& ... args)
 	::globalmq::marshalling::impl::gmq::composeParamToGmq<ComposerT, arg_10_type, true, uint64_t, uint64_t, (uint64_t)(0)>(composer, arg_10_type::nameAndTypeID, args...);
 }
 
+template<class ComposerT, typename ... Args>
+size_t MESSAGE_message_one_serializedSize(const ComposerT& composer, Args&& ... args)
+{
+	return ::globalmq::marshalling::impl::measureComposedSize( composer, [&]( auto& measuringComposer ) { MESSAGE_message_one_compose( measuringComposer, std::forward<Args>( args )... ); } );
+}
+
 template<class ParserT>
 structures::test_gmq::MESSAGE_message_one MESSAGE_message_one_parse(ParserT& parser)
 {
@@ -5037,10 +5647,193 @@ structures::test_gmq::MESSAGE_message_one MESSAGE_message_one_parse(ParserT& par
 	return t;
 }
 
+// read-only view over a GMQ-serialized MESSAGE message_one: positions of members are located once, at construction, and members are decoded only when accessed
+// (the view refers to the buffer, and strings are returned as views into it; therefore, the buffer must outlive both)
+template<class ParserT>
+class MESSAGE_message_one_View
+{
+	using RiterT = typename ParserT::RiterT;
+	using T = structures::test_gmq::MESSAGE_message_one;
+	RiterT memberPos[10];
+	bool lengthPrefixedStrings = false;
+
+public:
+	MESSAGE_message_one_View( ParserT& parser ) : lengthPrefixedStrings( parser.isLengthPrefixedStrings() )
+	{
+		static_assert( ParserT::proto == Proto::GMQ, "views are only supported for GMQ" );
+		memberPos[0] = parser.getIterator();
+		parser.skipSignedInteger();
+		memberPos[1] = parser.getIterator();
+		PublishableVectorProcessor::skip<ParserT, ::globalmq::marshalling::impl::SignedIntegralType>( parser );
+		memberPos[2] = parser.getIterator();
+		PublishableVectorProcessor::skip<ParserT, publishable_STRUCT_point3D>( parser );
+		memberPos[3] = parser.getIterator();
+		parser.skipUnsignedInteger();
+		memberPos[4] = parser.getIterator();
+		parser.skipString();
+		memberPos[5] = parser.getIterator();
+		PublishableVectorProcessor::skip<ParserT, publishable_STRUCT_point>( parser );
+		memberPos[6] = parser.getIterator();
+		parser.skipReal();
+		memberPos[7] = parser.getIterator();
+		publishable_STRUCT_point::skip( parser );
+		memberPos[8] = parser.getIterator();
+		publishable_STRUCT_point3D::skip( parser );
+		memberPos[9] = parser.getIterator();
+		PublishableVectorProcessor::skip<ParserT, ::globalmq::marshalling::impl::RealType>( parser );
+	}
+
+	decltype(T::firstParam) get_firstParam() const
+	{
+		RiterT riter = memberPos[0];
+		ParserT parser( riter );
+		parser.setLengthPrefixedStrings( lengthPrefixedStrings );
+		decltype(T::firstParam) ret;
+		parser.parseSignedInteger( &ret );
+		return ret;
+	}
+
+	decltype(T::secondParam) get_secondParam() const
+	{
+		RiterT riter = memberPos[1];
+		ParserT parser( riter );
+		parser.setLengthPrefixedStrings( lengthPrefixedStrings );
+		decltype(T::secondParam) ret;
+		PublishableVectorProcessor::parse<ParserT, decltype(T::secondParam), ::globalmq::marshalling::impl::SignedIntegralType, true>( parser, ret );
+		return ret;
+	}
+	size_t get_secondParam_size() const
+	{
+		RiterT riter = memberPos[1];
+		ParserT parser( riter );
+		size_t ret;
+		parser.parseUnsignedInteger( &ret );
+		return ret;
+	}
+
+	decltype(T::thirdParam) get_thirdParam() const
+	{
+		RiterT riter = memberPos[2];
+		ParserT parser( riter );
+		parser.setLengthPrefixedStrings( lengthPrefixedStrings );
+		decltype(T::thirdParam) ret;
+		PublishableVectorProcessor::parse<ParserT, decltype(T::thirdParam), publishable_STRUCT_point3D, true>( parser, ret );
+		return ret;
+	}
+	size_t get_thirdParam_size() const
+	{
+		RiterT riter = memberPos[2];
+		ParserT parser( riter );
+		size_t ret;
+		parser.parseUnsignedInteger( &ret );
+		return ret;
+	}
+
+	decltype(T::forthParam) get_forthParam() const
+	{
+		RiterT riter = memberPos[3];
+		ParserT parser( riter );
+		parser.setLengthPrefixedStrings( lengthPrefixedStrings );
+		decltype(T::forthParam) ret;
+		parser.parseUnsignedInteger( &ret );
+		return ret;
+	}
+
+	GMQ_COLL string_view get_fifthParam() const
+	{
+		RiterT riter = memberPos[4];
+		ParserT parser( riter );
+		parser.setLengthPrefixedStrings( lengthPrefixedStrings );
+		GMQ_COLL string_view ret;
+		parser.parseString( &ret );
+		return ret;
+	}
+
+	decltype(T::sixthParam) get_sixthParam() const
+	{
+		RiterT riter = memberPos[5];
+		ParserT parser( riter );
+		parser.setLengthPrefixedStrings( lengthPrefixedStrings );
+		decltype(T::sixthParam) ret;
+		PublishableVectorProcessor::parse<ParserT, decltype(T::sixthParam), publishable_STRUCT_point, true>( parser, ret );
+		return ret;
+	}
+	size_t get_sixthParam_size() const
+	{
+		RiterT riter = memberPos[5];
+		ParserT parser( riter );
+		size_t ret;
+		parser.parseUnsignedInteger( &ret );
+		return ret;
+	}
+
+	decltype(T::seventhParam) get_seventhParam() const
+	{
+		RiterT riter = memberPos[6];
+		ParserT parser( riter );
+		parser.setLengthPrefixedStrings( lengthPrefixedStrings );
+		decltype(T::seventhParam) ret;
+		parser.parseReal( &ret );
+		return ret;
+	}
+
+	decltype(T::eighthParam) get_eighthParam() const
+	{
+		RiterT riter = memberPos[7];
+		ParserT parser( riter );
+		parser.setLengthPrefixedStrings( lengthPrefixedStrings );
+		decltype(T::eighthParam) ret;
+		publishable_STRUCT_point::parseForStateSyncOrMessageInDepth( parser, ret );
+		return ret;
+	}
+
+	decltype(T::ninethParam) get_ninethParam() const
+	{
+		RiterT riter = memberPos[8];
+		ParserT parser( riter );
+		parser.setLengthPrefixedStrings( lengthPrefixedStrings );
+		decltype(T::ninethParam) ret;
+		publishable_STRUCT_point3D::parseForStateSyncOrMessageInDepth( parser, ret );
+		return ret;
+	}
+
+	decltype(T::tenthParam) get_tenthParam() const
+	{
+		RiterT riter = memberPos[9];
+		ParserT parser( riter );
+		parser.setLengthPrefixedStrings( lengthPrefixedStrings );
+		decltype(T::tenthParam) ret;
+		PublishableVectorProcessor::parse<ParserT, decltype(T::tenthParam), ::globalmq::marshalling::impl::RealType, true>( parser, ret );
+		return ret;
+	}
+	size_t get_tenthParam_size() const
+	{
+		RiterT riter = memberPos[9];
+		ParserT parser( riter );
+		size_t ret;
+		parser.parseUnsignedInteger( &ret );
+		return ret;
+	}
+};
+
+template<typename msgID, typename ... Args>
+size_t serializedSize( Args&& ... args )
+{
+	static_assert( std::is_base_of<::globalmq::marshalling::impl::MessageNameBase, msgID>::value );
+	::globalmq::marshalling::SizeMeasuringBuffer buffer;
+	globalmq::marshalling::GmqComposer composer( buffer );
+	::globalmq::marshalling::impl::composeUnsignedInteger( composer, msgID::id );
+	if constexpr ( msgID::id == message_one::id )
+		return buffer.size() + MESSAGE_message_one_serializedSize( composer, std::forward<Args>( args )... );
+	else
+		static_assert( std::is_same<::globalmq::marshalling::impl::MessageNameBase, msgID>::value, "unexpected value of msgID" );
+}
+
 template<typename msgID, class BufferT, typename ... Args>
 void composeMessage( BufferT& buffer, Args&& ... args )
 {
 	static_assert( std::is_base_of<::globalmq::marshalling::impl::MessageNameBase, msgID>::value );
+	::globalmq::marshalling::impl::reserveForComposing( buffer, serializedSize<msgID>( std::forward<Args>( args )... ) );
 	globalmq::marshalling::GmqComposer composer( buffer );
 	::globalmq::marshalling::impl::composeUnsignedInteger( composer, msgID::id );
 	if constexpr ( msgID::id == message_one::id )
@@ -5155,28 +5948,34 @@ void MESSAGE_message_one_compose(ComposerT& composer, Args&& ... args)
 
 	static_assert( ComposerT::proto == Proto::JSON, "this MESSAGE assumes only JSON protocol" );
 	composer.buff.append( "{\n  ", sizeof("{\n  ") - 1 );
-	::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_1_type, true, int64_t, int64_t, (int64_t)(0)>(composer, "firstParam", arg_1_type::nameAndTypeID, args...);
+	::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_1_type, true, int64_t, int64_t, (int64_t)(0)>(composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "firstParam", "\"firstParam\":" ), arg_1_type::nameAndTypeID, args...);
 	composer.buff.append( ",\n  ", 4 );
-	::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_2_type, true, int64_t, int64_t, (int64_t)(0)>(composer, "secondParam", arg_2_type::nameAndTypeID, args...);
+	::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_2_type, true, int64_t, int64_t, (int64_t)(0)>(composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "secondParam", "\"secondParam\":" ), arg_2_type::nameAndTypeID, args...);
 	composer.buff.append( ",\n  ", 4 );
-	::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_3_type, true, int64_t, int64_t, (int64_t)(0)>(composer, "thirdParam", arg_3_type::nameAndTypeID, args...);
+	::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_3_type, true, int64_t, int64_t, (int64_t)(0)>(composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "thirdParam", "\"thirdParam\":" ), arg_3_type::nameAndTypeID, args...);
 	composer.buff.append( ",\n  ", 4 );
-	::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_4_type, true, uint64_t, uint64_t, (uint64_t)(0)>(composer, "forthParam", arg_4_type::nameAndTypeID, args...);
+	::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_4_type, true, uint64_t, uint64_t, (uint64_t)(0)>(composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "forthParam", "\"forthParam\":" ), arg_4_type::nameAndTypeID, args...);
 	composer.buff.append( ",\n  ", 4 );
-	::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_5_type, true, uint64_t, uint64_t, (uint64_t)(0)>(composer, "fifthParam", arg_5_type::nameAndTypeID, args...);
+	::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_5_type, true, uint64_t, uint64_t, (uint64_t)(0)>(composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "fifthParam", "\"fifthParam\":" ), arg_5_type::nameAndTypeID, args...);
 	composer.buff.append( ",\n  ", 4 );
-	::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_6_type, true, int64_t, int64_t, (int64_t)(0)>(composer, "sixthParam", arg_6_type::nameAndTypeID, args...);
+	::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_6_type, true, int64_t, int64_t, (int64_t)(0)>(composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "sixthParam", "\"sixthParam\":" ), arg_6_type::nameAndTypeID, args...);
 	composer.buff.append( ",\n  ", 4 );
-	::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_7_type, true, FloatingDefault<0ll,-1023ll>, int, 0>(composer, "seventhParam", arg_7_type::nameAndTypeID, args...);
+	::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_7_type, true, FloatingDefault<0ll,-1023ll>, int, 0>(composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "seventhParam", "\"seventhParam\":" ), arg_7_type::nameAndTypeID, args...);
 	composer.buff.append( ",\n  ", 4 );
-	::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_8_type, true, int64_t, int64_t, (int64_t)(0)>(composer, "eighthParam", arg_8_type::nameAndTypeID, args...);
+	::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_8_type, true, int64_t, int64_t, (int64_t)(0)>(composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "eighthParam", "\"eighthParam\":" ), arg_8_type::nameAndTypeID, args...);
 	composer.buff.append( ",\n  ", 4 );
-	::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_9_type, true, int64_t, int64_t, (int64_t)(0)>(composer, "ninethParam", arg_9_type::nameAndTypeID, args...);
+	::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_9_type, true, int64_t, int64_t, (int64_t)(0)>(composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "ninethParam", "\"ninethParam\":" ), arg_9_type::nameAndTypeID, args...);
 	composer.buff.append( ",\n  ", 4 );
-	::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_10_type, true, int64_t, int64_t, (int64_t)(0)>(composer, "tenthParam", arg_10_type::nameAndTypeID, args...);
+	::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_10_type, true, int64_t, int64_t, (int64_t)(0)>(composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "tenthParam", "\"tenthParam\":" ), arg_10_type::nameAndTypeID, args...);
 	composer.buff.append( "\n}", 2 );
 }
 
+template<class ComposerT, typename ... Args>
+size_t MESSAGE_message_one_serializedSize(const ComposerT& composer, Args&& ... args)
+{
+	return ::globalmq::marshalling::impl::measureComposedSize( composer, [&]( auto& measuringComposer ) { MESSAGE_message_one_compose( measuringComposer, std::forward<Args>( args )... ); } );
+}
+
 template<class ParserT>
 structures::test_json::MESSAGE_message_one MESSAGE_message_one_parse(ParserT& parser)
 {
@@ -5218,15 +6017,33 @@ structures::test_json::MESSAGE_message_one MESSAGE_message_one_parse(ParserT& pa
 	return t;
 }
 
+template<typename msgID, typename ... Args>
+size_t serializedSize( Args&& ... args )
+{
+	static_assert( std::is_base_of<::globalmq::marshalling::impl::MessageNameBase, msgID>::value );
+	::globalmq::marshalling::SizeMeasuringBuffer buffer;
+	globalmq::marshalling::JsonComposer composer( buffer );
+	composer.buff.append( "{\n  ", sizeof("{\n  ") - 1 );
+	::globalmq::marshalling::impl::json::composeNamedSignedInteger( composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "msgid", "\"msgid\":" ), msgID::id);
+	composer.buff.append( ",\n  ", sizeof(",\n  ") - 1 );
+	::globalmq::marshalling::impl::json::addNamePart( composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "msgbody", "\"msgbody\":" ) );
+	composer.buff.append( "\n}", 2 );
+	if constexpr ( msgID::id == message_one::id )
+		return buffer.size() + MESSAGE_message_one_serializedSize( composer, std::forward<Args>( args )... );
+	else
+		static_assert( std::is_same<::globalmq::marshalling::impl::MessageNameBase, msgID>::value, "unexpected value of msgID" );
+}
+
 template<typename msgID, class BufferT, typename ... Args>
 void composeMessage( BufferT& buffer, Args&& ... args )
 {
 	static_assert( std::is_base_of<::globalmq::marshalling::impl::MessageNameBase, msgID>::value );
+	::globalmq::marshalling::impl::reserveForComposing( buffer, serializedSize<msgID>( std::forward<Args>( args )... ) );
 	globalmq::marshalling::JsonComposer composer( buffer );
 	composer.buff.append( "{\n  ", sizeof("{\n  ") - 1 );
-	::globalmq::marshalling::impl::json::composeNamedSignedInteger( composer, "msgid", msgID::id);
+	::globalmq::marshalling::impl::json::composeNamedSignedInteger( composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "msgid", "\"msgid\":" ), msgID::id);
 	composer.buff.append( ",\n  ", sizeof(",\n  ") - 1 );
-	::globalmq::marshalling::impl::json::addNamePart( composer, "msgbody" );
+	::globalmq::marshalling::impl::json::addNamePart( composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "msgbody", "\"msgbody\":" ) );
 	if constexpr ( msgID::id == message_one::id )
 		MESSAGE_message_one_compose( composer, std::forward<Args>( args )... );
 	else
@@ -5313,10 +6130,16 @@ void MESSAGE_Level_compose(ComposerT& composer, Args&& ... args)
 
 	static_assert( ComposerT::proto == Proto::JSON, "this MESSAGE assumes only JSON protocol" );
 	composer.buff.append( "{\n  ", sizeof("{\n  ") - 1 );
-	::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_1_type, true, int64_t, int64_t, (int64_t)(0)>(composer, "Level", arg_1_type::nameAndTypeID, args...);
+	::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_1_type, true, int64_t, int64_t, (int64_t)(0)>(composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "Level", "\"Level\":" ), arg_1_type::nameAndTypeID, args...);
 	composer.buff.append( "\n}", 2 );
 }
 
+template<class ComposerT, typename ... Args>
+size_t MESSAGE_Level_serializedSize(const ComposerT& composer, Args&& ... args)
+{
+	return ::globalmq::marshalling::impl::measureComposedSize( composer, [&]( auto& measuringComposer ) { MESSAGE_Level_compose( measuringComposer, std::forward<Args>( args )... ); } );
+}
+
 template<class ParserT>
 structures::level_data::MESSAGE_Level MESSAGE_Level_parse(ParserT& parser)
 {
@@ -5333,15 +6156,33 @@ structures::level_data::MESSAGE_Level MESSAGE_Level_parse(ParserT& parser)
 	return t;
 }
 
+template<typename msgID, typename ... Args>
+size_t serializedSize( Args&& ... args )
+{
+	static_assert( std::is_base_of<::globalmq::marshalling::impl::MessageNameBase, msgID>::value );
+	::globalmq::marshalling::SizeMeasuringBuffer buffer;
+	globalmq::marshalling::JsonComposer composer( buffer );
+	composer.buff.append( "{\n  ", sizeof("{\n  ") - 1 );
+	::globalmq::marshalling::impl::json::composeNamedSignedInteger( composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "msgid", "\"msgid\":" ), msgID::id);
+	composer.buff.append( ",\n  ", sizeof(",\n  ") - 1 );
+	::globalmq::marshalling::impl::json::addNamePart( composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "msgbody", "\"msgbody\":" ) );
+	composer.buff.append( "\n}", 2 );
+	if constexpr ( msgID::id == Level::id )
+		return buffer.size() + MESSAGE_Level_serializedSize( composer, std::forward<Args>( args )... );
+	else
+		static_assert( std::is_same<::globalmq::marshalling::impl::MessageNameBase, msgID>::value, "unexpected value of msgID" );
+}
+
 template<typename msgID, class BufferT, typename ... Args>
 void composeMessage( BufferT& buffer, Args&& ... args )
 {
 	static_assert( std::is_base_of<::globalmq::marshalling::impl::MessageNameBase, msgID>::value );
+	::globalmq::marshalling::impl::reserveForComposing( buffer, serializedSize<msgID>( std::forward<Args>( args )... ) );
 	globalmq::marshalling::JsonComposer composer( buffer );
 	composer.buff.append( "{\n  ", sizeof("{\n  ") - 1 );
-	::globalmq::marshalling::impl::json::composeNamedSignedInteger( composer, "msgid", msgID::id);
+	::globalmq::marshalling::impl::json::composeNamedSignedInteger( composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "msgid", "\"msgid\":" ), msgID::id);
 	composer.buff.append( ",\n  ", sizeof(",\n  ") - 1 );
-	::globalmq::marshalling::impl::json::addNamePart( composer, "msgbody" );
+	::globalmq::marshalling::impl::json::addNamePart( composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "msgbody", "\"msgbody\":" ) );
 	if constexpr ( msgID::id == Level::id )
 		MESSAGE_Level_compose( composer, std::forward<Args>( args )... );
 	else
@@ -5380,19 +6221,22 @@ public:
 	ComposerT& getComposer() { return composer; }
 	void startTick( BufferT&& buff ) { buffer = std::move( buff ); composer.reset(); ::globalmq::marshalling::impl::composeStateUpdateMessageBegin<ComposerT>( composer );}
 	BufferT&& endTick() { ::globalmq::marshalling::impl::composeStateUpdateMessageEnd( composer ); return std::move( buffer ); }
+	virtual bool setLengthPrefixedStrings( bool lengthPrefixed ) { return ::globalmq::marshalling::PublishableStateMessageHeader::applyStringEncoding( composer, lengthPrefixed ); }
+	virtual size_t serializedSize() { return ::globalmq::marshalling::impl::measureComposedSize( composer, [this]( auto& measuringComposer ) { compose( measuringComposer ); } ); }
+	virtual uint64_t changeCount() { return composer.changeCount; }
 	const char* name() { return stringTypeID; }
 	const char* publishableName() { return stringTypeID; }
 	virtual uint64_t stateTypeID() { return numTypeID; }
 	auto get_ID() { return t.ID; }
 	void set_ID( decltype(T::ID) val) { 
 		t.ID = val; 
-		::globalmq::marshalling::impl::composeAddressInPublishable( composer, GMQ_COLL vector<size_t>(), 0 );
+		::globalmq::marshalling::impl::composeAddressInPublishable( composer, ::globalmq::marshalling::PublishableAddress(), 0 );
 		::globalmq::marshalling::impl::publishableComposeLeafeInteger( composer, t.ID );
 	}
 	const auto& get_name() { return t.name; }
 	void set_name( decltype(T::name) val) { 
 		t.name = val; 
-		::globalmq::marshalling::impl::composeAddressInPublishable( composer, GMQ_COLL vector<size_t>(), 1 );
+		::globalmq::marshalling::impl::composeAddressInPublishable( composer, ::globalmq::marshalling::PublishableAddress(), 1 );
 		::globalmq::marshalling::impl::publishableComposeLeafeString( composer, t.name );
 	}
 
@@ -5401,9 +6245,9 @@ public:
 	{
 		::globalmq::marshalling::impl::composeStructBegin( composer );
 
-		::globalmq::marshalling::impl::publishableStructComposeInteger( composer, t.ID, "ID", true );
+		::globalmq::marshalling::impl::publishableStructComposeInteger( composer, t.ID, ::globalmq::marshalling::impl::JsonKeyForComposing( "ID", "\"ID\":" ), true );
 
-		::globalmq::marshalling::impl::publishableStructComposeString( composer, t.name, "name", false );
+		::globalmq::marshalling::impl::publishableStructComposeString( composer, t.name, ::globalmq::marshalling::impl::JsonKeyForComposing( "name", "\"name\":" ), false );
 
 
 		::globalmq::marshalling::impl::composeStructEnd( composer );
@@ -5475,8 +6319,8 @@ public:
 	{
 		::globalmq::marshalling::impl::parseStateUpdateMessageBegin( parser );
 		bool changed = false;
-		GMQ_COLL vector<size_t> addr;
-		while( ::globalmq::marshalling::impl::parseAddressInPublishable<ParserT, GMQ_COLL vector<size_t>>( parser, addr ) )
+		::globalmq::marshalling::PublishableAddress addr;
+		while( ::globalmq::marshalling::impl::parseAddressInPublishable<ParserT, ::globalmq::marshalling::PublishableAddress>( parser, addr ) )
 		{
 			GMQ_ASSERT( addr.size() );
 			switch ( addr[0] )
@@ -5632,9 +6476,9 @@ public:
 	{
 		::globalmq::marshalling::impl::composeStructBegin( composer );
 
-		::globalmq::marshalling::impl::publishableStructComposeInteger( composer, t.ID, "ID", true );
+		::globalmq::marshalling::impl::publishableStructComposeInteger( composer, t.ID, ::globalmq::marshalling::impl::JsonKeyForComposing( "ID", "\"ID\":" ), true );
 
-		::globalmq::marshalling::impl::publishableStructComposeString( composer, t.name, "name", false );
+		::globalmq::marshalling::impl::publishableStructComposeString( composer, t.name, ::globalmq::marshalling::impl::JsonKeyForComposing( "name", "\"name\":" ), false );
 
 
 		::globalmq::marshalling::impl::composeStructEnd( composer );
@@ -5651,8 +6495,8 @@ public:
 	{
 		::globalmq::marshalling::impl::parseStateUpdateMessageBegin( parser );
 		bool changed = false;
-		GMQ_COLL vector<size_t> addr;
-		while( ::globalmq::marshalling::impl::parseAddressInPublishable<ParserT, GMQ_COLL vector<size_t>>( parser, addr ) )
+		::globalmq::marshalling::PublishableAddress addr;
+		while( ::globalmq::marshalling::impl::parseAddressInPublishable<ParserT, ::globalmq::marshalling::PublishableAddress>( parser, addr ) )
 		{
 			GMQ_ASSERT( addr.size() );
 			switch ( addr[0] )
@@ -5741,115 +6585,118 @@ public:
 	ComposerT& getComposer() { return composer; }
 	void startTick( BufferT&& buff ) { buffer = std::move( buff ); composer.reset(); ::globalmq::marshalling::impl::composeStateUpdateMessageBegin<ComposerT>( composer );}
 	BufferT&& endTick() { ::globalmq::marshalling::impl::composeStateUpdateMessageEnd( composer ); return std::move( buffer ); }
+	virtual bool setLengthPrefixedStrings( bool lengthPrefixed ) { return ::globalmq::marshalling::PublishableStateMessageHeader::applyStringEncoding( composer, lengthPrefixed ); }
+	virtual size_t serializedSize() { return ::globalmq::marshalling::impl::measureComposedSize( composer, [this]( auto& measuringComposer ) { compose( measuringComposer ); } ); }
+	virtual uint64_t changeCount() { return composer.changeCount; }
 	const char* name() { return stringTypeID; }
 	const char* publishableName() { return stringTypeID; }
 	virtual uint64_t stateTypeID() { return numTypeID; }
 	auto get_ID() { return t.ID; }
 	void set_ID( decltype(T::ID) val) { 
 		t.ID = val; 
-		::globalmq::marshalling::impl::composeAddressInPublishable( composer, GMQ_COLL vector<size_t>(), 0 );
+		::globalmq::marshalling::impl::composeAddressInPublishable( composer, ::globalmq::marshalling::PublishableAddress(), 0 );
 		::globalmq::marshalling::impl::publishableComposeLeafeInteger( composer, t.ID );
 	}
 	const auto& get_name() { return t.name; }
 	void set_name( decltype(T::name) val) { 
 		t.name = val; 
-		::globalmq::marshalling::impl::composeAddressInPublishable( composer, GMQ_COLL vector<size_t>(), 1 );
+		::globalmq::marshalling::impl::composeAddressInPublishable( composer, ::globalmq::marshalling::PublishableAddress(), 1 );
 		::globalmq::marshalling::impl::publishableComposeLeafeString( composer, t.name );
 	}
 	const auto& get_size() { return t.size; }
 	void set_size( decltype(T::size) val) { 
 		t.size = val; 
-		::globalmq::marshalling::impl::composeAddressInPublishable( composer, GMQ_COLL vector<size_t>(), 2 );
+		::globalmq::marshalling::impl::composeAddressInPublishable( composer, ::globalmq::marshalling::PublishableAddress(), 2 );
 		::globalmq::marshalling::impl::publishableComposeLeafeStructBegin( composer );
 		publishable_STRUCT_SIZE::compose( composer, t.size );
 		::globalmq::marshalling::impl::publishableComposeLeafeStructEnd( composer );
 	}
-	auto get4set_size() { return SIZE_RefWrapper4Set<decltype(T::size), publishable_sample_WrapperForPublisher>(t.size, *this, GMQ_COLL vector<size_t>(), 2); }
+	auto get4set_size() { return SIZE_RefWrapper4Set<decltype(T::size), publishable_sample_WrapperForPublisher>(t.size, *this, ::globalmq::marshalling::PublishableAddress(), 2); }
 	const auto& get_chp() { return t.chp; }
 	void set_chp( decltype(T::chp) val) { 
 		t.chp = val; 
-		::globalmq::marshalling::impl::composeAddressInPublishable( composer, GMQ_COLL vector<size_t>(), 3 );
+		::globalmq::marshalling::impl::composeAddressInPublishable( composer, ::globalmq::marshalling::PublishableAddress(), 3 );
 		::globalmq::marshalling::impl::publishableComposeLeafeStructBegin( composer );
 		publishable_STRUCT_CharacterParamStruct::compose( composer, t.chp );
 		::globalmq::marshalling::impl::publishableComposeLeafeStructEnd( composer );
 	}
-	auto get4set_chp() { return CharacterParamStruct_RefWrapper4Set<decltype(T::chp), publishable_sample_WrapperForPublisher>(t.chp, *this, GMQ_COLL vector<size_t>(), 3); }
+	auto get4set_chp() { return CharacterParamStruct_RefWrapper4Set<decltype(T::chp), publishable_sample_WrapperForPublisher>(t.chp, *this, ::globalmq::marshalling::PublishableAddress(), 3); }
 	auto get_vector_of_int() { return globalmq::marshalling::VectorOfSimpleTypeRefWrapper(t.vector_of_int); }
 	void set_vector_of_int( decltype(T::vector_of_int) val) { 
 		t.vector_of_int = val; 
-		::globalmq::marshalling::impl::composeAddressInPublishable( composer, GMQ_COLL vector<size_t>(), 4 );
+		::globalmq::marshalling::impl::composeAddressInPublishable( composer, ::globalmq::marshalling::PublishableAddress(), 4 );
 		::globalmq::marshalling::impl::publishableComposeLeafeValueBegin( composer );
 		PublishableVectorProcessor::compose<ComposerT, decltype(T::vector_of_int), ::globalmq::marshalling::impl::SignedIntegralType>( composer, t.vector_of_int );
 		::globalmq::marshalling::impl::composeStateUpdateBlockEnd( composer );
 	}
-	auto get4set_vector_of_int() { return globalmq::marshalling::VectorRefWrapper4Set<decltype(T::vector_of_int), ::globalmq::marshalling::impl::SignedIntegralType, publishable_sample_WrapperForPublisher>(t.vector_of_int, *this, GMQ_COLL vector<size_t>(), 4); }
+	auto get4set_vector_of_int() { return globalmq::marshalling::VectorRefWrapper4Set<decltype(T::vector_of_int), ::globalmq::marshalling::impl::SignedIntegralType, publishable_sample_WrapperForPublisher>(t.vector_of_int, *this, ::globalmq::marshalling::PublishableAddress(), 4); }
 	auto get_vector_struct_point3dreal() { return globalmq::marshalling::VectorOfStructRefWrapper<POINT3DREAL_RefWrapper<typename decltype(T::vector_struct_point3dreal)::value_type>, decltype(T::vector_struct_point3dreal)>(t.vector_struct_point3dreal); }
 	void set_vector_struct_point3dreal( decltype(T::vector_struct_point3dreal) val) { 
 		t.vector_struct_point3dreal = val; 
-		::globalmq::marshalling::impl::composeAddressInPublishable( composer, GMQ_COLL vector<size_t>(), 5 );
+		::globalmq::marshalling::impl::composeAddressInPublishable( composer, ::globalmq::marshalling::PublishableAddress(), 5 );
 		::globalmq::marshalling::impl::publishableComposeLeafeValueBegin( composer );
 		PublishableVectorProcessor::compose<ComposerT, decltype(T::vector_struct_point3dreal), publishable_STRUCT_POINT3DREAL>( composer, t.vector_struct_point3dreal );
 		::globalmq::marshalling::impl::composeStateUpdateBlockEnd( composer );
 	}
-	auto get4set_vector_struct_point3dreal() { return globalmq::marshalling::VectorOfStructRefWrapper4Set<decltype(T::vector_struct_point3dreal), publishable_STRUCT_POINT3DREAL, publishable_sample_WrapperForPublisher, POINT3DREAL_RefWrapper4Set<typename decltype(T::vector_struct_point3dreal)::value_type, publishable_sample_WrapperForPublisher>>(t.vector_struct_point3dreal, *this, GMQ_COLL vector<size_t>(), 5); }
+	auto get4set_vector_struct_point3dreal() { return globalmq::marshalling::VectorOfStructRefWrapper4Set<decltype(T::vector_struct_point3dreal), publishable_STRUCT_POINT3DREAL, publishable_sample_WrapperForPublisher, POINT3DREAL_RefWrapper4Set<typename decltype(T::vector_struct_point3dreal)::value_type, publishable_sample_WrapperForPublisher>>(t.vector_struct_point3dreal, *this, ::globalmq::marshalling::PublishableAddress(), 5); }
 	const auto& get_structWithVectorOfInt() { return t.structWithVectorOfInt; }
 	void set_structWithVectorOfInt( decltype(T::structWithVectorOfInt) val) { 
 		t.structWithVectorOfInt = val; 
-		::globalmq::marshalling::impl::composeAddressInPublishable( composer, GMQ_COLL vector<size_t>(), 6 );
+		::globalmq::marshalling::impl::composeAddressInPublishable( composer, ::globalmq::marshalling::PublishableAddress(), 6 );
 		::globalmq::marshalling::impl::publishableComposeLeafeStructBegin( composer );
 		publishable_STRUCT_StructWithVectorOfInt::compose( composer, t.structWithVectorOfInt );
 		::globalmq::marshalling::impl::publishableComposeLeafeStructEnd( composer );
 	}
-	auto get4set_structWithVectorOfInt() { return StructWithVectorOfInt_RefWrapper4Set<decltype(T::structWithVectorOfInt), publishable_sample_WrapperForPublisher>(t.structWithVectorOfInt, *this, GMQ_COLL vector<size_t>(), 6); }
+	auto get4set_structWithVectorOfInt() { return StructWithVectorOfInt_RefWrapper4Set<decltype(T::structWithVectorOfInt), publishable_sample_WrapperForPublisher>(t.structWithVectorOfInt, *this, ::globalmq::marshalling::PublishableAddress(), 6); }
 	const auto& get_structWithVectorOfSize() { return t.structWithVectorOfSize; }
 	void set_structWithVectorOfSize( decltype(T::structWithVectorOfSize) val) { 
 		t.structWithVectorOfSize = val; 
-		::globalmq::marshalling::impl::composeAddressInPublishable( composer, GMQ_COLL vector<size_t>(), 7 );
+		::globalmq::marshalling::impl::composeAddressInPublishable( composer, ::globalmq::marshalling::PublishableAddress(), 7 );
 		::globalmq::marshalling::impl::publishableComposeLeafeStructBegin( composer );
 		publishable_STRUCT_StructWithVectorOfSize::compose( composer, t.structWithVectorOfSize );
 		::globalmq::marshalling::impl::publishableComposeLeafeStructEnd( composer );
 	}
-	auto get4set_structWithVectorOfSize() { return StructWithVectorOfSize_RefWrapper4Set<decltype(T::structWithVectorOfSize), publishable_sample_WrapperForPublisher>(t.structWithVectorOfSize, *this, GMQ_COLL vector<size_t>(), 7); }
+	auto get4set_structWithVectorOfSize() { return StructWithVectorOfSize_RefWrapper4Set<decltype(T::structWithVectorOfSize), publishable_sample_WrapperForPublisher>(t.structWithVectorOfSize, *this, ::globalmq::marshalling::PublishableAddress(), 7); }
 	const auto& get_du_one_instance() { return t.du_one_instance; }
 	void set_du_one_instance( decltype(T::du_one_instance) val) { 
 		t.du_one_instance = val; 
-		::globalmq::marshalling::impl::composeAddressInPublishable( composer, GMQ_COLL vector<size_t>(), 8 );
+		::globalmq::marshalling::impl::composeAddressInPublishable( composer, ::globalmq::marshalling::PublishableAddress(), 8 );
 		::globalmq::marshalling::impl::publishableComposeLeafeStructBegin( composer );
 		publishable_DISCRIMINATED_UNION_du_one::compose( composer, t.du_one_instance );
 		::globalmq::marshalling::impl::publishableComposeLeafeStructEnd( composer );
 	}
-	auto get4set_du_one_instance() { return du_one_RefWrapper4Set<decltype(T::du_one_instance), publishable_sample_WrapperForPublisher>(t.du_one_instance, *this, GMQ_COLL vector<size_t>(), 8); }
+	auto get4set_du_one_instance() { return du_one_RefWrapper4Set<decltype(T::du_one_instance), publishable_sample_WrapperForPublisher>(t.du_one_instance, *this, ::globalmq::marshalling::PublishableAddress(), 8); }
 
 	template<class ComposerType>
 	void compose( ComposerType& composer )
 	{
 		::globalmq::marshalling::impl::composeStructBegin( composer );
 
-		::globalmq::marshalling::impl::publishableStructComposeInteger( composer, t.ID, "ID", true );
+		::globalmq::marshalling::impl::publishableStructComposeInteger( composer, t.ID, ::globalmq::marshalling::impl::JsonKeyForComposing( "ID", "\"ID\":" ), true );
 
-		::globalmq::marshalling::impl::publishableStructComposeString( composer, t.name, "name", true );
+		::globalmq::marshalling::impl::publishableStructComposeString( composer, t.name, ::globalmq::marshalling::impl::JsonKeyForComposing( "name", "\"name\":" ), true );
 
-		::globalmq::marshalling::impl::composePublishableStructBegin( composer, "size" );
+		::globalmq::marshalling::impl::composePublishableStructBegin( composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "size", "\"size\":" ) );
 		publishable_STRUCT_SIZE::compose( composer, t.size );
 		::globalmq::marshalling::impl::composePublishableStructEnd( composer, true );
 
-		::globalmq::marshalling::impl::composePublishableStructBegin( composer, "chp" );
+		::globalmq::marshalling::impl::composePublishableStructBegin( composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "chp", "\"chp\":" ) );
 		publishable_STRUCT_CharacterParamStruct::compose( composer, t.chp );
 		::globalmq::marshalling::impl::composePublishableStructEnd( composer, true );
 
-		PublishableVectorProcessor::compose<ComposerT, decltype(T::vector_of_int), ::globalmq::marshalling::impl::SignedIntegralType>( composer, t.vector_of_int, "vector_of_int", true );
+		PublishableVectorProcessor::compose<ComposerType, decltype(T::vector_of_int), ::globalmq::marshalling::impl::SignedIntegralType>( composer, t.vector_of_int, ::globalmq::marshalling::impl::JsonKeyForComposing( "vector_of_int", "\"vector_of_int\":" ), true );
 
-		PublishableVectorProcessor::compose<ComposerT, decltype(T::vector_struct_point3dreal), publishable_STRUCT_POINT3DREAL>( composer, t.vector_struct_point3dreal, "vector_struct_point3dreal", true );
+		PublishableVectorProcessor::compose<ComposerType, decltype(T::vector_struct_point3dreal), publishable_STRUCT_POINT3DREAL>( composer, t.vector_struct_point3dreal, ::globalmq::marshalling::impl::JsonKeyForComposing( "vector_struct_point3dreal", "\"vector_struct_point3dreal\":" ), true );
 
-		::globalmq::marshalling::impl::composePublishableStructBegin( composer, "structWithVectorOfInt" );
+		::globalmq::marshalling::impl::composePublishableStructBegin( composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "structWithVectorOfInt", "\"structWithVectorOfInt\":" ) );
 		publishable_STRUCT_StructWithVectorOfInt::compose( composer, t.structWithVectorOfInt );
 		::globalmq::marshalling::impl::composePublishableStructEnd( composer, true );
 
-		::globalmq::marshalling::impl::composePublishableStructBegin( composer, "structWithVectorOfSize" );
+		::globalmq::marshalling::impl::composePublishableStructBegin( composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "structWithVectorOfSize", "\"structWithVectorOfSize\":" ) );
 		publishable_STRUCT_StructWithVectorOfSize::compose( composer, t.structWithVectorOfSize );
 		::globalmq::marshalling::impl::composePublishableStructEnd( composer, true );
 
-		::globalmq::marshalling::impl::composePublishableStructBegin( composer, "du_one_instance" );
+		::globalmq::marshalling::impl::composePublishableStructBegin( composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "du_one_instance", "\"du_one_instance\":" ) );
 		publishable_DISCRIMINATED_UNION_du_one::compose( composer, t.du_one_instance );
 		::globalmq::marshalling::impl::composePublishableStructEnd( composer, false );
 
@@ -5978,8 +6825,8 @@ public:
 	{
 		::globalmq::marshalling::impl::parseStateUpdateMessageBegin( parser );
 		bool changed = false;
-		GMQ_COLL vector<size_t> addr;
-		while( ::globalmq::marshalling::impl::parseAddressInPublishable<ParserT, GMQ_COLL vector<size_t>>( parser, addr ) )
+		::globalmq::marshalling::PublishableAddress addr;
+		while( ::globalmq::marshalling::impl::parseAddressInPublishable<ParserT, ::globalmq::marshalling::PublishableAddress>( parser, addr ) )
 		{
 			GMQ_ASSERT( addr.size() );
 			switch ( addr[0] )
@@ -6064,7 +6911,11 @@ public:
 						else
 						{
 							if constexpr ( reportChanges || has_update_notifier )
-								changed = publishable_STRUCT_SIZE::parse<ParserT, decltype(T::size), bool>( parser, t.size );
+							{
+								bool changedCurrent = publishable_STRUCT_SIZE::parse<ParserT, decltype(T::size), bool>( parser, t.size );
+								if ( changedCurrent )
+									changed = true;
+							}
 							else
 								publishable_STRUCT_SIZE::parse( parser, t.size );
 						}
@@ -6080,7 +6931,6 @@ public:
 							bool changedCurrent = publishable_STRUCT_SIZE::parse<ParserT, decltype(T::size), bool>( parser, t.size, addr, 1 );
 							if ( changedCurrent )
 							{
-								changed = true;
 								if constexpr ( reportChanges || has_update_notifier )
 									changed = true;
 								if constexpr( has_void_update_notifier_for_size )
@@ -6100,7 +6950,11 @@ public:
 							}
 						}
 						else if constexpr ( reportChanges || has_update_notifier )
-							changed = publishable_STRUCT_SIZE::parse<ParserT, decltype(T::size), bool>( parser, t.size, addr, 1 );
+						{
+							bool changedCurrent = publishable_STRUCT_SIZE::parse<ParserT, decltype(T::size), bool>( parser, t.size, addr, 1 );
+							if ( changedCurrent )
+								changed = true;
+						}
 						else
 							publishable_STRUCT_SIZE::parse( parser, t.size, addr, 1 );
 					}
@@ -6140,7 +6994,11 @@ public:
 						else
 						{
 							if constexpr ( reportChanges || has_update_notifier )
-								changed = publishable_STRUCT_CharacterParamStruct::parse<ParserT, decltype(T::chp), bool>( parser, t.chp );
+							{
+								bool changedCurrent = publishable_STRUCT_CharacterParamStruct::parse<ParserT, decltype(T::chp), bool>( parser, t.chp );
+								if ( changedCurrent )
+									changed = true;
+							}
 							else
 								publishable_STRUCT_CharacterParamStruct::parse( parser, t.chp );
 						}
@@ -6156,7 +7014,6 @@ public:
 							bool changedCurrent = publishable_STRUCT_CharacterParamStruct::parse<ParserT, decltype(T::chp), bool>( parser, t.chp, addr, 1 );
 							if ( changedCurrent )
 							{
-								changed = true;
 								if constexpr ( reportChanges || has_update_notifier )
 									changed = true;
 								if constexpr( has_void_update_notifier_for_chp )
@@ -6176,7 +7033,11 @@ public:
 							}
 						}
 						else if constexpr ( reportChanges || has_update_notifier )
-							changed = publishable_STRUCT_CharacterParamStruct::parse<ParserT, decltype(T::chp), bool>( parser, t.chp, addr, 1 );
+						{
+							bool changedCurrent = publishable_STRUCT_CharacterParamStruct::parse<ParserT, decltype(T::chp), bool>( parser, t.chp, addr, 1 );
+							if ( changedCurrent )
+								changed = true;
+						}
 						else
 							publishable_STRUCT_CharacterParamStruct::parse( parser, t.chp, addr, 1 );
 					}
@@ -6186,7 +7047,7 @@ public:
 				{
 					decltype(T::vector_of_int) oldVectorVal;
 					bool currentChanged = false;
-					constexpr bool alwaysCollectChanges = has_any_notifier_for_vector_of_int;
+					constexpr bool alwaysCollectChanges = reportChanges || has_any_notifier_for_vector_of_int;
 					if constexpr( alwaysCollectChanges )
 						::globalmq::marshalling::impl::copyVector<decltype(T::vector_of_int), ::globalmq::marshalling::impl::SignedIntegralType>( t.vector_of_int, oldVectorVal );
 					if ( addr.size() > 1 ) // one of actions over elements of the vector
@@ -6323,7 +7184,7 @@ public:
 				{
 					decltype(T::vector_struct_point3dreal) oldVectorVal;
 					bool currentChanged = false;
-					constexpr bool alwaysCollectChanges = has_any_notifier_for_vector_struct_point3dreal;
+					constexpr bool alwaysCollectChanges = reportChanges || has_any_notifier_for_vector_struct_point3dreal;
 					if constexpr( alwaysCollectChanges )
 						::globalmq::marshalling::impl::copyVector<decltype(T::vector_struct_point3dreal), publishable_STRUCT_POINT3DREAL>( t.vector_struct_point3dreal, oldVectorVal );
 					if ( addr.size() > 1 ) // one of actions over elements of the vector
@@ -6532,7 +7393,11 @@ public:
 						else
 						{
 							if constexpr ( reportChanges || has_update_notifier )
-								changed = publishable_STRUCT_StructWithVectorOfInt::parse<ParserT, decltype(T::structWithVectorOfInt), bool>( parser, t.structWithVectorOfInt );
+							{
+								bool changedCurrent = publishable_STRUCT_StructWithVectorOfInt::parse<ParserT, decltype(T::structWithVectorOfInt), bool>( parser, t.structWithVectorOfInt );
+								if ( changedCurrent )
+									changed = true;
+							}
 							else
 								publishable_STRUCT_StructWithVectorOfInt::parse( parser, t.structWithVectorOfInt );
 						}
@@ -6548,7 +7413,6 @@ public:
 							bool changedCurrent = publishable_STRUCT_StructWithVectorOfInt::parse<ParserT, decltype(T::structWithVectorOfInt), bool>( parser, t.structWithVectorOfInt, addr, 1 );
 							if ( changedCurrent )
 							{
-								changed = true;
 								if constexpr ( reportChanges || has_update_notifier )
 									changed = true;
 								if constexpr( has_void_update_notifier_for_structWithVectorOfInt )
@@ -6568,7 +7432,11 @@ public:
 							}
 						}
 						else if constexpr ( reportChanges || has_update_notifier )
-							changed = publishable_STRUCT_StructWithVectorOfInt::parse<ParserT, decltype(T::structWithVectorOfInt), bool>( parser, t.structWithVectorOfInt, addr, 1 );
+						{
+							bool changedCurrent = publishable_STRUCT_StructWithVectorOfInt::parse<ParserT, decltype(T::structWithVectorOfInt), bool>( parser, t.structWithVectorOfInt, addr, 1 );
+							if ( changedCurrent )
+								changed = true;
+						}
 						else
 							publishable_STRUCT_StructWithVectorOfInt::parse( parser, t.structWithVectorOfInt, addr, 1 );
 					}
@@ -6608,7 +7476,11 @@ public:
 						else
 						{
 							if constexpr ( reportChanges || has_update_notifier )
-								changed = publishable_STRUCT_StructWithVectorOfSize::parse<ParserT, decltype(T::structWithVectorOfSize), bool>( parser, t.structWithVectorOfSize );
+							{
+								bool changedCurrent = publishable_STRUCT_StructWithVectorOfSize::parse<ParserT, decltype(T::structWithVectorOfSize), bool>( parser, t.structWithVectorOfSize );
+								if ( changedCurrent )
+									changed = true;
+							}
 							else
 								publishable_STRUCT_StructWithVectorOfSize::parse( parser, t.structWithVectorOfSize );
 						}
@@ -6624,7 +7496,6 @@ public:
 							bool changedCurrent = publishable_STRUCT_StructWithVectorOfSize::parse<ParserT, decltype(T::structWithVectorOfSize), bool>( parser, t.structWithVectorOfSize, addr, 1 );
 							if ( changedCurrent )
 							{
-								changed = true;
 								if constexpr ( reportChanges || has_update_notifier )
 									changed = true;
 								if constexpr( has_void_update_notifier_for_structWithVectorOfSize )
@@ -6644,7 +7515,11 @@ public:
 							}
 						}
 						else if constexpr ( reportChanges || has_update_notifier )
-							changed = publishable_STRUCT_StructWithVectorOfSize::parse<ParserT, decltype(T::structWithVectorOfSize), bool>( parser, t.structWithVectorOfSize, addr, 1 );
+						{
+							bool changedCurrent = publishable_STRUCT_StructWithVectorOfSize::parse<ParserT, decltype(T::structWithVectorOfSize), bool>( parser, t.structWithVectorOfSize, addr, 1 );
+							if ( changedCurrent )
+								changed = true;
+						}
 						else
 							publishable_STRUCT_StructWithVectorOfSize::parse( parser, t.structWithVectorOfSize, addr, 1 );
 					}
@@ -6684,7 +7559,11 @@ public:
 						else
 						{
 							if constexpr ( reportChanges || has_update_notifier )
-								changed = publishable_DISCRIMINATED_UNION_du_one::parse<ParserT, decltype(T::du_one_instance), bool>( parser, t.du_one_instance );
+							{
+								bool changedCurrent = publishable_DISCRIMINATED_UNION_du_one::parse<ParserT, decltype(T::du_one_instance), bool>( parser, t.du_one_instance );
+								if ( changedCurrent )
+									changed = true;
+							}
 							else
 								publishable_DISCRIMINATED_UNION_du_one::parse( parser, t.du_one_instance );
 						}
@@ -6700,7 +7579,6 @@ public:
 							bool changedCurrent = publishable_DISCRIMINATED_UNION_du_one::parse<ParserT, decltype(T::du_one_instance), bool>( parser, t.du_one_instance, addr, 1 );
 							if ( changedCurrent )
 							{
-								changed = true;
 								if constexpr ( reportChanges || has_update_notifier )
 									changed = true;
 								if constexpr( has_void_update_notifier_for_du_one_instance )
@@ -6720,7 +7598,11 @@ public:
 							}
 						}
 						else if constexpr ( reportChanges || has_update_notifier )
-							changed = publishable_DISCRIMINATED_UNION_du_one::parse<ParserT, decltype(T::du_one_instance), bool>( parser, t.du_one_instance, addr, 1 );
+						{
+							bool changedCurrent = publishable_DISCRIMINATED_UNION_du_one::parse<ParserT, decltype(T::du_one_instance), bool>( parser, t.du_one_instance, addr, 1 );
+							if ( changedCurrent )
+								changed = true;
+						}
 						else
 							publishable_DISCRIMINATED_UNION_du_one::parse( parser, t.du_one_instance, addr, 1 );
 					}
@@ -6878,31 +7760,31 @@ public:
 	{
 		::globalmq::marshalling::impl::composeStructBegin( composer );
 
-		::globalmq::marshalling::impl::publishableStructComposeInteger( composer, t.ID, "ID", true );
+		::globalmq::marshalling::impl::publishableStructComposeInteger( composer, t.ID, ::globalmq::marshalling::impl::JsonKeyForComposing( "ID", "\"ID\":" ), true );
 
-		::globalmq::marshalling::impl::publishableStructComposeString( composer, t.name, "name", true );
+		::globalmq::marshalling::impl::publishableStructComposeString( composer, t.name, ::globalmq::marshalling::impl::JsonKeyForComposing( "name", "\"name\":" ), true );
 
-		::globalmq::marshalling::impl::composePublishableStructBegin( composer, "size" );
+		::globalmq::marshalling::impl::composePublishableStructBegin( composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "size", "\"size\":" ) );
 		publishable_STRUCT_SIZE::compose( composer, t.size );
 		::globalmq::marshalling::impl::composePublishableStructEnd( composer, true );
 
-		::globalmq::marshalling::impl::composePublishableStructBegin( composer, "chp" );
+		::globalmq::marshalling::impl::composePublishableStructBegin( composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "chp", "\"chp\":" ) );
 		publishable_STRUCT_CharacterParamStruct::compose( composer, t.chp );
 		::globalmq::marshalling::impl::composePublishableStructEnd( composer, true );
 
-		PublishableVectorProcessor::compose<ComposerT, decltype(T::vector_of_int), ::globalmq::marshalling::impl::SignedIntegralType>( composer, t.vector_of_int, "vector_of_int", true );
+		PublishableVectorProcessor::compose<ComposerType, decltype(T::vector_of_int), ::globalmq::marshalling::impl::SignedIntegralType>( composer, t.vector_of_int, ::globalmq::marshalling::impl::JsonKeyForComposing( "vector_of_int", "\"vector_of_int\":" ), true );
 
-		PublishableVectorProcessor::compose<ComposerT, decltype(T::vector_struct_point3dreal), publishable_STRUCT_POINT3DREAL>( composer, t.vector_struct_point3dreal, "vector_struct_point3dreal", true );
+		PublishableVectorProcessor::compose<ComposerType, decltype(T::vector_struct_point3dreal), publishable_STRUCT_POINT3DREAL>( composer, t.vector_struct_point3dreal, ::globalmq::marshalling::impl::JsonKeyForComposing( "vector_struct_point3dreal", "\"vector_struct_point3dreal\":" ), true );
 
-		::globalmq::marshalling::impl::composePublishableStructBegin( composer, "structWithVectorOfInt" );
+		::globalmq::marshalling::impl::composePublishableStructBegin( composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "structWithVectorOfInt", "\"structWithVectorOfInt\":" ) );
 		publishable_STRUCT_StructWithVectorOfInt::compose( composer, t.structWithVectorOfInt );
 		::globalmq::marshalling::impl::composePublishableStructEnd( composer, true );
 
-		::globalmq::marshalling::impl::composePublishableStructBegin( composer, "structWithVectorOfSize" );
+		::globalmq::marshalling::impl::composePublishableStructBegin( composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "structWithVectorOfSize", "\"structWithVectorOfSize\":" ) );
 		publishable_STRUCT_StructWithVectorOfSize::compose( composer, t.structWithVectorOfSize );
 		::globalmq::marshalling::impl::composePublishableStructEnd( composer, true );
 
-		::globalmq::marshalling::impl::composePublishableStructBegin( composer, "du_one_instance" );
+		::globalmq::marshalling::impl::composePublishableStructBegin( composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "du_one_instance", "\"du_one_instance\":" ) );
 		publishable_DISCRIMINATED_UNION_du_one::compose( composer, t.du_one_instance );
 		::globalmq::marshalling::impl::composePublishableStructEnd( composer, false );
 
@@ -6921,8 +7803,8 @@ public:
 	{
 		::globalmq::marshalling::impl::parseStateUpdateMessageBegin( parser );
 		bool changed = false;
-		GMQ_COLL vector<size_t> addr;
-		while( ::globalmq::marshalling::impl::parseAddressInPublishable<ParserT, GMQ_COLL vector<size_t>>( parser, addr ) )
+		::globalmq::marshalling::PublishableAddress addr;
+		while( ::globalmq::marshalling::impl::parseAddressInPublishable<ParserT, ::globalmq::marshalling::PublishableAddress>( parser, addr ) )
 		{
 			GMQ_ASSERT( addr.size() );
 			switch ( addr[0] )
@@ -7198,25 +8080,28 @@ public:
 	ComposerT& getComposer() { return composer; }
 	void startTick( BufferT&& buff ) { buffer = std::move( buff ); composer.reset(); ::globalmq::marshalling::impl::composeStateUpdateMessageBegin<ComposerT>( composer );}
 	BufferT&& endTick() { ::globalmq::marshalling::impl::composeStateUpdateMessageEnd( composer ); return std::move( buffer ); }
+	virtual bool setLengthPrefixedStrings( bool lengthPrefixed ) { return ::globalmq::marshalling::PublishableStateMessageHeader::applyStringEncoding( composer, lengthPrefixed ); }
+	virtual size_t serializedSize() { return ::globalmq::marshalling::impl::measureComposedSize( composer, [this]( auto& measuringComposer ) { compose( measuringComposer ); } ); }
+	virtual uint64_t changeCount() { return composer.changeCount; }
 	const char* name() { return stringTypeID; }
 	const char* publishableName() { return stringTypeID; }
 	virtual uint64_t stateTypeID() { return numTypeID; }
 	const auto& get_tag() { return t.tag; }
 	void set_tag( decltype(T::tag) val) { 
 		t.tag = val; 
-		::globalmq::marshalling::impl::composeAddressInPublishable( composer, GMQ_COLL vector<size_t>(), 0 );
+		::globalmq::marshalling::impl::composeAddressInPublishable( composer, ::globalmq::marshalling::PublishableAddress(), 0 );
 		::globalmq::marshalling::impl::publishableComposeLeafeStructBegin( composer );
 		publishable_STRUCT_HtmlTag::compose( composer, t.tag );
 		::globalmq::marshalling::impl::publishableComposeLeafeStructEnd( composer );
 	}
-	auto get4set_tag() { return HtmlTag_RefWrapper4Set<decltype(T::tag), publishable_html_tag_WrapperForPublisher>(t.tag, *this, GMQ_COLL vector<size_t>(), 0); }
+	auto get4set_tag() { return HtmlTag_RefWrapper4Set<decltype(T::tag), publishable_html_tag_WrapperForPublisher>(t.tag, *this, ::globalmq::marshalling::PublishableAddress(), 0); }
 
 	template<class ComposerType>
 	void compose( ComposerType& composer )
 	{
 		::globalmq::marshalling::impl::composeStructBegin( composer );
 
-		::globalmq::marshalling::impl::composePublishableStructBegin( composer, "tag" );
+		::globalmq::marshalling::impl::composePublishableStructBegin( composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "tag", "\"tag\":" ) );
 		publishable_STRUCT_HtmlTag::compose( composer, t.tag );
 		::globalmq::marshalling::impl::composePublishableStructEnd( composer, false );
 
@@ -7285,8 +8170,8 @@ public:
 	{
 		::globalmq::marshalling::impl::parseStateUpdateMessageBegin( parser );
 		bool changed = false;
-		GMQ_COLL vector<size_t> addr;
-		while( ::globalmq::marshalling::impl::parseAddressInPublishable<ParserT, GMQ_COLL vector<size_t>>( parser, addr ) )
+		::globalmq::marshalling::PublishableAddress addr;
+		while( ::globalmq::marshalling::impl::parseAddressInPublishable<ParserT, ::globalmq::marshalling::PublishableAddress>( parser, addr ) )
 		{
 			GMQ_ASSERT( addr.size() );
 			switch ( addr[0] )
@@ -7325,7 +8210,11 @@ public:
 						else
 						{
 							if constexpr ( reportChanges || has_update_notifier )
-								changed = publishable_STRUCT_HtmlTag::parse<ParserT, decltype(T::tag), bool>( parser, t.tag );
+							{
+								bool changedCurrent = publishable_STRUCT_HtmlTag::parse<ParserT, decltype(T::tag), bool>( parser, t.tag );
+								if ( changedCurrent )
+									changed = true;
+							}
 							else
 								publishable_STRUCT_HtmlTag::parse( parser, t.tag );
 						}
@@ -7341,7 +8230,6 @@ public:
 							bool changedCurrent = publishable_STRUCT_HtmlTag::parse<ParserT, decltype(T::tag), bool>( parser, t.tag, addr, 1 );
 							if ( changedCurrent )
 							{
-								changed = true;
 								if constexpr ( reportChanges || has_update_notifier )
 									changed = true;
 								if constexpr( has_void_update_notifier_for_tag )
@@ -7361,7 +8249,11 @@ public:
 							}
 						}
 						else if constexpr ( reportChanges || has_update_notifier )
-							changed = publishable_STRUCT_HtmlTag::parse<ParserT, decltype(T::tag), bool>( parser, t.tag, addr, 1 );
+						{
+							bool changedCurrent = publishable_STRUCT_HtmlTag::parse<ParserT, decltype(T::tag), bool>( parser, t.tag, addr, 1 );
+							if ( changedCurrent )
+								changed = true;
+						}
 						else
 							publishable_STRUCT_HtmlTag::parse( parser, t.tag, addr, 1 );
 					}
@@ -7469,7 +8361,7 @@ public:
 	{
 		::globalmq::marshalling::impl::composeStructBegin( composer );
 
-		::globalmq::marshalling::impl::composePublishableStructBegin( composer, "tag" );
+		::globalmq::marshalling::impl::composePublishableStructBegin( composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "tag", "\"tag\":" ) );
 		publishable_STRUCT_HtmlTag::compose( composer, t.tag );
 		::globalmq::marshalling::impl::composePublishableStructEnd( composer, false );
 
@@ -7488,8 +8380,8 @@ public:
 	{
 		::globalmq::marshalling::impl::parseStateUpdateMessageBegin( parser );
 		bool changed = false;
-		GMQ_COLL vector<size_t> addr;
-		while( ::globalmq::marshalling::impl::parseAddressInPublishable<ParserT, GMQ_COLL vector<size_t>>( parser, addr ) )
+		::globalmq::marshalling::PublishableAddress addr;
+		while( ::globalmq::marshalling::impl::parseAddressInPublishable<ParserT, ::globalmq::marshalling::PublishableAddress>( parser, addr ) )
 		{
 			GMQ_ASSERT( addr.size() );
 			switch ( addr[0] )
@@ -7570,14 +8462,11 @@ class HtmlTextOrTags_RefWrapper4Set
 {
 	T& t;
 	RootT& root;
-	GMQ_COLL vector<size_t> address;
+	::globalmq::marshalling::PublishableAddress address;
 
 
 public:
-	HtmlTextOrTags_RefWrapper4Set( T& actual, RootT& root_, const GMQ_COLL vector<size_t> address_, size_t idx ) : t( actual ), root( root_ ) {
-		address = address_;
-		address.push_back (idx );
-	}
+	HtmlTextOrTags_RefWrapper4Set( T& actual, RootT& root_, const ::globalmq::marshalling::PublishableAddress& address_, size_t idx ) : t( actual ), root( root_ ), address( address_, idx ) {}
 	auto get_currentVariant() { return t.currentVariant(); }
 	void set_currentVariant( typename T::Variants v ) { 
 		t.initAs( v ); 
@@ -7625,7 +8514,7 @@ class point3D_RefWrapper4Set
 {
 	T& t;
 	RootT& root;
-	GMQ_COLL vector<size_t> address;
+	::globalmq::marshalling::PublishableAddress address;
 	static constexpr bool has_x = has_x_member<T>;
 	static_assert( has_x, "type T must have member T::x of a type corresponding to IDL type INTEGER" );
 	static constexpr bool has_y = has_y_member<T>;
@@ -7635,10 +8524,7 @@ class point3D_RefWrapper4Set
 
 
 public:
-	point3D_RefWrapper4Set( T& actual, RootT& root_, const GMQ_COLL vector<size_t> address_, size_t idx ) : t( actual ), root( root_ ) {
-		address = address_;
-		address.push_back (idx );
-	}
+	point3D_RefWrapper4Set( T& actual, RootT& root_, const ::globalmq::marshalling::PublishableAddress& address_, size_t idx ) : t( actual ), root( root_ ), address( address_, idx ) {}
 	auto get_x() { return t.x; }
 	void set_x( decltype(T::x) val) { 
 		t.x = val; 
@@ -7683,7 +8569,7 @@ class SIZE_RefWrapper4Set
 {
 	T& t;
 	RootT& root;
-	GMQ_COLL vector<size_t> address;
+	::globalmq::marshalling::PublishableAddress address;
 	static constexpr bool has_X = has_X_member<T>;
 	static_assert( has_X, "type T must have member T::X of a type corresponding to IDL type REAL" );
 	static constexpr bool has_Y = has_Y_member<T>;
@@ -7693,10 +8579,7 @@ class SIZE_RefWrapper4Set
 
 
 public:
-	SIZE_RefWrapper4Set( T& actual, RootT& root_, const GMQ_COLL vector<size_t> address_, size_t idx ) : t( actual ), root( root_ ) {
-		address = address_;
-		address.push_back (idx );
-	}
+	SIZE_RefWrapper4Set( T& actual, RootT& root_, const ::globalmq::marshalling::PublishableAddress& address_, size_t idx ) : t( actual ), root( root_ ), address( address_, idx ) {}
 	auto get_X() { return t.X; }
 	void set_X( decltype(T::X) val) { 
 		t.X = val; 
@@ -7741,7 +8624,7 @@ class HtmlTag_RefWrapper4Set
 {
 	T& t;
 	RootT& root;
-	GMQ_COLL vector<size_t> address;
+	::globalmq::marshalling::PublishableAddress address;
 	static constexpr bool has_name = has_name_member<T>;
 	static_assert( has_name, "type T must have member T::name of a type corresponding to IDL type CHARACTER_STRING" );
 	static constexpr bool has_properties = has_properties_member<T>;
@@ -7751,10 +8634,7 @@ class HtmlTag_RefWrapper4Set
 
 
 public:
-	HtmlTag_RefWrapper4Set( T& actual, RootT& root_, const GMQ_COLL vector<size_t> address_, size_t idx ) : t( actual ), root( root_ ) {
-		address = address_;
-		address.push_back (idx );
-	}
+	HtmlTag_RefWrapper4Set( T& actual, RootT& root_, const ::globalmq::marshalling::PublishableAddress& address_, size_t idx ) : t( actual ), root( root_ ), address( address_, idx ) {}
 	const auto& get_name() { return t.name; }
 	void set_name( decltype(T::name) val) { 
 		t.name = val; 
@@ -7801,14 +8681,11 @@ class du_one_RefWrapper4Set
 {
 	T& t;
 	RootT& root;
-	GMQ_COLL vector<size_t> address;
+	::globalmq::marshalling::PublishableAddress address;
 
 
 public:
-	du_one_RefWrapper4Set( T& actual, RootT& root_, const GMQ_COLL vector<size_t> address_, size_t idx ) : t( actual ), root( root_ ) {
-		address = address_;
-		address.push_back (idx );
-	}
+	du_one_RefWrapper4Set( T& actual, RootT& root_, const ::globalmq::marshalling::PublishableAddress& address_, size_t idx ) : t( actual ), root( root_ ), address( address_, idx ) {}
 	auto get_currentVariant() { return t.currentVariant(); }
 	void set_currentVariant( typename T::Variants v ) { 
 		t.initAs( v ); 
@@ -7871,7 +8748,7 @@ class POINT3DREAL_RefWrapper4Set
 {
 	T& t;
 	RootT& root;
-	GMQ_COLL vector<size_t> address;
+	::globalmq::marshalling::PublishableAddress address;
 	static constexpr bool has_X = has_X_member<T>;
 	static_assert( has_X, "type T must have member T::X of a type corresponding to IDL type REAL" );
 	static constexpr bool has_Y = has_Y_member<T>;
@@ -7881,10 +8758,7 @@ class POINT3DREAL_RefWrapper4Set
 
 
 public:
-	POINT3DREAL_RefWrapper4Set( T& actual, RootT& root_, const GMQ_COLL vector<size_t> address_, size_t idx ) : t( actual ), root( root_ ) {
-		address = address_;
-		address.push_back (idx );
-	}
+	POINT3DREAL_RefWrapper4Set( T& actual, RootT& root_, const ::globalmq::marshalling::PublishableAddress& address_, size_t idx ) : t( actual ), root( root_ ), address( address_, idx ) {}
 	auto get_X() { return t.X; }
 	void set_X( decltype(T::X) val) { 
 		t.X = val; 
@@ -7926,7 +8800,7 @@ class CharacterParamStruct_RefWrapper4Set
 {
 	T& t;
 	RootT& root;
-	GMQ_COLL vector<size_t> address;
+	::globalmq::marshalling::PublishableAddress address;
 	static constexpr bool has_ID = has_ID_member<T>;
 	static_assert( has_ID, "type T must have member T::ID of a type corresponding to IDL type INTEGER" );
 	static constexpr bool has_Size = has_Size_member<T>;
@@ -7934,10 +8808,7 @@ class CharacterParamStruct_RefWrapper4Set
 
 
 public:
-	CharacterParamStruct_RefWrapper4Set( T& actual, RootT& root_, const GMQ_COLL vector<size_t> address_, size_t idx ) : t( actual ), root( root_ ) {
-		address = address_;
-		address.push_back (idx );
-	}
+	CharacterParamStruct_RefWrapper4Set( T& actual, RootT& root_, const ::globalmq::marshalling::PublishableAddress& address_, size_t idx ) : t( actual ), root( root_ ), address( address_, idx ) {}
 	auto get_ID() { return t.ID; }
 	void set_ID( decltype(T::ID) val) { 
 		t.ID = val; 
@@ -7976,7 +8847,7 @@ class StructWithVectorOfSize_RefWrapper4Set
 {
 	T& t;
 	RootT& root;
-	GMQ_COLL vector<size_t> address;
+	::globalmq::marshalling::PublishableAddress address;
 	static constexpr bool has_sizes = has_sizes_member<T>;
 	static_assert( has_sizes, "type T must have member T::sizes of a type corresponding to IDL type VECTOR<STRUCT SIZE>" );
 	static constexpr bool has_NN = has_NN_member<T>;
@@ -7984,10 +8855,7 @@ class StructWithVectorOfSize_RefWrapper4Set
 
 
 public:
-	StructWithVectorOfSize_RefWrapper4Set( T& actual, RootT& root_, const GMQ_COLL vector<size_t> address_, size_t idx ) : t( actual ), root( root_ ) {
-		address = address_;
-		address.push_back (idx );
-	}
+	StructWithVectorOfSize_RefWrapper4Set( T& actual, RootT& root_, const ::globalmq::marshalling::PublishableAddress& address_, size_t idx ) : t( actual ), root( root_ ), address( address_, idx ) {}
 	auto get_sizes() { return globalmq::marshalling::VectorOfStructRefWrapper<SIZE_RefWrapper<typename decltype(T::sizes)::value_type>, decltype(T::sizes)>(t.sizes); }
 	void set_sizes( decltype(T::sizes) val) { 
 		t.sizes = val; 
@@ -8026,7 +8894,7 @@ class StructWithVectorOfInt_RefWrapper4Set
 {
 	T& t;
 	RootT& root;
-	GMQ_COLL vector<size_t> address;
+	::globalmq::marshalling::PublishableAddress address;
 	static constexpr bool has_ID = has_ID_member<T>;
 	static_assert( has_ID, "type T must have member T::ID of a type corresponding to IDL type INTEGER" );
 	static constexpr bool has_signedInts = has_signedInts_member<T>;
@@ -8034,10 +8902,7 @@ class StructWithVectorOfInt_RefWrapper4Set
 
 
 public:
-	StructWithVectorOfInt_RefWrapper4Set( T& actual, RootT& root_, const GMQ_COLL vector<size_t> address_, size_t idx ) : t( actual ), root( root_ ) {
-		address = address_;
-		address.push_back (idx );
-	}
+	StructWithVectorOfInt_RefWrapper4Set( T& actual, RootT& root_, const ::globalmq::marshalling::PublishableAddress& address_, size_t idx ) : t( actual ), root( root_ ), address( address_, idx ) {}
 	auto get_ID() { return t.ID; }
 	void set_ID( decltype(T::ID) val) { 
 		t.ID = val; 
@@ -8078,12 +8943,18 @@ void STRUCT_CharacterParamStruct_compose(ComposerT& composer, Args&& ... args)
 
 	static_assert( ComposerT::proto == Proto::JSON, "this STRUCT assumes only JSON protocol" );
 	composer.buff.append( "{\n  ", sizeof("{\n  ") - 1 );
-	::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_1_type, true, int64_t, int64_t, (int64_t)(0)>(composer, "ID", arg_1_type::nameAndTypeID, args...);
+	::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_1_type, true, int64_t, int64_t, (int64_t)(0)>(composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "ID", "\"ID\":" ), arg_1_type::nameAndTypeID, args...);
 	composer.buff.append( ",\n  ", 4 );
-	::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_2_type, true, int64_t, int64_t, (int64_t)(0)>(composer, "Size", arg_2_type::nameAndTypeID, args...);
+	::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_2_type, true, int64_t, int64_t, (int64_t)(0)>(composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "Size", "\"Size\":" ), arg_2_type::nameAndTypeID, args...);
 	composer.buff.append( "\n}", 2 );
 }
 
+template<class ComposerT, typename ... Args>
+size_t STRUCT_CharacterParamStruct_serializedSize(const ComposerT& composer, Args&& ... args)
+{
+	return ::globalmq::marshalling::impl::measureComposedSize( composer, [&]( auto& measuringComposer ) { STRUCT_CharacterParamStruct_compose( measuringComposer, std::forward<Args>( args )... ); } );
+}
+
 //**********************************************************************
 // STRUCT "SIZE" Targets: JSON (3 parameters)
 //  1. REAL X (REQUIRED)
@@ -8110,14 +8981,20 @@ void STRUCT_SIZE_compose(ComposerT& composer, Args&& ... args)
 
 	static_assert( ComposerT::proto == Proto::JSON, "this STRUCT assumes only JSON protocol" );
 	composer.buff.append( "{\n  ", sizeof("{\n  ") - 1 );
-	::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_1_type, true, FloatingDefault<0ll,-1023ll>, int, 0>(composer, "X", arg_1_type::nameAndTypeID, args...);
+	::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_1_type, true, FloatingDefault<0ll,-1023ll>, int, 0>(composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "X", "\"X\":" ), arg_1_type::nameAndTypeID, args...);
 	composer.buff.append( ",\n  ", 4 );
-	::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_2_type, true, FloatingDefault<0ll,-1023ll>, int, 0>(composer, "Y", arg_2_type::nameAndTypeID, args...);
+	::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_2_type, true, FloatingDefault<0ll,-1023ll>, int, 0>(composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "Y", "\"Y\":" ), arg_2_type::nameAndTypeID, args...);
 	composer.buff.append( ",\n  ", 4 );
-	::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_3_type, true, FloatingDefault<0ll,-1023ll>, int, 0>(composer, "Z", arg_3_type::nameAndTypeID, args...);
+	::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_3_type, true, FloatingDefault<0ll,-1023ll>, int, 0>(composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "Z", "\"Z\":" ), arg_3_type::nameAndTypeID, args...);
 	composer.buff.append( "\n}", 2 );
 }
 
+template<class ComposerT, typename ... Args>
+size_t STRUCT_SIZE_serializedSize(const ComposerT& composer, Args&& ... args)
+{
+	return ::globalmq::marshalling::impl::measureComposedSize( composer, [&]( auto& measuringComposer ) { STRUCT_SIZE_compose( measuringComposer, std::forward<Args>( args )... ); } );
+}
+
 //**********************************************************************
 // STRUCT "POINT3DREAL" Targets: JSON (3 parameters)
 //  1. REAL X (REQUIRED)
@@ -8144,14 +9021,20 @@ void STRUCT_POINT3DREAL_compose(ComposerT& composer, Args&& ... args)
 
 	static_assert( ComposerT::proto == Proto::JSON, "this STRUCT assumes only JSON protocol" );
 	composer.buff.append( "{\n  ", sizeof("{\n  ") - 1 );
-	::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_1_type, true, FloatingDefault<0ll,-1023ll>, int, 0>(composer, "X", arg_1_type::nameAndTypeID, args...);
+	::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_1_type, true, FloatingDefault<0ll,-1023ll>, int, 0>(composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "X", "\"X\":" ), arg_1_type::nameAndTypeID, args...);
 	composer.buff.append( ",\n  ", 4 );
-	::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_2_type, true, FloatingDefault<0ll,-1023ll>, int, 0>(composer, "Y", arg_2_type::nameAndTypeID, args...);
+	::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_2_type, true, FloatingDefault<0ll,-1023ll>, int, 0>(composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "Y", "\"Y\":" ), arg_2_type::nameAndTypeID, args...);
 	composer.buff.append( ",\n  ", 4 );
-	::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_3_type, true, FloatingDefault<0ll,-1023ll>, int, 0>(composer, "Z", arg_3_type::nameAndTypeID, args...);
+	::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_3_type, true, FloatingDefault<0ll,-1023ll>, int, 0>(composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "Z", "\"Z\":" ), arg_3_type::nameAndTypeID, args...);
 	composer.buff.append( "\n}", 2 );
 }
 
+template<class ComposerT, typename ... Args>
+size_t STRUCT_POINT3DREAL_serializedSize(const ComposerT& composer, Args&& ... args)
+{
+	return ::globalmq::marshalling::impl::measureComposedSize( composer, [&]( auto& measuringComposer ) { STRUCT_POINT3DREAL_compose( measuringComposer, std::forward<Args>( args )... ); } );
+}
+
 //**********************************************************************
 // STRUCT "LineMap" Targets: GMQ (1 parameters)
 //  1. VECTOR< STRUCT Line> lineMap (REQUIRED)
@@ -8174,6 +9057,12 @@ void STRUCT_LineMap_compose(ComposerT& composer, Args&& ... args)
 	::globalmq::marshalling::impl::gmq::composeParamToGmq<ComposerT, arg_1_type, true, uint64_t, uint64_t, (uint64_t)(0)>(composer, arg_1_type::nameAndTypeID, args...);
 }
 
+template<class ComposerT, typename ... Args>
+size_t STRUCT_LineMap_serializedSize(const ComposerT& composer, Args&& ... args)
+{
+	return ::globalmq::marshalling::impl::measureComposedSize( composer, [&]( auto& measuringComposer ) { STRUCT_LineMap_compose( measuringComposer, std::forward<Args>( args )... ); } );
+}
+
 //**********************************************************************
 // STRUCT "Line" Targets: GMQ (2 parameters)
 //  1. VECTOR<NONEXTENDABLE STRUCT Vertex> a (REQUIRED)
@@ -8200,6 +9089,12 @@ void STRUCT_Line_compose(ComposerT& composer, Args&& ... args)
 	::globalmq::marshalling::impl::gmq::composeParamToGmq<ComposerT, arg_2_type, true, uint64_t, uint64_t, (uint64_t)(0)>(composer, arg_2_type::nameAndTypeID, args...);
 }
 
+template<class ComposerT, typename ... Args>
+size_t STRUCT_Line_serializedSize(const ComposerT& composer, Args&& ... args)
+{
+	return ::globalmq::marshalling::impl::measureComposedSize( composer, [&]( auto& measuringComposer ) { STRUCT_Line_compose( measuringComposer, std::forward<Args>( args )... ); } );
+}
+
 //**********************************************************************
 // STRUCT "ObstacleMap" Targets: GMQ (1 parameters)
 //  1. VECTOR< STRUCT PolygonMap> _ObstacleMap (REQUIRED)
@@ -8222,6 +9117,12 @@ void STRUCT_ObstacleMap_compose(ComposerT& composer, Args&& ... args)
 	::globalmq::marshalling::impl::gmq::composeParamToGmq<ComposerT, arg_1_type, true, uint64_t, uint64_t, (uint64_t)(0)>(composer, arg_1_type::nameAndTypeID, args...);
 }
 
+template<class ComposerT, typename ... Args>
+size_t STRUCT_ObstacleMap_serializedSize(const ComposerT& composer, Args&& ... args)
+{
+	return ::globalmq::marshalling::impl::measureComposedSize( composer, [&]( auto& measuringComposer ) { STRUCT_ObstacleMap_compose( measuringComposer, std::forward<Args>( args )... ); } );
+}
+
 //**********************************************************************
 // STRUCT "PolygonMap" Targets: GMQ (1 parameters)
 //  1. VECTOR<NONEXTENDABLE STRUCT Vertex> _PolygonMap (REQUIRED)
@@ -8244,6 +9145,12 @@ void STRUCT_PolygonMap_compose(ComposerT& composer, Args&& ... args)
 	::globalmq::marshalling::impl::gmq::composeParamToGmq<ComposerT, arg_1_type, true, uint64_t, uint64_t, (uint64_t)(0)>(composer, arg_1_type::nameAndTypeID, args...);
 }
 
+template<class ComposerT, typename ... Args>
+size_t STRUCT_PolygonMap_serializedSize(const ComposerT& composer, Args&& ... args)
+{
+	return ::globalmq::marshalling::impl::measureComposedSize( composer, [&]( auto& measuringComposer ) { STRUCT_PolygonMap_compose( measuringComposer, std::forward<Args>( args )... ); } );
+}
+
 //**********************************************************************
 // STRUCT "Vertex" NONEXTENDABLE Targets: JSON GMQ (3 parameters)
 //  1. INTEGER x (REQUIRED)
@@ -8278,16 +9185,25 @@ void STRUCT_Vertex_compose(ComposerT& composer, Args&& ... args)
 	{
 		static_assert( ComposerT::proto == Proto::JSON );
 		composer.buff.append( "{\n  ", sizeof("{\n  ") - 1 );
-		::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_1_type, true, int64_t, int64_t, (int64_t)(0)>(composer, "x", arg_1_type::nameAndTypeID, args...);
+		::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_1_type, true, int64_t, int64_t, (int64_t)(0)>(composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "x", "\"x\":" ), arg_1_type::nameAndTypeID, args...);
 		composer.buff.append( ",\n  ", 4 );
-		::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_2_type, true, int64_t, int64_t, (int64_t)(0)>(composer, "y", arg_2_type::nameAndTypeID, args...);
+		::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_2_type, true, int64_t, int64_t, (int64_t)(0)>(composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "y", "\"y\":" ), arg_2_type::nameAndTypeID, args...);
 		composer.buff.append( ",\n  ", 4 );
-		::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_3_type, true, int64_t, int64_t, (int64_t)(0)>(composer, "z", arg_3_type::nameAndTypeID, args...);
+		::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_3_type, true, int64_t, int64_t, (int64_t)(0)>(composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "z", "\"z\":" ), arg_3_type::nameAndTypeID, args...);
 		composer.buff.append( "\n}", 2 );
 
 	}
 }
 
+template<class ComposerT, typename ... Args>
+size_t STRUCT_Vertex_serializedSize(const ComposerT& composer, Args&& ... args)
+{
+	if constexpr ( ComposerT::proto == Proto::GMQ )
+		return 3 * ::globalmq::marshalling::impl::IntegralVlq::maxVlqSize; // fixed layout: upper bound, known at compile time
+	else
+		return ::globalmq::marshalling::impl::measureComposedSize( composer, [&]( auto& measuringComposer ) { STRUCT_Vertex_compose( measuringComposer, std::forward<Args>( args )... ); } );
+}
+
 //**********************************************************************
 // STRUCT "point" NONEXTENDABLE Targets: JSON GMQ (2 parameters)
 //  1. INTEGER x (REQUIRED)
@@ -8318,14 +9234,23 @@ void STRUCT_point_compose(ComposerT& composer, Args&& ... args)
 	{
 		static_assert( ComposerT::proto == Proto::JSON );
 		composer.buff.append( "{\n  ", sizeof("{\n  ") - 1 );
-		::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_1_type, true, int64_t, int64_t, (int64_t)(0)>(composer, "x", arg_1_type::nameAndTypeID, args...);
+		::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_1_type, true, int64_t, int64_t, (int64_t)(0)>(composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "x", "\"x\":" ), arg_1_type::nameAndTypeID, args...);
 		composer.buff.append( ",\n  ", 4 );
-		::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_2_type, true, int64_t, int64_t, (int64_t)(0)>(composer, "y", arg_2_type::nameAndTypeID, args...);
+		::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_2_type, true, int64_t, int64_t, (int64_t)(0)>(composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "y", "\"y\":" ), arg_2_type::nameAndTypeID, args...);
 		composer.buff.append( "\n}", 2 );
 
 	}
 }
 
+template<class ComposerT, typename ... Args>
+size_t STRUCT_point_serializedSize(const ComposerT& composer, Args&& ... args)
+{
+	if constexpr ( ComposerT::proto == Proto::GMQ )
+		return 2 * ::globalmq::marshalling::impl::IntegralVlq::maxVlqSize; // fixed layout: upper bound, known at compile time
+	else
+		return ::globalmq::marshalling::impl::measureComposedSize( composer, [&]( auto& measuringComposer ) { STRUCT_point_compose( measuringComposer, std::forward<Args>( args )... ); } );
+}
+
 //**********************************************************************
 // STRUCT "point3D" Targets: JSON GMQ (3 parameters)
 //  1. INTEGER x (REQUIRED)
@@ -8360,16 +9285,22 @@ void STRUCT_point3D_compose(ComposerT& composer, Args&& ... args)
 	{
 		static_assert( ComposerT::proto == Proto::JSON );
 		composer.buff.append( "{\n  ", sizeof("{\n  ") - 1 );
-		::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_1_type, true, int64_t, int64_t, (int64_t)(0)>(composer, "x", arg_1_type::nameAndTypeID, args...);
+		::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_1_type, true, int64_t, int64_t, (int64_t)(0)>(composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "x", "\"x\":" ), arg_1_type::nameAndTypeID, args...);
 		composer.buff.append( ",\n  ", 4 );
-		::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_2_type, true, int64_t, int64_t, (int64_t)(0)>(composer, "y", arg_2_type::nameAndTypeID, args...);
+		::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_2_type, true, int64_t, int64_t, (int64_t)(0)>(composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "y", "\"y\":" ), arg_2_type::nameAndTypeID, args...);
 		composer.buff.append( ",\n  ", 4 );
-		::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_3_type, true, int64_t, int64_t, (int64_t)(0)>(composer, "z", arg_3_type::nameAndTypeID, args...);
+		::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_3_type, true, int64_t, int64_t, (int64_t)(0)>(composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "z", "\"z\":" ), arg_3_type::nameAndTypeID, args...);
 		composer.buff.append( "\n}", 2 );
 
 	}
 }
 
+template<class ComposerT, typename ... Args>
+size_t STRUCT_point3D_serializedSize(const ComposerT& composer, Args&& ... args)
+{
+	return ::globalmq::marshalling::impl::measureComposedSize( composer, [&]( auto& measuringComposer ) { STRUCT_point3D_compose( measuringComposer, std::forward<Args>( args )... ); } );
+}
+
 //**********************************************************************
 // DISCRIMINATED_UNION "du_one" Targets: GMQ (2 cases)
 //  CASE one (2 parameters)(2 parameters)
@@ -8406,6 +9337,12 @@ void DISCRIMINATED_UNION_du_one_compose(ComposerT& composer, Args&& ... args)
 	::globalmq::marshalling::impl::gmq::composeParamToGmq<ComposerT, arg_4_type, true, uint64_t, uint64_t, (uint64_t)(0)>(composer, arg_4_type::nameAndTypeID, args...);
 }
 
+template<class ComposerT, typename ... Args>
+size_t DISCRIMINATED_UNION_du_one_serializedSize(const ComposerT& composer, Args&& ... args)
+{
+	return ::globalmq::marshalling::impl::measureComposedSize( composer, [&]( auto& measuringComposer ) { DISCRIMINATED_UNION_du_one_compose( measuringComposer, std::forward<Args>( args )... ); } );
+}
+
 //**********************************************************************
 // STRUCT "PolygonSt" Targets: JSON (2 parameters)
 //  1. VECTOR< STRUCT Line_> portalMap (REQUIRED)
@@ -8429,12 +9366,18 @@ void STRUCT_PolygonSt_compose(ComposerT& composer, Args&& ... args)
 
 	static_assert( ComposerT::proto == Proto::JSON, "this STRUCT assumes only JSON protocol" );
 	composer.buff.append( "{\n  ", sizeof("{\n  ") - 1 );
-	::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_1_type, true, int64_t, int64_t, (int64_t)(0)>(composer, "portalMap", arg_1_type::nameAndTypeID, args...);
+	::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_1_type, true, int64_t, int64_t, (int64_t)(0)>(composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "portalMap", "\"portalMap\":" ), arg_1_type::nameAndTypeID, args...);
 	composer.buff.append( ",\n  ", 4 );
-	::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_2_type, true, int64_t, int64_t, (int64_t)(0)>(composer, "animZones", arg_2_type::nameAndTypeID, args...);
+	::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_2_type, true, int64_t, int64_t, (int64_t)(0)>(composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "animZones", "\"animZones\":" ), arg_2_type::nameAndTypeID, args...);
 	composer.buff.append( "\n}", 2 );
 }
 
+template<class ComposerT, typename ... Args>
+size_t STRUCT_PolygonSt_serializedSize(const ComposerT& composer, Args&& ... args)
+{
+	return ::globalmq::marshalling::impl::measureComposedSize( composer, [&]( auto& measuringComposer ) { STRUCT_PolygonSt_compose( measuringComposer, std::forward<Args>( args )... ); } );
+}
+
 //**********************************************************************
 // STRUCT "AnimZone" Targets: JSON (2 parameters)
 //  1. VECTOR< STRUCT Line_> animVector (REQUIRED)
@@ -8458,12 +9401,18 @@ void STRUCT_AnimZone_compose(ComposerT& composer, Args&& ... args)
 
 	static_assert( ComposerT::proto == Proto::JSON, "this STRUCT assumes only JSON protocol" );
 	composer.buff.append( "{\n  ", sizeof("{\n  ") - 1 );
-	::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_1_type, true, int64_t, int64_t, (int64_t)(0)>(composer, "animVector", arg_1_type::nameAndTypeID, args...);
+	::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_1_type, true, int64_t, int64_t, (int64_t)(0)>(composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "animVector", "\"animVector\":" ), arg_1_type::nameAndTypeID, args...);
 	composer.buff.append( ",\n  ", 4 );
-	::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_2_type, true, int64_t, int64_t, (int64_t)(0)>(composer, "animSpeed", arg_2_type::nameAndTypeID, args...);
+	::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_2_type, true, int64_t, int64_t, (int64_t)(0)>(composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "animSpeed", "\"animSpeed\":" ), arg_2_type::nameAndTypeID, args...);
 	composer.buff.append( "\n}", 2 );
 }
 
+template<class ComposerT, typename ... Args>
+size_t STRUCT_AnimZone_serializedSize(const ComposerT& composer, Args&& ... args)
+{
+	return ::globalmq::marshalling::impl::measureComposedSize( composer, [&]( auto& measuringComposer ) { STRUCT_AnimZone_compose( measuringComposer, std::forward<Args>( args )... ); } );
+}
+
 //**********************************************************************
 // STRUCT "Line_" Targets: JSON (2 parameters)
 //  1. STRUCT Vertex a (REQUIRED)
@@ -8487,12 +9436,18 @@ void STRUCT_Line__compose(ComposerT& composer, Args&& ... args)
 
 	static_assert( ComposerT::proto == Proto::JSON, "this STRUCT assumes only JSON protocol" );
 	composer.buff.append( "{\n  ", sizeof("{\n  ") - 1 );
-	::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_1_type, true, int64_t, int64_t, (int64_t)(0)>(composer, "a", arg_1_type::nameAndTypeID, args...);
+	::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_1_type, true, int64_t, int64_t, (int64_t)(0)>(composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "a", "\"a\":" ), arg_1_type::nameAndTypeID, args...);
 	composer.buff.append( ",\n  ", 4 );
-	::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_2_type, true, int64_t, int64_t, (int64_t)(0)>(composer, "b", arg_2_type::nameAndTypeID, args...);
+	::globalmq::marshalling::impl::json::composeParamToJson<ComposerT, arg_2_type, true, int64_t, int64_t, (int64_t)(0)>(composer, ::globalmq::marshalling::impl::JsonKeyForComposing( "b", "\"b\":" ), arg_2_type::nameAndTypeID, args...);
 	composer.buff.append( "\n}", 2 );
 }
 
+template<class ComposerT, typename ... Args>
+size_t STRUCT_Line__serializedSize(const ComposerT& composer, Args&& ... args)
+{
+	return ::globalmq::marshalling::impl::measureComposedSize( composer, [&]( auto& measuringComposer ) { STRUCT_Line__compose( measuringComposer, std::forward<Args>( args )... ); } );
+}
+
 
 } // namespace mtest
 
@@ -244,4 +244,127 @@ void testScopedMessageComposingAndParsing()
 		mtest::makeDefaultMessageHandler([&](auto& parser, uint64_t msgID){ fmt::print( "Unhandled message {}\n", msgID ); })
 	);
 
-}
\ No newline at end of file
+}
+template<class ComposerT>
+void composePoint3DMessage( ComposerT& composer, const mtest::structures::infrastructural::MESSAGE_point3D& msg )
+{
+	// MESSAGE_point3D_compose() does not take dictionaries; members go as MESSAGE_point3D_parse() expects them
+	mtest::publishable_STRUCT_point3D::compose( composer, msg.pt );
+	mtest::publishable_DISCRIMINATED_UNION_du_one::compose( composer, msg.du_one_instance );
+	globalmq::marshalling::PublishableDictionaryProcessor::compose<ComposerT, decltype(msg.num2stringDictionary), globalmq::marshalling::impl::UnsignedIntegralType, globalmq::marshalling::impl::StringType>( composer, msg.num2stringDictionary );
+}
+
+void testGmqViews()
+{
+	fmt::print( "\nrunning testGmqViews() \n" );
+	for ( bool lengthPrefixed : { false, true } )
+	{
+		// struct, discriminated union (each case) and dictionary members
+		for ( auto variant : { mtest::structures::du_one::one, mtest::structures::du_one::two } )
+		{
+			mtest::structures::infrastructural::MESSAGE_point3D msg;
+			msg.pt = { 1, -2, 3 };
+			msg.du_one_instance.initAs( variant );
+			if ( variant == mtest::structures::du_one::one )
+			{
+				msg.du_one_instance.pt3d_1() = { 4, 5, -6 };
+				msg.du_one_instance.i_1() = -7;
+			}
+			else
+			{
+				msg.du_one_instance.i_2() = 8;
+				msg.du_one_instance.vp_2() = { 0.5, -1.5 };
+			}
+			msg.num2stringDictionary = { { 1, "one" }, { 2, "" }, { 300, "three hundred" } };
+
+			mtest::Buffer b;
+			mtest::GmqComposer composer( b );
+			composer.setLengthPrefixedStrings( lengthPrefixed );
+			composePoint3DMessage( composer, msg );
+			globalmq::marshalling::impl::composeUnsignedInteger( composer, 77 ); // whatever follows the message
+
+			auto riter = b.getReadIter();
+			mtest::GmqParser<mtest::Buffer> parser( riter );
+			parser.setLengthPrefixedStrings( lengthPrefixed );
+			mtest::infrastructural::MESSAGE_point3D_View<mtest::GmqParser<mtest::Buffer>> view( parser );
+			uint64_t next = 0;
+			parser.parseUnsignedInteger( &next );
+			assert( next == 77 ); // the view has walked past the message
+			assert( !riter.isData() );
+
+			auto pt = view.get_pt();
+			assert( pt.x == 1 && pt.y == -2 && pt.z == 3 );
+			auto du = view.get_du_one_instance();
+			assert( du.currentVariant() == variant );
+			if ( variant == mtest::structures::du_one::one )
+			{
+				assert( du.pt3d_1().x == 4 && du.pt3d_1().y == 5 && du.pt3d_1().z == -6 );
+				assert( du.i_1() == -7 );
+			}
+			else
+			{
+				assert( du.i_2() == 8 );
+				assert( du.vp_2() == msg.du_one_instance.vp_2() );
+			}
+			assert( view.get_num2stringDictionary_size() == 3 );
+			assert( view.get_num2stringDictionary() == msg.num2stringDictionary );
+			// accessors are independent of each other and of their order
+			assert( view.get_pt().z == 3 );
+
+			auto riter2 = b.getReadIter();
+			mtest::GmqParser<mtest::Buffer> parser2( riter2 );
+			parser2.setLengthPrefixedStrings( lengthPrefixed );
+			auto parsed = mtest::infrastructural::MESSAGE_point3D_parse( parser2 );
+			assert( parsed.num2stringDictionary == msg.num2stringDictionary );
+		}
+
+		// vectors and strings; strings are views into the buffer
+		std::vector<int> vectorOfNumbers = { 0, 1, 2, 3, 4, 5 };
+		std::vector<double> vectorOfRealNumbers = { 0.1, 1.2, 2.3 };
+		std::vector<Point> vectorOfPoints = { {0, 1}, {2, 3}, {4, 5} };
+		std::vector<Point3D> vectorOfPoints3D = { {0, 1, 2}, {3, 4, 5} };
+		Point pt = {175, 186};
+		Point3D pt3D = {123, 456, 789};
+		mtest::Buffer b;
+		mtest::GmqComposer composer( b );
+		composer.setLengthPrefixedStrings( lengthPrefixed );
+		mtest::test_gmq::MESSAGE_message_one_compose( composer, 
+			mtest::thirdParam = mtest::CollectionWrapperForComposing( [&]() { return vectorOfPoints3D.size(); }, [&](auto& c, size_t ordinal){ mtest::STRUCT_point3D_compose( c, mtest::x = vectorOfPoints3D[ordinal].x, mtest::y = vectorOfPoints3D[ordinal].y, mtest::z = vectorOfPoints3D[ordinal].z );} ), 
+			mtest::firstParam = 1, mtest::fifthParam = "def", mtest::forthParam = 3, mtest::seventhParam = 3.1416, 
+			mtest::eighthParam = mtest::MessageWrapperForComposing( [&](auto& c){ mtest::STRUCT_point_compose( c, mtest::x = pt.x, mtest::y = pt.y );} ),
+			mtest::ninethParam = mtest::MessageWrapperForComposing( [&](auto& c){ mtest::STRUCT_point3D_compose( c, mtest::x = pt3D.x, mtest::y = pt3D.y, mtest::z = pt3D.z );} ),
+			mtest::secondParam = mtest::SimpleTypeCollectionWrapper( vectorOfNumbers ),
+			mtest::tenthParam = mtest::SimpleTypeCollectionWrapper( vectorOfRealNumbers ),
+			mtest::sixthParam = mtest::CollectionWrapperForComposing( [&]() { return vectorOfPoints.size(); }, [&](auto& c, size_t ordinal){ mtest::STRUCT_point_compose( c, mtest::x = vectorOfPoints[ordinal].x, mtest::y = vectorOfPoints[ordinal].y );} )
+		);
+
+		auto riter = b.getReadIter();
+		mtest::GmqParser<mtest::Buffer> parser( riter );
+		parser.setLengthPrefixedStrings( lengthPrefixed );
+		mtest::test_gmq::MESSAGE_message_one_View<mtest::GmqParser<mtest::Buffer>> view( parser );
+		assert( !riter.isData() );
+
+		assert( view.get_fifthParam() == "def" );
+		const char* fifth = view.get_fifthParam().data();
+		assert( fifth >= reinterpret_cast<const char*>( b.begin() ) && fifth < reinterpret_cast<const char*>( b.begin() ) + b.size() );
+		assert( view.get_firstParam() == 1 );
+		assert( view.get_forthParam() == 3 );
+		assert( view.get_seventhParam() == 3.1416 );
+		assert( view.get_secondParam_size() == vectorOfNumbers.size() );
+		auto second = view.get_secondParam();
+		for ( size_t i=0; i<vectorOfNumbers.size(); ++i )
+			assert( second[i] == vectorOfNumbers[i] );
+		assert( view.get_tenthParam() == vectorOfRealNumbers );
+		auto third = view.get_thirdParam();
+		assert( third.size() == vectorOfPoints3D.size() );
+		for ( size_t i=0; i<vectorOfPoints3D.size(); ++i )
+			assert( third[i].x == vectorOfPoints3D[i].x && third[i].y == vectorOfPoints3D[i].y && third[i].z == vectorOfPoints3D[i].z );
+		auto sixth = view.get_sixthParam();
+		assert( view.get_sixthParam_size() == vectorOfPoints.size() );
+		for ( size_t i=0; i<vectorOfPoints.size(); ++i )
+			assert( sixth[i].x == vectorOfPoints[i].x && sixth[i].y == vectorOfPoints[i].y );
+		assert( view.get_eighthParam().x == pt.x && view.get_eighthParam().y == pt.y );
+		auto ninth = view.get_ninethParam();
+		assert( ninth.x == pt3D.x && ninth.y == pt3D.y && ninth.z == pt3D.z );
+	}
+}
@@ -6,6 +6,7 @@ void runJsonSample();
 void testParsingJsonFile();
 void testMessageAliases();
 void testScopedMessageComposingAndParsing();
+void testGmqViews();
 
 void quickTestForGmqParts();
 void publishableTestOne();
@@ -0,0 +1,73 @@
+/* -------------------------------------------------------------------------------
+* Copyright (c) 2022, OLogN Technologies AG
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*	 * Redistributions of source code must retain the above copyright
+*	   notice, this list of conditions and the following disclaimer.
+*	 * Redistributions in binary form must reproduce the above copyright
+*	   notice, this list of conditions and the following disclaimer in the
+*	   documentation and/or other materials provided with the distribution.
+*	 * Neither the name of the OLogN Technologies AG nor the
+*	   names of its contributors may be used to endorse or promote products
+*	   derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL OLogN Technologies AG BE LIABLE FOR ANY
+* DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+* ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* -------------------------------------------------------------------------------*/
+
+#include "test_common.h"
+
+using namespace globalmq::marshalling;
+
+const lest::test test_buffer_pool[] =
+{
+    lest_CASE( "test_buffer_pool.SizeClasses" )
+    {
+        EXPECT( BufferPool::roundUp( 1 ) == MIN_BUFFER );
+        EXPECT( BufferPool::roundUp( MIN_BUFFER + 1 ) == 2 * MIN_BUFFER );
+        EXPECT( BufferPool::roundUp( ( size_t(1) << BufferPool::MAX_CLASS_BITS ) - 1 ) == ( size_t(1) << BufferPool::MAX_CLASS_BITS ) );
+        // beyond the largest class sizes are not rounded (and blocks are not pooled)
+        EXPECT( BufferPool::roundUp( ( size_t(1) << BufferPool::MAX_CLASS_BITS ) + 1 ) == ( size_t(1) << BufferPool::MAX_CLASS_BITS ) + 1 );
+    },
+
+    lest_CASE( "test_buffer_pool.LargestClassIsCachedGlobally" )
+    {
+        // the largest class exceeds per-thread budget, but fits the global one
+        static_assert( ( size_t(1) << BufferPool::MAX_CLASS_BITS ) > BufferPool::MAX_THREAD_CACHED_BYTES );
+        static_assert( ( size_t(1) << BufferPool::MAX_CLASS_BITS ) <= BufferPool::MAX_GLOBAL_CACHED_BYTES );
+        size_t capacity = 0;
+        uint8_t* block = BufferPool::allocate( size_t(1) << BufferPool::MAX_CLASS_BITS, capacity );
+        EXPECT( capacity == ( size_t(1) << BufferPool::MAX_CLASS_BITS ) );
+        BufferPool::release( block, capacity );
+        size_t capacity2 = 0;
+        uint8_t* block2 = BufferPool::allocate( capacity, capacity2 );
+        EXPECT( block2 == block );
+        EXPECT( capacity2 == capacity );
+        BufferPool::release( block2, capacity2 );
+    },
+
+    lest_CASE( "test_buffer_pool.GrowAndShrink" )
+    {
+        BufferT b;
+        for ( size_t i=0; i<( 8 << 20 ); i += 4096 )
+        {
+            uint8_t chunk[4096];
+            memset( chunk, (int)( i >> 12 ), sizeof(chunk) );
+            b.append( chunk, sizeof(chunk) );
+        }
+        EXPECT( b.size() == ( 8 << 20 ) );
+        EXPECT( b.begin()[( 8 << 20 ) - 1] == (uint8_t)( ( ( 8 << 20 ) - 4096 ) >> 12 ) );
+    },
+};
+
+lest_MODULE(specification(), test_buffer_pool);
@@ -0,0 +1,103 @@
+/* -------------------------------------------------------------------------------
+* Copyright (c) 2022, OLogN Technologies AG
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*	 * Redistributions of source code must retain the above copyright
+*	   notice, this list of conditions and the following disclaimer.
+*	 * Redistributions in binary form must reproduce the above copyright
+*	   notice, this list of conditions and the following disclaimer in the
+*	   documentation and/or other materials provided with the distribution.
+*	 * Neither the name of the OLogN Technologies AG nor the
+*	   names of its contributors may be used to endorse or promote products
+*	   derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL OLogN Technologies AG BE LIABLE FOR ANY
+* DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+* ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* -------------------------------------------------------------------------------*/
+
+#ifndef UNIT_TEST_COMMON_H_INCLUDED
+#define UNIT_TEST_COMMON_H_INCLUDED
+
+// unit tests of the library itself (as opposed to generated code, which is covered by interop tests)
+
+#include "../../../3rdparty/lest/include/lest/lest.hpp"
+#include <global_mq_common.h>
+#include <marshalling.h>
+
+using BufferT = globalmq::marshalling::Buffer;
+
+inline BufferT bufferOf( std::string_view text )
+{
+    BufferT b;
+    b.append( text.data(), text.size() );
+    return b;
+}
+
+// a Buffer read as if it was split into chunks of chunkSize bytes (as a paged buffer would be): direct reads never cross a chunk bound
+template<size_t chunkSize>
+struct ChunkedBuffer
+{
+    class ReadIter
+    {
+        BufferT::ReadIter it;
+
+    public:
+        ReadIter( const BufferT& b ) : it( b ) {}
+        bool isData() { return it.isData(); }
+        size_t directlyAvailableSize() { return std::min( it.directlyAvailableSize(), chunkSize - it.offset() % chunkSize ); }
+        const uint8_t* directPeek() { return it.directPeek(); }
+        const uint8_t* directRead( size_t sz ) { GMQ_ASSERT( sz <= directlyAvailableSize() ); return it.directRead( sz ); }
+        uint8_t operator * () { return *it; }
+        void operator ++ () { ++it; }
+        size_t skip( size_t sz ) { return it.skip( sz ); }
+        size_t offset() const { return it.offset(); }
+    };
+    using ReadIteratorT = ReadIter;
+};
+
+// every target char at every position of spans up to a few scan blocks long, over every filler char;
+// the result is also checked against a plain one-char-at-a-time scan
+template<class FindT, class IsTargetT>
+bool findsAtAnyOffset( FindT find, IsTargetT isTarget, std::initializer_list<uint8_t> targets )
+{
+    auto reference = [&]( const uint8_t* p, size_t sz ) {
+        size_t i = 0;
+        while ( i < sz && !isTarget( p[i] ) )
+            ++i;
+        return i;
+    };
+    uint8_t span[50];
+    for ( size_t sz = 0; sz <= sizeof( span ); ++sz )
+        for ( unsigned filler = 0; filler < 256; ++filler )
+        {
+            if ( isTarget( (uint8_t)filler ) )
+                continue;
+            memset( span, filler, sizeof( span ) );
+            if ( find( span, sz ) != sz )
+                return false;
+            for ( uint8_t target : targets )
+                for ( size_t pos = 0; pos < sz; ++pos )
+                {
+                    memset( span, filler, sizeof( span ) );
+                    span[pos] = target;
+                    span[sz - 1] = target; // a later one must not be taken instead
+                    if ( find( span, sz ) != pos || reference( span, sz ) != pos )
+                        return false;
+                }
+        }
+    return true;
+}
+
+lest::tests& specification();
+
+#endif // UNIT_TEST_COMMON_H_INCLUDED
@@ -0,0 +1,150 @@
+/* -------------------------------------------------------------------------------
+* Copyright (c) 2022, OLogN Technologies AG
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*	 * Redistributions of source code must retain the above copyright
+*	   notice, this list of conditions and the following disclaimer.
+*	 * Redistributions in binary form must reproduce the above copyright
+*	   notice, this list of conditions and the following disclaimer in the
+*	   documentation and/or other materials provided with the distribution.
+*	 * Neither the name of the OLogN Technologies AG nor the
+*	   names of its contributors may be used to endorse or promote products
+*	   derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL OLogN Technologies AG BE LIABLE FOR ANY
+* DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+* ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* -------------------------------------------------------------------------------*/
+
+#include "test_common.h"
+#include <comparsers.h>
+
+namespace
+{
+
+struct Inner
+{
+    int a = 0;
+    std::string s;
+
+    template<typename ObjectT, typename ComparserT>
+    static void rw( ObjectT& obj, ComparserT& comparser )
+    {
+        comparser.template beginStruct<"Inner">( obj );
+        comparser.template rw<comparsers::INT>( "a", obj.a );
+        comparser.template rw<comparsers::STRING>( "s", obj.s );
+        comparser.endStruct();
+    }
+};
+
+struct Outer
+{
+    int i = 0;
+    std::string s;
+    Inner in;
+    std::vector<uint64_t> v;
+    std::string t;
+
+    template<typename ObjectT, typename ComparserT>
+    static void rw( ObjectT& obj, ComparserT& comparser )
+    {
+        comparser.template beginStruct<"Outer">( obj );
+        comparser.template rw<comparsers::INT>( "i", obj.i );
+        comparser.template rw<comparsers::STRING>( "s", obj.s );
+        comparser.template rw<comparsers::STRUCT>( "in", obj.in );
+        comparser.template rw<comparsers::VofUINT>( "v", obj.v );
+        comparser.template rw<comparsers::STRING>( "t", obj.t );
+        comparser.endStruct();
+    }
+};
+
+// cannot be copied to keep a position: JsonParser2 stashes out-of-order values as text
+class OneWayReadIter
+{
+    BufferT::ReadIter it;
+
+public:
+    using CharT = char;
+    OneWayReadIter( const BufferT& b ) : it( b ) {}
+    OneWayReadIter( const OneWayReadIter& ) = delete;
+    OneWayReadIter& operator = ( const OneWayReadIter& ) = delete;
+    bool isData() { return it.isData(); }
+    CharT readChar() { return it.readChar(); }
+};
+
+template<class RiterT>
+Outer parseOuter( std::string_view json, std::vector<std::string>* unknown = nullptr )
+{
+    BufferT b = bufferOf( json );
+    RiterT riter( b );
+    comparsers::JsonParser2<RiterT> parser( riter );
+    std::function<void(const std::vector<std::string>&, const std::string&)> reporter = [&]( const std::vector<std::string>& path, const std::string& name ) {
+        std::string full;
+        for ( auto& part : path )
+            full += part + ".";
+        unknown->push_back( full + name );
+    };
+    if ( unknown != nullptr )
+        parser.setUnknownFieldsReporter( reporter );
+    Outer o;
+    Outer::rw( o, parser );
+    return o;
+}
+
+template<class RiterT>
+void parsesOutOfOrder( lest::env & lest_env )
+{
+    // string values with escaped quotes followed by closing brackets, which a re-parse of unescaped text would take for their end
+    Outer o = parseOuter<RiterT>( R"( { "t" : "x\"}y", "in":{"s":"}\"{\\","a":2}, "v":[1,2,3], "s":"\\\"}]", "i":-1 } )" );
+    EXPECT( o.i == -1 );
+    EXPECT( o.s == "\\\"}]" );
+    EXPECT( o.in.a == 2 );
+    EXPECT( o.in.s == "}\"{\\" );
+    EXPECT( ( o.v == std::vector<uint64_t>{ 1, 2, 3 } ) );
+    EXPECT( o.t == "x\"}y" );
+
+    Outer partly = parseOuter<RiterT>( R"({"i":5,"v":[],"t":"\"}","s":"é\"","in":{"a":-3,"s":""}})" );
+    EXPECT( partly.i == 5 );
+    EXPECT( partly.s == "\xc3\xa9\"" );
+    EXPECT( partly.in.a == -3 );
+    EXPECT( partly.v.empty() );
+    EXPECT( partly.t == "\"}" );
+
+    std::vector<std::string> unknown;
+    Outer withUnknown = parseOuter<RiterT>( R"({"zz":{"q":"\"}"},"in":{"s":"a","x":[1],"a":7},"i":1,"s":"b","v":[4],"t":"c"})", &unknown );
+    EXPECT( withUnknown.in.a == 7 );
+    EXPECT( withUnknown.t == "c" );
+    EXPECT( ( unknown == std::vector<std::string>{ "in.x", "zz" } ) );
+}
+
+} // namespace
+
+const lest::test test_comparsers_out_of_order[] =
+{
+    lest_CASE( "test_comparsers_out_of_order.Positions" )
+    {
+        parsesOutOfOrder<BufferT::ReadIter>( lest_env );
+    },
+
+    lest_CASE( "test_comparsers_out_of_order.Text" )
+    {
+        parsesOutOfOrder<OneWayReadIter>( lest_env );
+    },
+
+    lest_CASE( "test_comparsers_out_of_order.Missing" )
+    {
+        EXPECT_THROWS( parseOuter<BufferT::ReadIter>( R"({"t":"\"}","i":1,"s":"","in":{"a":1,"s":""}})" ) );
+        EXPECT_THROWS( parseOuter<OneWayReadIter>( R"({"t":"\"}","i":1,"s":"","in":{"a":1,"s":""}})" ) );
+    },
+};
+
+lest_MODULE(specification(), test_comparsers_out_of_order);
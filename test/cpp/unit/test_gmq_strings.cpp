@@ -0,0 +1,168 @@
+/* -------------------------------------------------------------------------------
+* Copyright (c) 2022, OLogN Technologies AG
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*	 * Redistributions of source code must retain the above copyright
+*	   notice, this list of conditions and the following disclaimer.
+*	 * Redistributions in binary form must reproduce the above copyright
+*	   notice, this list of conditions and the following disclaimer in the
+*	   documentation and/or other materials provided with the distribution.
+*	 * Neither the name of the OLogN Technologies AG nor the
+*	   names of its contributors may be used to endorse or promote products
+*	   derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL OLogN Technologies AG BE LIABLE FOR ANY
+* DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+* ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* -------------------------------------------------------------------------------*/
+
+#include "test_common.h"
+
+using namespace globalmq::marshalling;
+
+namespace
+{
+
+BufferT composeGmqString( const GMQ_COLL string& str, bool lengthPrefixed )
+{
+    BufferT b;
+    GmqComposer<BufferT> composer( b );
+    composer.setLengthPrefixedStrings( lengthPrefixed );
+    impl::composeString( composer, str );
+    return b;
+}
+
+GMQ_COLL string parseGmqString( BufferT& b, bool lengthPrefixed )
+{
+    auto riter = b.getReadIter();
+    GmqParser<BufferT> parser( riter );
+    parser.setLengthPrefixedStrings( lengthPrefixed );
+    GMQ_COLL string str;
+    parser.parseString( &str );
+    return str;
+}
+
+void skipGmqString( BufferT& b, bool lengthPrefixed )
+{
+    auto riter = b.getReadIter();
+    GmqParser<BufferT> parser( riter );
+    parser.setLengthPrefixedStrings( lengthPrefixed );
+    parser.skipString();
+}
+
+// strings of 0, 1, ... count-1 chars, one after another, so that some of them straddle any chunk bound
+BufferT composeGmqStrings( size_t count, bool lengthPrefixed )
+{
+    BufferT b;
+    GmqComposer<BufferT> composer( b );
+    composer.setLengthPrefixedStrings( lengthPrefixed );
+    for ( size_t i=0; i<count; ++i )
+        impl::composeString( composer, GMQ_COLL string( i, 'a' + i % 26 ) );
+    return b;
+}
+
+template<class MessageT>
+bool parseGmqStrings( const BufferT& b, size_t count, bool lengthPrefixed, bool skipOdd )
+{
+    typename MessageT::ReadIteratorT riter( b );
+    GmqParser<MessageT> parser( riter );
+    parser.setLengthPrefixedStrings( lengthPrefixed );
+    for ( size_t i=0; i<count; ++i )
+    {
+        if ( skipOdd && i % 2 )
+        {
+            parser.skipString();
+            continue;
+        }
+        GMQ_COLL string str;
+        parser.parseString( &str );
+        if ( str != GMQ_COLL string( i, 'a' + i % 26 ) )
+            return false;
+    }
+    return !riter.isData();
+}
+
+} // namespace
+
+const lest::test test_gmq_strings[] =
+{
+    lest_CASE( "test_gmq_strings.RoundTrip" )
+    {
+        GMQ_COLL string withNul( "ab\0cd", 5 );
+        for ( bool lengthPrefixed : { false, true } )
+        {
+            BufferT b = composeGmqString( "abc", lengthPrefixed );
+            EXPECT( parseGmqString( b, lengthPrefixed ) == "abc" );
+            BufferT empty = composeGmqString( "", lengthPrefixed );
+            EXPECT( parseGmqString( empty, lengthPrefixed ) == "" );
+        }
+        BufferT b = composeGmqString( withNul, true );
+        EXPECT( parseGmqString( b, true ) == withNul );
+    },
+
+    lest_CASE( "test_gmq_strings.TruncatedLengthPrefixed" )
+    {
+        // bytes beyond the end are still in the buffer's memory (as in a pooled block); they must not be taken for the string
+        BufferT b = composeGmqString( GMQ_COLL string( 127, 'x' ), true );
+        b.set_size( b.size() - 126 );
+        EXPECT_THROWS( parseGmqString( b, true ) );
+        EXPECT_THROWS( skipGmqString( b, true ) );
+
+        BufferT justPrefix = composeGmqString( GMQ_COLL string( 1000, 'y' ), true );
+        justPrefix.set_size( 2 );
+        EXPECT_THROWS( parseGmqString( justPrefix, true ) );
+        EXPECT_THROWS( skipGmqString( justPrefix, true ) );
+    },
+
+    lest_CASE( "test_gmq_strings.Unterminated" )
+    {
+        BufferT b = composeGmqString( "abcdef", false );
+        b.set_size( b.size() - 1 ); // terminator is dropped, but stays in memory right after the end
+        EXPECT_THROWS( parseGmqString( b, false ) );
+        EXPECT_THROWS( skipGmqString( b, false ) );
+
+        BufferT empty;
+        EXPECT_THROWS( parseGmqString( empty, false ) );
+        EXPECT_THROWS( skipGmqString( empty, false ) );
+    },
+
+    lest_CASE( "test_gmq_strings.SplitAcrossChunks" )
+    {
+        for ( bool lengthPrefixed : { false, true } )
+        {
+            constexpr size_t count = 160; // including some with two-byte size prefixes
+            BufferT b = composeGmqStrings( count, lengthPrefixed );
+            for ( bool skipOdd : { false, true } )
+            {
+                EXPECT( parseGmqStrings<BufferT>( b, count, lengthPrefixed, skipOdd ) );
+                EXPECT( parseGmqStrings<ChunkedBuffer<1>>( b, count, lengthPrefixed, skipOdd ) );
+                EXPECT( parseGmqStrings<ChunkedBuffer<3>>( b, count, lengthPrefixed, skipOdd ) );
+                EXPECT( parseGmqStrings<ChunkedBuffer<64>>( b, count, lengthPrefixed, skipOdd ) );
+            }
+
+            BufferT truncated = composeGmqStrings( count, lengthPrefixed );
+            truncated.set_size( truncated.size() - 1 );
+            EXPECT_THROWS( parseGmqStrings<ChunkedBuffer<3>>( truncated, count, lengthPrefixed, false ) );
+            EXPECT_THROWS( parseGmqStrings<ChunkedBuffer<3>>( truncated, count, lengthPrefixed, true ) );
+
+            // a view can only refer to a string lying within a chunk
+            BufferT one = composeGmqString( "abcdef", lengthPrefixed );
+            ChunkedBuffer<4>::ReadIter riter( one );
+            GmqParser<ChunkedBuffer<4>> parser( riter );
+            parser.setLengthPrefixedStrings( lengthPrefixed );
+            GMQ_COLL string_view view;
+            EXPECT_THROWS( parser.parseString( &view ) );
+        }
+    },
+};
+
+lest_MODULE(specification(), test_gmq_strings);
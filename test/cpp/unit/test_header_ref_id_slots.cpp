@@ -0,0 +1,174 @@
+/* -------------------------------------------------------------------------------
+* Copyright (c) 2022, OLogN Technologies AG
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*	 * Redistributions of source code must retain the above copyright
+*	   notice, this list of conditions and the following disclaimer.
+*	 * Redistributions in binary form must reproduce the above copyright
+*	   notice, this list of conditions and the following disclaimer in the
+*	   documentation and/or other materials provided with the distribution.
+*	 * Neither the name of the OLogN Technologies AG nor the
+*	   names of its contributors may be used to endorse or promote products
+*	   derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL OLogN Technologies AG BE LIABLE FOR ANY
+* DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+* ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* -------------------------------------------------------------------------------*/
+
+#include "test_common.h"
+#include <globalmq/marshalling2/marshalling2.h>
+#include <gmqueue.h>
+
+using namespace globalmq::marshalling;
+using namespace globalmq::marshalling2;
+
+namespace
+{
+
+template<class ComposerT>
+BufferT composeStateUpdate( uint64_t refIdAtSubscriber, uint64_t refIdAtPublisher, bool fixedRefIdSlots )
+{
+    PublishableStateMessageHeader header;
+    header.type = PublishableStateMessageHeader::MsgType::stateUpdate;
+    header.state_type_id_or_direction = 5;
+    header.priority = 0;
+    header.ref_id_at_subscriber = refIdAtSubscriber;
+    header.ref_id_at_publisher = refIdAtPublisher;
+    header.fixedRefIdSlots = fixedRefIdSlots;
+
+    BufferT b;
+    ComposerT composer( b );
+    helperComposePublishableStateMessageBegin( composer, header );
+    if constexpr ( ComposerT::proto == Proto::GMQ || ComposerT::proto == Proto::JSON )
+    {
+        impl::composeStructBegin( composer );
+        impl::composeStructEnd( composer );
+    }
+    else
+    {
+        composer.structBegin();
+        composer.structEnd();
+    }
+    helperComposePublishableStateMessageEnd( composer );
+    return b;
+}
+
+template<class ParserT>
+ParsedMessageHeader parseStateUpdate( BufferT& b )
+{
+    auto riter = b.getReadIter();
+    ParserT parser( riter );
+    ParsedMessageHeader parsed;
+    helperParsePublishableStateMessageBegin( parser, parsed.header );
+    parsed.bodyOffset = parser.getCurrentOffset();
+    return parsed;
+}
+
+template<class ComposerT, class ParserT>
+void patchesRefIdsInPlace( lest::env & lest_env )
+{
+    BufferT msg = composeStateUpdate<ComposerT>( 1, 2, true );
+    ParsedMessageHeader parsed = parseStateUpdate<ParserT>( msg );
+    EXPECT( parsed.header.fixedRefIdSlots );
+    EXPECT( parsed.header.ref_id_at_subscriber == 1 );
+    EXPECT( parsed.header.ref_id_at_publisher == 2 );
+    EXPECT( parsed.header.ref_id_at_subscriber_slot != PublishableStateMessageHeader::invalidOffset );
+    EXPECT( parsed.header.ref_id_at_publisher_slot != PublishableStateMessageHeader::invalidOffset );
+
+    const uint8_t* data = msg.begin();
+    size_t size = msg.size();
+    GMQ_COLL vector<uint8_t> body( msg.begin() + parsed.bodyOffset, msg.begin() + size );
+
+    PublishableStateMessageHeader::UpdatedData ud;
+    ud.ref_id_at_subscriber = 0x0102030405060708ull;
+    ud.update_ref_id_at_subscriber = true;
+    ud.ref_id_at_publisher = 77;
+    ud.update_ref_id_at_publisher = true;
+    size_t subscriberSlot = parsed.header.ref_id_at_subscriber_slot;
+    BufferT patched = helperUpdatePublishableStateMessage<ParserT, ComposerT>( std::move( msg ), parsed, ud );
+
+    EXPECT( patched.begin() == data );
+    EXPECT( patched.size() == size );
+    EXPECT( GMQ_COLL vector<uint8_t>( patched.begin() + parsed.bodyOffset, patched.begin() + patched.size() ) == body );
+
+    ParsedMessageHeader reparsed = parseStateUpdate<ParserT>( patched );
+    EXPECT( reparsed.header.ref_id_at_subscriber == 0x0102030405060708ull );
+    EXPECT( reparsed.header.ref_id_at_publisher == 77 );
+    EXPECT( reparsed.bodyOffset == parsed.bodyOffset );
+
+    if constexpr ( ComposerT::proto == Proto::GMQ || std::is_same<ComposerT, GmqComposer2<BufferT>>::value )
+    {
+        const uint8_t expected[impl::fixed_width_uinteger_size] = { 0x08, 0x07, 0x06, 0x05, 0x04, 0x03, 0x02, 0x01 };
+        EXPECT( memcmp( patched.begin() + subscriberSlot, expected, impl::fixed_width_uinteger_size ) == 0 );
+    }
+
+    // must be the same as what composing the message with these ids from scratch gives
+    BufferT composed = composeStateUpdate<ComposerT>( 0x0102030405060708ull, 77, true );
+    EXPECT( composed.size() == patched.size() );
+    EXPECT( memcmp( composed.begin(), patched.begin(), composed.size() ) == 0 );
+}
+
+} // namespace
+
+const lest::test test_header_ref_id_slots[] =
+{
+    lest_CASE( "test_header_ref_id_slots.GmqLittleEndian" )
+    {
+        BufferT b;
+        GmqComposer<BufferT> composer( b );
+        impl::composeFixedWidthUnsignedInteger( composer, 0x1122334455667788ull );
+        const uint8_t expected[impl::fixed_width_uinteger_size] = { 0x88, 0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11 };
+        EXPECT( b.size() == impl::fixed_width_uinteger_size );
+        EXPECT( memcmp( b.begin(), expected, impl::fixed_width_uinteger_size ) == 0 );
+
+        auto riter = b.getReadIter();
+        GmqParser<BufferT> parser( riter );
+        uint64_t num = 0;
+        parser.parseFixedWidthUnsignedInteger( &num );
+        EXPECT( num == 0x1122334455667788ull );
+    },
+
+    lest_CASE( "test_header_ref_id_slots.GmqTruncated" )
+    {
+        BufferT b;
+        GmqComposer<BufferT> composer( b );
+        impl::composeFixedWidthUnsignedInteger( composer, 1 );
+        b.set_size( b.size() - 1 );
+        auto riter = b.getReadIter();
+        GmqParser<BufferT> parser( riter );
+        uint64_t num = 0;
+        EXPECT_THROWS( parser.parseFixedWidthUnsignedInteger( &num ) );
+    },
+
+    lest_CASE( "test_header_ref_id_slots.PatchGmq" )
+    {
+        patchesRefIdsInPlace<GmqComposer<BufferT>, GmqParser<BufferT>>( lest_env );
+    },
+
+    lest_CASE( "test_header_ref_id_slots.PatchJson" )
+    {
+        patchesRefIdsInPlace<JsonComposer<BufferT>, JsonParser<BufferT>>( lest_env );
+    },
+
+    lest_CASE( "test_header_ref_id_slots.PatchGmq2" )
+    {
+        patchesRefIdsInPlace<GmqComposer2<BufferT>, GmqParser2<BufferT>>( lest_env );
+    },
+
+    lest_CASE( "test_header_ref_id_slots.PatchJson2" )
+    {
+        patchesRefIdsInPlace<JsonComposer2<BufferT>, JsonParser2<BufferT>>( lest_env );
+    },
+};
+
+lest_MODULE(specification(), test_header_ref_id_slots);
@@ -0,0 +1,259 @@
+/* -------------------------------------------------------------------------------
+* Copyright (c) 2022, OLogN Technologies AG
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*	 * Redistributions of source code must retain the above copyright
+*	   notice, this list of conditions and the following disclaimer.
+*	 * Redistributions in binary form must reproduce the above copyright
+*	   notice, this list of conditions and the following disclaimer in the
+*	   documentation and/or other materials provided with the distribution.
+*	 * Neither the name of the OLogN Technologies AG nor the
+*	   names of its contributors may be used to endorse or promote products
+*	   derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL OLogN Technologies AG BE LIABLE FOR ANY
+* DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+* ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* -------------------------------------------------------------------------------*/
+
+#include "test_common.h"
+#include <gmqueue.h>
+#include <platforms/inproc_queue.h>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace globalmq::marshalling;
+
+namespace
+{
+
+struct Item // counts live instances to check that the queue destroys whatever it constructs
+{
+    static inline std::atomic<int> live = 0;
+    size_t producer = 0;
+    size_t seq = 0;
+
+    Item() { ++live; }
+    Item( size_t producer_, size_t seq_ ) : producer( producer_ ), seq( seq_ ) { ++live; }
+    Item( Item&& other ) noexcept : producer( other.producer ), seq( other.seq ) { ++live; }
+    Item& operator = ( Item&& other ) noexcept { producer = other.producer; seq = other.seq; return *this; }
+    Item( const Item& ) = delete;
+    Item& operator = ( const Item& ) = delete;
+    ~Item() { --live; }
+};
+
+using QueueT = MPSCRingQueueWithFlowControl<Item, 2>;
+
+template<class PredT>
+bool waitUntil( PredT&& pred, int ms = 5000 )
+{
+    auto until = std::chrono::steady_clock::now() + std::chrono::milliseconds( ms );
+    while ( !pred() )
+    {
+        if ( std::chrono::steady_clock::now() > until )
+            return false;
+        std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+    }
+    return true;
+}
+
+} // namespace
+
+const lest::test test_inproc_queue[] =
+{
+    lest_CASE( "test_inproc_queue.FifoAcrossRingAndSpill" )
+    {
+        {
+            QueueT queue( 4, true );
+            for ( size_t i=0; i<5; ++i )
+                queue.push_back( Item( 0, i ) );
+            EXPECT( Item::live == 5 ); // overflow list constructs items only as they are spilled
+            for ( size_t i=5; i<200; ++i )
+                queue.push_back( Item( 0, i ) );
+            EXPECT( queue.size() == 200 );
+            EXPECT( queue.getSpilledCount() == 196 );
+            EXPECT( queue.getHwmSize() == 200 );
+
+            Item messages[7];
+            size_t expected = 0;
+            while ( expected < 150 )
+            {
+                size_t popped = queue.pop_front( messages, 7 );
+                for ( size_t i=0; i<popped; ++i )
+                    EXPECT( messages[i].seq == expected++ );
+            }
+            // ring is free again, but new items must still go after what is left in overflow list
+            for ( size_t i=200; i<210; ++i )
+                queue.push_back( Item( 0, i ) );
+            while ( expected < 210 )
+            {
+                size_t popped = queue.pop_front( messages, 7, 0 );
+                EXPECT( popped > 0 );
+                for ( size_t i=0; i<popped; ++i )
+                    EXPECT( messages[i].seq == expected++ );
+            }
+            EXPECT( queue.size() == 0 );
+
+            for ( size_t i=0; i<100; ++i ) // left in both ring and overflow list
+                queue.push_back( Item( 0, i ) );
+        }
+        EXPECT( Item::live == 0 );
+    },
+
+    lest_CASE( "test_inproc_queue.FifoPerProducer" )
+    {
+        for ( bool spill : { false, true } )
+        {
+            constexpr size_t producerCount = 4;
+            constexpr size_t msgsPerProducer = 5000;
+            QueueT queue( 4, spill );
+            std::vector<std::thread> producers;
+            for ( size_t p=0; p<producerCount; ++p )
+                producers.emplace_back( [&queue, p]() {
+                    for ( size_t i=0; i<msgsPerProducer; ++i )
+                        queue.push_back( Item( p, i ) );
+                } );
+
+            Item messages[16];
+            std::vector<size_t> next( producerCount, 0 );
+            bool ordered = true;
+            for ( size_t received = 0; received < producerCount * msgsPerProducer; )
+            {
+                size_t popped = queue.pop_front( messages, 16 );
+                for ( size_t i=0; i<popped; ++i )
+                    ordered = ordered && messages[i].seq == next[messages[i].producer]++;
+                received += popped;
+            }
+            for ( auto& t : producers )
+                t.join();
+            EXPECT( ordered );
+            EXPECT( queue.size() == 0 );
+            EXPECT( ( spill || ( queue.getHwmSize() <= queue.capacity() && queue.getSpilledCount() == 0 ) ) );
+        }
+        EXPECT( Item::live == 0 );
+    },
+
+    lest_CASE( "test_inproc_queue.BlocksAtHighWatermark" )
+    {
+        QueueT queue( 8 );
+        queue.setWatermarks( 4, 1 );
+        std::atomic<size_t> pushed = 0;
+        std::thread producer( [&queue, &pushed]() {
+            for ( size_t i=0; i<5; ++i )
+            {
+                queue.push_back( Item( 0, i ) );
+                ++pushed;
+            }
+        } );
+
+        EXPECT( waitUntil( [&]() { return pushed == 4; } ) );
+        std::this_thread::sleep_for( std::chrono::milliseconds( 50 ) );
+        EXPECT( pushed == 4 );
+        EXPECT( queue.size() == 4 );
+
+        // above low watermark: still blocked
+        Item messages[2];
+        EXPECT( queue.pop_front( messages, 1 ) == 1 );
+        std::this_thread::sleep_for( std::chrono::milliseconds( 50 ) );
+        EXPECT( pushed == 4 );
+
+        // down to low watermark: released
+        EXPECT( queue.pop_front( messages, 2 ) == 2 );
+        EXPECT( waitUntil( [&]() { return pushed == 5; } ) );
+        producer.join();
+        EXPECT( queue.size() == 2 );
+        EXPECT( queue.getNFulls() >= 1 );
+        EXPECT( queue.getHwmSize() == 4 );
+        EXPECT( queue.getSpilledCount() == 0 );
+
+        size_t expected = 3;
+        while ( queue.size() )
+        {
+            size_t popped = queue.pop_front( messages, 2 );
+            for ( size_t i=0; i<popped; ++i )
+                EXPECT( messages[i].seq == expected++ );
+        }
+        EXPECT( expected == 5 );
+    },
+
+    lest_CASE( "test_inproc_queue.PopTimeout" )
+    {
+        QueueT queue;
+        Item messages[4];
+        EXPECT( queue.pop_front( messages, 4, 0 ) == 0 );
+
+        auto start = std::chrono::steady_clock::now();
+        EXPECT( queue.pop_front( messages, 4, 30 ) == 0 );
+        EXPECT( std::chrono::steady_clock::now() - start >= std::chrono::milliseconds( 30 ) );
+
+        std::thread producer( [&queue]() {
+            std::this_thread::sleep_for( std::chrono::milliseconds( 20 ) );
+            queue.push_back( Item( 0, 42 ) );
+        } );
+        size_t popped = queue.pop_front( messages, 4, 10000 );
+        producer.join();
+        EXPECT( popped == 1 );
+        EXPECT( messages[0].seq == 42 );
+    },
+
+    lest_CASE( "test_inproc_queue.KillWakesParkedReader" )
+    {
+        for ( int variant = 0; variant < 3; ++variant )
+        {
+            QueueT queue;
+            std::atomic<bool> done = false;
+            bool got = true;
+            size_t popped = 1;
+            std::thread reader( [&]() {
+                Item messages[4];
+                if ( variant == 0 )
+                    got = queue.pop_front().first;
+                else if ( variant == 1 )
+                    popped = queue.pop_front( messages, 4 );
+                else
+                    popped = queue.pop_front( messages, 4, 100000 );
+                done = true;
+            } );
+            std::this_thread::sleep_for( std::chrono::milliseconds( 50 ) );
+            EXPECT( !done );
+            queue.kill();
+            EXPECT( waitUntil( [&]() { return done.load(); } ) );
+            reader.join();
+            EXPECT( ( variant == 0 ? !got : popped == 0 ) );
+
+            queue.push_back( Item( 0, 0 ) ); // dropped
+            EXPECT( queue.size() == 0 );
+        }
+    },
+
+    lest_CASE( "test_inproc_queue.KillReleasesBlockedWriter" )
+    {
+        QueueT queue( 2 );
+        queue.push_back( Item( 0, 0 ) );
+        queue.push_back( Item( 0, 1 ) );
+        std::atomic<bool> done = false;
+        std::thread producer( [&]() {
+            queue.push_back( Item( 0, 2 ) );
+            done = true;
+        } );
+        std::this_thread::sleep_for( std::chrono::milliseconds( 50 ) );
+        EXPECT( !done );
+        queue.kill();
+        EXPECT( waitUntil( [&]() { return done.load(); } ) );
+        producer.join();
+        EXPECT( queue.size() == 2 );
+    },
+};
+
+lest_MODULE(specification(), test_inproc_queue);
@@ -0,0 +1,143 @@
+/* -------------------------------------------------------------------------------
+* Copyright (c) 2022, OLogN Technologies AG
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*	 * Redistributions of source code must retain the above copyright
+*	   notice, this list of conditions and the following disclaimer.
+*	 * Redistributions in binary form must reproduce the above copyright
+*	   notice, this list of conditions and the following disclaimer in the
+*	   documentation and/or other materials provided with the distribution.
+*	 * Neither the name of the OLogN Technologies AG nor the
+*	   names of its contributors may be used to endorse or promote products
+*	   derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL OLogN Technologies AG BE LIABLE FOR ANY
+* DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+* ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* -------------------------------------------------------------------------------*/
+
+#include "test_common.h"
+#include <comparsers.h>
+
+using namespace globalmq::marshalling;
+
+namespace
+{
+
+GMQ_COLL string composeJsonString( const GMQ_COLL string& str )
+{
+    BufferT b;
+    JsonComposer<BufferT> composer( b );
+    impl::json::composeString( composer, str );
+    return GMQ_COLL string( reinterpret_cast<const char*>( b.begin() ), b.size() );
+}
+
+GMQ_COLL string parseJsonString( std::string_view json )
+{
+    BufferT b = bufferOf( GMQ_COLL string( json ) + "," );
+    auto riter = b.getReadIter();
+    JsonParser<BufferT> parser( riter );
+    GMQ_COLL string s;
+    parser.readStringFromJson( &s );
+    return s;
+}
+
+GMQ_COLL string allControlChars()
+{
+    GMQ_COLL string ret;
+    for ( int ch = 0; ch < 0x20; ++ch )
+        ret += (char)ch;
+    return ret;
+}
+
+struct Text
+{
+    std::string s;
+
+    template<typename ObjectT, typename ComparserT>
+    static void rw( ObjectT& obj, ComparserT& comparser )
+    {
+        comparser.template beginStruct<"Text">( obj );
+        comparser.template rw<comparsers::STRING>( "s", obj.s );
+        comparser.endStruct();
+    }
+};
+
+} // namespace
+
+const lest::test test_json_escaping[] =
+{
+    lest_CASE( "test_json_escaping.ControlChars" )
+    {
+        EXPECT( composeJsonString( GMQ_COLL string( "\0", 1 ) ) == "\"\\u0000\"" );
+        EXPECT( composeJsonString( "\x01\x1f" ) == "\"\\u0001\\u001f\"" );
+        EXPECT( composeJsonString( "\n\r\t" ) == "\"\\n\\r\\t\"" );
+        EXPECT( composeJsonString( "\"\\" ) == "\"\\\"\\\\\"" );
+        EXPECT( impl::json::string2JsonString( GMQ_COLL string( "a\x02" ) ) == "a\\u0002" );
+
+        GMQ_COLL string controls = allControlChars();
+        GMQ_COLL string composed = composeJsonString( controls );
+        for ( char ch : composed )
+            EXPECT( (uint8_t)ch >= 0x20 );
+        EXPECT( parseJsonString( composed ) == controls );
+    },
+
+    lest_CASE( "test_json_escaping.FindCharToEscape" )
+    {
+        // bytes of multibyte UTF-8 chars (>= 0x80) must not be taken for control chars
+        EXPECT( findsAtAnyOffset( impl::json::findCharToEscape, []( uint8_t ch ) { return ch < 0x20 || ch == '\"' || ch == '\\'; }, { 0, 0x1f, '\n', '\"', '\\' } ) );
+    },
+
+    lest_CASE( "test_json_escaping.RoundTripAtAnyOffset" )
+    {
+        // chars to escape at every offset relative to the 16-byte blocks of the scanner, between clean runs
+        for ( size_t lead = 0; lead < 40; ++lead )
+            for ( char ch : { '\x01', '\n', '\"', '\\', '\x1f' } )
+            {
+                GMQ_COLL string str = GMQ_COLL string( lead, 'a' ) + ch + GMQ_COLL string( 40 - lead, 'b' ) + ch;
+                EXPECT( parseJsonString( composeJsonString( str ) ) == str );
+            }
+    },
+
+    lest_CASE( "test_json_escaping.Utf8" )
+    {
+        GMQ_COLL string utf8 = "\xc3\xa9\xe2\x82\xac\x7f"; // e-acute, euro sign, DEL: as is
+        EXPECT( composeJsonString( utf8 ) == "\"" + utf8 + "\"" );
+        EXPECT( parseJsonString( composeJsonString( utf8 ) ) == utf8 );
+        EXPECT( parseJsonString( "\"\\u00e9\\u20AC\\u0041\"" ) == "\xc3\xa9\xe2\x82\xac" "A" );
+        EXPECT_THROWS( parseJsonString( "\"\\ud83d\\ude00\"" ) ); // surrogates are not supported
+        EXPECT_THROWS( parseJsonString( "\"\\u00g9\"" ) );
+        EXPECT_THROWS( parseJsonString( "\"\\u00\"" ) );
+        EXPECT_THROWS( parseJsonString( "\"\\x41\"" ) );
+    },
+
+    lest_CASE( "test_json_escaping.Comparsers" )
+    {
+        Text text;
+        text.s = allControlChars() + "\"\\\xc3\xa9" + GMQ_COLL string( 20, 'x' ) + "\x01";
+        BufferT b;
+        comparsers::JsonComposer2 composer( b );
+        Text::rw( text, composer );
+        std::string_view composed( reinterpret_cast<const char*>( b.begin() ), b.size() );
+        EXPECT( composed.find( "\\u0001" ) != std::string_view::npos );
+        for ( char ch : composed )
+            EXPECT( ( (uint8_t)ch >= 0x20 || ch == '\n' ) ); // beautified: line breaks between, not within strings
+
+        auto riter = b.getReadIter();
+        comparsers::JsonParser2<BufferT::ReadIteratorT> parser( riter );
+        Text back;
+        Text::rw( back, parser );
+        EXPECT( back.s == text.s );
+    },
+};
+
+lest_MODULE(specification(), test_json_escaping);
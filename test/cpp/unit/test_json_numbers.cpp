@@ -0,0 +1,194 @@
+/* -------------------------------------------------------------------------------
+* Copyright (c) 2022, OLogN Technologies AG
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*	 * Redistributions of source code must retain the above copyright
+*	   notice, this list of conditions and the following disclaimer.
+*	 * Redistributions in binary form must reproduce the above copyright
+*	   notice, this list of conditions and the following disclaimer in the
+*	   documentation and/or other materials provided with the distribution.
+*	 * Neither the name of the OLogN Technologies AG nor the
+*	   names of its contributors may be used to endorse or promote products
+*	   derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL OLogN Technologies AG BE LIABLE FOR ANY
+* DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+* ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* -------------------------------------------------------------------------------*/
+
+#include "test_common.h"
+#include <comparsers.h>
+
+using namespace globalmq::marshalling;
+
+namespace
+{
+
+template<class T, class MessageT = BufferT>
+T readJsonNumber( std::string_view json )
+{
+    BufferT b = bufferOf( json );
+    typename MessageT::ReadIteratorT riter( b );
+    JsonParser<MessageT> parser( riter );
+    T num;
+    if constexpr ( std::is_floating_point<T>::value )
+        parser.readRealFromJson( &num );
+    else if constexpr ( std::is_signed<T>::value )
+        parser.readSignedIntegerFromJson( &num );
+    else
+        parser.readUnsignedIntegerFromJson( &num );
+    return num;
+}
+
+struct Numbers
+{
+    uint8_t u8 = 0;
+    int8_t i8 = 0;
+    uint64_t u64 = 0;
+    int64_t i64 = 0;
+
+    template<typename ObjectT, typename ComparserT>
+    static void rw( ObjectT& obj, ComparserT& comparser )
+    {
+        comparser.template beginStruct<"Numbers">( obj );
+        comparser.template rw<comparsers::UINT>( "u8", obj.u8 );
+        comparser.template rw<comparsers::INT>( "i8", obj.i8 );
+        comparser.template rw<comparsers::INT>( "u64", obj.u64 ); // all bits of an unsigned value, as INT
+        comparser.template rw<comparsers::UINT>( "i64", obj.i64 ); // and vice versa
+        comparser.endStruct();
+    }
+};
+
+Numbers parseNumbers( std::string_view json )
+{
+    BufferT b = bufferOf( json );
+    auto riter = b.getReadIter();
+    comparsers::JsonParser2<BufferT::ReadIteratorT> parser( riter );
+    Numbers n;
+    Numbers::rw( n, parser );
+    return n;
+}
+
+} // namespace
+
+const lest::test test_json_numbers[] =
+{
+    lest_CASE( "test_json_numbers.InRange" )
+    {
+        EXPECT( readJsonNumber<uint64_t>( "18446744073709551615," ) == UINT64_MAX );
+        EXPECT( readJsonNumber<int64_t>( "-9223372036854775808}" ) == INT64_MIN );
+        EXPECT( readJsonNumber<int64_t>( "9223372036854775807]" ) == INT64_MAX );
+        EXPECT( readJsonNumber<uint8_t>( "255," ) == 255 );
+        EXPECT( readJsonNumber<int8_t>( "-128," ) == -128 );
+        EXPECT( readJsonNumber<uint32_t>( " \t\r\n 42," ) == 42 );
+        EXPECT( readJsonNumber<double>( "1.5e3," ) == 1500.0 );
+        EXPECT( readJsonNumber<double>( "-0.25 }" ) == -0.25 );
+    },
+
+    lest_CASE( "test_json_numbers.OutOfRange" )
+    {
+        EXPECT_THROWS( readJsonNumber<uint64_t>( "18446744073709551616," ) );
+        EXPECT_THROWS( readJsonNumber<uint32_t>( "4294967296," ) );
+        EXPECT_THROWS( readJsonNumber<uint8_t>( "256," ) );
+        EXPECT_THROWS( readJsonNumber<int64_t>( "9223372036854775808," ) );
+        EXPECT_THROWS( readJsonNumber<int64_t>( "-9223372036854775809," ) );
+        EXPECT_THROWS( readJsonNumber<int8_t>( "128," ) );
+        EXPECT_THROWS( readJsonNumber<int8_t>( "-129," ) );
+        EXPECT_THROWS( readJsonNumber<double>( "1e999," ) );
+    },
+
+    lest_CASE( "test_json_numbers.Negative" )
+    {
+        EXPECT_THROWS( readJsonNumber<uint64_t>( "-1," ) );
+        EXPECT_THROWS( readJsonNumber<uint8_t>( "-0," ) );
+        EXPECT( readJsonNumber<int32_t>( "-1," ) == -1 );
+    },
+
+    lest_CASE( "test_json_numbers.NotANumber" )
+    {
+        EXPECT_THROWS( readJsonNumber<uint32_t>( "," ) );
+        EXPECT_THROWS( readJsonNumber<int32_t>( "-," ) );
+        EXPECT_THROWS( readJsonNumber<int32_t>( "1-2," ) ); // the whole token must be a number
+        EXPECT_THROWS( readJsonNumber<double>( "1.5.3," ) );
+        EXPECT_THROWS( readJsonNumber<double>( "abc," ) );
+        EXPECT_THROWS( readJsonNumber<uint32_t>( "42" ) ); // a number is never the last thing in a message
+    },
+
+    lest_CASE( "test_json_numbers.SplitSpan" )
+    {
+        // the token does not fit in what the iterator exposes directly, and goes through the on-stack copy
+        EXPECT( ( readJsonNumber<uint64_t, ChunkedBuffer<4>>( "  18446744073709551615," ) == UINT64_MAX ) );
+        EXPECT( ( readJsonNumber<int64_t, ChunkedBuffer<1>>( "-9223372036854775808}" ) == INT64_MIN ) );
+        EXPECT( ( readJsonNumber<double, ChunkedBuffer<3>>( "12.5e-1]" ) == 1.25 ) );
+        EXPECT_THROWS( ( readJsonNumber<uint8_t, ChunkedBuffer<2>>( "256," ) ) );
+        EXPECT_THROWS( ( readJsonNumber<uint64_t, ChunkedBuffer<2>>( "-1," ) ) );
+        EXPECT_THROWS( ( readJsonNumber<int32_t, ChunkedBuffer<2>>( "1-2," ) ) );
+    },
+
+    lest_CASE( "test_json_numbers.Skip" )
+    {
+        BufferT b = bufferOf( "42 ,-7,2.5]" );
+        auto riter = b.getReadIter();
+        JsonParser<BufferT> parser( riter );
+        parser.skipUnsignedIntegerFromJson();
+        EXPECT( parser.isComma() );
+        parser.skipComma();
+        parser.skipSignedIntegerFromJson();
+        parser.skipComma();
+        parser.skipRealFromJson();
+        EXPECT( parser.isDelimiter( ']' ) );
+
+        BufferT negative = bufferOf( "-1," );
+        auto riter2 = negative.getReadIter();
+        JsonParser<BufferT> parser2( riter2 );
+        EXPECT_THROWS( parser2.skipUnsignedIntegerFromJson() );
+
+        BufferT notANumber = bufferOf( "1.5.3," );
+        auto riter3 = notANumber.getReadIter();
+        JsonParser<BufferT> parser3( riter3 );
+        EXPECT_THROWS( parser3.skipRealFromJson() );
+    },
+
+    lest_CASE( "test_json_numbers.Comparsers" )
+    {
+        Numbers n = parseNumbers( R"({"u8":255,"i8":-128,"u64":1,"i64":18446744073709551615})" );
+        EXPECT( n.u8 == 255 );
+        EXPECT( n.i8 == -128 );
+        EXPECT( n.u64 == 1 );
+        EXPECT( n.i64 == -1 );
+
+        EXPECT_THROWS( parseNumbers( R"({"u8":256,"i8":0,"u64":0,"i64":0})" ) );
+        EXPECT_THROWS( parseNumbers( R"({"u8":-1,"i8":0,"u64":0,"i64":0})" ) );
+        EXPECT_THROWS( parseNumbers( R"({"u8":0,"i8":-129,"u64":0,"i64":0})" ) );
+        EXPECT_THROWS( parseNumbers( R"({"u8":0,"i8":0,"u64":0,"i64":18446744073709551616})" ) );
+    },
+
+    lest_CASE( "test_json_numbers.ComparsersRoundTrip" )
+    {
+        // a signed field written as UINT (and an unsigned one as INT) comes back bit for bit
+        Numbers n;
+        n.u8 = 200;
+        n.i8 = -3;
+        n.u64 = UINT64_MAX;
+        n.i64 = -1;
+        BufferT b;
+        comparsers::JsonComposer2 composer( b );
+        Numbers::rw( n, composer );
+        Numbers back = parseNumbers( std::string_view( reinterpret_cast<const char*>( b.begin() ), b.size() ) );
+        EXPECT( back.u8 == n.u8 );
+        EXPECT( back.i8 == n.i8 );
+        EXPECT( back.u64 == n.u64 );
+        EXPECT( back.i64 == n.i64 );
+    },
+};
+
+lest_MODULE(specification(), test_json_numbers);
@@ -0,0 +1,137 @@
+/* -------------------------------------------------------------------------------
+* Copyright (c) 2022, OLogN Technologies AG
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*	 * Redistributions of source code must retain the above copyright
+*	   notice, this list of conditions and the following disclaimer.
+*	 * Redistributions in binary form must reproduce the above copyright
+*	   notice, this list of conditions and the following disclaimer in the
+*	   documentation and/or other materials provided with the distribution.
+*	 * Neither the name of the OLogN Technologies AG nor the
+*	   names of its contributors may be used to endorse or promote products
+*	   derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL OLogN Technologies AG BE LIABLE FOR ANY
+* DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+* ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* -------------------------------------------------------------------------------*/
+
+#include "test_common.h"
+
+using namespace globalmq::marshalling;
+
+namespace
+{
+
+GMQ_COLL string padding( size_t sz )
+{
+    static const char spaces[] = { ' ', '\t', '\r', '\n' };
+    GMQ_COLL string ret;
+    for ( size_t i=0; i<sz; ++i )
+        ret += spaces[i % sizeof( spaces )];
+    return ret;
+}
+
+template<class MessageT>
+struct JsonReader // a parser over its own copy of the text
+{
+    BufferT b;
+    typename MessageT::ReadIteratorT riter;
+    JsonParser<MessageT> parser;
+    JsonReader( std::string_view json ) : b( bufferOf( json ) ), riter( b ), parser( riter ) {}
+};
+
+// structural chars at every offset relative to scan blocks (and, with ChunkedBuffer, to chunk bounds)
+template<class MessageT>
+void scansAcrossBlocks( lest::env & lest_env )
+{
+    for ( size_t lead = 0; lead < 40; ++lead )
+    {
+        {
+            JsonReader<MessageT> r( padding( lead ) + "x" );
+            EXPECT( r.parser.isDelimiter( 'x' ) );
+        }
+
+        GMQ_COLL string text = GMQ_COLL string( lead, 'a' ) + "\\\"" + GMQ_COLL string( 20, 'b' ) + "\\u00e9\\\\" + GMQ_COLL string( 17, 'c' );
+        GMQ_COLL string expected = GMQ_COLL string( lead, 'a' ) + "\"" + GMQ_COLL string( 20, 'b' ) + "\xc3\xa9\\" + GMQ_COLL string( 17, 'c' );
+        GMQ_COLL string json = padding( lead % 5 ) + "\"" + text + "\",";
+        {
+            JsonReader<MessageT> r( json );
+            GMQ_COLL string s;
+            r.parser.readStringFromJson( &s );
+            EXPECT( s == expected );
+            EXPECT( r.parser.isComma() );
+        }
+        {
+            JsonReader<MessageT> r( json );
+            r.parser.skipStringFromJson();
+            EXPECT( r.parser.isComma() );
+        }
+
+        // brackets within strings, including right after an escaped backslash, do not count
+        GMQ_COLL string block = padding( lead % 3 ) + "{\"k" + GMQ_COLL string( lead, 'x' ) + "\":\"}{\\\"]\" , \"n\":{\"m\":[1,{},\"\\\\\"]}, \"s\":\"" + GMQ_COLL string( lead, '}' ) + "\"},";
+        {
+            JsonReader<MessageT> r( block );
+            r.parser.skipMessageFromJson();
+            EXPECT( r.parser.isComma() );
+        }
+        GMQ_COLL string vector = "[" + padding( lead ) + "\"]\\\\\", [ [], \"" + GMQ_COLL string( lead, ']' ) + "\" ], {\"[\":1} ]}";
+        {
+            JsonReader<MessageT> r( vector );
+            r.parser.skipVectorFromJson();
+            EXPECT( r.parser.isDelimiter( '}' ) );
+        }
+    }
+}
+
+} // namespace
+
+const lest::test test_json_scanning[] =
+{
+    lest_CASE( "test_json_scanning.FindNonSpace" )
+    {
+        EXPECT( findsAtAnyOffset( impl::json::findNonSpace, []( uint8_t ch ) { return !impl::json::isSpace( ch ); }, { 'x', '\"', 0, 0x80, 0xff } ) );
+    },
+
+    lest_CASE( "test_json_scanning.FindQuoteOrBackslash" )
+    {
+        EXPECT( findsAtAnyOffset( impl::json::findQuoteOrBackslash, []( uint8_t ch ) { return ch == '\"' || ch == '\\'; }, { '\"', '\\' } ) );
+    },
+
+    lest_CASE( "test_json_scanning.FindQuoteOrBracket" )
+    {
+        auto findInObject = []( const uint8_t* p, size_t sz ) { return impl::json::findQuoteOrBracket( p, sz, '{', '}' ); };
+        EXPECT( findsAtAnyOffset( findInObject, []( uint8_t ch ) { return ch == '\"' || ch == '{' || ch == '}'; }, { '\"', '{', '}' } ) );
+        auto findInVector = []( const uint8_t* p, size_t sz ) { return impl::json::findQuoteOrBracket( p, sz, '[', ']' ); };
+        EXPECT( findsAtAnyOffset( findInVector, []( uint8_t ch ) { return ch == '\"' || ch == '[' || ch == ']'; }, { '\"', '[', ']' } ) );
+    },
+
+    lest_CASE( "test_json_scanning.Parser" )
+    {
+        scansAcrossBlocks<BufferT>( lest_env );
+        scansAcrossBlocks<ChunkedBuffer<7>>( lest_env );
+        scansAcrossBlocks<ChunkedBuffer<16>>( lest_env );
+    },
+
+    lest_CASE( "test_json_scanning.Unterminated" )
+    {
+        for ( size_t len = 0; len < 40; ++len )
+        {
+            JsonReader<BufferT> string( "\"" + GMQ_COLL string( len, 'a' ) );
+            EXPECT_THROWS( string.parser.skipStringFromJson() );
+            JsonReader<BufferT> escape( "\"" + GMQ_COLL string( len, 'a' ) + "\\" );
+            EXPECT_THROWS( escape.parser.skipStringFromJson() );
+        }
+    },
+};
+
+lest_MODULE(specification(), test_json_scanning);
@@ -0,0 +1,132 @@
+/* -------------------------------------------------------------------------------
+* Copyright (c) 2022, OLogN Technologies AG
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*	 * Redistributions of source code must retain the above copyright
+*	   notice, this list of conditions and the following disclaimer.
+*	 * Redistributions in binary form must reproduce the above copyright
+*	   notice, this list of conditions and the following disclaimer in the
+*	   documentation and/or other materials provided with the distribution.
+*	 * Neither the name of the OLogN Technologies AG nor the
+*	   names of its contributors may be used to endorse or promote products
+*	   derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL OLogN Technologies AG BE LIABLE FOR ANY
+* DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+* ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* -------------------------------------------------------------------------------*/
+#include "test_common.h"
+#include <atomic>
+#include <new>
+
+using namespace globalmq::marshalling;
+
+// every allocation of the test binary is counted; cases look at the count across the code under test only
+static std::atomic<size_t> allocationCount = 0;
+
+void* operator new( size_t sz )
+{
+    ++allocationCount;
+    if ( void* ptr = malloc( sz != 0 ? sz : 1 ) )
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete( void* ptr ) noexcept { free( ptr ); }
+void operator delete( void* ptr, size_t ) noexcept { free( ptr ); }
+
+namespace
+{
+
+template<class ComposerT>
+BufferT composeAddresses( const PublishableAddress& addr, size_t count )
+{
+    BufferT b;
+    ComposerT composer( b );
+    for ( size_t i=0; i<count; ++i )
+        impl::composeAddressInPublishable( composer, addr, i );
+    return b;
+}
+
+// parses count addresses into the same PublishableAddress, as a subscriber does for each change of an update; returns number of allocations made meanwhile
+template<template<class> class ParserT>
+size_t parseAddresses( BufferT& b, size_t count, size_t expectedSize )
+{
+    auto riter = b.getReadIter();
+    ParserT<BufferT> parser( riter );
+    PublishableAddress addr;
+    size_t allocationsBefore = allocationCount;
+    for ( size_t i=0; i<count; ++i )
+    {
+        addr.clear();
+        if ( !impl::parseAddressInPublishable( parser, addr ) || addr.size() != expectedSize || addr[expectedSize - 1] != i )
+            throw std::exception();
+    }
+    return allocationCount - allocationsBefore;
+}
+
+PublishableAddress makeAddress( size_t depth )
+{
+    PublishableAddress addr;
+    for ( size_t i=0; i<depth; ++i )
+        addr.push_back( i * 3 );
+    return addr;
+}
+
+} // namespace
+
+const lest::test test_publishable_address[] =
+{
+    lest_CASE( "test_publishable_address.InlineNoAllocations" )
+    {
+        PublishableAddress root = makeAddress( 2 );
+        size_t allocationsBefore = allocationCount;
+        PublishableAddress member( root, 7 ); // as RefWrapper4Set classes do
+        PublishableAddress nested( member, 1 );
+        PublishableAddress copy = nested;
+        PublishableAddress moved( std::move( copy ) );
+        bool prefixes = nested.startsWith( root ) && nested.startsWith( member ) && moved.startsWith( nested ) && !root.startsWith( member );
+        PublishableAddress full = makeAddress( PublishableAddress::inlineDepth );
+        bool fullPrefixes = full.startsWith( root ) && !full.startsWith( nested );
+        size_t allocations = allocationCount - allocationsBefore;
+
+        EXPECT( allocations == 0 );
+        EXPECT( prefixes );
+        EXPECT( fullPrefixes );
+        EXPECT( nested.size() == 4 );
+        EXPECT( nested[2] == 7 );
+        EXPECT( nested[3] == 1 );
+    },
+
+    lest_CASE( "test_publishable_address.ParseNoAllocations" )
+    {
+        PublishableAddress base = makeAddress( PublishableAddress::inlineDepth - 1 );
+        constexpr size_t count = 200;
+        BufferT gmq = composeAddresses<GmqComposer<BufferT>>( base, count );
+        BufferT json = composeAddresses<JsonComposer<BufferT>>( base, count );
+        EXPECT( parseAddresses<GmqParser>( gmq, count, PublishableAddress::inlineDepth ) == 0 );
+        EXPECT( parseAddresses<JsonParser>( json, count, PublishableAddress::inlineDepth ) == 0 );
+    },
+
+    lest_CASE( "test_publishable_address.DeepAddressesSpillOnce" )
+    {
+        PublishableAddress base = makeAddress( PublishableAddress::inlineDepth + 4 );
+        constexpr size_t count = 200;
+        BufferT gmq = composeAddresses<GmqComposer<BufferT>>( base, count );
+        // the first address spills to the heap; clear() keeps its capacity for the rest
+        size_t allocations = parseAddresses<GmqParser>( gmq, count, PublishableAddress::inlineDepth + 5 );
+        EXPECT( allocations > 0 );
+        EXPECT( allocations <= 4 ); // vector growth steps
+    },
+};
+
+lest_MODULE(specification(), test_publishable_address);
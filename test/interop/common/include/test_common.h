@@ -427,6 +427,49 @@ void testEmptyUpdate2(std::string fileNameInit, std::string fileNameUpdate, std:
 
 }
 
+// composes the same changes with and without update coalescing, and applies each update to a subscriber synced to the init state
+// returns sizes of the coalesced and of the plain update
+template<typename Types>
+std::pair<size_t, size_t> testCoalescedUpdate(std::function<typename Types::DataT()> getInitState,
+                        std::function<void(typename Types::PublishableT&)> doUpdatePub,
+                        std::function<void(typename Types::DataT&)> doUpdateData, lest::env& lest_env)
+{
+    auto data3 = getInitState();
+    doUpdateData(data3);
+
+    size_t sizes[2];
+    for(int i = 0; i != 2; ++i)
+    {
+        typename Types::PublishableT publ(getInitState());
+
+        BufferT buffInit;
+        typename Types::ComposerT composer(buffInit);
+        publ.generateStateSyncMessage(composer);
+
+        publ.getComposer().setUpdateCoalescing(i == 0);
+        publ.startTick(BufferT());
+        doUpdatePub(publ);
+        BufferT b = publ.endTick();
+        sizes[i] = b.size();
+
+        typename Types::SubscriberT subs;
+
+        auto itInit = buffInit.getReadIter();
+        typename Types::ParserT parserInit(itInit);
+
+        subs.parseStateSyncMessage(parserInit);
+
+        auto it = b.getReadIter();
+        typename Types::ParserT parser(it);
+
+        subs.applyMessageWithUpdates(parser);
+
+        EXPECT(subs == data3);
+    }
+
+    return { sizes[0], sizes[1] };
+}
+
 template<typename Types, typename Evs>
 void testNotify2(std::string fileNameInit, std::string fileNameUpdate, std::vector<Evs> events, lest::env& lest_env)
 {
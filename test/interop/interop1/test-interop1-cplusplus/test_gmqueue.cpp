@@ -37,6 +37,8 @@ public:
 	using ComposerT = globalmq::marshalling2::JsonComposer2<BufferT>;
 	template<class T>
 	using OwningPtrT = std::unique_ptr<T>;
+	template<class T>
+	using AllocatorForGMQueueT = std::allocator<T>;
 };
 
 GMQ_COLL string getSubcriptionAddress(const char* name)
@@ -65,7 +67,7 @@ void deliverAllMessages(MetaPoolT& mp, MsgQueue& queue, const std::string &fileP
         for (size_t i = 0; i < popped; ++i)
         {
             //		fmt::print( "msg = \"{}\"\n", messages[i].msg.begin() );
-            mp.onMessage(messages[i].msg);
+            mp.onMessage(messages[i].msg, messages[i].parsedHeader);
             ++msgCnt;
             if (!filePrefix.empty())
             {
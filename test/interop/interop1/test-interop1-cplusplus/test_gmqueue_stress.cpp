@@ -0,0 +1,293 @@
+/* -------------------------------------------------------------------------------
+* Copyright (c) 2022, OLogN Technologies AG
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*	 * Redistributions of source code must retain the above copyright
+*	   notice, this list of conditions and the following disclaimer.
+*	 * Redistributions in binary form must reproduce the above copyright
+*	   notice, this list of conditions and the following disclaimer in the
+*	   documentation and/or other materials provided with the distribution.
+*	 * Neither the name of the OLogN Technologies AG nor the
+*	   names of its contributors may be used to endorse or promote products
+*	   derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL OLogN Technologies AG BE LIABLE FOR ANY
+* DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+* ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* -------------------------------------------------------------------------------*/
+
+
+#include "test_common.h"
+#include "platforms/inproc_queue.h"
+#include <thread>
+#include <atomic>
+
+// GMQueue under concurrent load: publishers posting updates from their threads, subscribers subscribing from theirs,
+// and locations being added and removed in between. Meant to be run under ThreadSanitizer as well (see GLOBAL_MQ_TSAN)
+
+namespace
+{
+
+template<template<class> class ParserT_, template<class> class ComposerT_>
+class TestPlatformSupportT
+{
+public:
+	using BufferT = globalmq::marshalling::Buffer;
+	using ParserT = ParserT_<BufferT>;
+	using ComposerT = ComposerT_<BufferT>;
+	template<class T>
+	using OwningPtrT = std::unique_ptr<T>;
+	template<class T>
+	using AllocatorForGMQueueT = std::allocator<T>;
+};
+
+using JsonPlatformSupport = TestPlatformSupportT<globalmq::marshalling2::JsonParser2, globalmq::marshalling2::JsonComposer2>;
+using GmqPlatformSupport = TestPlatformSupportT<globalmq::marshalling2::GmqParser2, globalmq::marshalling2::GmqComposer2>;
+
+using BufferT = globalmq::marshalling::Buffer;
+using MsgQueue = typename ThreadQueuePostman<BufferT>::MsgQueue;
+
+constexpr size_t publisherCount = 2;
+constexpr int ticksPerPublisher = 300;
+constexpr size_t subscriberThreadCount = 3;
+constexpr size_t subscribersPerThread = 12;
+constexpr size_t churnThreadCount = 2;
+constexpr int churnRounds = 200;
+constexpr size_t slowQueueCapacity = 4;
+
+template<class MetaPoolT>
+size_t deliver( MetaPoolT& mp, MsgQueue& queue )
+{
+	size_t cnt = 0;
+	ThreadQueueItem<BufferT> messages[16];
+	while ( size_t popped = queue.pop_front( messages, 16, 0 ) )
+		for ( size_t i = 0; i < popped; ++i, ++cnt )
+			mp.onMessage( messages[i].msg, messages[i].parsedHeader, messages[i].sharedBody );
+	return cnt;
+}
+
+GMQ_COLL string publisherName( size_t idx ) { return fmt::format( "stress_pub_{}", idx ); }
+
+// all queues spill instead of blocking: a thread posting to a full queue must not wait for one that posts to its own
+template<class PlatformSupportT>
+struct StressPublisher
+{
+	using ComposerT = typename PlatformSupportT::ComposerT;
+
+	MsgQueue queue;
+	GMQThreadQueueTransport<PlatformSupportT> transport;
+	MetaPool<PlatformSupportT> mp;
+	mtest::publishable_seven_WrapperForPublisher<ComposerT> publ;
+	mtest::structures::publishable_seven data; // as it must be at subscribers
+	GMQ_COLL string path;
+
+	StressPublisher( GMQueue<PlatformSupportT>& gmqueue, size_t idx ) : queue( 256, true ), transport( gmqueue, publisherName( idx ), queue, idx, true )
+	{
+		mp.setTransport( &transport );
+		mp.add( &publ );
+
+		GmqPathHelper::PathComponents pc;
+		pc.type = PublishableStateMessageHeader::MsgType::subscriptionRequest;
+		pc.nodeName = publisherName( idx );
+		pc.statePublisherOrConnectionType = publ.publishableName();
+		path = GmqPathHelper::compose( pc );
+	}
+
+	void run()
+	{
+		for ( int i = 0; i < ticksPerPublisher; ++i )
+		{
+			deliver( mp, queue );
+			publ.get4set_intVec().insert_before( data.intVec.size(), i );
+			data.intVec.push_back( i );
+			mp.postAllUpdates();
+			std::this_thread::yield();
+		}
+	}
+};
+
+template<class PlatformSupportT>
+struct StressSubscribers
+{
+	MsgQueue queue;
+	GMQThreadQueueTransport<PlatformSupportT> transport;
+	MetaPool<PlatformSupportT> mp;
+	GMQ_COLL vector<GMQ_COLL unique_ptr<mtest::publishable_seven_subscriber>> subscribers;
+
+	StressSubscribers( GMQueue<PlatformSupportT>& gmqueue, int idx ) : queue( 256, true ), transport( gmqueue, queue, idx, true )
+	{
+		mp.setTransport( &transport );
+	}
+
+	// subscribes one by one to the publishers in turn, while delivering whatever comes, until publishers are done
+	void run( const GMQ_COLL vector<GMQ_COLL string>& paths, const std::atomic<size_t>& publishersDone )
+	{
+		for ( size_t i = 0; publishersDone.load() < paths.size(); ++i )
+		{
+			if ( i % 8 == 0 && subscribers.size() < subscribersPerThread )
+			{
+				subscribers.emplace_back( new mtest::publishable_seven_subscriber() );
+				mp.add( subscribers.back().get() );
+				mp.subscribe( subscribers.back().get(), paths[subscribers.size() % paths.size()] );
+			}
+			deliver( mp, queue );
+			std::this_thread::yield();
+		}
+	}
+};
+
+// subscribed to all publishers before they start, and then taking messages slowly from a small blocking queue,
+// so that publishers block while forwarding to it (see MPSCRingQueueWithFlowControl), with no GMQueue locks held
+template<class PlatformSupportT>
+struct SlowSubscriber
+{
+	MsgQueue queue;
+	GMQThreadQueueTransport<PlatformSupportT> transport;
+	MetaPool<PlatformSupportT> mp;
+	GMQ_COLL vector<GMQ_COLL unique_ptr<mtest::publishable_seven_subscriber>> subscribers;
+
+	SlowSubscriber( GMQueue<PlatformSupportT>& gmqueue, const GMQ_COLL vector<GMQ_COLL string>& paths ) : queue( slowQueueCapacity, false ), transport( gmqueue, queue, 99, true )
+	{
+		mp.setTransport( &transport );
+		for ( auto& path : paths )
+		{
+			subscribers.emplace_back( new mtest::publishable_seven_subscriber() );
+			mp.add( subscribers.back().get() );
+			mp.subscribe( subscribers.back().get(), path );
+		}
+	}
+
+	void run( const std::atomic<size_t>& publishersDone )
+	{
+		while ( queue.size() < slowQueueCapacity && publishersDone.load() < publisherCount )
+			std::this_thread::sleep_for( std::chrono::microseconds( 100 ) );
+		std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) ); // for publishers to run into the full queue
+		ThreadQueueItem<BufferT> messages[2];
+		while ( publishersDone.load() < publisherCount )
+		{
+			size_t popped = queue.pop_front( messages, 2, 0 );
+			for ( size_t i = 0; i < popped; ++i )
+				mp.onMessage( messages[i].msg, messages[i].parsedHeader, messages[i].sharedBody );
+			std::this_thread::sleep_for( std::chrono::microseconds( 100 ) );
+		}
+	}
+};
+
+// adds and removes named and unnamed locations, and looks up publishers' ones meanwhile
+template<class PlatformSupportT>
+void churnLocations( GMQueue<PlatformSupportT>& gmqueue, size_t threadIdx, std::atomic<int>& failures )
+{
+	for ( int i = 0; i < churnRounds; ++i )
+	{
+		MsgQueue queue( 16, true );
+		GMQThreadQueueTransport<PlatformSupportT> named( gmqueue, fmt::format( "churn_{}_{}", threadIdx, i ), queue, 1000 + i );
+		GMQThreadQueueTransport<PlatformSupportT> unnamed( gmqueue, queue, 2000 + i );
+		for ( size_t p = 0; p < publisherCount; ++p )
+			if ( !gmqueue.locationNameToSlotIdx( publisherName( p ) ).isInitialized() )
+				++failures;
+		std::this_thread::yield();
+	}
+}
+
+template<class PlatformSupportT>
+void gmqueueStress( lest::env & lest_env, bool withSlowSubscriber )
+{
+	using ComposerT = typename PlatformSupportT::ComposerT;
+
+	GMQueue<PlatformSupportT> gmqueue;
+	gmqueue.template initStateConcentratorFactory<mtest::StateConcentratorFactory<BufferT, ComposerT>>();
+	gmqueue.setAuthority( "" );
+
+	GMQ_COLL vector<GMQ_COLL unique_ptr<StressPublisher<PlatformSupportT>>> publishers;
+	GMQ_COLL vector<GMQ_COLL string> paths;
+	for ( size_t i = 0; i < publisherCount; ++i )
+	{
+		publishers.emplace_back( new StressPublisher<PlatformSupportT>( gmqueue, i ) );
+		paths.push_back( publishers.back()->path );
+	}
+	GMQ_COLL vector<GMQ_COLL unique_ptr<StressSubscribers<PlatformSupportT>>> subscribers;
+	for ( size_t i = 0; i < subscriberThreadCount; ++i )
+		subscribers.emplace_back( new StressSubscribers<PlatformSupportT>( gmqueue, (int)(100 + i) ) );
+	GMQ_COLL unique_ptr<SlowSubscriber<PlatformSupportT>> slow;
+	if ( withSlowSubscriber )
+		slow.reset( new SlowSubscriber<PlatformSupportT>( gmqueue, paths ) );
+
+	std::atomic<size_t> publishersDone = 0;
+	std::atomic<int> failures = 0;
+	auto guarded = [&]( auto&& f ) {
+		return [&failures, f]() {
+			try { f(); }
+			catch ( ... ) { ++failures; }
+		};
+	};
+
+	GMQ_COLL vector<std::thread> threads;
+	for ( auto& s : subscribers )
+		threads.emplace_back( guarded( [&, s = s.get()]() { s->run( paths, publishersDone ); } ) );
+	for ( size_t i = 0; i < churnThreadCount; ++i )
+		threads.emplace_back( guarded( [&, i]() { churnLocations( gmqueue, i, failures ); } ) );
+	if ( slow )
+		threads.emplace_back( guarded( [&]() { slow->run( publishersDone ); } ) );
+	for ( auto& p : publishers )
+		threads.emplace_back( guarded( [&, p = p.get()]() { p->run(); ++publishersDone; } ) );
+	for ( auto& t : threads )
+		t.join();
+	EXPECT( failures == 0 );
+
+	// subscription requests and responses still on their way
+	for ( int i = 0; i < 4; ++i )
+	{
+		for ( auto& p : publishers )
+			deliver( p->mp, p->queue );
+		for ( auto& s : subscribers )
+			deliver( s->mp, s->queue );
+		if ( slow )
+			deliver( slow->mp, slow->queue );
+	}
+
+	for ( auto& s : subscribers )
+	{
+		EXPECT( s->subscribers.size() != 0 );
+		for ( size_t i = 0; i < s->subscribers.size(); ++i )
+			EXPECT( *s->subscribers[i] == publishers[( i + 1 ) % publisherCount]->data );
+	}
+	if ( slow )
+	{
+		EXPECT( slow->queue.getHwmSize() == slowQueueCapacity );
+		for ( size_t i = 0; i < publisherCount; ++i )
+			EXPECT( *slow->subscribers[i] == publishers[i]->data );
+	}
+}
+
+} // namespace
+
+const lest::test test_gmqueue_stress[] =
+{
+	lest_CASE( "test_gmqueue_stress.Json" )
+	{
+		gmqueueStress<JsonPlatformSupport>( lest_env, false );
+	},
+	lest_CASE( "test_gmqueue_stress.Gmq" )
+	{
+		gmqueueStress<GmqPlatformSupport>( lest_env, false );
+	},
+	lest_CASE( "test_gmqueue_stress.FullQueueJson" )
+	{
+		gmqueueStress<JsonPlatformSupport>( lest_env, true );
+	},
+	lest_CASE( "test_gmqueue_stress.FullQueueGmq" )
+	{
+		gmqueueStress<GmqPlatformSupport>( lest_env, true );
+	},
+};
+
+lest_MODULE(specification(), test_gmqueue_stress);
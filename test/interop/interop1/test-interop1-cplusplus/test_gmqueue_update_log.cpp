@@ -0,0 +1,530 @@
+/* -------------------------------------------------------------------------------
+* Copyright (c) 2022, OLogN Technologies AG
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*	 * Redistributions of source code must retain the above copyright
+*	   notice, this list of conditions and the following disclaimer.
+*	 * Redistributions in binary form must reproduce the above copyright
+*	   notice, this list of conditions and the following disclaimer in the
+*	   documentation and/or other materials provided with the distribution.
+*	 * Neither the name of the OLogN Technologies AG nor the
+*	   names of its contributors may be used to endorse or promote products
+*	   derived from this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL OLogN Technologies AG BE LIABLE FOR ANY
+* DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+* ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* -------------------------------------------------------------------------------*/
+
+#include "test_common.h"
+#include "platforms/inproc_queue.h"
+
+// Subscribers coming back with a state version they have (see StateUpdateLogT): resync via concentrator's update log,
+// dropping of updates already applied, and state sync for a version of another publisher instance.
+// New subscribers: state sync composed once while the state stays the same, and recomposed after it changes
+
+namespace
+{
+
+template<template<class> class ParserT_, template<class> class ComposerT_>
+class TestPlatformSupportT
+{
+public:
+	using BufferT = globalmq::marshalling::Buffer;
+	using ParserT = ParserT_<BufferT>;
+	using ComposerT = ComposerT_<BufferT>;
+	template<class T>
+	using OwningPtrT = std::unique_ptr<T>;
+	template<class T>
+	using AllocatorForGMQueueT = std::allocator<T>;
+};
+
+using JsonPlatformSupport = TestPlatformSupportT<globalmq::marshalling2::JsonParser2, globalmq::marshalling2::JsonComposer2>;
+using GmqPlatformSupport = TestPlatformSupportT<globalmq::marshalling2::GmqParser2, globalmq::marshalling2::GmqComposer2>;
+
+using BufferT = globalmq::marshalling::Buffer;
+
+int stateSyncsComposed = 0; // by concentrators
+
+template<class ComposerT>
+class CountingConcentrator : public StateConcentratorBase<BufferT, ComposerT>
+{
+	GMQ_COLL unique_ptr<StateConcentratorBase<BufferT, ComposerT>> impl;
+
+public:
+	CountingConcentrator( StateConcentratorBase<BufferT, ComposerT>* impl_ ) : impl( impl_ ) {}
+	void applyGmqMessageWithUpdates( GmqParser<BufferT>& parser ) override { impl->applyGmqMessageWithUpdates( parser ); }
+	void applyJsonMessageWithUpdates( JsonParser<BufferT>& parser ) override { impl->applyJsonMessageWithUpdates( parser ); }
+	void applyGmqStateSyncMessage( GmqParser<BufferT>& parser ) override { impl->applyGmqStateSyncMessage( parser ); }
+	void applyJsonStateSyncMessage( JsonParser<BufferT>& parser ) override { impl->applyJsonStateSyncMessage( parser ); }
+	void generateStateSyncMessage( ComposerT& composer ) override { ++stateSyncsComposed; impl->generateStateSyncMessage( composer ); }
+	void publishableApplyUpdates( globalmq::marshalling2::ParserBase& parser ) override { impl->publishableApplyUpdates( parser ); }
+	void publishableApplyStateSync( globalmq::marshalling2::ParserBase& parser ) override { impl->publishableApplyStateSync( parser ); }
+	void publishableGenerateStateSync( globalmq::marshalling2::ComposerBase& composer ) override { ++stateSyncsComposed; impl->publishableGenerateStateSync( composer ); }
+};
+
+template<class ComposerT>
+class CountingConcentratorFactory : public StateConcentratorFactoryBase<BufferT, ComposerT>
+{
+	mtest::StateConcentratorFactory<BufferT, ComposerT> factory;
+
+public:
+	StateConcentratorBase<BufferT, ComposerT>* createConcentrator( uint64_t typeID ) override { return new CountingConcentrator<ComposerT>( factory.createConcentrator( typeID ) ); }
+};
+
+class SevenSubscriber : public mtest::publishable_seven_subscriber
+{
+public:
+	int inserted = 0; // elements of intVec, as inserted by updates
+	void notifyInserted_intVec( size_t ) override { ++inserted; }
+};
+
+template<class MsgQueueT>
+size_t drop( MsgQueueT& queue )
+{
+	size_t cnt = 0;
+	ThreadQueueItem<BufferT> messages[16];
+	while ( size_t popped = queue.pop_front( messages, 16, 0 ) )
+		cnt += popped;
+	return cnt;
+}
+
+template<class MetaPoolT, class MsgQueueT>
+size_t deliver( MetaPoolT& mp, MsgQueueT& queue )
+{
+	size_t cnt = 0;
+	ThreadQueueItem<BufferT> messages[16];
+	while ( size_t popped = queue.pop_front( messages, 16, 0 ) )
+		for ( size_t i = 0; i < popped; ++i, ++cnt )
+			mp.onMessage( messages[i].msg, messages[i].parsedHeader, messages[i].sharedBody );
+	return cnt;
+}
+
+// a node: GMQueue with publisher of publishable_seven (and its own subscriber) at "test_node", and another subscriber at a separate transport
+template<class PlatformSupportT>
+struct Node
+{
+	using ComposerT = typename PlatformSupportT::ComposerT;
+	using MsgQueue = typename ThreadQueuePostman<BufferT>::MsgQueue;
+
+	GMQueue<PlatformSupportT> gmqueue;
+	MsgQueue queue, queue2;
+	GMQThreadQueueTransport<PlatformSupportT> transport;
+	GMQThreadQueueTransport<PlatformSupportT> transport2;
+	MetaPool<PlatformSupportT> mp, mp2;
+	mtest::publishable_seven_WrapperForPublisher<ComposerT> publ;
+	mtest::structures::publishable_seven data; // as it must be at subscribers
+	GMQ_COLL string path;
+	int64_t ticks = 0;
+
+	Node( size_t updateLogDepth, int64_t valueBase, bool sharedBodies = true ) : transport( initGmqueue( updateLogDepth ), "test_node", queue, 1, sharedBodies ), transport2( gmqueue, queue2, 2, sharedBodies ), ticks( valueBase )
+	{
+		mp.setTransport( &transport );
+		mp.setUpdateLogDepth( updateLogDepth );
+		mp2.setTransport( &transport2 );
+		mp.add( &publ );
+
+		GmqPathHelper::PathComponents pc;
+		pc.type = PublishableStateMessageHeader::MsgType::subscriptionRequest;
+		pc.nodeName = "test_node";
+		pc.statePublisherOrConnectionType = publ.publishableName();
+		path = GmqPathHelper::compose( pc );
+	}
+	GMQueue<PlatformSupportT>& initGmqueue( size_t updateLogDepth )
+	{
+		gmqueue.template initStateConcentratorFactory<CountingConcentratorFactory<ComposerT>>();
+		gmqueue.setAuthority( "" );
+		gmqueue.setUpdateLogDepth( updateLogDepth );
+		return gmqueue;
+	}
+
+	void tick() // appends to intVec, so that an update applied twice shows
+	{
+		++ticks;
+		publ.get4set_intVec().insert_before( data.intVec.size(), ticks );
+		data.intVec.push_back( ticks );
+		mp.postAllUpdates();
+	}
+	size_t pump()
+	{
+		size_t cnt = 0;
+		for ( int i = 0; i < 3; ++i )
+			cnt += deliver( mp, queue ) + deliver( mp2, queue2 );
+		return cnt;
+	}
+};
+
+template<class PlatformSupportT>
+void resyncFromUpdateLog( lest::env & lest_env )
+{
+	Node<PlatformSupportT> node( 4, 0 );
+	SevenSubscriber a, b;
+	node.mp.add( &a );
+	node.mp.subscribe( &a, node.path );
+	node.mp2.add( &b );
+	node.mp2.subscribe( &b, node.path );
+	node.pump();
+	node.tick();
+	node.pump();
+	EXPECT( a == node.data );
+	EXPECT( b == node.data );
+	int syncs = stateSyncsComposed;
+
+	// b misses two updates and comes back: gets just them
+	node.tick();
+	drop( node.queue2 );
+	node.tick();
+	drop( node.queue2 );
+	int inserted = b.inserted;
+	node.mp2.subscribe( &b, node.path );
+	node.pump();
+	EXPECT( b == node.data );
+	EXPECT( a == node.data );
+	EXPECT( b.inserted == inserted + 2 );
+	EXPECT( stateSyncsComposed == syncs );
+
+	// b is subscribed twice now, and each update comes to it twice; the second one is dropped
+	node.tick();
+	node.pump();
+	EXPECT( b == node.data );
+	EXPECT( b.inserted == inserted + 3 );
+
+	// more missed updates than the log keeps: state sync
+	for ( int i = 0; i < 6; ++i )
+	{
+		node.tick();
+		drop( node.queue2 );
+	}
+	node.mp2.subscribe( &b, node.path );
+	node.pump();
+	EXPECT( b == node.data );
+	EXPECT( stateSyncsComposed == syncs + 1 );
+	node.tick();
+	node.pump();
+	EXPECT( b == node.data );
+	EXPECT( a == node.data );
+}
+
+template<class PlatformSupportT>
+void noUpdateLog( lest::env & lest_env )
+{
+	Node<PlatformSupportT> node( 0, 0 );
+	SevenSubscriber b;
+	node.mp2.add( &b );
+	node.mp2.subscribe( &b, node.path );
+	node.pump();
+	node.tick();
+	node.pump();
+	EXPECT( b == node.data );
+	int syncs = stateSyncsComposed;
+
+	node.tick();
+	drop( node.queue2 );
+	node.mp2.subscribe( &b, node.path );
+	node.pump();
+	EXPECT( b == node.data );
+	EXPECT( stateSyncsComposed == syncs + 1 );
+}
+
+template<class PlatformSupportT>
+void otherEpochGetsStateSync( lest::env & lest_env )
+{
+	// two instances of the same publisher (say, before and after restart), with the same versions, but different states
+	Node<PlatformSupportT> nodeA( 4, 0 );
+	Node<PlatformSupportT> nodeB( 4, 1000 );
+	SevenSubscriber b, c;
+	nodeA.mp2.add( &b );
+	nodeA.mp2.subscribe( &b, nodeA.path );
+	nodeB.mp2.add( &c );
+	nodeB.mp2.subscribe( &c, nodeB.path );
+	nodeA.pump();
+	nodeB.pump();
+	for ( int i = 0; i < 3; ++i )
+	{
+		nodeA.tick();
+		nodeB.tick();
+	}
+	nodeB.tick();
+	nodeA.pump();
+	nodeB.pump();
+	EXPECT( b == nodeA.data );
+	EXPECT( c == nodeB.data );
+
+	// b's version is in the log of B's concentrator, but it is a version of A
+	int syncs = stateSyncsComposed;
+	nodeA.mp2.setTransport( &nodeB.transport2 );
+	nodeA.mp2.subscribe( &b, nodeB.path );
+	for ( int i = 0; i < 3; ++i )
+		deliver( nodeA.mp2, nodeB.queue2 );
+	EXPECT( b == nodeB.data );
+	EXPECT( stateSyncsComposed == syncs + 1 );
+}
+
+template<class PlatformSupportT>
+void duplicateIsDropped( lest::env & lest_env, bool checkEnd )
+{
+	Node<PlatformSupportT> node( 4, 0 );
+	SevenSubscriber b;
+	node.mp2.add( &b );
+	node.mp2.subscribe( &b, node.path );
+	node.pump();
+	node.tick();
+	deliver( node.mp, node.queue );
+
+	ThreadQueueItem<BufferT> messages[16];
+	size_t popped = node.queue2.pop_front( messages, 16, 0 );
+	EXPECT( popped == 1 );
+	BufferT duplicate;
+	node.mp2.onMessage( messages[0].msg, messages[0].parsedHeader, messages[0].sharedBody );
+	BufferT& msg = messages[0].materialize();
+	duplicate.append( msg.begin(), msg.size() );
+	EXPECT( b == node.data );
+	EXPECT( b.inserted == 1 );
+
+	// dropped, but still parsed up to its end
+	if ( checkEnd )
+	{
+		BufferT malformed;
+		malformed.append( duplicate.begin(), duplicate.size() - 1 );
+		malformed.appendUint8( ']' ); // instead of closing '}'
+		EXPECT_THROWS( node.mp2.onMessage( malformed ) );
+	}
+	node.mp2.onMessage( duplicate );
+	EXPECT( b == node.data );
+	EXPECT( b.inserted == 1 );
+}
+
+template<class PlatformSupportT>
+void publisherStateSyncCache( lest::env & lest_env )
+{
+	using ComposerT = typename PlatformSupportT::ComposerT;
+	mtest::publishable_seven_WrapperForPublisher<ComposerT> publ;
+	StatePublisherData<PlatformSupportT> data( 0, &publ, false );
+	auto composedNow = [&]() {
+		BufferT buff;
+		ComposerT composer( buff );
+		publ.generateStateSyncMessage( composer );
+		helperComposePublishableStateMessageEnd( composer );
+		return GMQ_COLL string( reinterpret_cast<const char*>( buff.begin() ), buff.size() );
+	};
+	auto text = []( const SharedMessageBodyT<BufferT>& body ) { return GMQ_COLL string( reinterpret_cast<const char*>( body.begin() ), body.size() ); };
+
+	SharedMessageBodyT<BufferT> first = data.getStateSyncBody();
+	EXPECT( text( first ) == composedNow() );
+	EXPECT( data.getStateSyncBody().begin() == first.begin() ); // the same body, not just the same content
+
+	publ.get4set_intVec().insert_before( 0, 17 );
+	SharedMessageBodyT<BufferT> changed = data.getStateSyncBody();
+	EXPECT( changed.begin() != first.begin() );
+	EXPECT( text( changed ) != text( first ) );
+	EXPECT( text( changed ) == composedNow() );
+	EXPECT( data.getStateSyncBody().begin() == changed.begin() );
+
+	data.endTick(); // changes are counted across ticks
+	BufferT buff;
+	data.startTick( std::move( buff ), false );
+	EXPECT( data.getStateSyncBody().begin() == changed.begin() );
+	publ.set_strVec( { "five" } );
+	EXPECT( text( data.getStateSyncBody() ) == composedNow() );
+	EXPECT( text( data.getStateSyncBody() ) != text( changed ) );
+}
+
+template<class PlatformSupportT>
+void concentratorStateSyncCache( lest::env & lest_env )
+{
+	Node<PlatformSupportT> node( 0, 0 );
+	SevenSubscriber a, b, c, d, e;
+	node.mp2.add( &a );
+	node.mp2.subscribe( &a, node.path );
+	node.pump();
+	node.tick();
+	node.pump();
+	EXPECT( a == node.data );
+	int syncs = stateSyncsComposed;
+
+	// state has changed since a came: b gets it as it is now
+	node.mp2.add( &b );
+	node.mp2.subscribe( &b, node.path );
+	node.pump();
+	EXPECT( b == node.data );
+	EXPECT( b.get_intVec().size() == 1 );
+	EXPECT( stateSyncsComposed == syncs + 1 );
+
+	// state is the same: c gets what b got
+	node.mp2.add( &c );
+	node.mp2.subscribe( &c, node.path );
+	node.pump();
+	EXPECT( c == node.data );
+	EXPECT( stateSyncsComposed == syncs + 1 );
+
+	// and after an update, not the cached one
+	node.tick();
+	node.pump();
+	node.mp2.add( &d );
+	node.mp2.subscribe( &d, node.path );
+	node.pump();
+	EXPECT( d == node.data );
+	EXPECT( d.get_intVec().size() == 2 );
+	EXPECT( stateSyncsComposed == syncs + 2 );
+
+	node.mp2.add( &e );
+	node.mp2.subscribe( &e, node.path );
+	node.pump();
+	EXPECT( e == node.data );
+	EXPECT( stateSyncsComposed == syncs + 2 );
+
+	node.tick();
+	node.pump();
+	EXPECT( a == node.data );
+	EXPECT( b == node.data );
+	EXPECT( c == node.data );
+	EXPECT( d == node.data );
+	EXPECT( e == node.data );
+}
+
+template<class PlatformSupportT>
+void fanOutSharesBody( lest::env & lest_env )
+{
+	Node<PlatformSupportT> node( 0, 0 );
+	SevenSubscriber a, b, c;
+	node.mp.add( &a );
+	node.mp.subscribe( &a, node.path );
+	node.mp2.add( &b );
+	node.mp2.subscribe( &b, node.path );
+	node.mp2.add( &c );
+	node.mp2.subscribe( &c, node.path );
+	node.pump();
+	node.tick();
+
+	// one update for each subscriber, all with the body the publisher has composed, none with a copy of it
+	ThreadQueueItem<BufferT> messages[16];
+	size_t popped = node.queue.pop_front( messages, 16, 0 );
+	EXPECT( popped == 1 );
+	size_t popped2 = node.queue2.pop_front( messages + popped, 16 - popped, 0 );
+	EXPECT( popped2 == 2 );
+	for ( size_t i = 0; i < popped + popped2; ++i )
+	{
+		EXPECT( messages[i].sharedBody.isValid() );
+		EXPECT( messages[i].sharedBody.begin() == messages[0].sharedBody.begin() );
+		EXPECT( messages[i].msg.size() == 0 );
+	}
+	EXPECT( messages[1].parsedHeader.header.ref_id_at_subscriber != messages[2].parsedHeader.header.ref_id_at_subscriber );
+
+	node.mp.onMessage( messages[0].msg, messages[0].parsedHeader, messages[0].sharedBody );
+	for ( size_t i = popped; i < popped + popped2; ++i )
+		node.mp2.onMessage( messages[i].msg, messages[i].parsedHeader, messages[i].sharedBody );
+	EXPECT( a == node.data );
+	EXPECT( b == node.data );
+	EXPECT( c == node.data );
+}
+
+template<class PlatformSupportT>
+void fanOutToWholeMessages( lest::env & lest_env )
+{
+	Node<PlatformSupportT> node( 0, 0, false );
+	SevenSubscriber a, b;
+	node.mp.add( &a );
+	node.mp.subscribe( &a, node.path );
+	node.mp2.add( &b );
+	node.mp2.subscribe( &b, node.path );
+	node.pump();
+	node.tick();
+
+	// recipients that have not asked for shared bodies get each message as a whole in msg
+	ThreadQueueItem<BufferT> messages[16];
+	size_t popped = node.queue.pop_front( messages, 16, 0 );
+	EXPECT( popped == 1 );
+	size_t popped2 = node.queue2.pop_front( messages + popped, 16 - popped, 0 );
+	EXPECT( popped2 == 1 );
+	for ( size_t i = 0; i < popped + popped2; ++i )
+	{
+		EXPECT( !messages[i].sharedBody.isValid() );
+		EXPECT( messages[i].msg.size() > messages[i].parsedHeader.bodyOffset );
+	}
+
+	node.mp.onMessage( messages[0].msg, messages[0].parsedHeader );
+	node.mp2.onMessage( messages[1].msg );
+	EXPECT( a == node.data );
+	EXPECT( b == node.data );
+}
+
+} // namespace
+
+const lest::test test_gmqueue_update_log[] =
+{
+	lest_CASE( "test_gmqueue_update_log.ResyncJson" )
+	{
+		resyncFromUpdateLog<JsonPlatformSupport>( lest_env );
+	},
+	lest_CASE( "test_gmqueue_update_log.ResyncGmq" )
+	{
+		resyncFromUpdateLog<GmqPlatformSupport>( lest_env );
+	},
+	lest_CASE( "test_gmqueue_update_log.NoUpdateLogJson" )
+	{
+		noUpdateLog<JsonPlatformSupport>( lest_env );
+	},
+	lest_CASE( "test_gmqueue_update_log.NoUpdateLogGmq" )
+	{
+		noUpdateLog<GmqPlatformSupport>( lest_env );
+	},
+	lest_CASE( "test_gmqueue_update_log.DuplicateDroppedJson" )
+	{
+		duplicateIsDropped<JsonPlatformSupport>( lest_env, true );
+	},
+	lest_CASE( "test_gmqueue_update_log.DuplicateDroppedGmq" )
+	{
+		duplicateIsDropped<GmqPlatformSupport>( lest_env, false ); // message end is not marked in GMQ
+	},
+	lest_CASE( "test_gmqueue_update_log.OtherEpochJson" )
+	{
+		otherEpochGetsStateSync<JsonPlatformSupport>( lest_env );
+	},
+	lest_CASE( "test_gmqueue_update_log.OtherEpochGmq" )
+	{
+		otherEpochGetsStateSync<GmqPlatformSupport>( lest_env );
+	},
+	lest_CASE( "test_gmqueue_update_log.PublisherStateSyncCacheJson" )
+	{
+		publisherStateSyncCache<JsonPlatformSupport>( lest_env );
+	},
+	lest_CASE( "test_gmqueue_update_log.PublisherStateSyncCacheGmq" )
+	{
+		publisherStateSyncCache<GmqPlatformSupport>( lest_env );
+	},
+	lest_CASE( "test_gmqueue_update_log.ConcentratorStateSyncCacheJson" )
+	{
+		concentratorStateSyncCache<JsonPlatformSupport>( lest_env );
+	},
+	lest_CASE( "test_gmqueue_update_log.ConcentratorStateSyncCacheGmq" )
+	{
+		concentratorStateSyncCache<GmqPlatformSupport>( lest_env );
+	},
+	lest_CASE( "test_gmqueue_update_log.FanOutSharesBodyJson" )
+	{
+		fanOutSharesBody<JsonPlatformSupport>( lest_env );
+	},
+	lest_CASE( "test_gmqueue_update_log.FanOutSharesBodyGmq" )
+	{
+		fanOutSharesBody<GmqPlatformSupport>( lest_env );
+	},
+	lest_CASE( "test_gmqueue_update_log.FanOutToWholeMessagesJson" )
+	{
+		fanOutToWholeMessages<JsonPlatformSupport>( lest_env );
+	},
+	lest_CASE( "test_gmqueue_update_log.FanOutToWholeMessagesGmq" )
+	{
+		fanOutToWholeMessages<GmqPlatformSupport>( lest_env );
+	},
+};
+
+lest_MODULE(specification(), test_gmqueue_update_log);
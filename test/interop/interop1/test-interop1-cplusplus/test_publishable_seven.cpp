@@ -352,6 +352,89 @@ std::vector<Events7> events5 = {
                     Events7::notifyUpdated_structVec,
                     Events7::notifyUpdated
                 };
+
+void doUpdateRepeatedSets(mtest::structures::publishable_seven& data)
+{
+    data.intVec[0] = 9;
+    data.structVec[0].y = 509;
+    data.strVec = { "five" };
+}
+
+template<class T>
+void doUpdatePublisherRepeatedSets(T& publ)
+{
+    //same members set several times, only the last values should go out
+    for(int i = 0; i != 10; ++i)
+    {
+        publ.get4set_intVec().set_at(i, 0);
+        publ.get4set_structVec().get4set_at(0).set_y(500 + i);
+    }
+
+    //element sets followed by a set of the whole vector
+    publ.get4set_strVec().set_at("four", 1);
+    publ.set_strVec({ "five" });
+}
+
+void doUpdateInsertRemove(mtest::structures::publishable_seven& data)
+{
+    data.uintVec.erase(data.uintVec.begin() + 1);
+}
+
+template<class T>
+void doUpdatePublisherInsertRemove(T& publ)
+{
+    //inserted and removed within the same tick, should not go out at all
+    publ.get4set_intVec().insert_before(1, 42);
+    publ.get4set_intVec().remove(1);
+
+    mtest::structures::point3D v{301, 302, 303};
+    publ.get4set_structVec().insert_before(2, v);
+    publ.get4set_structVec().get4set_at(2).set_x(304);
+    publ.get4set_structVec().remove(2);
+
+    //set of an element that is removed afterwards
+    publ.get4set_uintVec().set_at(55, 1);
+    publ.get4set_uintVec().remove(1);
+}
+
+void doUpdateShiftingInsert(mtest::structures::publishable_seven& data)
+{
+    data.intVec = { 42, 1, 3 };
+    data.strVec = { "zero", "one", "three" };
+}
+
+template<class T>
+void doUpdatePublisherShiftingInsert(T& publ)
+{
+    //element 1 is shifted to 2 by the insertion, so neither the set nor the removal refers to the inserted element
+    publ.get4set_intVec().set_at(7, 1);
+    publ.get4set_intVec().insert_before(0, 42);
+    publ.get4set_intVec().remove(2);
+
+    publ.get4set_strVec().insert_before(0, "zero");
+    publ.get4set_strVec().remove(2);
+}
+
+GMQ_COLL string bigString(char c) { return GMQ_COLL string(1000, c); }
+
+void doUpdateSqueeze(mtest::structures::publishable_seven& data)
+{
+    data.intVec[2] = 19;
+    data.strVec = { bigString('j'), "tail" };
+    data.structVec[1].z = 219;
+}
+
+template<class T>
+void doUpdatePublisherSqueeze(T& publ)
+{
+    //drops well over the squeeze threshold, with kept changes between the dropped ones
+    for(int i = 0; i != 10; ++i)
+    {
+        publ.set_strVec({ bigString('a' + i), "tail" });
+        publ.get4set_intVec().set_at(10 + i, 2);
+        publ.get4set_structVec().get4set_at(1).set_z(210 + i);
+    }
+}
 }
 
 const lest::test test_publishable_seven[] =
@@ -386,6 +469,35 @@ const lest::test test_publishable_seven[] =
         testUpdate2<publishable_seven_json>(PathPubSevenJson, PathPubSevenJson5, GetPublishableSeven, doUpdatePublisher5<typename publishable_seven_json::PublishableT>, doUpdate5, lest_env);
         testUpdate2<publishable_seven_gmq>(PathPubSevenGmq, PathPubSevenGmq5, GetPublishableSeven, doUpdatePublisher5<typename publishable_seven_gmq::PublishableT>, doUpdate5, lest_env);
     },
+    lest_CASE( "test_publishable_seven.TestCoalescedRepeatedSets" )
+    {
+        auto json = testCoalescedUpdate<publishable_seven_json>(GetPublishableSeven, doUpdatePublisherRepeatedSets<typename publishable_seven_json::PublishableT>, doUpdateRepeatedSets, lest_env);
+        EXPECT(json.first < json.second);
+        auto gmq = testCoalescedUpdate<publishable_seven_gmq>(GetPublishableSeven, doUpdatePublisherRepeatedSets<typename publishable_seven_gmq::PublishableT>, doUpdateRepeatedSets, lest_env);
+        EXPECT(gmq.first < gmq.second);
+    },
+    lest_CASE( "test_publishable_seven.TestCoalescedInsertRemove" )
+    {
+        auto json = testCoalescedUpdate<publishable_seven_json>(GetPublishableSeven, doUpdatePublisherInsertRemove<typename publishable_seven_json::PublishableT>, doUpdateInsertRemove, lest_env);
+        EXPECT(json.first < json.second);
+        auto gmq = testCoalescedUpdate<publishable_seven_gmq>(GetPublishableSeven, doUpdatePublisherInsertRemove<typename publishable_seven_gmq::PublishableT>, doUpdateInsertRemove, lest_env);
+        EXPECT(gmq.first < gmq.second);
+    },
+    lest_CASE( "test_publishable_seven.TestCoalescedShiftingInsert" )
+    {
+        //nothing may be dropped here
+        auto json = testCoalescedUpdate<publishable_seven_json>(GetPublishableSeven, doUpdatePublisherShiftingInsert<typename publishable_seven_json::PublishableT>, doUpdateShiftingInsert, lest_env);
+        EXPECT(json.first == json.second);
+        auto gmq = testCoalescedUpdate<publishable_seven_gmq>(GetPublishableSeven, doUpdatePublisherShiftingInsert<typename publishable_seven_gmq::PublishableT>, doUpdateShiftingInsert, lest_env);
+        EXPECT(gmq.first == gmq.second);
+    },
+    lest_CASE( "test_publishable_seven.TestCoalescedSqueeze" )
+    {
+        auto json = testCoalescedUpdate<publishable_seven_json>(GetPublishableSeven, doUpdatePublisherSqueeze<typename publishable_seven_json::PublishableT>, doUpdateSqueeze, lest_env);
+        EXPECT(json.second - json.first > 4096);
+        auto gmq = testCoalescedUpdate<publishable_seven_gmq>(GetPublishableSeven, doUpdatePublisherSqueeze<typename publishable_seven_gmq::PublishableT>, doUpdateSqueeze, lest_env);
+        EXPECT(gmq.second - gmq.first > 4096);
+    },
     lest_CASE( "test_publishable_seven.TestNotifyStateSync" )
     {
         testNotify2<publishable_seven_json>(PathPubSevenJson, "", events0, lest_env);
@@ -81,7 +81,7 @@ void deliverAllMessages(MetaPoolT& mp, MsgQueue& queue, const std::string &fileP
         for (size_t i = 0; i < popped; ++i)
         {
             //		fmt::print( "msg = \"{}\"\n", messages[i].msg.begin() );
-            mp.onMessage(messages[i].msg);
+            mp.onMessage(messages[i].msg, messages[i].parsedHeader);
             ++msgCnt;
             if (!filePrefix.empty())
             {
@@ -106,6 +106,39 @@ const lest::test test_message_two[] =
                 })
         );
             
+        EXPECT(condition);
+    },
+    lest_CASE( "test_message_two.TestGmqView" )
+    {
+        mtest::Buffer b = makeBuffer(PathMsg2Gmq, lest_env);
+
+        bool condition = false;
+
+        mtest::test_gmq::handleMessage(b,
+            mtest::makeMessageHandler<mtest::test_gmq::message_two>(
+                [&](auto& parser) {
+                    mtest::test_gmq::MESSAGE_message_two_View<std::remove_reference_t<decltype(parser)>> view(parser);
+                    auto msg2 = GetSampleStructOne();
+                    EXPECT(view.get_firstParam() == msg2.firstParam);
+                    EXPECT(view.get_secondParam_size() == msg2.secondParam.size());
+                    EXPECT(view.get_secondParam() == msg2.secondParam);
+                    EXPECT(view.get_thirdParam() == msg2.thirdParam);
+                    EXPECT(view.get_forthParam() == msg2.forthParam);
+                    EXPECT(view.get_fifthParam() == msg2.fifthParam);
+                    EXPECT(view.get_sixthParam() == msg2.sixthParam);
+                    EXPECT(view.get_seventhParam() == msg2.seventhParam);
+                    EXPECT(view.get_eighthParam() == msg2.eighthParam);
+                    EXPECT(view.get_ninethParam() == msg2.ninethParam);
+                    EXPECT(view.get_tenthParam_size() == msg2.tenthParam.size());
+                    EXPECT(view.get_tenthParam() == msg2.tenthParam);
+                    condition = true;
+                }),
+            mtest::makeDefaultMessageHandler(
+                [&](auto& parser, uint64_t msgID) {
+                    EXPECT(false);
+                })
+        );
+            
         EXPECT(condition);
     },
 };
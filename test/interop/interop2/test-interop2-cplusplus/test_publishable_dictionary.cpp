@@ -98,6 +98,33 @@ void doUpdatePublisher3(T& publ)
     publ.get4set_data().get4set_dictionary_one().remove("red");
 }
 
+void doUpdateCoalesced(mtest::structures::publishable_dictionary& data)
+{
+    data.data.dictionary_one["hello"] = "again";
+    data.data.dictionary_one["cow"] = "oink";
+    data.data.dictionary_one.erase("red");
+}
+
+template<class T>
+void doUpdatePublisherCoalesced(T& publ)
+{
+    //only the last update of a key should go out
+    publ.get4set_data().get4set_dictionary_one().update_value("hello", "goodbye");
+    publ.get4set_data().get4set_dictionary_one().update_value("hello", "again");
+
+    //an insertion followed by an update is kept as is
+    publ.get4set_data().get4set_dictionary_one().insert("cow", "moo");
+    publ.get4set_data().get4set_dictionary_one().update_value("cow", "oink");
+
+    //inserted and removed within the same tick, should not go out at all
+    publ.get4set_data().get4set_dictionary_one().insert("tmp", "value");
+    publ.get4set_data().get4set_dictionary_one().remove("tmp");
+
+    //update of a key that is removed afterwards
+    publ.get4set_data().get4set_dictionary_one().update_value("red", "green");
+    publ.get4set_data().get4set_dictionary_one().remove("red");
+}
+
 class publishable_dictionary_json : public types_json
 {
     public:
@@ -145,6 +172,13 @@ const lest::test test_publishable_dictionary[] =
         testUpdate2<publishable_dictionary_json>(Prefix + "state_sync_1.json", Prefix + "update_3.json", GetPublishableDictionary_1, doUpdatePublisher3<typename publishable_dictionary_json::PublishableT>, doUpdate3, lest_env);
         testUpdate2<publishable_dictionary_gmq>(Prefix + "state_sync_1.gmq", Prefix + "update_3.gmq", GetPublishableDictionary_1, doUpdatePublisher3<typename publishable_dictionary_gmq::PublishableT>, doUpdate3, lest_env);
     },
+    lest_CASE( "test_publishable_dictionary.TestCoalescedUpdate" )
+    {
+        auto json = testCoalescedUpdate<publishable_dictionary_json>(GetPublishableDictionary_1, doUpdatePublisherCoalesced<typename publishable_dictionary_json::PublishableT>, doUpdateCoalesced, lest_env);
+        EXPECT(json.first < json.second);
+        auto gmq = testCoalescedUpdate<publishable_dictionary_gmq>(GetPublishableDictionary_1, doUpdatePublisherCoalesced<typename publishable_dictionary_gmq::PublishableT>, doUpdateCoalesced, lest_env);
+        EXPECT(gmq.first < gmq.second);
+    },
 };
 
 lest_MODULE(specification(), test_publishable_dictionary);